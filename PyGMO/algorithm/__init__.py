@@ -89,6 +89,7 @@ def _jde_ctor(
         ftol=1e-6,
         xtol=1e-6,
         memory=False,
+        batch=False,
         screen_output=False):
     """
     Constructs a jDE algorithm (self-adaptive DE)
@@ -97,7 +98,7 @@ def _jde_ctor(
     J Brest, V Zumer, MS Maucec - Evolutionary Computation, 2006.
     http://dsp.szu.edu.cn/DSP2006/research/publication/yan/WebEdit/UploadFile/Self-adaptive%20Differential%20Evolution%20Algorithm%20for%20Constrained%20Real-Parameter%20Optimization.pdf
 
-    USAGE: algorithm.jde(gen=100, variant=2, variant_adptv=1, ftol=1e-6, xtol=1e-6, memory = False, screen_output = False)
+    USAGE: algorithm.jde(gen=100, variant=2, variant_adptv=1, ftol=1e-6, xtol=1e-6, memory = False, batch = False, screen_output = False)
 
     * gen: number of generations
     * variant: algoritmic variant to use (one of [1 .. 18])
@@ -115,6 +116,7 @@ def _jde_ctor(
     * ftol: stop criteria on f
     * xtol: stop criteria on x
     * memory: if True the algorithm internal state is saved and used for the next call
+    * batch: if True the trials of a generation are evaluated at once (concurrently, if the problem allows it) before the selection
     * screen_output: activates screen output of the algorithm (do not use in archipealgo, otherwise the screen will be flooded with
     *				 different island outputs)
     """
@@ -126,6 +128,7 @@ def _jde_ctor(
     arg_list.append(ftol)
     arg_list.append(xtol)
     arg_list.append(memory)
+    arg_list.append(batch)
     self._orig_init(*arg_list)
     self.screen_output = screen_output
 jde._orig_init = jde.__init__
@@ -150,11 +153,12 @@ def _de_1220_ctor(
         memory=False,
         ftol=1e-6,
         xtol=1e-6,
+        batch=False,
         screen_output=False):
     """
     Constructs a Differential Evolution algorithm (our own brew). Self adaptation on F, CR and mutation variant.:
 
-    USAGE: algorithm.de_1220(gen=100, variant_adptv=1, allowed_variants = [i for i in range(1,19)], memory = False, ftol=1e-6, xtol=1e-6, screen_output = False)
+    USAGE: algorithm.de_1220(gen=100, variant_adptv=1, allowed_variants = [i for i in range(1,19)], memory = False, ftol=1e-6, xtol=1e-6, batch = False, screen_output = False)
 
     * gen: number of generations
     * variant_adptv: adaptiv scheme to use (one of [1..2])
@@ -172,6 +176,7 @@ def _de_1220_ctor(
     * ftol: stop criteria on f
     * xtol: stop criteria on x
     * memory: if True the algorithm internal state is saved and used for the next call
+    * batch: if True the trials of a generation are evaluated at once (concurrently, if the problem allows it) before the selection
     """
     # We set the defaults or the kwargs
     arg_list = []
@@ -181,6 +186,7 @@ def _de_1220_ctor(
     arg_list.append(memory)
     arg_list.append(ftol)
     arg_list.append(xtol)
+    arg_list.append(batch)
     self._orig_init(*arg_list)
     self.screen_output = screen_output
 de_1220._orig_init = de_1220.__init__
@@ -534,18 +540,23 @@ sga_gray._orig_init = sga_gray.__init__
 sga_gray.__init__ = _sga_gray_ctor
 
 
-def _nsga_II_ctor(self, gen=100, cr=0.95, eta_c=10, m=0.01, eta_m=10):
+def _nsga_II_ctor(self, gen=100, cr=0.95, eta_c=10, m=0.01, eta_m=10, selection='generational'):
     """
     Constructs a Non-dominated Sorting Genetic Algorithm (NSGA_II)
 
-    USAGE: algorithm.nsga_II(self, gen=100, cr = 0.95, eta_c = 10, m = 0.01, eta_m = 10)
+    USAGE: algorithm.nsga_II(self, gen=100, cr = 0.95, eta_c = 10, m = 0.01, eta_m = 10, selection = 'generational')
 
     * gen: number of generations
     * cr: crossover factor [0,1[
     * eta_c: Distribution index for crossover
     * m: mutation probability [0,1]
     * eta_m: Distribution index for mutation
+    * selection: 'generational' or 'steady_state' (one offspring inserted at each step)
     """
+    SELECTION_TYPE = {
+        'generational': _algorithm._nsga_II_selection.GENERATIONAL,
+        'steady_state': _algorithm._nsga_II_selection.STEADY_STATE,
+    }
     # We set the defaults or the kwargs
     arg_list = []
     arg_list.append(gen)
@@ -553,6 +564,7 @@ def _nsga_II_ctor(self, gen=100, cr=0.95, eta_c=10, m=0.01, eta_m=10):
     arg_list.append(eta_c)
     arg_list.append(m)
     arg_list.append(eta_m)
+    arg_list.append(SELECTION_TYPE[selection.lower()])
     self._orig_init(*arg_list)
 nsga_II._orig_init = nsga_II.__init__
 nsga_II.__init__ = _nsga_II_ctor
@@ -751,14 +763,15 @@ def _moead_ctor(
         cr=1.0,
         f=0.5,
         eta_m=20,
-        diversity=True):
+        diversity=True,
+        batch=False):
     """
     Multi Objective Evolutionary Algorithm based on Decomposition and Differential Evolution (MOEA/D - DE)
 
     REF Zhang, Qingfu, and Hui Li. "MOEA/D: A multiobjective evolutionary algorithm based on decomposition." Evolutionary Computation, IEEE Transactions on 11.6 (2007): 712-731.
     REF Li, Hui, and Qingfu Zhang. "Multiobjective optimization problems with complicated Pareto sets, MOEA/D and NSGA-II." Evolutionary Computation, IEEE Transactions on 13.2 (2009): 284-302.
 
-    USAGE: algorithm.spea2(gen=100, weights = 'grid', T = 20, realb = 0.9, limit = 2, cr = 1.0, f = 0.5, eta_m=20, diversity=True)
+    USAGE: algorithm.moead(gen=100, weights = 'grid', T = 20, realb = 0.9, limit = 2, cr = 1.0, f = 0.5, eta_m=20, diversity=True, batch=False)
 
     * gen: Number of generations to evolve.
     * weights: weight generation method, one of ('grid', 'low_discrepancy', 'random')
@@ -769,6 +782,8 @@ def _moead_ctor(
     * f f parameter in the Differential Evolution operator
     * eta_m Distribution index for the polynomial mutation
     * diversity when true activates the two diversity preservation mechanism described in Li, Hui, and Qingfu Zhang paper
+    * batch when true the offspring of a whole generation are evaluated at once (concurrently, if the problem allows it)
+      and then inserted in the order the subproblems were visited
     """
     def weight_generation_type(x):
         return {
@@ -788,6 +803,7 @@ def _moead_ctor(
     arg_list.append(f)
     arg_list.append(eta_m)
     arg_list.append(diversity)
+    arg_list.append(batch)
     self._orig_init(*arg_list)
 moead._orig_init = moead.__init__
 moead.__init__ = _moead_ctor
@@ -1181,11 +1197,13 @@ def _cmaes_ctor(
         ftol=1e-6,
         xtol=1e-6,
         memory=False,
+        covariance='full',
+        async_eigen=False,
         screen_output=False):
     """
     Constructs a Covariance Matrix Adaptation Evolutionary Strategy (C++)
 
-    USAGE: algorithm.cmaes(gen = 500, cc = -1, cs = -1, c1 = -1, cmu = -1, sigma0=0.5, ftol = 1e-6, xtol = 1e-6, memory = False, screen_output = False)
+    USAGE: algorithm.cmaes(gen = 500, cc = -1, cs = -1, c1 = -1, cmu = -1, sigma0=0.5, ftol = 1e-6, xtol = 1e-6, memory = False, covariance = 'full', async_eigen = False, screen_output = False)
 
     NOTE: In our variant of the algorithm, particle memory is used to extract the elite and reinsertion
     is made aggressively ..... getting rid of the worst guy). Also, the bounds of the problem
@@ -1201,9 +1219,18 @@ def _cmaes_ctor(
     * xtol: stopping criteria on the x tolerance
     * ftol: stopping criteria on the f tolerance
     * memory: if True the algorithm internal state is saved and used for the next call
+    * covariance: 'full', 'separable' (diagonal, sep-CMA-ES) or 'limited_memory' (LM-CMA) model of the covariance matrix.
+    * 		 The last two need O(N) memory and are suited to problems with thousands of variables
+    * async_eigen: if True (and covariance is 'full') the eigendecomposition of C runs on a helper thread while sampling
+    * 		 continues with the previous one, which is replaced when the next decomposition is due
     * screen_output: activates screen output of the algorithm (do not use in archipealgo, otherwise the screen will be flooded with
     * 		 different island outputs)
     """
+    COVARIANCE_TYPE = {
+        'full': _algorithm._cmaes_covariance.FULL,
+        'separable': _algorithm._cmaes_covariance.SEPARABLE,
+        'limited_memory': _algorithm._cmaes_covariance.LIMITED_MEMORY,
+    }
     # We set the defaults or the kwargs
     arg_list = []
     arg_list.append(gen)
@@ -1215,6 +1242,8 @@ def _cmaes_ctor(
     arg_list.append(ftol)
     arg_list.append(xtol)
     arg_list.append(memory)
+    arg_list.append(COVARIANCE_TYPE[covariance.lower()])
+    arg_list.append(async_eigen)
     self._orig_init(*arg_list)
     self.screen_output = screen_output
 cmaes._orig_init = cmaes.__init__
@@ -247,8 +247,12 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.def(init<const int &, const double &, optional<const double &, const double &> >());
 
 	// CMAES
+	enum_<algorithm::cmaes::covariance_type>("_cmaes_covariance")
+		.value("FULL", algorithm::cmaes::FULL)
+		.value("SEPARABLE", algorithm::cmaes::SEPARABLE)
+		.value("LIMITED_MEMORY", algorithm::cmaes::LIMITED_MEMORY);
 	algorithm_wrapper<algorithm::cmaes>("cmaes","Covariance Matrix Adaptation Evolutionary Startegy")
-		.def(init<optional<int, double, double, double, double, double, double, double, bool> >())
+		.def(init<optional<int, double, double, double, double, double, double, double, bool, algorithm::cmaes::covariance_type, bool> >())
 		.add_property("gen",&algorithm::cmaes::get_gen,&algorithm::cmaes::set_gen)
 		.add_property("cc",&algorithm::cmaes::get_cc,&algorithm::cmaes::set_cc)
 		.add_property("cs",&algorithm::cmaes::get_cs,&algorithm::cmaes::set_cs)
@@ -345,8 +349,11 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.def(init<optional<int> >());
 
 	// NSGA II
+	enum_<algorithm::nsga2::selection_type>("_nsga_II_selection")
+		.value("GENERATIONAL", algorithm::nsga2::GENERATIONAL)
+		.value("STEADY_STATE", algorithm::nsga2::STEADY_STATE);
 	algorithm_wrapper<algorithm::nsga2>("nsga_II", "The NSGA-II algorithm")
-		.def(init<optional<int, double, double, double, double> >());
+		.def(init<optional<int, double, double, double, double, algorithm::nsga2::selection_type> >());
 	
 	// PaDe
 	enum_<algorithm::pade::weight_generation_type>("_weight_generation")
@@ -368,7 +375,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 		.value("GRID", algorithm::moead::GRID)
 		.value("LOW_DISCREPANCY", algorithm::moead::LOW_DISCREPANCY);
 	algorithm_wrapper<algorithm::moead>("moead", "MOEA/D-DE")
-		.def(init<optional<int, algorithm::moead::weight_generation_type, population::size_type, double, unsigned int, double,double,double,bool> >())
+		.def(init<optional<int, algorithm::moead::weight_generation_type, population::size_type, double, unsigned int, double,double,double,bool,bool> >())
 		.def("generate_weights", &algorithm::moead::generate_weights,
 		"Generates the weights of the decomposed problem\n\n"
 		"  USAGE:: w = moead.generate_weights(nf,nw)\n"
@@ -402,7 +409,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	// Differential evolution (jDE)
 	algorithm_wrapper<algorithm::jde>("jde", "Self-Adaptive Differential Evolution Algorithm: jDE.\n")
-		.def( init<optional<int, int, int, double, double, bool> >());
+		.def( init<optional<int, int, int, double, double, bool, bool> >());
 
 	// Differential evolution (mde_pbx)
 	algorithm_wrapper<algorithm::mde_pbx>("mde_pbx", "Self-Adaptive Differential Evolution Algorithm: mde_pbx.\n")
@@ -410,7 +417,7 @@ BOOST_PYTHON_MODULE(_algorithm) {
 
 	// Differential evolution (our own brew)
 	algorithm_wrapper<algorithm::de_1220>("de_1220", "Differential Evolution Algorithm (our brew ...).\n")
-		.def(init<optional<int, int, std::vector<int>, bool, double, double> >());
+		.def(init<optional<int, int, std::vector<int>, bool, double, double, bool> >());
 		
 	// Simulated annealing, Corana's version.
 	algorithm_wrapper<algorithm::sa_corana>("sa_corana","Simulated annealing, Corana's version with adaptive neighbourhood.")
@@ -300,6 +300,11 @@ BOOST_PYTHON_MODULE(_core)
 		.def("compute_nadir",&population::compute_nadir, "Get the nadir objective vector")
 		.def("compute_ideal",&population::compute_ideal, "Get the ideal objective vector")
 		.def("compute_pareto_fronts",&population::compute_pareto_fronts, "Computes all Pareto fronts")
+		.def("get_epoch",&population::get_epoch, "Get the modification epoch of the population")
+		.def("get_hv_contributions",&population::get_hv_contributions, "Get the (cached) hypervolume contributions of a group of individuals")
+		.def("get_hv_cache_hits",&population::get_hv_cache_hits, "Number of hypervolume contribution requests served from the cache")
+		.def("get_hv_cache_misses",&population::get_hv_cache_misses, "Number of hypervolume contribution requests computed")
+		.def("reset_hv_cache_counters",&population::reset_hv_cache_counters, "Reset the hypervolume cache counters")
 //		.def("get_crowding_d",&population::get_crowding_d, "returns crowding distance")
 //		.def("update_pareto_information",&population::update_pareto_information, "updates crowding distance and front informations")
 		.def("get_best_idx",get_best_1_idx(&population::get_best_idx),"Get index of best individual.")
@@ -405,6 +410,7 @@ BOOST_PYTHON_MODULE(_core)
 		.def("set_algorithm", &archipelago_set_algorithm,"Set algorithm on island.")
 		.def("dump_migr_history", &archipelago::dump_migr_history)
 		.def("clear_migr_history", &archipelago::clear_migr_history)
+		.def("get_dropped_migrations", &archipelago::get_dropped_migrations,"Number of migrations dropped because the inbox of the destination island was full.")
 		.def("cpp_loads", &py_cpp_loads<archipelago>,
 			"Load C++ serialized representation from string *str*.\n\n"
 			":Parameters:\n"
@@ -417,6 +423,7 @@ BOOST_PYTHON_MODULE(_core)
 		)
 		.add_property("topology", &archipelago::get_topology, &archipelago::set_topology,"Topology property.")
 		.add_property("distribution_type", &archipelago::get_distribution_type, &archipelago::set_distribution_type, "Distribution type property.")
+		.add_property("pool_size", &archipelago::get_pool_size, &archipelago::set_pool_size, "Number of threads evolving the islands (setting it to 0 selects the number of hardware threads).")
 		.def_pickle(archipelago_pickle_suite());
 
 	// Archipelago's migration strategies.
@@ -447,11 +447,14 @@ hv_algorithm.hoy._original_init = hv_algorithm.hoy.__init__
 hv_algorithm.hoy.__init__ = _hoy_ctor
 
 
-def _wfg_ctor(self, stop_dimension=2):
+def _wfg_ctor(self, stop_dimension=2, n_threads=1):
     """
     Hypervolume algorithm: WFG.
     Applicable to hypervolume computation problems of dimension in [2, ..]
 
+    n_threads: number of threads used by compute and contributions (0 for the number of hardware threads).
+    The results do not depend on the number of threads.
+
     REF: "A Fast Way of Calculating Exact Hypervolumes", Lyndon While, Lucas Bradstreet, Luigi Barone.
     IEEE TRANSACXTIONS ON EVOLUTIONARY COMPUTATION, VOL. 16, NO. 1, FEBRURARY 2012
 
@@ -464,6 +467,7 @@ def _wfg_ctor(self, stop_dimension=2):
     """
     args = []
     args.append(stop_dimension)
+    args.append(n_threads)
     return self._original_init(*args)
 hv_algorithm.wfg._original_init = hv_algorithm.wfg.__init__
 hv_algorithm.wfg.__init__ = _wfg_ctor
@@ -515,7 +519,7 @@ hv_algorithm.bf_approx._original_init = hv_algorithm.bf_approx.__init__
 hv_algorithm.bf_approx.__init__ = _bf_approx_ctor
 
 
-def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2):
+def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2, n_threads=1):
     """
     Hypervolume algorithm: Bringmann-Friedrich approximation.
 
@@ -527,15 +531,17 @@ def _bf_fpras_ctor(self, eps=1e-2, delta=1e-2):
     USAGE:
             * eps - accuracy of approximation
             * delta - confidence of approximation
+            * n_threads - number of threads drawing the samples (0 for the number of hardware threads)
 
             hv = hypervolume(...) # see 'hypervolume?' for usage
             refpoint = [1.0]*7
-            hv.least_contributor(r=refpoint, algorithm=hv_algorithm.bf_fpras())
+            hv.compute(r=refpoint, algorithm=hv_algorithm.bf_fpras())
     """
 
     args = []
     args.append(eps)
     args.append(delta)
+    args.append(n_threads)
     return self._original_init(*args)
 hv_algorithm.bf_fpras._original_init = hv_algorithm.bf_fpras.__init__
 hv_algorithm.bf_fpras.__init__ = _bf_fpras_ctor
@@ -131,10 +131,10 @@ void expose_hv_algorithm()
 	algorithm_wrapper<util::hv_algorithm::hv4d>("hv4d","hv4d algorithm.");
 	algorithm_wrapper<util::hv_algorithm::fpl>("fpl","FPL algorithm.");
 	algorithm_wrapper<util::hv_algorithm::hoy>("hoy","HOY algorithm.");
-	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int>());
+	class_<util::hv_algorithm::wfg, bases<util::hv_algorithm::base> >("wfg","WFG algorithm.", init<const unsigned int, const unsigned int>());
 	class_<util::hv_algorithm::bf_approx, bases<util::hv_algorithm::base> >("bf_approx","Bringmann-Friedrich approximated algorithm.", 
 			init<const bool, const unsigned int, const double, const double, const double, const double, const double, const double>());
-	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double>());
+	class_<util::hv_algorithm::bf_fpras, bases<util::hv_algorithm::base> >("bf_fpras","Hypervolume approximation based on FPRAS", init<const double, const double, const unsigned int>());
 }
 
 void expose_hypervolume()
@@ -171,7 +171,11 @@ void expose_hypervolume()
 		.def("get_copy_points", &util::hypervolume::get_copy_points)
 		.def("get_points", &util::hypervolume::get_points)
 		.def("set_verify", &util::hypervolume::set_verify)
-		.def("get_verify", &util::hypervolume::get_verify);
+		.def("get_verify", &util::hypervolume::get_verify)
+		.def("set_threads", &util::hypervolume::set_threads, "Sets the number of threads used by the automatically chosen algorithms.")
+		.def("get_threads", &util::hypervolume::get_threads)
+		.def("set_approx_threshold", &util::hypervolume::set_approx_threshold, "Sets the expected number of operations above which the hypervolume is approximated.")
+		.def("get_approx_threshold", &util::hypervolume::get_approx_threshold);
 }
 
 // Main method containing all the juice of race_pop
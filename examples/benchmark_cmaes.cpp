@@ -0,0 +1,63 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iomanip>
+#include <iostream>
+#include "../src/pagmo.h"
+
+/**
+DESCRIPTION: This example measures the time per generation of CMA-ES on the Rosenbrock function in 100, 1000 and 5000
+dimensions, with a population of 100 individuals, for each of the FULL, SEPARABLE and LIMITED_MEMORY covariance models. The number of generations can be passed as first argument (default 20);
+in N dimensions max(1, gen * 1000 / N) generations are run (gen for N <= 1000), so that the largest problem takes a comparable time.
+*/
+
+using namespace pagmo;
+
+int main(int argc, char *argv[])
+{
+	const int gen = argc > 1 ? boost::lexical_cast<int>(argv[1]) : 20;
+	const int sizes[] = {100, 1000, 5000};
+	const algorithm::cmaes::covariance_type models[] = {algorithm::cmaes::FULL, algorithm::cmaes::SEPARABLE, algorithm::cmaes::LIMITED_MEMORY};
+	const char *names[] = {"FULL", "SEPARABLE", "LIMITED_MEMORY"};
+	std::cout << std::setw(16) << "model" << std::setw(8) << "N" << std::setw(8) << "gen" << std::setw(16) << "seconds/gen" << std::setw(20) << "best" << std::endl;
+	for (int k = 0; k < 3; ++k) {
+		for (int j = 0; j < 3; ++j) {
+			const int g = sizes[j] <= 1000 ? gen : std::max<int>(1,gen * 1000 / sizes[j]);
+			problem::rosenbrock prob(sizes[j]);
+			population pop(prob,100,42);
+			// Tolerances set to zero, so that all the generations are run.
+			algorithm::cmaes algo(g,-1,-1,-1,-1,0.5,0.,0.,true,models[k]);
+			algo.reset_rngs(42);
+			const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+			algo.evolve(pop);
+			const double t = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() / 1E6 / g;
+			std::cout << std::setw(16) << names[k] << std::setw(8) << sizes[j] << std::setw(8) << g << std::setprecision(4) << std::setw(16) << t
+				<< std::setprecision(10) << std::setw(20) << pop.champion().f[0] << std::endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+
+/**
+DESCRIPTION: This example measures the number of trial vectors per second built and evaluated by DE (strategies
+rand/1/exp and rand/1/bin), jDE, DE 1220 and MDE-pBX on the Rosenbrock function in 10, 100 and 1000 dimensions, with a
+population of 100 individuals. The function is cheap, so that the time is dominated by the construction of the trials.
+The number of generations can be passed as first argument (default 200). Tolerances are set to zero, so that all the
+generations are run.
+*/
+
+using namespace pagmo;
+
+double trials_per_second(const algorithm::base &algo, const problem::base &prob, int gen)
+{
+	population pop(prob,100,42);
+	algorithm::base_ptr a = algo.clone();
+	a->reset_rngs(42);
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	a->evolve(pop);
+	return 100. * gen / ((boost::posix_time::microsec_clock::local_time() - start).total_microseconds() / 1E6);
+}
+
+int main(int argc, char *argv[])
+{
+	const int gen = argc > 1 ? boost::lexical_cast<int>(argv[1]) : 200;
+	const algorithm::de de_exp(gen,0.8,0.9,2,0.,0.), de_bin(gen,0.8,0.9,7,0.,0.);
+	const algorithm::jde jde(gen,2,1,0.,0.);
+	const int variants[] = {2,3,7,10,13,14,15,16};
+	const algorithm::de_1220 de_1220(gen,1,std::vector<int>(variants,variants + 8),true,0.,0.);
+	const algorithm::mde_pbx mde_pbx(gen,0.15,1.5,0.,0.);
+	const algorithm::base *algos[] = {&de_exp, &de_bin, &jde, &de_1220, &mde_pbx};
+	const char *names[] = {"de rand/1/exp", "de rand/1/bin", "jde", "de_1220", "mde_pbx"};
+	const int sizes[] = {10, 100, 1000};
+	std::cout << std::setw(16) << "algorithm" << std::setw(8) << "D" << std::setw(16) << "trials/second" << std::endl;
+	for (int k = 0; k < 5; ++k) {
+		for (int j = 0; j < 3; ++j) {
+			problem::rosenbrock prob(sizes[j]);
+			std::cout << std::setw(16) << names[k] << std::setw(8) << sizes[j] << std::setprecision(4)
+				<< std::setw(16) << trials_per_second(*algos[k],prob,gen) << std::endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,171 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/hv_algorithm/hv2d.h"
+#include "../src/util/hv_algorithm/hv3d.h"
+
+/**
+DESCRIPTION: This example measures the time taken by hv2d and hv3d to compute the hypervolume and the exclusive contributions
+of fronts of 10 to 10000 points, through the common interface (vectors of fitness vectors) and through the flat one (contiguous
+arrays of coordinates). The points are drawn uniformly on the unit hypersphere (a concave front) with the reference point in
+(1.1, ..., 1.1). Each computation is repeated for at least the time (in seconds) that can be passed as first argument (default 0.2),
+and the average time per call is printed in microseconds.
+*/
+
+using namespace pagmo;
+using util::hv_algorithm::hv2d;
+using util::hv_algorithm::hv3d;
+
+std::vector<fitness_vector> sphere_front(unsigned int n, unsigned int d, rng_uint32::result_type seed)
+{
+	rng_uint32 urng(seed);
+	boost::normal_distribution<double> normal;
+	boost::variate_generator<rng_uint32 &,boost::normal_distribution<double> > gauss(urng,normal);
+	std::vector<fitness_vector> points(n,fitness_vector(d));
+	for (unsigned int i = 0; i < n; ++i) {
+		double norm = 0;
+		for (unsigned int j = 0; j < d; ++j) {
+			points[i][j] = std::fabs(gauss());
+			norm += points[i][j] * points[i][j];
+		}
+		for (unsigned int j = 0; j < d; ++j) {
+			points[i][j] /= std::sqrt(norm);
+		}
+	}
+	return points;
+}
+
+// Average microseconds taken by a call of f, repeating it for at least min_time seconds.
+template <class F>
+double microseconds(F f, double min_time)
+{
+	unsigned long n_calls = 0;
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	double elapsed;
+	do {
+		for (int i = 0; i < 10; ++i) {
+			f();
+		}
+		n_calls += 10;
+		elapsed = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds();
+	} while (elapsed < min_time * 1E6);
+	return elapsed / n_calls;
+}
+
+// Each task works on a copy of the points, as the common interface may reorder them.
+template <class Algorithm>
+struct compute_task
+{
+	compute_task(const std::vector<fitness_vector> &points, const fitness_vector &r):m_points(points),m_r(r) {}
+	void operator()()
+	{
+		m_copy = m_points;
+		m_sink = Algorithm().compute(m_copy,m_r);
+	}
+	const std::vector<fitness_vector> &m_points;
+	const fitness_vector &m_r;
+	std::vector<fitness_vector> m_copy;
+	double m_sink;
+};
+
+template <class Algorithm>
+struct contributions_task
+{
+	contributions_task(const std::vector<fitness_vector> &points, const fitness_vector &r):m_points(points),m_r(r) {}
+	void operator()()
+	{
+		m_copy = m_points;
+		m_sink = Algorithm().contributions(m_copy,m_r);
+	}
+	const std::vector<fitness_vector> &m_points;
+	const fitness_vector &m_r;
+	std::vector<fitness_vector> m_copy;
+	std::vector<double> m_sink;
+};
+
+template <class Algorithm>
+struct flat_compute_task
+{
+	flat_compute_task(const std::vector<double> &points, const fitness_vector &r):m_points(points),m_r(r) {}
+	void operator()()
+	{
+		m_sink = Algorithm().compute(&m_points[0],m_points.size() / m_r.size(),&m_r[0]);
+	}
+	const std::vector<double> &m_points;
+	const fitness_vector &m_r;
+	double m_sink;
+};
+
+template <class Algorithm>
+struct flat_contributions_task
+{
+	flat_contributions_task(const std::vector<double> &points, const fitness_vector &r):m_points(points),m_r(r),
+		m_sink(points.size() / r.size()) {}
+	void operator()()
+	{
+		Algorithm().contributions(&m_points[0],m_sink.size(),&m_r[0],&m_sink[0]);
+	}
+	const std::vector<double> &m_points;
+	const fitness_vector &m_r;
+	std::vector<double> m_sink;
+};
+
+template <class Algorithm>
+void run(unsigned int d, double min_time)
+{
+	const unsigned int sizes[] = {10, 100, 1000, 10000};
+	for (int j = 0; j < 4; ++j) {
+		const std::vector<fitness_vector> points = sphere_front(sizes[j],d,42);
+		std::vector<double> flat;
+		for (unsigned int i = 0; i < points.size(); ++i) {
+			flat.insert(flat.end(),points[i].begin(),points[i].end());
+		}
+		const fitness_vector r(d,1.1);
+		std::cout << std::setw(4) << d << std::setw(8) << sizes[j] << std::setprecision(4)
+			<< std::setw(14) << microseconds(compute_task<Algorithm>(points,r),min_time)
+			<< std::setw(14) << microseconds(flat_compute_task<Algorithm>(flat,r),min_time)
+			<< std::setw(16) << microseconds(contributions_task<Algorithm>(points,r),min_time)
+			<< std::setw(16) << microseconds(flat_contributions_task<Algorithm>(flat,r),min_time) << std::endl;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	const double min_time = argc > 1 ? boost::lexical_cast<double>(argv[1]) : 0.2;
+	std::cout << std::setw(4) << "D" << std::setw(8) << "N" << std::setw(14) << "compute" << std::setw(14) << "flat"
+		<< std::setw(16) << "contributions" << std::setw(16) << "flat" << "   (microseconds per call)" << std::endl;
+	run<hv2d>(2,min_time);
+	run<hv3d>(3,min_time);
+	return 0;
+}
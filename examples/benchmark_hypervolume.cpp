@@ -0,0 +1,127 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/hv_algorithm/wfg.h"
+
+/**
+DESCRIPTION: This example measures the time taken by the WFG algorithm to compute the hypervolume and the exclusive contributions
+of fronts of 100 to 1000 points with 6 to 10 objectives. The points are drawn uniformly on the unit hypersphere (a concave front)
+with the reference point in (1.1, ..., 1.1). The time budget (in seconds) of a single computation can be passed as first argument:
+the larger fronts of a dimension are skipped once it is exceeded. The number of threads used by WFG can be passed as second
+argument (default 1, 0 for the number of hardware threads).
+*/
+
+using namespace pagmo;
+
+std::vector<fitness_vector> sphere_front(unsigned int n, unsigned int d, rng_uint32::result_type seed)
+{
+	rng_uint32 urng(seed);
+	boost::normal_distribution<double> normal;
+	boost::variate_generator<rng_uint32 &,boost::normal_distribution<double> > gauss(urng,normal);
+	std::vector<fitness_vector> points(n,fitness_vector(d));
+	for (unsigned int i = 0; i < n; ++i) {
+		double norm = 0;
+		for (unsigned int j = 0; j < d; ++j) {
+			points[i][j] = std::fabs(gauss());
+			norm += points[i][j] * points[i][j];
+		}
+		for (unsigned int j = 0; j < d; ++j) {
+			points[i][j] /= std::sqrt(norm);
+		}
+	}
+	return points;
+}
+
+// Seconds taken by one call of f.
+template <class F>
+double seconds(const F &f)
+{
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	f();
+	return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1E-6;
+}
+
+struct compute_task
+{
+	compute_task(std::vector<fitness_vector> &points, const fitness_vector &r, unsigned int n_threads):
+		m_points(points),m_r(r),m_n_threads(n_threads) {}
+	void operator()() const
+	{
+		util::hv_algorithm::wfg(2,m_n_threads).compute(m_points,m_r);
+	}
+	std::vector<fitness_vector> &m_points;
+	const fitness_vector &m_r;
+	const unsigned int m_n_threads;
+};
+
+struct contributions_task
+{
+	contributions_task(std::vector<fitness_vector> &points, const fitness_vector &r, unsigned int n_threads):
+		m_points(points),m_r(r),m_n_threads(n_threads) {}
+	void operator()() const
+	{
+		util::hv_algorithm::wfg(2,m_n_threads).contributions(m_points,m_r);
+	}
+	std::vector<fitness_vector> &m_points;
+	const fitness_vector &m_r;
+	const unsigned int m_n_threads;
+};
+
+int main(int argc, char *argv[])
+{
+	// Larger fronts of a given dimension are skipped once a computation takes longer than this.
+	const double budget = argc > 1 ? boost::lexical_cast<double>(argv[1]) : 10.;
+	const unsigned int n_threads = argc > 2 ? boost::lexical_cast<unsigned int>(argv[2]) : 1u;
+	const unsigned int dims[] = {6, 8, 10}, sizes[] = {100, 300, 1000};
+	std::cout << std::setw(4) << "D" << std::setw(8) << "N" << std::setw(16) << "compute (s)" << std::setw(20) << "contributions (s)" << std::endl;
+	for (int i = 0; i < 3; ++i) {
+		bool over_budget = false;
+		for (int j = 0; j < 3 && !over_budget; ++j) {
+			std::vector<fitness_vector> points = sphere_front(sizes[j],dims[i],42);
+			const fitness_vector r(dims[i],1.1);
+			const double t_compute = seconds(compute_task(points,r,n_threads));
+			std::cout << std::setw(4) << dims[i] << std::setw(8) << sizes[j] << std::setprecision(4) << std::setw(16) << t_compute << std::flush;
+			// The exclusive contributions cost roughly N / D times as much as the hypervolume.
+			if (t_compute * sizes[j] / dims[i] > budget) {
+				std::cout << std::setw(20) << "-" << std::endl;
+				over_budget = true;
+				continue;
+			}
+			const double t_contributions = seconds(contributions_task(points,r,n_threads));
+			std::cout << std::setw(20) << t_contributions << std::endl;
+			over_budget = t_contributions > budget;
+		}
+	}
+	return 0;
+}
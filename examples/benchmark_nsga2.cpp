@@ -0,0 +1,71 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../src/pagmo.h"
+
+/**
+DESCRIPTION: This example measures the time per generation of the generational and steady-state variants of NSGA-II on
+ZDT1 (30 variables), ZDT3 (30 variables) and DTLZ2 (3 objectives, 12 variables) for populations of 100 to 10000 individuals.
+Both variants perform as many function evaluations per generation as there are individuals. The number of generations
+can be passed as first argument (default 20); a population of N individuals is evolved for max(1, gen * 1000 / N)
+generations (at least gen for N <= 1000), so that the larger populations take a comparable time.
+*/
+
+using namespace pagmo;
+
+double seconds_per_generation(const problem::base &prob, population::size_type n, int gen, algorithm::nsga2::selection_type selection)
+{
+	population pop(prob,n,42);
+	algorithm::nsga2 algo(gen,0.95,10,0.01,50,selection);
+	algo.reset_rngs(42);
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	algo.evolve(pop);
+	return (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() / 1E6 / gen;
+}
+
+int main(int argc, char *argv[])
+{
+	const int gen = argc > 1 ? boost::lexical_cast<int>(argv[1]) : 20;
+	const problem::zdt zdt1(1,30), zdt3(3,30);
+	const problem::dtlz dtlz2(2,12,3);
+	const problem::base *probs[] = {&zdt1, &zdt3, &dtlz2};
+	const population::size_type sizes[] = {100, 1000, 10000};
+	std::cout << std::setw(8) << "problem" << std::setw(8) << "N" << std::setw(8) << "gen" << std::setw(16) << "generational"
+		<< std::setw(16) << "steady-state" << "   (seconds per generation)" << std::endl;
+	for (int p = 0; p < 3; ++p) {
+		for (int j = 0; j < 3; ++j) {
+			const int g = sizes[j] <= 1000 ? gen : std::max<int>(1,gen * 1000 / sizes[j]);
+			std::cout << std::setw(8) << probs[p]->get_name() << std::setw(8) << sizes[j] << std::setw(8) << g << std::setprecision(4)
+				<< std::setw(16) << seconds_per_generation(*probs[p],sizes[j],g,algorithm::nsga2::GENERATIONAL)
+				<< std::setw(16) << seconds_per_generation(*probs[p],sizes[j],g,algorithm::nsga2::STEADY_STATE) << std::endl;
+		}
+	}
+	return 0;
+}
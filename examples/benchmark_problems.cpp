@@ -0,0 +1,115 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lexical_cast.hpp>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/benchmark_kernels.h"
+
+/**
+DESCRIPTION: This example measures the evaluation throughput of the standard benchmark problems, comparing the evaluation
+of the candidates one at a time with the batch evaluation through the vectorised kernels. The CEC2013 problems are
+included if the directory containing their data files is passed as first argument. The number of candidates per batch
+can be passed as second argument.
+*/
+
+using namespace pagmo;
+
+// Number of batches evaluated for each measure.
+const int n_batches = 20;
+
+// Evaluations per second of a problem, evaluating the candidates one by one or in batches.
+double throughput(const problem::base &prob, const std::vector<std::vector<decision_vector> > &batches, bool batch)
+{
+	// Work on a fresh copy, so that no fitness comes from the cache of a previous measure.
+	problem::base_ptr p = prob.clone();
+	std::vector<fitness_vector> f;
+	fitness_vector f_single(p->get_f_dimension());
+	std::size_t count = 0;
+	const boost::posix_time::ptime start = boost::posix_time::microsec_clock::local_time();
+	for (std::vector<std::vector<decision_vector> >::size_type i = 0; i < batches.size(); ++i) {
+		if (batch) {
+			p->objfun_batch(f,batches[i]);
+		} else {
+			for (std::vector<decision_vector>::size_type j = 0; j < batches[i].size(); ++j) {
+				p->objfun(f_single,batches[i][j]);
+			}
+		}
+		count += batches[i].size();
+	}
+	const double seconds = (boost::posix_time::microsec_clock::local_time() - start).total_microseconds() * 1E-6;
+	return count / seconds;
+}
+
+void run(const problem::base &prob, population::size_type n)
+{
+	// Random candidates within the bounds.
+	rng_double drng(42);
+	std::vector<std::vector<decision_vector> > batches(n_batches);
+	for (int i = 0; i < n_batches; ++i) {
+		for (population::size_type j = 0; j < n; ++j) {
+			batches[i].push_back(decision_vector(prob.get_dimension()));
+			for (problem::base::size_type k = 0; k < prob.get_dimension(); ++k) {
+				batches[i].back()[k] = prob.get_lb()[k] + (prob.get_ub()[k] - prob.get_lb()[k]) * drng();
+			}
+		}
+	}
+	const double single = throughput(prob,batches,false), batch = throughput(prob,batches,true);
+	std::cout << std::left << std::setw(40) << prob.get_name() << std::right << std::setw(6) << prob.get_dimension()
+		<< std::setw(16) << std::setprecision(4) << single << std::setw(16) << batch
+		<< std::setw(10) << std::setprecision(3) << batch / single << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+	const population::size_type n = argc > 2 ? boost::lexical_cast<population::size_type>(argv[2]) : 1000;
+	std::cout << "Kernels compiled for: " << util::kernels::isa() << ", " << n << " candidates per batch" << std::endl;
+	std::cout << std::left << std::setw(40) << "Problem" << std::right << std::setw(6) << "D" << std::setw(16) << "Single (ev/s)"
+		<< std::setw(16) << "Batch (ev/s)" << std::setw(10) << "Speedup" << std::endl;
+	const int dims[] = {10, 30, 100};
+	for (int i = 0; i < 3; ++i) {
+		run(problem::ackley(dims[i]),n);
+		run(problem::rastrigin(dims[i]),n);
+		run(problem::rosenbrock(dims[i]),n);
+		run(problem::griewank(dims[i]),n);
+		run(problem::schwefel(dims[i]),n);
+		run(problem::dejong(dims[i]),n);
+		run(problem::michalewicz(dims[i]),n);
+		run(problem::levy5(dims[i]),n);
+	}
+	if (argc > 1) {
+		const int cec_dims[] = {10, 30, 50};
+		for (int i = 0; i < 3; ++i) {
+			for (unsigned int j = 1; j <= 28; ++j) {
+				run(problem::cec2013(j,cec_dims[i],argv[1]),n);
+			}
+		}
+	}
+	return 0;
+}
@@ -32,6 +32,7 @@
 #include <boost/random/uniform_real.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/thread/thread.hpp>
 
 
 #include "cmaes.h"
@@ -56,12 +57,15 @@ namespace pagmo { namespace algorithm {
  * @param[in] ftol stopping criteria on the x tolerance
  * @param[in] xtol stopping criteria on the f tolerance
  * @param[in] memory when true the algorithm preserves its memory of the parameter adaptation (C, p etc ....) at each call
+ * @param[in] covariance model of the covariance matrix: FULL, SEPARABLE (diagonal) or LIMITED_MEMORY
+ * @param[in] async_eigen when true (and covariance is FULL) the eigendecomposition of C runs on a helper thread while
+ * sampling continues with the previous one, which is replaced when the next decomposition is due.
  * @throws value_error if cc,cs,c1,cmu are not in [0,1] or not -1
  * 
  * */
-cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0, double ftol, double xtol, bool memory):
+cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0, double ftol, double xtol, bool memory, covariance_type covariance, bool async_eigen):
 		base(), m_gen(boost::numeric_cast<std::size_t>(gen)), m_cc(cc), m_cs(cs), m_c1(c1), 
-		m_cmu(cmu), m_sigma(sigma0), m_ftol(ftol), m_xtol(xtol), m_memory(memory) {
+		m_cmu(cmu), m_sigma(sigma0), m_ftol(ftol), m_xtol(xtol), m_memory(memory), m_covariance(covariance), m_async_eigen(async_eigen) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -81,11 +85,16 @@ cmaes::cmaes(int gen, double cc, double cs, double c1, double cmu, double sigma0
 	//Initialize the algorithm memory
 	m_mean = Eigen::VectorXd::Zero(1);
 	m_variation = Eigen::VectorXd::Zero(1);
-	m_newpop = std::vector<Eigen::VectorXd>();
+	m_newpop = Eigen::MatrixXd::Zero(1,1);
 	m_B = Eigen::MatrixXd::Identity(1,1);
 	m_D = Eigen::MatrixXd::Identity(1,1);
 	m_C = Eigen::MatrixXd::Identity(1,1);
 	m_invsqrtC = Eigen::MatrixXd::Identity(1,1);
+	m_diagC = Eigen::VectorXd::Ones(1);
+	m_P = Eigen::MatrixXd::Zero(1,0);
+	m_V = Eigen::MatrixXd::Zero(1,0);
+	m_b = Eigen::VectorXd::Zero(0);
+	m_d = Eigen::VectorXd::Zero(0);
 	m_pc = Eigen::VectorXd::Zero(1);
 	m_ps = Eigen::VectorXd::Zero(1);
 	m_counteval = 0;
@@ -112,6 +121,83 @@ struct cmp_using_cur
 	const population &m_pop;
 };
 
+// Limited memory model (LM-CMA). C = A A' where A is built by rank-one updates of the identity
+// with the stored directions p_t: A_(t+1) = a A_t + b_t p_t v_t', with v_t = A_t^-1 p_t.
+
+// Applies the inverse of the factor built from the first k stored directions to x, in place.
+static void lm_ainvz(Eigen::VectorXd &x, const Eigen::MatrixXd &V, const Eigen::VectorXd &d, double a, Eigen::MatrixXd::Index k)
+{
+	for (Eigen::MatrixXd::Index t = 0; t < k; ++t) {
+		const double vx = V.col(t).dot(x);
+		x /= a;
+		x -= (d(t) * vx) * V.col(t);
+	}
+}
+
+// Recomputes v_t, b_t and d_t for all the stored directions (columns of P).
+static void lm_update(const Eigen::MatrixXd &P, Eigen::MatrixXd &V, Eigen::VectorXd &b, Eigen::VectorXd &d, double c1)
+{
+	const double a = std::sqrt(1 - c1);
+	V.resize(P.rows(),P.cols());
+	b.resize(P.cols());
+	d.resize(P.cols());
+	Eigen::VectorXd v;
+	for (Eigen::MatrixXd::Index t = 0; t < P.cols(); ++t) {
+		v = P.col(t);
+		lm_ainvz(v, V, d, a, t);
+		V.col(t) = v;
+		const double nv2 = std::max(1e-20, v.squaredNorm());
+		const double r = std::sqrt(1 + c1 / (1 - c1) * nv2);
+		b(t) = a / nv2 * (r - 1);
+		d(t) = 1 / (a * nv2) * (1 - 1 / r);
+	}
+}
+
+// Eigendecomposition of a snapshot of C running on a helper thread. The destructor waits for its completion.
+struct async_eigen_solver
+{
+	~async_eigen_solver()
+	{
+		wait();
+	}
+	void start(const Eigen::MatrixXd &C)
+	{
+		m_C = C;
+		m_thread = boost::thread(&async_eigen_solver::run,this);
+	}
+	bool running() const
+	{
+		return m_thread.joinable();
+	}
+	void wait()
+	{
+		if (m_thread.joinable()) {
+			m_thread.join();
+		}
+	}
+	void run()
+	{
+		m_es.compute(m_C);
+	}
+	Eigen::MatrixXd					m_C;
+	Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>	m_es;
+	boost::thread					m_thread;
+};
+
+// Sets B, D (standard deviations), the cached B*D and C^-1/2 from a successful eigendecomposition of C.
+// If the eigendecomposition failed they are left untouched and false is returned.
+static bool apply_eigen(const Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> &es, Eigen::MatrixXd &B, Eigen::MatrixXd &D, Eigen::MatrixXd &BD, Eigen::MatrixXd &invsqrtC)
+{
+	if (es.info() != Eigen::Success) {
+		return false;
+	}
+	B = es.eigenvectors();
+	D = es.eigenvalues().cwiseMax(1e-20).cwiseSqrt().asDiagonal();	//D contains standard deviations now
+	BD = B * D.diagonal().asDiagonal();
+	invsqrtC.noalias() = B * D.diagonal().cwiseInverse().asDiagonal() * B.transpose();
+	return true;
+}
+
 
 /// Evolve implementation.
 /**
@@ -180,25 +266,48 @@ void cmaes::evolve(population &pop) const
 		cs = (mueff+2) / (N+mueff+5);				// t-const for cumulation for sigma control
 	}
 	if (c1 == -1) {
-		c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);			// learning rate for rank-one update of C
+		if (m_covariance == LIMITED_MEMORY) {
+			c1 = 1.0 / (10 * std::log(N+1.0));		// learning rate for each stored direction (LM-CMA)
+		} else {
+			c1 = 2.0 / ((N+1.3)*(N+1.3)+mueff);		// learning rate for rank-one update of C
+			if (m_covariance == SEPARABLE) {
+				c1 *= (N+2) / 3.0;			// a diagonal C can be learned faster (sep-CMA-ES)
+			}
+		}
 	}
 	if (cmu == -1) {
 		cmu = 2.0 * (mueff-2+1/mueff) / ((N+2)*(N+2)+mueff);	// and for rank-mu update
+		if (m_covariance == SEPARABLE) {
+			cmu = std::min(1 - c1, cmu * (N+2) / 3.0);
+		}
 	}
-	
+	if (m_covariance == LIMITED_MEMORY) {
+		cmu = 0;						// the limited memory model has no rank-mu update
+	}
+
 	double damps = 1 + 2*std::max(0.0, std::sqrt((mueff-1)/(N+1))-1) + cs;	// damping for sigma
 	double chiN = std::sqrt(N) * (1-1.0/(4*N)+1.0/(21*N*N));		// expectation of ||N(0,I)|| == norm(randn(N,1))
 
+	// Limited memory model: at most lm_m directions, one stored every lm_t generations
+	const MatrixXd::Index lm_m = std::min<MatrixXd::Index>(N, 4 + (MatrixXd::Index)(3 * std::log((double)N)));
+	const int lm_t = std::max<int>(1, N / lm_m);
+	const double lm_a = std::sqrt(1 - c1);
+
 	// Initializing and allocating (here one could use mutable data member to avoid redefinition of non const data)
 
 	// Algorithm's Memory. This allows the algorithm to start from its last "state"
 	VectorXd mean(m_mean);
 	VectorXd variation(m_variation);
-	std::vector<VectorXd> newpop(m_newpop);
+	MatrixXd newpop(m_newpop);
 	MatrixXd B(m_B);
 	MatrixXd D(m_D);
 	MatrixXd C(m_C);
 	MatrixXd invsqrtC(m_invsqrtC);
+	VectorXd diagC(m_diagC);
+	MatrixXd P(m_P);
+	MatrixXd V(m_V);
+	VectorXd b(m_b);
+	VectorXd d(m_d);
 	VectorXd pc(m_pc);
 	VectorXd ps(m_ps);
 	int counteval(m_counteval);
@@ -206,42 +315,61 @@ void cmaes::evolve(population &pop) const
 	double sigma(m_sigma);
 	double var_norm = 0;
 
-	// Some buffers
+	// Some buffers. A whole generation is sampled at once: column i of arz holds the normal
+	// vector of the i-th offspring, and of ary its step from the mean.
 	VectorXd meanold = VectorXd::Zero(N);
-	MatrixXd Dinv = MatrixXd::Identity(N,N);
-	MatrixXd Cold = MatrixXd::Identity(N,N);
-	VectorXd tmp = VectorXd::Zero(N);
-	std::vector<VectorXd> elite(mu,tmp);
-	decision_vector dumb(N,0);
+	VectorXd step(N);
+	MatrixXd arz(N,lam);
+	MatrixXd ary(N,lam);
+	MatrixXd elite(N,mu);
+	MatrixXd elitew(N,mu);
+	MatrixXd lm_vz;
+	VectorXd lm_coef;
+	std::vector<decision_vector> newpop_x(lam,decision_vector(N,0));
+	std::vector<population::size_type> newpop_idx(lam);
+	for (population::size_type i = 0; i<lam; ++i ) {
+		newpop_idx[i] = i;
+	}
+	// The initial scaling is the witdh of the box (if this is too small... then 1e-6 is used). The
+	// limited memory model keeps working on coordinates scaled by it.
+	VectorXd scale(N);
+	for (problem::base::size_type j=0; j<N; ++j){
+		scale(j) = std::max((ub[j]-lb[j]),1e-6);
+	}
 
 	// If the algorithm is called for the first time on this problem dimension / pop size or if m_memory is false we erease the memory of past calls
-	if ( (m_newpop.size() != lam) || ((unsigned int)(m_newpop[0].rows() ) != N) || (m_memory==false) ) {
+	if ( ((population::size_type)m_newpop.cols() != lam) || ((problem::base::size_type)m_newpop.rows() != N) || (m_memory==false) ) {
 		mean.resize(N);
 		for (problem::base::size_type i=0;i<N;++i){
 			mean(i) = pop.champion().x[i];
 		}
-		newpop = std::vector<VectorXd>(lam,tmp);
+		newpop = MatrixXd::Zero(N,lam);
 		variation.resize(N);
 
-		//We define the satrting B,D,C
-		B.resize(N,N); B = MatrixXd::Identity(N,N);			//B defines the coordinate system
-		D.resize(N,N); D = MatrixXd::Identity(N,N);			//diagonal D defines the scaling. By default this is the witdh of the box. 
-										//If this is too small... then 1e-6 is used
-		for (problem::base::size_type j=0; j<N; ++j){
-			D(j,j) = std::max((ub[j]-lb[j]),1e-6);
-		}
-		C.resize(N,N); C = MatrixXd::Identity(N,N);			//covariance matrix C
-		C = D*D;						
-		invsqrtC.resize(N,N); invsqrtC = MatrixXd::Identity(N,N);	//inverse of sqrt(C)
-		for (problem::base::size_type j=0; j<N; ++j){
-			invsqrtC(j,j) = 1 / D(j,j);
+		switch (m_covariance) {
+		case FULL:
+			//We define the satrting B,D,C
+			B = MatrixXd::Identity(N,N);				//B defines the coordinate system
+			D = scale.asDiagonal();					//diagonal D defines the scaling.
+			C = scale.cwiseAbs2().asDiagonal();			//covariance matrix C
+			invsqrtC = scale.cwiseInverse().asDiagonal();		//inverse of sqrt(C)
+			break;
+		case SEPARABLE:
+			diagC = scale.cwiseAbs2();				//diagonal covariance matrix C
+			break;
+		case LIMITED_MEMORY:
+			P.resize(N,0);						//no stored direction: C is diag(scale)^2
+			V.resize(N,0);
+			b.resize(0);
+			d.resize(0);
+			break;
 		}
 		pc.resize(N); pc = VectorXd::Zero(N);
 		ps.resize(N); ps = VectorXd::Zero(N);
 		counteval = 0;
 		eigeneval = 0;
 	}
-	
+
 	// ----------------------------------------------//
 	// HERE WE START THE REAL ALGORITHM              //
 	// ----------------------------------------------//
@@ -261,28 +389,61 @@ void cmaes::evolve(population &pop) const
 			<< " - damps: " << damps
 			<< " - chiN: " << chiN << std::endl;
 	}
-	
-	SelfAdjointEigenSolver<MatrixXd> es(N);
+
+	// B*D only changes with the eigendecomposition, so we cache it (D is diagonal). In the separable
+	// model we cache sqrt(diag(C)) instead.
+	MatrixXd BD;
+	VectorXd sqrtdiagC;
+	SelfAdjointEigenSolver<MatrixXd> es;
+	async_eigen_solver async_es;
+	if (m_covariance == FULL) {
+		BD = B * D.diagonal().asDiagonal();
+	} else if (m_covariance == SEPARABLE) {
+		sqrtdiagC = diagC.cwiseMax(1e-20).cwiseSqrt();
+	}
 	for (std::size_t g = 0; g < m_gen; ++g) {
 		// 1 - We generate and evaluate lam new individuals
 
+		// 1a - we create lam randomly normal distributed vectors
 		for (population::size_type i = 0; i<lam; ++i ) {
-			// 1a - we create a randomly normal distributed vector
 			for (problem::base::size_type j=0; j<N; ++j){
-				tmp(j) = normally_distributed_number();
+				arz(j,i) = normally_distributed_number();
+			}
+		}
+		// 1b - and store their transformed values in the newpop (one matrix-matrix product)
+		switch (m_covariance) {
+		case FULL:
+			ary.noalias() = BD * arz;
+			ary *= sigma;
+			break;
+		case SEPARABLE:
+			ary.noalias() = (sigma * sqrtdiagC).asDiagonal() * arz;
+			break;
+		case LIMITED_MEMORY:
+			// A z = a^k z + sum_t a^(k-1-t) b_t p_t v_t' z, for all the columns at once
+			ary = std::pow(lm_a, (double)P.cols()) * arz;
+			if (P.cols() > 0) {
+				lm_coef.resize(P.cols());
+				for (MatrixXd::Index t = 0; t < P.cols(); ++t) {
+					lm_coef(t) = std::pow(lm_a, (double)(P.cols() - 1 - t)) * b(t);
+				}
+				lm_vz.noalias() = V.transpose() * arz;
+				ary.noalias() += P * (lm_coef.asDiagonal() * lm_vz);
 			}
-			// 1b - and store its transformed value in the newpop
-			newpop[i] = mean + (sigma * B * D * tmp);
+			ary = (sigma * scale).asDiagonal() * ary;
+			break;
 		}
-		//This is evaluated here on the last generated tmp and will be used only as 
+		newpop = ary.colwise() + mean;
+
+		//This is evaluated here on the last generated vector and will be used only as
 		//a stopping criteria
-		var_norm = (sigma * B * D * tmp).norm();
-		
-		//1b - Check the exit conditions (every 5 generations) // we need to do it here as 
-		//termination is defined on tmp
+		var_norm = ary.col(lam-1).norm();
+
+		//1b - Check the exit conditions (every 5 generations) // we need to do it here as
+		//termination is defined on the last generated vector
 		if (g%5 == 0) {
-			if  ( (sigma*B*D*tmp).norm() < m_xtol ) {
-				if (m_screen_output) { 
+			if  ( var_norm < m_xtol ) {
+				if (m_screen_output) {
 					std::cout << "Exit condition -- xtol < " <<  m_xtol << std::endl;
 				}
 				return;
@@ -298,11 +459,11 @@ void cmaes::evolve(population &pop) const
 			}
 		}
 
-		// 1c - we fix the bounds 
+		// 1c - we fix the bounds
 		for (population::size_type i = 0; i<lam; ++i ) {
 			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				if ( (newpop[i](j) < lb[j]) || (newpop[i](j) > ub[j]) ) {
-					newpop[i](j) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
+				if ( (newpop(j,i) < lb[j]) || (newpop(j,i) > ub[j]) ) {
+					newpop(j,i) = lb[j] + randomly_distributed_number() * (ub[j] - lb[j]);
 				}
 			}
 		}
@@ -314,25 +475,21 @@ void cmaes::evolve(population &pop) const
 			dynamic_cast<const pagmo::problem::base_stochastic &>(prob).set_seed(m_urng());
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
 			for (population::size_type i = 0; i<lam; ++i ) {
-			  	for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.push_back(dumb);
+				Map<VectorXd>(&newpop_x[i][0],N) = newpop.col(i);
 			}
+			pop.push_back(newpop_x);
 			counteval += lam;
 		}
 		catch (const std::bad_cast& e)
 		{
-			// Reinsertion (original method)
+			// Reinsertion (original method), the whole generation is evaluated in one batch
 			for (population::size_type i = 0; i<lam; ++i ) {
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					dumb[j] = newpop[i](j);
-				}
-				pop.set_x(i,dumb);
+				Map<VectorXd>(&newpop_x[i][0],N) = newpop.col(i);
 			}
+			pop.set_x(newpop_idx,newpop_x);
 			counteval += lam;
 		}
-		
+
 		// 2 - We extract the elite from this generation. We use cur_f, equivalent to the
 		// original method
 		std::vector<population::size_type> best_idx;
@@ -344,84 +501,118 @@ void cmaes::evolve(population &pop) const
 		std::sort(best_idx.begin(),best_idx.end(),cmp);
 		best_idx.resize(mu);
 		for (population::size_type i = 0; i<mu; ++i ) {
-			for (decision_vector::size_type j = 0; j<N; ++j ) {
-				elite[i](j) = pop.get_individual(best_idx[i]).cur_x[j];
-			}
+			elite.col(i) = Map<const VectorXd>(&pop.get_individual(best_idx[i]).cur_x[0],N);
 		}
 
 
 		// 3 - Compute the new elite mean storing the old one
 		meanold=mean;
-		mean = elite[0]*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			mean += elite[i]*weights(i);
+		mean.noalias() = elite * weights;
+
+		// 4 - Update evolution paths (step is the mean shift whitened by C^-1/2)
+		switch (m_covariance) {
+		case FULL:
+			step.noalias() = invsqrtC * (mean-meanold);
+			break;
+		case SEPARABLE:
+			step = (mean-meanold).cwiseQuotient(sqrtdiagC);
+			break;
+		case LIMITED_MEMORY:
+			step = (mean-meanold).cwiseQuotient(scale);
+			lm_ainvz(step, V, d, lm_a, V.cols());
+			break;
 		}
-
-		// 4 - Update evolution paths
-		ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * invsqrtC * (mean-meanold) / sigma;
+		ps = (1 - cs) * ps + std::sqrt(cs*(2-cs)*mueff) * step / sigma;
 		double hsig = 0;
 		hsig = (ps.squaredNorm() / N / (1-std::pow((1-cs),(2.0*counteval/lam))) ) < (2.0 + 4/(N+1));
-		pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
+		if (m_covariance == LIMITED_MEMORY) {
+			pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold).cwiseQuotient(scale) / sigma;
+		} else {
+			pc = (1-cc) * pc + hsig * std::sqrt(cc*(2-cc)*mueff) * (mean-meanold) / sigma;
+		}
 
-		// 5 - Adapt Covariance Matrix
-		Cold = C;
-		C = (elite[0]-meanold)*(elite[0]-meanold).transpose()*weights(0);
-		for (population::size_type i = 1; i<mu; ++i ) {
-			C += (elite[i]-meanold)*(elite[i]-meanold).transpose()*weights(i);
+		// 5 - Adapt Covariance Matrix. The rank-mu update is a single product of the
+		// (weighted) elite steps
+		switch (m_covariance) {
+		case FULL:
+			elite = (elite.colwise() - meanold) / sigma;
+			elitew.noalias() = elite * weights.asDiagonal();
+			C *= (1-c1-cmu) + c1 * (1-hsig) * cc * (2-cc);
+			C.noalias() += c1 * pc * pc.transpose();
+			C.noalias() += cmu * elitew * elite.transpose();
+			break;
+		case SEPARABLE:
+			elite = (elite.colwise() - meanold) / sigma;
+			diagC *= (1-c1-cmu) + c1 * (1-hsig) * cc * (2-cc);
+			diagC += c1 * pc.cwiseAbs2();
+			diagC.noalias() += cmu * elite.cwiseAbs2() * weights;
+			sqrtdiagC = diagC.cwiseMax(1e-20).cwiseSqrt();
+			break;
+		case LIMITED_MEMORY:
+			// We store pc every lm_t generations, dropping the oldest direction when lm_m are stored
+			if ((counteval / lam) % lm_t == 0) {
+				if (P.cols() < lm_m) {
+					P.conservativeResize(N, P.cols() + 1);
+				} else {
+					for (MatrixXd::Index t = 1; t < P.cols(); ++t) {
+						P.col(t-1) = P.col(t);
+					}
+				}
+				P.col(P.cols()-1) = pc;
+				lm_update(P, V, b, d, c1);
+			}
+			break;
 		}
-		C /= sigma*sigma;
-		C = (1-c1-cmu) * Cold +
-			cmu * C +
-			c1 * ((pc * pc.transpose()) + (1-hsig) * cc * (2-cc) * Cold);
 
 		//6 - Adapt sigma
 		sigma *= std::exp( std::min( 0.6, (cs/damps) * (ps.norm()/chiN - 1) ) );
 		if ( (boost::math::isnan)(sigma) || (boost::math::isnan)(sigma) || (boost::math::isinf)(var_norm) || (boost::math::isnan)(var_norm) ) {
-			std::cout << "eigen: " << es.info() << std::endl;
-			std::cout << "B: " << B << std::endl;
-			std::cout << "D: " << D << std::endl;
-			std::cout << "Dinv: " << D << std::endl;
-			std::cout << "invsqrtC: " << invsqrtC << std::endl;
+			if (m_covariance == FULL) {
+				std::cout << "eigen: " << es.info() << std::endl;
+				std::cout << "B: " << B << std::endl;
+				std::cout << "D: " << D << std::endl;
+				std::cout << "invsqrtC: " << invsqrtC << std::endl;
+			}
 			pagmo_throw(value_error,"NaN!!!!! in CMAES");
 		}
 
-		//7 - Perform eigen-decomposition of C
-		if ( (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
+		//7 - Perform eigen-decomposition of C. In the asynchronous mode it is started on a snapshot of C
+		//and sampling continues with the current B and D. The result is applied when the next decomposition
+		//is due (waiting for it if needed), so that the generations using it do not depend on thread timing.
+		if ( m_covariance == FULL && (counteval - eigeneval) > (lam/(c1+cmu)/N/10) ) {		//achieve O(N^2)
 			eigeneval = counteval;
 			C = (C+C.transpose())/2;				//enforce symmetry
-			es.compute(C);						//eigen decomposition
-			if (es.info()==Success) {
-				B = es.eigenvectors();
-				D = es.eigenvalues().asDiagonal();
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					D(j,j) = std::sqrt( std::max(1e-20,D(j,j)) );				//D contains standard deviations now
-				}
-				for (decision_vector::size_type j = 0; j<N; ++j ) {
-					Dinv(j,j) = 1.0 / D(j,j);
+			if (m_async_eigen) {
+				if (async_es.running()) {
+					async_es.wait();
+					apply_eigen(async_es.m_es,B,D,BD,invsqrtC);
 				}
-				invsqrtC = B*Dinv*B.transpose();
-			} //if eigendecomposition fails just skip it and keep pevious succesful one.
+				async_es.start(C);
+			} else {
+				es.compute(C);					//eigen decomposition
+				apply_eigen(es,B,D,BD,invsqrtC);		//if eigendecomposition fails just skip it and keep pevious succesful one.
+			}
 		}
-		
-		
+
+
 
 		//8 - We print on screen if required
 		if (m_screen_output) {
 			if (!(g%20)) {
-				std::cout << std::endl << std::left << std::setw(20) << 
-				"Gen." << std::setw(20) << 
-				"Champion " << std::setw(20) << 
-				"Highest " << std::setw(20) << 
-				"Lowest" << std::setw(20) << 
-				"Variation" << std::setw(20) << 
-				"Step" << std::endl; 
+				std::cout << std::endl << std::left << std::setw(20) <<
+				"Gen." << std::setw(20) <<
+				"Champion " << std::setw(20) <<
+				"Highest " << std::setw(20) <<
+				"Lowest" << std::setw(20) <<
+				"Variation" << std::setw(20) <<
+				"Step" << std::endl;
 			}
-				
-			std::cout << std::left << std::setprecision(14) << std::setw(20) << 
-				g << std::setw(20) << 
-				pop.champion().f[0] << std::setw(20) << 
-				pop.get_individual(pop.get_best_idx()).best_f[0] << std::setw(20) << 
-				pop.get_individual(pop.get_worst_idx()).best_f[0] << std::setw(20) << 
+
+			std::cout << std::left << std::setprecision(14) << std::setw(20) <<
+				g << std::setw(20) <<
+				pop.champion().f[0] << std::setw(20) <<
+				pop.get_individual(pop.get_best_idx()).best_f[0] << std::setw(20) <<
+				pop.get_individual(pop.get_worst_idx()).best_f[0] << std::setw(20) <<
 				var_norm << std::setw(20) <<
 				sigma << std::endl;
 		}
@@ -435,14 +626,29 @@ void cmaes::evolve(population &pop) const
 		m_D = D;
 		m_C = C;
 		m_invsqrtC = invsqrtC;
+		m_diagC = diagC;
+		m_P = P;
+		m_V = V;
+		m_b = b;
+		m_d = d;
 		m_pc = pc;
 		m_ps = ps;
 		m_counteval = counteval;
 		m_eigeneval = eigeneval;
 		m_sigma = sigma;
 	}
-		
+
 	} // end loop on g
+
+	// A decomposition still running is waited for, so that the memory is left in a consistent state
+	if (async_es.running()) {
+		async_es.wait();
+		if (apply_eigen(async_es.m_es,B,D,BD,invsqrtC) && m_memory) {
+			m_B = B;
+			m_D = D;
+			m_invsqrtC = invsqrtC;
+		}
+	}
 }
 
 /// Setter for m_gen 
@@ -507,7 +713,9 @@ std::string cmaes::human_readable_extra() const
 	  << "sigma0:" << m_sigma << ' '
 	  << "ftol:" << m_ftol << ' '
 	  << "xtol:" << m_xtol << ' ' 
-	  << "memory:" << m_memory;
+	  << "memory:" << m_memory << ' '
+	  << "covariance:" << (m_covariance == FULL ? "FULL" : (m_covariance == SEPARABLE ? "SEPARABLE" : "LIMITED_MEMORY")) << ' '
+	  << "async_eigen:" << m_async_eigen;
 	return s.str();
 }
 
@@ -42,13 +42,30 @@ namespace pagmo { namespace algorithm {
 
 /// Covariance Matrix Adaptation Evolutionary Strategy (CMAES)
 /**
-
+ * The covariance matrix can be modelled in three ways. FULL is the original algorithm, with O(N^2) memory and
+ * sampling cost and an O(N^3) eigendecomposition every O(N) generations. SEPARABLE adapts only the diagonal of C
+ * (sep-CMA-ES), with learning rates increased by (N+2)/3. LIMITED_MEMORY represents the Cholesky factor of C
+ * implicitly through the last m = 4 + 3 ln(N) evolution paths, stored every N/m generations (LM-CMA, rank-one updates
+ * only, cmu is ignored). Both have O(N) (resp. O(mN)) memory and cost per sample and never decompose C, which makes
+ * them the choice for problems with thousands of variables.
+ *
+ * With the FULL model the eigendecomposition can optionally run on a helper thread (async_eigen): sampling then goes
+ * on with the previous B and D, which are swapped with the new ones when the next decomposition is due.
+ *
+ * @see Ros, R. and Hansen, N., "A simple modification in CMA-ES achieving linear time and space complexity"
+ * @see Loshchilov, I., "A computationally efficient limited memory CMA-ES for large scale optimization"
  */
 
 class __PAGMO_VISIBLE cmaes: public base
 {
 public:
-	cmaes(int gen = 500, double cc = -1, double cs = -1, double c1 = -1, double cmu = -1, double sigma0=0.5, double ftol = 1e-6, double xtol = 1e-6, bool memory = true);
+	/// Model of the covariance matrix
+	enum covariance_type {
+		FULL = 0, ///< Full N x N covariance matrix
+		SEPARABLE = 1, ///< Diagonal covariance matrix
+		LIMITED_MEMORY = 2 ///< Covariance matrix implicitly defined by a few stored directions
+	};
+	cmaes(int gen = 500, double cc = -1, double cs = -1, double c1 = -1, double cmu = -1, double sigma0=0.5, double ftol = 1e-6, double xtol = 1e-6, bool memory = true, covariance_type covariance = FULL, bool async_eigen = false);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -95,6 +112,8 @@ private:
 		ar & m_xtol;
 		ar & m_ftol;
 		ar & m_memory;
+		ar & m_covariance;
+		ar & m_async_eigen;
 		ar & m_mean;
 		ar & m_variation;
 		ar & m_newpop;
@@ -102,6 +121,11 @@ private:
 		ar & m_D;
 		ar & m_C;
 		ar & m_invsqrtC;
+		ar & m_diagC;
+		ar & m_P;
+		ar & m_V;
+		ar & m_b;
+		ar & m_d;
 		ar & m_pc;
 		ar & m_ps;
 		ar & m_counteval;
@@ -117,15 +141,22 @@ private:
 	double m_ftol;
 	double m_xtol;
 	bool m_memory;
+	covariance_type m_covariance;
+	bool m_async_eigen;
 
 	// "Memory" data members (these are here as to enable control over each single generation)
 	mutable Eigen::VectorXd m_mean;
 	mutable Eigen::VectorXd m_variation;
-	mutable std::vector<Eigen::VectorXd> m_newpop;
+	mutable Eigen::MatrixXd m_newpop;
 	mutable Eigen::MatrixXd m_B;
 	mutable Eigen::MatrixXd m_D;
 	mutable Eigen::MatrixXd m_C;
 	mutable Eigen::MatrixXd m_invsqrtC;
+	mutable Eigen::VectorXd m_diagC;
+	mutable Eigen::MatrixXd m_P;
+	mutable Eigen::MatrixXd m_V;
+	mutable Eigen::VectorXd m_b;
+	mutable Eigen::VectorXd m_d;
 	mutable Eigen::VectorXd m_pc;
 	mutable Eigen::VectorXd m_ps;
 	mutable int m_counteval;
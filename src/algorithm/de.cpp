@@ -22,14 +22,16 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
-#include <boost/random/uniform_int.hpp>
-#include <boost/random/uniform_real.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <string>
 #include <vector>
 
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/de_kernels.h"
+#include "../util/soa_population.h"
 #include "base.h"
 #include "de.h"
 
@@ -105,19 +107,23 @@ void de::evolve(population &pop) const
 		return;
 	}
 	// Some vectors used during evolution are allocated here.
-	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
-	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
+	decision_vector tmp(D); //tmp to contain the velocity of an accepted candidate
+	// The trials of a generation are built first and then evaluated with a single objfun_batch() call.
+	std::vector<decision_vector> trials(NP,tmp);
+	std::vector<fitness_vector> trial_fit(NP);
+	// The chromosomes are the rows of the decision vector matrix of a structure-of-arrays copy of the population, swapped
+	// with the matrix of the next generation at the end of each generation.
+	util::soa_population store(pop);
+	util::soa_population::matrix_type &popold = store.cur_x;
+	util::soa_population::matrix_type popnew(popold);
 	decision_vector gbX(D),gbIter(D);
-	fitness_vector newfitness(prob_f_dimension);	//new fitness of the mutaded candidate
 	fitness_vector gbfit(prob_f_dimension);	//global best fitness
 	std::vector<fitness_vector> fit(NP,gbfit);
 
-	//We extract from pop the chromosomes and fitness associated
+	//We extract from pop the fitness associated to the chromosomes
 	for (std::vector<double>::size_type i = 0; i < NP; ++i) {
-		popold[i] = pop.get_individual(i).cur_x;
 		fit[i] = pop.get_individual(i).cur_f;
 	}
-	popnew = popold;
 
 	// Initialise the global bests
 	gbX=pop.champion().x;
@@ -125,188 +131,52 @@ void de::evolve(population &pop) const
 	// container for the best decision vector of generation
 	gbIter = gbX;
 
+	// The trial function of the strategy, the sampler of the random vectors and the crossover mask are set up once
+	const util::de_kernels::trial_function trial = util::de_kernels::trial(m_strategy);
+	util::de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(Dc);
+	std::size_t r[5];	//indexes to the selected population members
+	const double *v[util::de_kernels::NONE];	//vectors combined by the strategy, indexed by role
+
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5;	//indexes to the selected population members
 	for (int gen = 0; gen < m_gen; ++gen) {
+		v[util::de_kernels::BEST] = &gbIter[0];
 		//Start of the loop through the deme
 		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = boost::uniform_int<int>(0,NP-1)(m_urng);
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-
-
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (m_strategy == 1) { /* strategy DE0 (not in our paper) */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (m_strategy == 2) { /* strategy DE1 in the techreport */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
+			sampler.sample(r,5,m_urng,i);
+			v[util::de_kernels::CURRENT] = popold.data() + i * D;
+			for (int k = 0; k < 5; ++k) {
+				v[util::de_kernels::R1 + k] = popold.data() + r[k] * D;
 			}
+			trial(&trials[i][0],v,m_f,m_cr,util::de_kernels::uniform_index(m_urng,Dc),Dc,D,&mask[0],m_drng);
 
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and m_cr=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (m_strategy == 3) { /* similiar to DE2 but generally better */
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (m_strategy == 4) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (m_strategy == 5) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					n = (n+1)%Dc;
-					++L;
-				} while ((m_drng() < m_cr) && (L < Dc));
-			}
-
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 6) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (m_strategy == 7) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + m_f*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (m_strategy == 8) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + m_f*(gbIter[n] - tmp[n]) + m_f*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 9) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (m_strategy == 10) {
-				tmp = popold[i];
-				size_t n = boost::uniform_int<int>(0,Dc-1)(m_urng);
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((m_drng() < m_cr) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*m_f;
-					}
-					n = (n+1)%Dc;
-				}
-			}
+			/*=======Trial mutation now in trials[i]. force feasibility.==================*/
+			util::de_kernels::repair(&trials[i][0],lb,ub,Dc,m_drng);
+		}
 
+		// The trials only depend on the population at the start of the generation, so they can be evaluated all
+		// at once (concurrently, if the problem allows it) without changing the outcome.
+		prob.objfun_batch(trial_fit,trials);
 
-			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
-			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = boost::uniform_real<double>(lb[i2],ub[i2])(m_drng);
-				++i2;
-			}
-
-			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
-			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
-				fit[i]=newfitness;
-				popnew[i] = tmp;
+		// Selection, in the order of the deme
+		for (size_t i = 0; i < NP; ++i) {
+			const decision_vector &xnew = trials[i];
+			if ( pop.problem().compare_fitness(trial_fit[i],fit[i]) ) {  /* improved objective function value ? */
+				fit[i]=trial_fit[i];
+				util::soa_population::row(popnew,i) = util::soa_population::const_row_type(&xnew[0],D);
 				// As a fitness improvment occured we move the point
 				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
+				std::transform(xnew.begin(), xnew.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+				//updates x and v (the fitness of the trial is already known)
+				pop.set_x(i,xnew,trial_fit[i]);
 				pop.set_v(i,tmp);
-				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
+				if ( pop.problem().compare_fitness(trial_fit[i],gbfit) ) {
 					/* if so...*/
-					gbfit=newfitness;          /* reset gbfit to new low...*/
-					gbX=popnew[i];
+					gbfit=trial_fit[i];          /* reset gbfit to new low...*/
+					gbX=xnew;
 				}
 			} else {
-				popnew[i] = popold[i];
+				popnew.row(i) = popold.row(i);
 			}
 
 		}//End of the loop through the deme
@@ -315,7 +185,7 @@ void de::evolve(population &pop) const
 		gbIter = gbX;
 
 		/* swap population arrays. New generation becomes old one */
-		std::swap(popold, popnew);
+		popold.swap(popnew);
 
 
 		//9 - Check the exit conditions (every 40 generations)
@@ -61,6 +61,14 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the velocity is also updated along DE whenever a new chromosome is accepted.
  *
+ * The trials of a generation are built from the population at the start of the generation and evaluated with a single
+ * call to problem::base::objfun_batch(), which evaluates them concurrently if the problem is thread safe and has been given
+ * more than one evaluation thread (see problem::base::set_eval_threads()). The result does not depend on the number of threads.
+ *
+ * The mutations are computed in the order of the official DE code. PaGMO is built with -ffast-math by default with GCC, which
+ * lets the compiler reassociate them: the rand-to-best strategies (3 and 8) in particular can then round differently, so
+ * results obtained with a fixed seed are reproducible only with the same build.
+ *
  * @see http://www.icsi.berkeley.edu/~storn/code.html for the official DE web site
  * @see http://www.springerlink.com/content/x555692233083677/ for the paper that introduces Differential Evolution
  *
@@ -32,6 +32,7 @@
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/de_kernels.h"
 #include "base.h"
 #include "de_1220.h"
 
@@ -49,11 +50,12 @@ namespace pagmo { namespace algorithm {
  * @param[in] memory when true the algorithm re-initialize randomly the parameters at each call
  * @param[in] ftol stopping criteria on the x tolerance
  * @param[in] xtol stopping criteria on the f tolerance
+ * @param[in] batch when true the trials of a generation are evaluated at once (concurrently, if the problem allows it) before the selection
  * @throws value_error if gen is negative, variant_adptv is not in [1,2], varianis contains value outside
  * the [1,18] range
  */
-de_1220::de_1220(int gen, int variant_adptv, const std::vector<int> & allowed_variants, bool memory, double ftol, double xtol):base(), m_gen(gen),
-	 m_variant_adptv(variant_adptv), m_allowed_variants(allowed_variants), m_memory(memory), m_ftol(ftol), m_xtol(xtol), m_f(0), m_cr(0), m_variants(0) {
+de_1220::de_1220(int gen, int variant_adptv, const std::vector<int> & allowed_variants, bool memory, double ftol, double xtol, bool batch):base(), m_gen(gen),
+	 m_variant_adptv(variant_adptv), m_allowed_variants(allowed_variants), m_memory(memory), m_ftol(ftol), m_xtol(xtol), m_batch(batch), m_f(0), m_cr(0), m_variants(0) {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
 	}
@@ -113,10 +115,13 @@ void de_1220::evolve(population &pop) const
 		return;
 	}
 	// Some vectors used during evolution are allocated here.
-	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the mutated candidate
+	decision_vector dummy(D), tmp(D); //dummy is used for initialisation purposes, tmp to contain the velocity of an accepted candidate
 	std::vector<decision_vector> popold(NP,dummy), popnew(NP,dummy);
+	std::vector<decision_vector> trials(NP,dummy);	//the mutated candidates
+	std::vector<fitness_vector> trial_fit(NP,fitness_vector(1));	//their fitnesses
+	std::vector<double> trial_F(NP), trial_CR(NP);	//and the parameters and variants they were generated with
+	std::vector<int> trial_variant(NP);
 	decision_vector gbX(D),gbIter(D);
-	fitness_vector newfitness(1);	//new fitness of the mutaded candidate
 	fitness_vector gbfit(1);	//global best fitness
 	std::vector<fitness_vector> fit(NP,gbfit);
 
@@ -138,10 +143,6 @@ void de_1220::evolve(population &pop) const
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > n_dist(m_drng,normal);
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
-	boost::uniform_int<int> r_p_idx(0,NP-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,r_p_idx);
-	boost::uniform_int<int> r_c_idx(0,Dc-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > c_idx(m_urng,r_c_idx);
 	boost::uniform_int<int> r_v_idx(0,m_allowed_variants.size()-1);
 	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > v_idx(m_urng,r_v_idx);
 
@@ -170,369 +171,80 @@ void de_1220::evolve(population &pop) const
 	double gbIterF = m_f[0];
 	double gbIterCR = m_cr[0];
 
+	// The sampler of the random vectors and the crossover mask are set up once
+	util::de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(Dc);
+	std::size_t r[util::de_kernels::n_random];	//indexes to the selected population members
+	const double *v[util::de_kernels::NONE];	//vectors combined by the strategy, indexed by role
+
 	// Main DE iterations
-	size_t r1,r2,r3,r4,r5,r6,r7;	//indexes to the selected population members
 	for (int gen = 0; gen < m_gen; ++gen) {
-		//Start of the loop through the deme
-		for (size_t i = 0; i < NP; ++i) {
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 2 !!!     */
-				r1 = p_idx();
-			} while (r1==i);
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 3 !!!     */
-				r2 = p_idx();
-			} while ((r2==i) || (r2==r1));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 4 !!!     */
-				r3 = p_idx();
-			} while ((r3==i) || (r3==r1) || (r3==r2));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 5 !!!     */
-				r4 = p_idx();
-			} while ((r4==i) || (r4==r1) || (r4==r2) || (r4==r3));
-
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 6 !!!     */
-				r5 = p_idx();
-			} while ((r5==i) || (r5==r1) || (r5==r2) || (r5==r3) || (r5==r4));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 7 !!!     */
-				r6 = p_idx();
-			} while ((r6==i) || (r6==r1) || (r6==r2) || (r6==r3) || (r6==r4) || (r6==r5));
-			do {                       /* Pick a random population member */
-				/* Endless loop for NP < 8 !!!     */
-				r7 = p_idx();
-			} while ((r7==i) || (r7==r1) || (r7==r2) || (r7==r3) || (r7==r4) || (r7==r5) || (r7==r6));
-
-			// Adapt amplification factor and crossover probability
-			double F=0, CR=0;
-			int VARIANT=0;
-			if (m_variant_adptv==1) {
-				F =  (r_dist() < 0.9) ? m_f[i]  : r_dist() * 0.9 + 0.1;
-				CR = (r_dist() < 0.9) ? m_cr[i] : r_dist();
-			}
-			VARIANT = (r_dist() < 0.9) ? m_variants[i] : m_allowed_variants[v_idx()];
-				
-			/*-------DE/best/1/exp--------------------------------------------------------------------*/
-			/*-------Our oldest strategy but still not bad. However, we have found several------------*/
-			/*-------optimization problems where misconvergence occurs.-------------------------------*/
-			if (VARIANT == 1) { /* strategy DE0 (not in our paper) */
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] + F*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*-------DE/rand/1/exp-------------------------------------------------------------------*/
-			/*-------This is one of my favourite strategies. It works especially well when the-------*/
-			/*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_f=0.7 and m_cr=0.5---------*/
-			/*-------as a first guess.---------------------------------------------------------------*/
-			else if (VARIANT == 2) { /* strategy DE1 in the techreport */
-				if (m_variant_adptv==2) {
-					F =  m_f[r1]  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = m_cr[r1] + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r1][n] + F*(popold[r2][n]-popold[r3][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-
-			/*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-			/*-------This strategy seems to be one of the best strategies. Try m_f=0.85 and c=1.------*/
-			/*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-			/*-------should play around with all three control variables.----------------------------*/
-			else if (VARIANT == 3) { /* similiar to DE2 but generally better */
-				if (m_variant_adptv==2) {
-					F =  m_f[i]  + n_dist() * 0.5 * (gbIterF-m_f[i]) +   n_dist() * 0.5 * (m_f[r1] - m_f[r2]);
-					CR = m_cr[i] + n_dist() * 0.5 * (gbIterCR-m_cr[i]) + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = tmp[n] + F*(gbIter[n] - tmp[n]) + F*(popold[r1][n]-popold[r2][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/best/2/exp is another powerful strategy worth trying--------------------------*/
-			else if (VARIANT == 4) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 *  (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = gbIterCR  + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
+		v[util::de_kernels::BEST] = &gbIter[0];
+		//Start of the loop through the deme. In batch mode all the trials are built, then evaluated together and
+		//then selected, otherwise each trial is selected before the next one is built.
+		for (size_t first = 0, last; first < NP; first = last) {
+			last = m_batch ? NP : first + 1;
+			for (size_t i = first; i < last; ++i) {
+				sampler.sample(r,util::de_kernels::n_random,m_urng,i);
+				v[util::de_kernels::CURRENT] = &popold[i][0];
+				for (std::size_t k = 0; k < util::de_kernels::n_random; ++k) {
+					v[util::de_kernels::R1 + k] = &popold[r[k]][0];
 				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-			else if (VARIANT == 5) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r5]  + n_dist() * 0.5 * (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = m_cr[r5] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r5][n] +
-						 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
 
-			/*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-
-			/*-------DE/best/1/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 6) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + F*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/1/bin-------------------------------------------------------------------*/
-			else if (VARIANT == 7) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r1]  + n_dist() * 0.5 * (m_f[r2]-m_f[r3]);
-					CR = m_cr[r1] + n_dist() * 0.5 * (m_cr[r2]-m_cr[r3]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r1][n] + F*(popold[r2][n]-popold[r3][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-			else if (VARIANT == 8) {
-				if (m_variant_adptv==2) {
-					F =  m_f[i]  + n_dist() * 0.5 * (gbIterF-m_f[i]) +   n_dist() * 0.5 * (m_f[r1] - m_f[r2]);
-					CR = m_cr[i] + n_dist() * 0.5 * (gbIterCR-m_cr[i]) + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = tmp[n] + F*(gbIter[n] - tmp[n]) + F*(popold[r1][n]-popold[r2][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/best/2/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 9) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 *  (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = gbIterCR  + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					}
-					n = (n+1)%Dc;
+				// Adapt amplification factor and crossover probability
+				double F=0, CR=0;
+				int VARIANT=0;
+				if (m_variant_adptv==1) {
+					F =  (r_dist() < 0.9) ? m_f[i]  : r_dist() * 0.9 + 0.1;
+					CR = (r_dist() < 0.9) ? m_cr[i] : r_dist();
 				}
-			}
-			/*-------DE/rand/2/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 10) {
+				VARIANT = (r_dist() < 0.9) ? m_variants[i] : m_allowed_variants[util::de_kernels::uniform_index(m_urng,m_allowed_variants.size())];
 				if (m_variant_adptv==2) {
-					F =  m_f[r5]  + n_dist() * 0.5 * (m_f[r1] - m_f[r3]) +   n_dist() * 0.5 * (m_f[r2] - m_f[r4]);
-					CR = m_cr[r5] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r3]) + n_dist() * 0.5 * (m_cr[r2] - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r5][n] +
-							 (popold[r1][n]+popold[r2][n]-popold[r3][n]-popold[r4][n])*F;
-					}
-					n = (n+1)%Dc;
+					F =  util::de_kernels::adapted_parameter(VARIANT,m_f,gbIterF,i,r,n_dist);
+					CR = util::de_kernels::adapted_parameter(VARIANT,m_cr,gbIterCR,i,r,n_dist);
 				}
-			}
+				util::de_kernels::trial(VARIANT)(&trials[i][0],v,F,CR,util::de_kernels::uniform_index(m_urng,Dc),Dc,D,&mask[0],m_drng);
+				trial_F[i] = F;
+				trial_CR[i] = CR;
+				trial_variant[i] = VARIANT;
 
-			/*-------DE/best/3/exp--------------------------------------------------------------------*/
-			if (VARIANT == 11) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = gbIter[n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/best/3/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 12) {
-				if (m_variant_adptv==2) {
-					F =  gbIterF  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = gbIterCR + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = gbIter[n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand/3/exp--------------------------------------------------------------------*/
-			if (VARIANT == 13) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand/3/bin--------------------------------------------------------------------*/
-			else if (VARIANT == 14) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[r2]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[r2]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[r2][n]) + F*(popold[r3][n]-popold[r4][n]) + F*(popold[r5][n]-popold[r6][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-current/2/exp---------------------------------------------------------*/
-			if (VARIANT == 15) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(popold[r3][n]-popold[r4][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand-to-current/2/bin---------------------------------------------------------*/
-			else if (VARIANT == 16) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (m_f[r3] - m_f[r4]) + n_dist() * 0.5 * (m_f[r5] - m_f[r6]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (m_cr[r3] - m_cr[r4]) + n_dist() * 0.5 * (m_cr[r5] - m_cr[r6]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(popold[r3][n]-popold[r4][n]);
-					}
-					n = (n+1)%Dc;
-				}
-			}
-			/*-------DE/rand-to-best-and-current/2/exp------------------------------------------------*/
-			if (VARIANT == 17) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (gbIterF - m_f[r4]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (gbIterCR - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx(), L = 0;
-				do {
-					tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(gbIter[n]-popold[r4][n]);
-					n = (n+1)%Dc;
-					++L;
-				} while ((r_dist() < CR) && (L < Dc));
-			}
-			/*-------DE/rand-to-best-and-current/2/bin------------------------------------------------*/
-			else if (VARIANT == 18) {
-				if (m_variant_adptv==2) {
-					F =  m_f[r7]  + n_dist() * 0.5 * (m_f[r1] - m_f[i]) + n_dist() * 0.5 * (gbIterF - m_f[r4]);
-					CR = m_cr[r7] + n_dist() * 0.5 * (m_cr[r1] - m_cr[i]) + n_dist() * 0.5 * (gbIterCR - m_cr[r4]);
-				}
-				tmp = popold[i];
-				size_t n = c_idx();
-				for (size_t L = 0; L < Dc; ++L) { /* perform Dc binomial trials */
-					if ((r_dist() < CR) || L + 1 == Dc) { /* change at least one parameter */
-						tmp[n] = popold[r7][n] + F*(popold[r1][n]-popold[i][n]) + F*(gbIter[n]-popold[r4][n]);
-					}
-					n = (n+1)%Dc;
-				}
+				/*=======Trial mutation now in trials[i]. force feasibility.==================*/
+				util::de_kernels::repair(&trials[i][0],lb,ub,Dc,m_drng);
 			}
 
-			/*=======Trial mutation now in tmp[]. force feasibility and how good this choice really was.==================*/
-			// a) feasibility
-			size_t i2 = 0;
-			while (i2<Dc) {
-				if ((tmp[i2] < lb[i2]) || (tmp[i2] > ub[i2]))
-					tmp[i2] = r_dist() * (ub[i2]-lb[i2]) + lb[i2];
-				++i2;
+			// How good? (concurrently, if the problem allows it)
+			if (m_batch) {
+				prob.objfun_batch(trial_fit,trials);
+			} else {
+				prob.objfun(trial_fit[first],trials[first]);
 			}
 
-			//b) how good?
-			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] */
-			if ( pop.problem().compare_fitness(newfitness,fit[i]) ) {  /* improved objective function value ? */
-				fit[i]=newfitness;
-				popnew[i] = tmp;
+			for (size_t i = first; i < last; ++i) {
+				if ( pop.problem().compare_fitness(trial_fit[i],fit[i]) ) {  /* improved objective function value ? */
+					fit[i]=trial_fit[i];
+					popnew[i] = trials[i];
 				
-				// Update the adapted parameters
-				m_cr[i] = CR;
-				m_f[i] = F;
-				m_variants[i] = VARIANT;
+					// Update the adapted parameters
+					m_cr[i] = trial_CR[i];
+					m_f[i] = trial_F[i];
+					m_variants[i] = trial_variant[i];
 				
-				// As a fitness improvment occured we move the point
-				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+					// As a fitness improvment occured we move the point
+					// and thus can evaluate a new velocity
+					std::transform(popnew[i].begin(), popnew[i].end(), pop.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
 				
-				//updates x and v (cache avoids to recompute the objective function)
-				pop.set_x(i,popnew[i]);
-				pop.set_v(i,tmp);
-				if ( pop.problem().compare_fitness(newfitness,gbfit) ) {
-					/* if so...*/
-					gbfit=newfitness;          /* reset gbfit to new low...*/
-					gbX=popnew[i];
+					//updates x and v (the fitness of the trial is already known)
+					pop.set_x(i,popnew[i],trial_fit[i]);
+					pop.set_v(i,tmp);
+					if ( pop.problem().compare_fitness(trial_fit[i],gbfit) ) {
+						/* if so...*/
+						gbfit=trial_fit[i];          /* reset gbfit to new low...*/
+						gbX=popnew[i];
+					}
+				} else {
+					popnew[i] = popold[i];
 				}
-			} else {
-				popnew[i] = popold[i];
 			}
-
 		}//End of the loop through the deme
 
 		/* Save best population member of current iteration */
@@ -592,6 +304,7 @@ std::string de_1220::human_readable_extra() const
 	s << "self_adaptation:" << m_variant_adptv << ' ';
 	s << "variants:" << m_allowed_variants << ' ';
 	s << "memory:" << m_memory << ' ';
+	s << "batch:" << m_batch << ' ';
 	s << "ftol:" << m_ftol << ' ';
 	s << "xtol:" << m_xtol;
 
@@ -49,6 +49,11 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the pagmo::population::individual_type::cur_v is also updated in DE 1220 as soon as a new chromosome is accepted.
  *
+ * In batch mode the trials of a generation are built first and evaluated with a single call to problem::base::objfun_batch(),
+ * which evaluates them concurrently if the problem is thread safe and has been given more than one evaluation thread
+ * (see problem::base::set_eval_threads()). The self-adaptation then reads the parameters as they were at the start of the
+ * generation, and, for a given seed, the result does not depend on the number of threads. With m_variant_adptv = 1 the
+ * result is also the same as in the default mode.
  * @author Dario Izzo (dario.izzo@googlemail.com)
  */
 
@@ -57,7 +62,7 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE de_1220: public base
 {
 public:
-	de_1220(int = 100, int = 1, const std::vector<int>& = construct_default_strategies(), bool = true, double = 1e-6, double = 1e-6);
+	de_1220(int = 100, int = 1, const std::vector<int>& = construct_default_strategies(), bool = true, double = 1e-6, double = 1e-6, bool = false);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -82,6 +87,7 @@ private:
 		ar & const_cast<bool &>(m_memory);
 		ar & const_cast<double &>(m_ftol);
 		ar & const_cast<double &>(m_xtol);
+		ar & const_cast<bool &>(m_batch);
 		ar & m_f;
 		ar & m_cr;
 		ar & m_variants;
@@ -102,6 +108,9 @@ private:
 	//Tolerances
 	const double m_ftol;
 	const double m_xtol;
+
+	//Batch evaluation of the trials
+	const bool m_batch;
 	
 	// Weighting factor
 	mutable std::vector<double> m_f;
@@ -53,6 +53,11 @@ namespace pagmo { namespace algorithm {
  *
  * NOTE3: the pagmo::population::individual_type::cur_v is also updated along DE as soon as a new chromosome is accepted.
  *
+ * In batch mode the trials of a generation are built first and evaluated with a single call to problem::base::objfun_batch(),
+ * which evaluates them concurrently if the problem is thread safe and has been given more than one evaluation thread
+ * (see problem::base::set_eval_threads()). The self-adaptation then reads the parameters as they were at the start of the
+ * generation, and, for a given seed, the result does not depend on the number of threads. With m_variant_adptv = 1 the
+ * result is also the same as in the default mode.
  *
  * @see http://labraj.uni-mb.si/images/0/05/CEC09_slides_Brest.pdf  where m_variant_adptv = 1 is studied.
  * @see http://sci2s.ugr.es/EAMHCO/pdfs/contributionsCEC11/05949732.pdf for a paper where a similar apporach to m_variant_adptv=2 is described
@@ -64,7 +69,7 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE jde : public base
 {
 public:
-	jde(int = 100, int = 2, int = 1, double = 1e-6, double = 1e-6, bool = false);
+	jde(int = 100, int = 2, int = 1, double = 1e-6, double = 1e-6, bool = false, bool = false);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -85,6 +90,7 @@ private:
 		ar & m_f;
 		ar & m_cr;
 		ar & const_cast<bool &>(m_memory);
+		ar & const_cast<bool &>(m_batch);
 	}
 	
 	// Number of generations.
@@ -105,6 +111,8 @@ private:
 
 	// Memory option
 	const bool m_memory;
+	// Batch evaluation of the trials
+	const bool m_batch;
 };
 
 }}
@@ -23,7 +23,6 @@
 *****************************************************************************/
 
 #include <boost/math/constants/constants.hpp>
-#include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/cauchy_distribution.hpp>
@@ -36,6 +35,8 @@
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/de_kernels.h"
+#include "../util/soa_population.h"
 #include "base.h"
 #include "mde_pbx.h"
 
@@ -86,7 +87,8 @@ void mde_pbx::evolve(population &pop) const
 	const problem::base::size_type D = prob.get_dimension();
 	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	const population::size_type NP = pop.size();
-	const population::size_type NP_Part = m_qperc * NP; // here we rely on an implicit cast
+	// here we rely on an implicit cast, the q% sample contains at least one individual and at most all but i
+	const population::size_type NP_Part = std::min<population::size_type>(NP - 1,std::max<population::size_type>(1,m_qperc * NP));
 
 	//We perform some checks to determine wether the problem/population are suitable for DE
 	if ( D == 0 ) {
@@ -101,8 +103,9 @@ void mde_pbx::evolve(population &pop) const
 		pagmo_throw(value_error,"The problem is not single objective and MDE_pBX is not suitable to solve it");
 	}
 
-	if (NP < 3) {
-		pagmo_throw(value_error,"for this algorithm, at least 3 individuals in the population are needed");
+	// i, the best of the q% sample and two further distinct individuals
+	if (NP < 4) {
+		pagmo_throw(value_error,"for this algorithm, at least 4 individuals in the population are needed");
 	}
 
 	if (NP_Part < 1) {
@@ -126,27 +129,30 @@ void mde_pbx::evolve(population &pop) const
 	boost::uniform_real<double> uniform(0.0,1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::uniform_real<double> > r_dist(m_drng,uniform);
 
-	boost::uniform_int<decision_vector::size_type> r_c_idx(0,D-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<decision_vector::size_type> > c_idx(m_urng,r_c_idx);
-	
-	boost::uniform_int<population::size_type> r_p_idx(0,NP-1);
-	boost::variate_generator<boost::mt19937 &, boost::uniform_int<population::size_type> > p_idx(m_urng,r_p_idx);
-	
 	boost::normal_distribution<double> nd(0.0, 1.0);
 	boost::variate_generator<boost::lagged_fibonacci607 &, boost::normal_distribution<double> > gauss(m_drng,nd);
 	
 	// Declaring temporary variables used by the main-loop
 	population::size_type p;
-	population::size_type r1, r2, bestq_idx, bestp_idx, j_rand;
-	std::vector<population::size_type> a(NP-1,0);
+	population::size_type bestq_idx, bestp_idx, j_rand;
+	std::size_t r[2];
+	std::vector<std::size_t> a(NP_Part,0);
 	double cri, fi; //, wcr, wf;
+	util::de_kernels::index_sampler sampler(NP);
+	std::vector<char> mask(D);
+	// The chromosomes and fitnesses of the population at the start of the generation
+	util::soa_population::matrix_type x_old(NP,D);
+	std::vector<fitness_vector> f_old(NP);
 
 	// **** Main Loop of MDE-pBX ****
 	for (int gen = 0; gen < m_gen; ++gen) {
 		
 		// make a snapshot of the current population
-		// as we loop over individuals pop will contain the new generation while pop_old remains unchanged
-		pagmo::population pop_old(pop);
+		// as we loop over individuals pop will contain the new generation while x_old and f_old remain unchanged
+		for (pagmo::population::size_type i = 0; i < NP; ++i) {
+			util::soa_population::row(x_old,i) = util::soa_population::const_row_type(&pop.get_individual(i).cur_x[0],D);
+			f_old[i] = pop.get_individual(i).cur_f;
+		}
 		
 		// clear the sets of successful scale factors and crossover probabilities
 		m_fsuccess.clear();
@@ -157,42 +163,26 @@ void mde_pbx::evolve(population &pop) const
 		p = ceil((NP / 2.0) * ( 1.0 - (double)(gen) / m_gen));
 
 		// get the p-best individuals
-		std::vector<population::size_type> pbest = pop_old.get_best_idx(p);
+		std::vector<population::size_type> pbest = pop.get_best_idx(p);
 		
 		// loop through all individuals
 		for (pagmo::population::size_type i = 0; i < NP; ++i) {
 			
 			// Get q% random indices excluding i
-			// First we build the index list (for example i=5 -> a = [1,2,3,4,6,7,8, .... ]) containing NP-1 entries
-			for (pagmo::population::size_type k = 0; k < NP-1; ++k) {
-				(k<i) ? a[k] = k : a[k] = k+1;
-			}
-			// Then we swap the first q% of the indexes
-			for (pagmo::population::size_type k = 0; k < NP_Part; ++k) {
-				r1 = boost::uniform_int<int>(k,NP-2)(m_urng);
-				std::swap(a[k], a[r1]);
-			}
+			sampler.sample(&a[0],NP_Part,m_urng,i);
 			
 			// find index of individual from q% sample with best fitness
 			bestq_idx = a[0];
 			for (pagmo::population::size_type k = 1; k < NP_Part; ++k) {
-				if ( prob.compare_fitness(pop_old.get_individual(a[k]).cur_f, pop_old.get_individual(bestq_idx).cur_f) ) {
+				if ( prob.compare_fitness(f_old[a[k]], f_old[bestq_idx]) ) {
 					bestq_idx = a[k];
 				}
 			}
 			
 			// choose two random distinct pop members
-			do {
-				/* Endless loop for NP < 2 !!!     */
-				r1 = p_idx();
-			} while ((r1==i) || (r1==bestq_idx));
-			
-			do {
-				/* Endless loop for NP < 3 !!!     */
-				r2 = p_idx();
-			} while ((r2==i) || (r2==r1) || (r2==bestq_idx));
+			sampler.sample(r,2,m_urng,i,bestq_idx);
 			
-			bestp_idx = pbest[boost::uniform_int<int>(0,p-1)(m_urng)];
+			bestp_idx = pbest[util::de_kernels::uniform_index(m_urng,p)];
 			
 			// sample scale factors
 			//do {
@@ -209,32 +199,32 @@ void mde_pbx::evolve(population &pop) const
 				fi = std::min(1.0,fi);
 			} while (fi <= 0.0); // || (fi >=1.0));
 			
-			// fix a random dimension index
-			j_rand = c_idx();
+			// fix a random dimension index, and draw the crossover mask
+			j_rand = util::de_kernels::uniform_index(m_urng,D);
+			for (size_t j = 0; j < D; ++j) {
+				mask[j] = (j == j_rand || r_dist() < cri);
+			}
 
 			// Mutation + Crossover
+			const double *xi = x_old.data() + i * D, *xq = x_old.data() + bestq_idx * D, *x1 = x_old.data() + r[0] * D,
+				*x2 = x_old.data() + r[1] * D, *xp = x_old.data() + bestp_idx * D;
 			for (size_t j = 0; j < D; ++j) {
-				if (j == j_rand || r_dist() < cri) {
-					tmp[j] = pop_old.get_individual(i).cur_x[j] + fi * (pop_old.get_individual(bestq_idx).cur_x[j] - pop_old.get_individual(i).cur_x[j] + pop_old.get_individual(r1).cur_x[j] - pop_old.get_individual(r2).cur_x[j]);
-// The paper does not speak about constraint enforcing ....
-					if ((tmp[j] < lb[j]) || (tmp[j] > ub[j])) { // enforce box-bounds
-						tmp[j] = lb[j]+ r_dist()*(ub[j]-lb[j]);
-					}
-				} else {
-					tmp[j] = pop_old.get_individual(bestp_idx).cur_x[j];
-				}
+				const double m = xi[j] + fi * (xq[j] - xi[j] + x1[j] - x2[j]);
+				tmp[j] = mask[j] ? m : xp[j];
 			}
+// The paper does not speak about constraint enforcing .... (only mutated components can violate the bounds)
+			util::de_kernels::repair(&tmp[0],lb,ub,D,m_drng);
 			
 			/*=======Trial mutation now in tmp[] and feasible. Test how good this choice really was.==========*/
 
 			
 			// b) Compare with the objective function
 			prob.objfun(newfitness, tmp);    /* Evaluate new vector in tmp[] and records it fitness in newfitness */
-			if ( pop.problem().compare_fitness(newfitness,pop_old.get_individual(i).cur_f) ) {  /* improved objective function value ? */
+			if ( pop.problem().compare_fitness(newfitness,f_old[i]) ) {  /* improved objective function value ? */
 				// As a fitness improvement occured we 
 				pop.set_x(i,tmp);
 				// and thus can evaluate a new velocity
-				std::transform(tmp.begin(), tmp.end(), pop_old.get_individual(i).cur_x.begin(), tmp.begin(),std::minus<double>());
+				std::transform(tmp.begin(), tmp.end(), xi, tmp.begin(),std::minus<double>());
 				// updates  v (cache avoids to recompute the objective function)
 				pop.set_v(i,tmp);
 				// pop_old.set_x(i,tmp); (un-comment for a steady-state version)
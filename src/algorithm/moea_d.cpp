@@ -61,6 +61,8 @@ namespace pagmo { namespace algorithm {
  * @param[in] f f parameter in the Differential Evolution operator
  * @param[in] eta_m Distribution index for the polynomial mutation
  * @param[in] preserve_diversity when true activates the two diversity preservation mechanism described in Li, Hui, and Qingfu Zhang paper
+ * @param[in] batch when true the offspring of all subproblems are produced first and evaluated with a single call to
+ * problem::base::objfun_batch(), then inserted in the population one subproblem after the other
  * @throws value_error if gen is negative, weight_generation is not one of the allowed types, realb,cr or f are not in [1.0] or m_eta is < 0
  */
 moead::moead(int gen,
@@ -71,7 +73,8 @@ moead::moead(int gen,
 		 double cr,
 		 double f,
 		 double eta_m,
-		 bool preserve_diversity
+		 bool preserve_diversity,
+		 bool batch
 		   ) : base(),
 	  m_gen(gen),
 	  m_T(T),
@@ -81,7 +84,8 @@ moead::moead(int gen,
 	  m_cr(cr),
 	  m_f(f),
 	  m_eta_m(eta_m),
-	  m_preserve_diversity(preserve_diversity)
+	  m_preserve_diversity(preserve_diversity),
+	  m_batch(batch)
 {
 	// Sanity checks
 	if (gen < 0) {
@@ -287,6 +291,92 @@ void moead::mating_selection(std::vector<population::size_type> &list, int n, in
 		}
 }
 
+// Neighbourhood from which the parents of an offspring are taken and in which it is inserted: 1 for the
+// neighbourhood of the subproblem, 2 for the whole population
+int moead::neighbourhood_type() const
+{
+	if(m_drng()<m_realb || !m_preserve_diversity)	return 1;	// neighborhood
+	else											return 2;	// whole population
+}
+
+// Produces the offspring of subproblem n with the DE operator and the polynomial mutation
+void moead::reproduce(decision_vector &candidate, population::size_type n, int type, const std::vector<std::vector<population::size_type> > &neigh_idx, const population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
+	candidate.resize(prob.get_dimension());
+
+	// We select two mating partners (not n) in the neighbourhood
+	std::vector<population::size_type> p(2);
+	mating_selection(p,n,type,neigh_idx);
+
+	for(decision_vector::size_type kk=0;kk<prob.get_dimension(); ++kk)
+	{
+		if (m_drng()<m_cr) {
+			/*Selected Two Parents*/
+			candidate[kk] = pop.get_individual(n).cur_x[kk] + m_f*(pop.get_individual(p[0]).cur_x[kk] - pop.get_individual(p[1]).cur_x[kk]);
+			
+			// Fix the bounds
+			if(candidate[kk]<lb[kk]){
+				candidate[kk] = lb[kk] + m_drng()*(pop.get_individual(n).cur_x[kk] - lb[kk]);
+			}
+			if(candidate[kk]>ub[kk]){ 
+				candidate[kk] = ub[kk] - m_drng()*(ub[kk] - pop.get_individual(n).cur_x[kk]);
+			}
+		} else {
+			candidate[kk] = pop.get_individual(n).cur_x[kk];
+		}
+	}
+	mutation(candidate, pop, 1.0 / prob.get_dimension());
+}
+
+// Inserts the offspring of subproblem n (with fitness new_f) in place of the individuals it improves, first on
+// problem n and then on its neighbourhood (or on the whole population) up to m_limit replacements. In batch mode
+// new_f was computed by the problem of the population, which has already counted the evaluation, so the population
+// takes it as it is. In the default mode it was computed on the copy held by prob_decomposed, so the population
+// evaluates the candidate itself (once, then from its cache) and counts it as before.
+void moead::update_subproblems(population &pop, population::size_type n, int type, const decision_vector &candidate, const fitness_vector &new_f,
+	const std::vector<std::vector<population::size_type> > &neigh_idx, const std::vector<fitness_vector> &weights, const problem::decompose &prob_decomposed) const
+{
+	const population::size_type NP = pop.size();
+	boost::uniform_int<int> pop_idx(0,NP-1);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,pop_idx);
+	fitness_vector f1(1), f2(1);
+
+	unsigned int size, time = 0;
+	// First try on problem n
+	prob_decomposed.compute_decomposed_fitness(f1,pop.get_individual(n).cur_f,weights[n]);
+	prob_decomposed.compute_decomposed_fitness(f2,new_f,weights[n]);
+	if(f2[0]<f1[0])
+	{
+		if (m_batch) pop.set_x(n,candidate,new_f);
+		else pop.set_x(n,candidate);
+		time++;
+	}
+	// Then on neighbouring problems up to m_limit (to preserve diversity)
+	if(type==1)	size = neigh_idx[n].size();	// neighborhood
+	else		size = NP;					// whole population
+	std::vector<population::size_type> shuffle2(size);
+	for(pagmo::population::size_type k=0; k < shuffle2.size(); ++k) shuffle2[k] = k;
+	std::random_shuffle(shuffle2.begin(), shuffle2.end(), p_idx);
+	for (unsigned int k=0; k<shuffle2.size(); ++k) {
+		population::size_type pick;
+		if(type==1)	pick = neigh_idx[n][shuffle2[k]];		// neighborhood
+		else		pick = shuffle2[k];					// whole population
+
+		prob_decomposed.compute_decomposed_fitness(f1,pop.get_individual(pick).cur_f,weights[pick]);
+		prob_decomposed.compute_decomposed_fitness(f2,new_f,weights[pick]);
+		if(f2[0]<f1[0])
+		{
+			if (m_batch) pop.set_x(pick,candidate,new_f);
+			else pop.set_x(pick,candidate);
+			time++;
+		}
+		// the maximal number of solutions updated is not allowed to exceed 'limit' if diversity is to be preserved
+		if(time>=m_limit && m_preserve_diversity) break;
+	}
+}
+
 /// Evolve implementation.
 
 void moead::evolve(population &pop) const
@@ -294,7 +384,6 @@ void moead::evolve(population &pop) const
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
 	const population::size_type NP = pop.size();
-	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 
 	// And make some sanity checks
 	if ( prob.get_f_dimension() < 2 ) {
@@ -324,10 +413,9 @@ void moead::evolve(population &pop) const
 	
 	// We compute, for each weight vector, the m_T neighbouring ones
 	std::vector<std::vector<population::size_type> > neigh_idx;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(neigh_idx, weights);
+	pagmo::util::neighbourhood::euclidian::compute_neighbours(neigh_idx, weights, m_T + 1);
 	for (unsigned int i=0; i < neigh_idx.size();++i) {
 		neigh_idx[i].erase(neigh_idx[i].begin());
-		neigh_idx[i].erase(neigh_idx[i].begin()+m_T, neigh_idx[i].end());
 	}
 
 	// We create a decomposed problem which we will use not as a polymorphic problem,
@@ -340,82 +428,49 @@ void moead::evolve(population &pop) const
 	std::vector<population::size_type> shuffle(NP);
 	for(pagmo::population::size_type i=0; i < shuffle.size(); ++i) shuffle[i] = i;
 	
-	fitness_vector new_f(prob.get_f_dimension()), f1(1), f2(1); 
+	fitness_vector new_f(prob.get_f_dimension());
+
+	// Offspring of a whole generation and the neighbourhood type each was produced with (only used in batch mode)
+	std::vector<decision_vector> offspring(m_batch ? NP : 0);
+	std::vector<fitness_vector> offspring_f;
+	std::vector<int> types(m_batch ? NP : 0);
 
 	// Main MOEA/D loop
 	for (int g = 0; g<m_gen; ++g) {
 	//Shuffle the indexes
 	std::random_shuffle(shuffle.begin(), shuffle.end(), p_idx);
-		for (population::size_type i = 0; i<NP;++i) {
-			// We consider the subproblem with index n
-			int n = shuffle[i];
-			// We select at random between a neighborhood and the whole pop
-			int type;
-			if(m_drng()<m_realb || !m_preserve_diversity)	type = 1;	// neighborhood
-			else											type = 2;	// whole population
-			// 1 - We select two mating partners (not n) in the neighbourhood
-			std::vector<population::size_type> p(2);
-			mating_selection(p,n,type,neigh_idx);
-			
-			// 2 - We produce and evaluate an offspring using a DE operator
-			for(decision_vector::size_type kk=0;kk<prob.get_dimension(); ++kk)
-			{
-				if (m_drng()<m_cr) {
-					/*Selected Two Parents*/
-					candidate[kk] = pop.get_individual(n).cur_x[kk] + m_f*(pop.get_individual(p[0]).cur_x[kk] - pop.get_individual(p[1]).cur_x[kk]);
-					
-					// Fix the bounds
-					if(candidate[kk]<lb[kk]){
-						candidate[kk] = lb[kk] + m_drng()*(pop.get_individual(n).cur_x[kk] - lb[kk]);
-					}
-					if(candidate[kk]>ub[kk]){ 
-						candidate[kk] = ub[kk] - m_drng()*(ub[kk] - pop.get_individual(n).cur_x[kk]);
-					}
-				} else {
-					candidate[kk] = pop.get_individual(n).cur_x[kk];
+		if (m_batch) {
+			// 1 - One offspring per subproblem, all produced from the population at the start of the generation
+			for (population::size_type i = 0; i<NP;++i) {
+				types[i] = neighbourhood_type();
+				reproduce(offspring[i], shuffle[i], types[i], neigh_idx, pop);
+			}
+			// 2 - A single evaluation of the whole batch, which the problem can distribute over its evaluation threads
+			prob.objfun_batch(offspring_f, offspring);
+			for (population::size_type i = 0; i<NP;++i) {
+				for (fitness_vector::size_type j=0; j<prob.get_f_dimension(); ++j){
+					if (offspring_f[i][j] < ideal_point[j]) ideal_point[j] = offspring_f[i][j];
 				}
 			}
-			mutation(candidate, pop, 1.0 / prob.get_dimension());
-			// Note that we do not use prob, hence the cache of prob does not get these values.
-			// Note that the ideal point is here updated too
-			prob_decomposed.compute_original_fitness(new_f, candidate);
-			
-			// 3 - We update the ideal point (Not needed as its done in decomposed when the flag adapt_weight is true)
-			//for (fitness_vector::size_type j=0; j<prob.get_f_dimension(); ++j){
-			//	if (new_f[j] < ideal_point[j]) ideal_point[j] = new_f[j];
-			//}
-			//prob_decomposed.set_ideal_point(ideal_point);
-			
-			// 4-  We insert the newly found solution into the population
-			unsigned int size, time = 0;
-			// First try on problem n
-			prob_decomposed.compute_decomposed_fitness(f1,pop.get_individual(n).cur_f,weights[n]);
-			prob_decomposed.compute_decomposed_fitness(f2,new_f,weights[n]);
-			if(f2[0]<f1[0])
-			{
-				pop.set_x(n,candidate);
-				time++;
+			prob_decomposed.set_ideal_point(ideal_point);
+			// 3 - The replacements are applied in the order of the shuffled subproblems, so that a child only
+			// competes with the children of the subproblems preceding it.
+			for (population::size_type i = 0; i<NP;++i) {
+				update_subproblems(pop, shuffle[i], types[i], offspring[i], offspring_f[i], neigh_idx, weights, prob_decomposed);
 			}
-			// Then on neighbouring problems up to m_limit (to preserve diversity)
-			if(type==1)	size = neigh_idx[n].size();	// neighborhood
-			else		size = NP;					// whole population
-			std::vector<population::size_type> shuffle2(size);
-			for(pagmo::population::size_type k=0; k < shuffle2.size(); ++k) shuffle2[k] = k;
-			std::random_shuffle(shuffle2.begin(), shuffle2.end(), p_idx);
-			for (unsigned int k=0; k<shuffle2.size(); ++k) {
-				population::size_type pick;
-				if(type==1)	pick = neigh_idx[n][shuffle2[k]];		// neighborhood
-				else		pick = shuffle2[k];					// whole population
-
-				prob_decomposed.compute_decomposed_fitness(f1,pop.get_individual(pick).cur_f,weights[pick]);
-				prob_decomposed.compute_decomposed_fitness(f2,new_f,weights[pick]);
-				if(f2[0]<f1[0])
-				{
-					pop.set_x(pick,candidate);
-					time++;
-				}
-				// the maximal number of solutions updated is not allowed to exceed 'limit' if diversity is to be preserved
-				if(time>=m_limit && m_preserve_diversity) break;
+		} else {
+			for (population::size_type i = 0; i<NP;++i) {
+				// We consider the subproblem with index n
+				const population::size_type n = shuffle[i];
+				// We select at random between a neighborhood and the whole pop
+				const int type = neighbourhood_type();
+				// We produce and evaluate an offspring using a DE operator
+				reproduce(candidate, n, type, neigh_idx, pop);
+				// Note that we do not use prob, hence the cache of prob does not get these values.
+				// Note that the ideal point is here updated too
+				prob_decomposed.compute_original_fitness(new_f, candidate);
+				// We insert the newly found solution into the population
+				update_subproblems(pop, n, type, candidate, new_f, neigh_idx, weights, prob_decomposed);
 			}
 		}
 	}
@@ -458,6 +513,9 @@ std::string moead::human_readable_extra() const
 	s << "preserve diversity:";
 	if (m_preserve_diversity) s << "True " ;
 	else s << "False ";
+	s << "batch:";
+	if (m_batch) s << "True " ;
+	else s << "False ";
 	return s.str();
 }
 
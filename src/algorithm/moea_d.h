@@ -42,6 +42,12 @@ namespace pagmo { namespace algorithm {
  * one can select to use the ideas introduced in the second paper or not. In all cases Tchebycheff decomposition and 
  * a differential evolution operator are used
  *
+ * In batch mode the offspring of all the subproblems of a generation are produced from the population at the start of
+ * the generation and evaluated with a single call to problem::base::objfun_batch(), which evaluates them concurrently
+ * if the problem is thread safe and has been given more than one evaluation thread (see problem::base::set_eval_threads()).
+ * The replacements are then applied in the (random) order in which the subproblems were visited, so that, for a given
+ * seed, the result does not depend on the number of threads.
+ *
  * @see Zhang, Qingfu, and Hui Li. "MOEA/D: A multiobjective evolutionary algorithm based on decomposition." Evolutionary Computation, IEEE Transactions on 11.6 (2007): 712-731.
  * @see Li, Hui, and Qingfu Zhang. "Multiobjective optimization problems with complicated Pareto sets, MOEA/D and NSGA-II." Evolutionary Computation, IEEE Transactions on 13.2 (2009): 284-302.
  *
@@ -66,7 +72,8 @@ public:
 		 double CR = 1.0,
 		 double F=0.5,
 		 double eta_m = 20,
-		 bool preserve_diversity = true
+		 bool preserve_diversity = true,
+		 bool batch = false
 		);
 
 	base_ptr clone() const;
@@ -82,6 +89,10 @@ private:
 	void compute_neighbours(std::vector<std::vector<int> > &, const std::vector<std::vector <double> > &);
 	void mating_selection(std::vector<population::size_type> &, int, int,const std::vector<std::vector<population::size_type> >&) const;
 	void mutation(decision_vector&, const population&, double rate) const;
+	int neighbourhood_type() const;
+	void reproduce(decision_vector &, population::size_type, int, const std::vector<std::vector<population::size_type> > &, const population &) const;
+	void update_subproblems(population &, population::size_type, int, const decision_vector &, const fitness_vector &,
+		const std::vector<std::vector<population::size_type> > &, const std::vector<fitness_vector> &, const problem::decompose &) const;
 	
 	friend class boost::serialization::access;
 	template <class Archive>
@@ -97,6 +108,7 @@ private:
 		ar & const_cast<double &>(m_f);
 		ar & const_cast<double &>(m_eta_m);
 		ar & const_cast<double &>(m_preserve_diversity);
+		ar & const_cast<bool &>(m_batch);
 	}
 	//Number of generations
 	const int m_gen;
@@ -109,6 +121,8 @@ private:
 	const double m_f;
 	const double m_eta_m;
 	const double m_preserve_diversity;
+	// Produce and evaluate the offspring of a whole generation at once
+	const bool m_batch;
 };
 
 }} //namespaces
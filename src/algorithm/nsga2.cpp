@@ -32,16 +32,149 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <cstddef>
+#include <limits>
 
 #include "../exceptions.h"
 #include "../population.h"
 #include "../problem/base.h"
 #include "../types.h"
+#include "../util/non_dominated_sorting.h"
+#include "../util/pareto_fronts.h"
 #include "base.h"
 #include "nsga2.h"
 
 namespace pagmo { namespace algorithm {
 
+namespace {
+
+// Pareto ranks by pairwise comparison of the fitness vectors, for problems that redefine the dominance relation.
+void dominance_ranks(const problem::base &prob, const std::vector<fitness_vector> &f, std::vector<std::size_t> &rank)
+{
+	const std::size_t n = f.size();
+	std::vector<std::vector<std::size_t> > dom_list(n);
+	std::vector<std::size_t> dom_count(n,0), front, next;
+	for (std::size_t i = 0; i < n; ++i) {
+		for (std::size_t j = 0; j < n; ++j) {
+			if (i != j && prob.compare_fitness(f[i],f[j])) {
+				dom_list[i].push_back(j);
+				++dom_count[j];
+			}
+		}
+	}
+	rank.assign(n,0);
+	for (std::size_t i = 0; i < n; ++i) {
+		if (!dom_count[i]) {
+			front.push_back(i);
+		}
+	}
+	for (std::size_t r = 1; !front.empty(); ++r) {
+		next.clear();
+		for (std::size_t i = 0; i < front.size(); ++i) {
+			for (std::size_t j = 0; j < dom_list[front[i]].size(); ++j) {
+				const std::size_t k = dom_list[front[i]][j];
+				if (!--dom_count[k]) {
+					rank[k] = r;
+					next.push_back(k);
+				}
+			}
+		}
+		front.swap(next);
+	}
+}
+
+// Order along one objective.
+struct objective_less
+{
+	objective_less(const std::vector<fitness_vector> &f, fitness_vector::size_type k):m_f(f),m_k(k) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		return m_f[a][m_k] < m_f[b][m_k];
+	}
+	const std::vector<fitness_vector> &m_f;
+	fitness_vector::size_type m_k;
+};
+
+// Crowding distance of the points of a front, as in population::update_crowding_d().
+void crowding_distance(const std::vector<fitness_vector> &f, std::vector<std::size_t> I, std::vector<double> &crowd)
+{
+	const std::size_t lastidx = I.size() - 1;
+	for (fitness_vector::size_type k = 0; k < f[I[0]].size(); ++k) {
+		std::sort(I.begin(),I.end(),objective_less(f,k));
+		crowd[I[0]] = std::numeric_limits<double>::max();
+		crowd[I[lastidx]] = std::numeric_limits<double>::max();
+		const double df = f[I[lastidx]][k] - f[I[0]][k];
+		if (df == 0.0) {
+			continue;
+		}
+		for (std::size_t j = 1; j < lastidx; ++j) {
+			crowd[I[j]] += (f[I[j + 1]][k] - f[I[j - 1]][k]) / df;
+		}
+	}
+}
+
+// Pareto ranks and crowding distances of a set of fitness vectors.
+void pareto_information(const problem::base &prob, const std::vector<fitness_vector> &f, std::vector<std::size_t> &rank, std::vector<double> &crowd)
+{
+	if (prob.has_pareto_dominance()) {
+		util::non_dominated_sorting::compute_ranks(rank,f);
+	} else {
+		dominance_ranks(prob,f,rank);
+	}
+	std::vector<std::vector<std::size_t> > fronts;
+	for (std::size_t i = 0; i < f.size(); ++i) {
+		if (rank[i] >= fronts.size()) {
+			fronts.resize(rank[i] + 1);
+		}
+		fronts[rank[i]].push_back(i);
+	}
+	crowd.assign(f.size(),0.0);
+	for (std::size_t r = 0; r < fronts.size(); ++r) {
+		crowding_distance(f,fronts[r],crowd);
+	}
+}
+
+// Crowded comparison operator on the positions of a pool.
+struct crowded_less
+{
+	crowded_less(const std::vector<std::size_t> &rank, const std::vector<double> &crowd):m_rank(rank),m_crowd(crowd) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		if (m_rank[a] == m_rank[b]) {
+			return m_crowd[a] > m_crowd[b];
+		}
+		return m_rank[a] < m_rank[b];
+	}
+	const std::vector<std::size_t> &m_rank;
+	const std::vector<double> &m_crowd;
+};
+
+// Make the current vectors of an individual its best ones, as for a freshly inserted individual.
+void reset_memory(population::individual_type &ind)
+{
+	ind.best_x = ind.cur_x;
+	ind.best_f = ind.cur_f;
+	ind.best_c = ind.cur_c;
+}
+
+// Set the champion of the population from scratch.
+void update_champion(population &pop)
+{
+	const problem::base &prob = pop.problem();
+	population::champion_type champ;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		if (!i || prob.compare_fc(ind.best_f,ind.best_c,champ.f,champ.c)) {
+			champ.x = ind.best_x;
+			champ.f = ind.best_f;
+			champ.c = ind.best_c;
+		}
+	}
+	population_access::set_champion(pop,champ);
+}
+
+}
+
 /// Constructor
  /**
  * Constructs a NSGA II algorithm
@@ -51,9 +184,11 @@ namespace pagmo { namespace algorithm {
  * @param[in] eta_c Distribution index for crossover
  * @param[in] m Mutation probability
  * @param[in] eta_m Distribution index for mutation
+ * @param[in] selection selection scheme (generational or steady-state)
  * @throws value_error if gen is negative, crossover probability is not \f$ \in [0,1[\f$, mutation probability or mutation width is not \f$ \in [0,1]\f$,
  */
-nsga2::nsga2(int gen, double cr, double eta_c, double m, double eta_m):base(),m_gen(gen),m_cr(cr),m_eta_c(eta_c),m_m(m),m_eta_m(eta_m)
+nsga2::nsga2(int gen, double cr, double eta_c, double m, double eta_m, selection_type selection):base(),m_gen(gen),m_cr(cr),m_eta_c(eta_c),m_m(m),m_eta_m(eta_m),
+	m_selection(selection)
 {
 	if (gen < 0) {
 		pagmo_throw(value_error,"number of generations must be nonnegative");
@@ -70,6 +205,9 @@ nsga2::nsga2(int gen, double cr, double eta_c, double m, double eta_m):base(),m_
 	if (eta_m <1 || eta_m >= 100) {
 		pagmo_throw(value_error,"Distribution index for mutation must be in 1..100");
 	}
+	if (selection != GENERATIONAL && selection != STEADY_STATE) {
+		pagmo_throw(value_error,"unknown selection scheme");
+	}
 }
 
 /// Clone method.
@@ -78,24 +216,22 @@ base_ptr nsga2::clone() const
 	return base_ptr(new nsga2(*this));
 }
 
-pagmo::population::size_type nsga2::tournament_selection(pagmo::population::size_type idx1, pagmo::population::size_type idx2, const pagmo::population& pop) const
+std::size_t nsga2::tournament_selection(std::size_t idx1, std::size_t idx2, const std::vector<std::size_t> &rank, const std::vector<double> &crowd) const
 {
-	if (pop.get_pareto_rank(idx1) < pop.get_pareto_rank(idx2)) return idx1;
-	if (pop.get_pareto_rank(idx1) > pop.get_pareto_rank(idx2)) return idx2;
-	if (pop.get_crowding_d(idx1) > pop.get_crowding_d(idx2)) return idx1;
-	if (pop.get_crowding_d(idx1) < pop.get_crowding_d(idx2)) return idx2;
+	if (rank[idx1] < rank[idx2]) return idx1;
+	if (rank[idx1] > rank[idx2]) return idx2;
+	if (crowd[idx1] > crowd[idx2]) return idx1;
+	if (crowd[idx1] < crowd[idx2]) return idx2;
 	return ((m_drng() > 0.5) ? idx1 : idx2);
 }
 
-void nsga2::crossover(decision_vector& child1, decision_vector& child2, pagmo::population::size_type parent1_idx, pagmo::population::size_type parent2_idx,const pagmo::population& pop) const
+void nsga2::crossover(decision_vector& child1, decision_vector& child2, const decision_vector &parent1, const decision_vector &parent2, const problem::base &prob) const
 {
 
-		problem::base::size_type D = pop.problem().get_dimension();
-		problem::base::size_type Di = pop.problem().get_i_dimension();
+		problem::base::size_type D = prob.get_dimension();
+		problem::base::size_type Di = prob.get_i_dimension();
 		problem::base::size_type Dc = D - Di;
-	const decision_vector &lb = pop.problem().get_lb(), &ub = pop.problem().get_ub();
-	const decision_vector& parent1 = pop.get_individual(parent1_idx).cur_x;
-	const decision_vector& parent2 = pop.get_individual(parent2_idx).cur_x;
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	double y1,y2,yl,yu, rand, beta, alpha, betaq, c1, c2;
 	child1 = parent1;
 	child2 = parent2;
@@ -181,13 +317,13 @@ void nsga2::crossover(decision_vector& child1, decision_vector& child2, pagmo::p
 	}
 }
 
-void nsga2::mutate(decision_vector& child, const pagmo::population& pop) const
+void nsga2::mutate(decision_vector& child, const problem::base &prob) const
 {
 
-	problem::base::size_type D = pop.problem().get_dimension();
-		problem::base::size_type Di = pop.problem().get_i_dimension();
+	problem::base::size_type D = prob.get_dimension();
+		problem::base::size_type Di = prob.get_i_dimension();
 		problem::base::size_type Dc = D - Di;
-	const decision_vector &lb = pop.problem().get_lb(), &ub = pop.problem().get_ub();
+	const decision_vector &lb = prob.get_lb(), &ub = prob.get_ub();
 	double rnd, delta1, delta2, mut_pow, deltaq;
 	double y, yl, yu, val, xy;
 		int gen_num;
@@ -246,7 +382,6 @@ void nsga2::evolve(population &pop) const
 {
 	// Let's store some useful variables.
 	const problem::base &prob = pop.problem();
-	const problem::base::size_type D = prob.get_dimension();
 	const problem::base::size_type prob_c_dimension = prob.get_c_dimension();
 	const population::size_type NP = pop.size();
 
@@ -256,8 +391,8 @@ void nsga2::evolve(population &pop) const
 			pagmo_throw(value_error, "The problem is not box constrained and NSGA-II is not suitable to solve it");
 	}
 
-	if (NP < 5 || (NP % 4 != 0) ) {
-		pagmo_throw(value_error, "for NSGA-II at least 5 individuals in the population are needed and the population size must be a multiple of 4");
+	if (NP < 5 || (m_selection == GENERATIONAL && NP % 4 != 0) ) {
+		pagmo_throw(value_error, "for NSGA-II at least 5 individuals in the population are needed and, for the generational variant, the population size must be a multiple of 4");
 	}
 
 	if ( prob.get_f_dimension() < 2 ) {
@@ -269,22 +404,40 @@ void nsga2::evolve(population &pop) const
 		return;
 	}
 
-	std::vector<population::size_type> best_idx(NP), shuffle1(NP),shuffle2(NP);
-	population::size_type parent1_idx, parent2_idx;
+	if (m_selection == STEADY_STATE) {
+		evolve_steady_state(pop);
+	} else {
+		evolve_generational(pop);
+	}
+}
+
+// Generational NSGA-II on an index-based pool: positions [0,NP) are the parents, [NP,2NP) the offspring.
+void nsga2::evolve_generational(population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension();
+	const population::size_type NP = pop.size();
+
+	std::vector<population::size_type> shuffle1(NP),shuffle2(NP);
+	std::vector<std::size_t> best_idx(2 * NP), rank;
+	std::vector<double> crowd;
+	std::size_t parent1_idx, parent2_idx;
 	decision_vector child1(D), child2(D);
+	std::vector<decision_vector> offspring(NP);
+	std::vector<fitness_vector> f(NP), offspring_f, next_f(NP);
+	std::vector<population::individual_type> next(NP);
 
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle1[i] = i;
 	for (pagmo::population::size_type i=0; i< NP; i++) shuffle2[i] = i;
+	for (pagmo::population::size_type i=0; i< NP; i++) f[i] = pop.get_individual(i).cur_f;
 
 	boost::uniform_int<int> pop_idx(0,NP-1);
 	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,pop_idx);
 
 	// Main NSGA-II loop
 	for (int g = 0; g<m_gen; g++) {
-		//At each generation we make a copy of the population into popnew
-		// We compute the crowding distance and the pareto rank of pop
-		pop.update_pareto_information();
-		population popnew(pop);
+		// We compute the crowding distance and the pareto rank of the parents
+		pareto_information(prob,f,rank,crowd);
 
 		//We create some pseudo-random permutation of the poulation indexes
 		std::random_shuffle(shuffle1.begin(),shuffle1.end(),p_idx);
@@ -294,32 +447,118 @@ void nsga2::evolve(population &pop) const
 		//each create 2 new offspring
 		for (pagmo::population::size_type i=0; i< NP; i+=4) {
 			// We create two offsprings using the shuffled list 1
-			parent1_idx = tournament_selection(shuffle1[i], shuffle1[i+1],pop);
-			parent2_idx = tournament_selection(shuffle1[i+2], shuffle1[i+3],pop);
-			crossover(child1, child2, parent1_idx,parent2_idx,pop);
-			mutate(child1,pop);
-			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
+			parent1_idx = tournament_selection(shuffle1[i], shuffle1[i+1],rank,crowd);
+			parent2_idx = tournament_selection(shuffle1[i+2], shuffle1[i+3],rank,crowd);
+			crossover(child1, child2, pop.get_individual(parent1_idx).cur_x, pop.get_individual(parent2_idx).cur_x, prob);
+			mutate(child1,prob);
+			mutate(child2,prob);
+			offspring[i] = child1;
+			offspring[i+1] = child2;
 
 			// We repeat with the shuffled list 2
-			parent1_idx = tournament_selection(shuffle2[i], shuffle2[i+1],pop);
-			parent2_idx = tournament_selection(shuffle2[i+2], shuffle2[i+3],pop);
-			crossover(child1, child2, parent1_idx,parent2_idx,pop);
-			mutate(child1,pop);
-			mutate(child2,pop);
-			popnew.push_back(child1);
-			popnew.push_back(child2);
-		} // popnew now contains 2NP individuals
-
-		// This method returns the sorted N best individuals in the population according to the crowded comparison operator
-		// defined in population.cpp
-		best_idx = popnew.get_best_idx(NP);
-		// We completely cancel the population (NOTE: memory of all individuals and the notion of
-		// champion is thus destroyed)
-		pop.clear();
-		for (population::size_type i=0; i < NP; ++i) pop.push_back(popnew.get_individual(best_idx[i]).cur_x);
+			parent1_idx = tournament_selection(shuffle2[i], shuffle2[i+1],rank,crowd);
+			parent2_idx = tournament_selection(shuffle2[i+2], shuffle2[i+3],rank,crowd);
+			crossover(child1, child2, pop.get_individual(parent1_idx).cur_x, pop.get_individual(parent2_idx).cur_x, prob);
+			mutate(child1,prob);
+			mutate(child2,prob);
+			offspring[i+2] = child1;
+			offspring[i+3] = child2;
+		}
+
+		// Only the offspring are evaluated: the pool now contains 2NP fitness vectors
+		prob.objfun_batch(offspring_f,offspring);
+		f.resize(2 * NP);
+		for (pagmo::population::size_type i=0; i< NP; i++) f[NP + i].swap(offspring_f[i]);
+
+		// We sort the pool according to the crowded comparison operator and keep the N best
+		pareto_information(prob,f,rank,crowd);
+		for (std::size_t i=0; i< 2 * NP; i++) best_idx[i] = i;
+		std::sort(best_idx.begin(),best_idx.end(),crowded_less(rank,crowd));
+
+		// The survivors are moved (not copied) in the next generation, in the order of the sort
+		for (pagmo::population::size_type i=0; i< NP; i++) {
+			const std::size_t s = best_idx[i];
+			next_f[i].swap(f[s]);
+			population::individual_type &ind = next[i];
+			if (s < NP) {
+				std::swap(ind,population_access::get_individual(pop,s));
+			} else {
+				ind.cur_x.swap(offspring[s - NP]);
+				ind.cur_f = next_f[i];
+				prob.compute_constraints(ind.cur_c,ind.cur_x);
+				ind.cur_v.resize(D);
+			}
+			reset_memory(ind);
+		}
+		// Every survivor gets a new random velocity, drawn in order from the generator of the population
+		for (pagmo::population::size_type i=0; i< NP; i++) {
+			std::swap(population_access::get_individual(pop,i),next[i]);
+			population_access::init_velocity(pop,i);
+		}
+		f.swap(next_f);
+		next_f.resize(NP);
 	} // end of main SGA loop
+	update_champion(pop);
+}
+
+// Steady-state NSGA-II. The individuals live in NP + 1 slots: at each step the offspring is placed in the free slot, and the
+// slot of the worst individual becomes the free one.
+void nsga2::evolve_steady_state(population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	const problem::base::size_type D = prob.get_dimension();
+	const population::size_type NP = pop.size();
+
+	std::vector<decision_vector> x(NP + 1);
+	std::vector<fitness_vector> f(NP + 1,fitness_vector(prob.get_f_dimension()));
+	// Whether the slot holds an offspring, which must be written back to the population.
+	std::vector<char> fresh(NP + 1,0);
+	util::pareto_fronts fronts(prob.get_f_dimension(),&prob);
+	for (pagmo::population::size_type i=0; i< NP; i++) {
+		x[i] = pop.get_individual(i).cur_x;
+		f[i] = pop.get_individual(i).cur_f;
+		fronts.insert(i,f[i]);
+	}
+	std::size_t free_slot = NP;
+	decision_vector child1(D), child2(D);
+
+	boost::uniform_int<int> pop_idx(0,NP-1);
+	boost::variate_generator<boost::mt19937 &, boost::uniform_int<int> > p_idx(m_urng,pop_idx);
+
+	for (int g = 0; g<m_gen; g++) {
+		for (pagmo::population::size_type step = 0; step < NP; ++step) {
+			// Random occupied slots for the tournaments
+			std::size_t candidates[4];
+			for (int k = 0; k < 4; ++k) {
+				candidates[k] = p_idx();
+				if (candidates[k] >= free_slot) ++candidates[k];
+			}
+			const std::size_t parent1_idx = tournament_selection(candidates[0],candidates[1],fronts.get_pareto_ranks(),fronts.get_crowding_d());
+			const std::size_t parent2_idx = tournament_selection(candidates[2],candidates[3],fronts.get_pareto_ranks(),fronts.get_crowding_d());
+			crossover(child1, child2, x[parent1_idx], x[parent2_idx], prob);
+			mutate(child1,prob);
+			x[free_slot] = child1;
+			prob.objfun(f[free_slot],child1);
+			fresh[free_slot] = 1;
+			fronts.insert(free_slot,f[free_slot]);
+			free_slot = fronts.get_worst();
+			fronts.erase(free_slot);
+		}
+	}
+
+	// Slot i goes back to position i, and slot NP (if occupied) to the position of the free slot.
+	for (pagmo::population::size_type i=0; i< NP; i++) {
+		const std::size_t s = (i == free_slot) ? NP : i;
+		population::individual_type &ind = population_access::get_individual(pop,i);
+		if (fresh[s]) {
+			ind.cur_x.swap(x[s]);
+			ind.cur_f.swap(f[s]);
+			prob.compute_constraints(ind.cur_c,ind.cur_x);
+			population_access::init_velocity(pop,i);
+		}
+		reset_memory(ind);
+	}
+	update_champion(pop);
 }
 
 /// Algorithm name
@@ -339,7 +578,8 @@ std::string nsga2::human_readable_extra() const
 	s << "cr:" << m_cr << ' ';
 	s << "eta_c:" << m_eta_c << ' ';
 	s << "m:" << m_m << ' ';
-	s << "eta_m:" << m_eta_m << std::endl;
+	s << "eta_m:" << m_eta_m << ' ';
+	s << "selection:" << (m_selection == STEADY_STATE ? "STEADY_STATE" : "GENERATIONAL") << std::endl;
 
 	return s.str();
 }
@@ -25,6 +25,9 @@
 #ifndef PAGMO_ALGORITHM_NSGA2_H
 #define PAGMO_ALGORITHM_NSGA2_H
 
+#include <cstddef>
+#include <vector>
+
 #include "../config.h"
 #include "../serialization.h"
 #include "base.h"
@@ -40,6 +43,17 @@ namespace pagmo { namespace algorithm {
  *
  * The algorithm can be applied to continuous box-bounded optimization. The version for mixed integer
  * and constrained optimization is also planned.
+ *
+ * In the generational variant, parents and offspring are ranked together in an index-based pool: the parents are
+ * neither copied nor re-evaluated, and only the offspring are evaluated (with a single call to
+ * problem::base::objfun_batch() per generation). In the steady-state variant a single offspring is generated and
+ * inserted at each step, and the worst individual according to the crowded comparison operator is discarded. Ranks and
+ * crowding distances are then maintained incrementally with util::pareto_fronts. A generation of the steady-state
+ * variant consists of as many steps as there are individuals, so that both variants perform the same number of
+ * function evaluations.
+ *
+ * In both variants the memory of the individuals is not kept: after the evolution the best decision vector of each
+ * individual is its current one.
  * 
  * @see Deb, K. and Pratap, A. and Agarwal, S. and Meyarivan, T., "A fast and elitist multiobjective genetic algorithm: NSGA-II"
  *
@@ -49,7 +63,12 @@ namespace pagmo { namespace algorithm {
 class __PAGMO_VISIBLE nsga2: public base
 {
 public:
-	nsga2(int gen=100, double cr = 0.95, double eta_c = 10, double m = 0.01, double eta_m = 50);
+	/// Selection scheme
+	enum selection_type {
+		GENERATIONAL = 0, ///< The whole population is replaced at each generation
+		STEADY_STATE = 1 ///< One offspring is inserted at each step
+	};
+	nsga2(int gen=100, double cr = 0.95, double eta_c = 10, double m = 0.01, double eta_m = 50, selection_type = GENERATIONAL);
 	base_ptr clone() const;
 	void evolve(population &) const;
 	std::string get_name() const;
@@ -58,9 +77,11 @@ protected:
 	std::string human_readable_extra() const;
 	
 private:
-	pagmo::population::size_type tournament_selection(pagmo::population::size_type, pagmo::population::size_type, const pagmo::population&) const;
-	void crossover(decision_vector&, decision_vector&, pagmo::population::size_type, pagmo::population::size_type,const pagmo::population&) const;
-	void mutate(decision_vector&, const pagmo::population&) const;
+	std::size_t tournament_selection(std::size_t, std::size_t, const std::vector<std::size_t> &, const std::vector<double> &) const;
+	void crossover(decision_vector&, decision_vector&, const decision_vector &, const decision_vector &, const problem::base &) const;
+	void mutate(decision_vector&, const problem::base &) const;
+	void evolve_generational(population &) const;
+	void evolve_steady_state(population &) const;
 	
 	friend class boost::serialization::access;
 	template <class Archive>
@@ -72,6 +93,7 @@ private:
 		ar & const_cast<double &>(m_eta_c);
 		ar & const_cast<double &>(m_m);
 		ar & const_cast<double &>(m_eta_m);
+		ar & const_cast<selection_type &>(m_selection);
 	}
 	//Number of generations
 	const int m_gen;
@@ -83,6 +105,8 @@ private:
 	const double m_m;
 	// Ditribution index for mutation
 	const double m_eta_m;
+	// Selection scheme
+	const selection_type m_selection;
 
 
 };
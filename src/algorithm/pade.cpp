@@ -247,7 +247,7 @@ void pade::evolve(population &pop) const
 	
 	// We compute, for each weight vector, the neighbouring ones (this will form the topology later on)
 	std::vector<std::vector<population::size_type> > indices;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(indices, weights);
+	pagmo::util::neighbourhood::euclidian::compute_neighbours(indices, weights, m_T + 1);
 
 	// Create the archipelago of NP islands:
 	// each island in the archipelago solves a different single-objective problem.
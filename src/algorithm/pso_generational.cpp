@@ -337,14 +337,13 @@ void pso_generational::evolve(population &pop) const
 			pop.clear(); // Removes memory based on different seeds (champion and best_x, best_f, best_c)
 
 			// Re-evaluate wrt new seed the particle position and memory
+			// (the whole swarm at once, concurrently if the problem allows it)
+			prob.objfun_batch( fit, X );
+			prob.objfun_batch( lbfit, lbX );
 			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				// We re-evaluate the fitness of the particle memory
-				prob.objfun( lbfit[p], lbX[p] );
 				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
 				pop.push_back(lbX[p]);
-				pop.set_x(p,X[p]);
+				pop.set_x(p,X[p],fit[p]);
 				pop.set_v(p,V[p]);
 			}
 			//UPDATE BEST_FIT and BEST to account for the new seed
@@ -360,11 +359,10 @@ void pso_generational::evolve(population &pop) const
 		}
 		catch (const std::bad_cast& e)
 		{
-			//Only evaluate new position
+			//Only evaluate new position (the whole swarm at once, concurrently if the problem allows it)
+			prob.objfun_batch( fit, X );
 			for( p = 0; p < swarm_size; p++ ){
-				// We evaluate here the new individual fitness
-				prob.objfun( fit[p], X[p] );
-				pop.set_x(p,X[p]);
+				pop.set_x(p,X[p],fit[p]);
 				pop.set_v(p,V[p]);
 			}
 		}
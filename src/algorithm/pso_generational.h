@@ -41,6 +41,10 @@ namespace pagmo { namespace algorithm {
  * NOTE: this PSO is suitable for stochastic optimization problems. The random seed is changed at the end
  * of each generation
  *
+ * The new positions of the swarm are evaluated with a single call to problem::base::objfun_batch(), which evaluates them
+ * concurrently if the problem is thread safe and has been given more than one evaluation thread
+ * (see problem::base::set_eval_threads()). The result does not depend on the number of threads.
+ *
  * @see http://www.particleswarm.info/ for a repository of information related to PSO
  * @see http://dx.doi.org/10.1007/s11721-007-0002-0 for a recent survey
  * @see http://www.engr.iupui.edu/~shi/Coference/psopap4.html for the first paper on this algorithm
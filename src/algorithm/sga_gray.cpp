@@ -169,16 +169,12 @@ void sga_gray::evolve(population &pop) const
 			
 			// We re-evaluate the best individual (for elitism)
 			prob.objfun(bestfit,bestX);
-			// Re-evaluate wrt new seed the particle position and memory
+			///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed. The whole
+			///generation is evaluated in one batch.
+			pop.push_back(Xnew);
 			for (pagmo::population::size_type i = 0; i < NP;i++) {
-				// We evaluate here the new individual fitness
-				prob.objfun(fit[i],Xnew[i]);
-				// We update the velocity (in case coupling with PSO via archipelago)
-				//dummy = Xnew[i];
-				//std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
-				///We now set the cleared pop. cur_x is the best_x, re-evaluated with new seed.
-				pop.push_back(Xnew[i]);
-				//pop.set_v(i,dummy);
+				// We get here the new individual fitness
+				fit[i] = pop.get_individual(i).cur_f;
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
 					bestX = Xnew[i];
@@ -188,13 +184,18 @@ void sga_gray::evolve(population &pop) const
 		catch (const std::bad_cast& e)
 		{
 			//4 - Evaluate the new population (deterministic problem)
+			// Velocities are computed before the current positions get overwritten.
+			std::vector<decision_vector> V(NP,dummy);
+			std::vector<pagmo::population::size_type> idx(NP);
 			for (pagmo::population::size_type i = 0; i < NP;i++) {
-				prob.objfun(fit[i],Xnew[i]);
-				dummy = Xnew[i];
-				std::transform(dummy.begin(), dummy.end(), pop.get_individual(i).cur_x.begin(), dummy.begin(),std::minus<double>());
-				//updates x and v (cache avoids to recompute the objective function and constraints)
-				pop.set_x(i,Xnew[i]);
-				pop.set_v(i,dummy);
+				std::transform(Xnew[i].begin(), Xnew[i].end(), pop.get_individual(i).cur_x.begin(), V[i].begin(),std::minus<double>());
+				idx[i] = i;
+			}
+			//updates x, evaluating the whole generation in one batch
+			pop.set_x(idx,Xnew);
+			for (pagmo::population::size_type i = 0; i < NP;i++) {
+				fit[i] = pop.get_individual(i).cur_f;
+				pop.set_v(i,V[i]);
 				if (prob.compare_fitness(fit[i], bestfit)) {
 					bestfit = fit[i];
 					bestX = Xnew[i];
@@ -27,6 +27,7 @@
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/math/special_functions/round.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -35,6 +36,7 @@
 #include "../population.h"
 #include "../problem/base.h"
 #include "../types.h"
+#include "../util/hv_algorithm/dynamic_hv.h"
 #include "base.h"
 #include "sms_emoa.h"
 
@@ -282,8 +284,25 @@ void sms_emoa::mutate(decision_vector& child, const pagmo::population& pop) cons
 	}
 }
 
+struct sms_emoa::selection_state
+{
+	// Contributions of the tracked individuals, with respect to refpoint.
+	boost::scoped_ptr<util::hv_algorithm::dynamic_hv> hv;
+	fitness_vector refpoint;
+	// Id in hv of each individual of the population, or npos if it is not tracked.
+	std::vector<util::hv_algorithm::dynamic_hv::id_type> id_of;
+	static const util::hv_algorithm::dynamic_hv::id_type npos = static_cast<util::hv_algorithm::dynamic_hv::id_type>(-1);
+};
+
+const util::hv_algorithm::dynamic_hv::id_type sms_emoa::selection_state::npos;
+
 // Find the index of the least contributing individual
-population::size_type sms_emoa::evaluate_s_metric_selection(const population & pop) const
+//
+// Unless a specific hypervolume algorithm was requested, the contributions of the last front are kept in a dynamic
+// hypervolume structure between calls: in a steady-state scheme the front typically changes by one or two points per
+// generation, so only the contributions next to those points need to be recomputed. The structure is rebuilt when the
+// reference point moves or when most of the front changed, starting from the contributions cached by the population.
+population::size_type sms_emoa::evaluate_s_metric_selection(const population & pop, selection_state &state) const
 {
 
 	std::vector< std::vector< population::size_type> > fronts = pop.compute_pareto_fronts();
@@ -303,15 +322,63 @@ population::size_type sms_emoa::evaluate_s_metric_selection(const population & p
 			points[idx] = fitness_vector(pop.get_individual(last_front[idx]).cur_f);
 		}
 
-		pagmo::util::hypervolume hypvol(points);
-		fitness_vector r = hypvol.get_nadir_point(1.0);
+		if (m_hv_algorithm) {
+			pagmo::util::hypervolume hypvol(points);
+			fitness_vector r = hypvol.get_nadir_point(1.0);
+			return last_front[hypvol.least_contributor(r, m_hv_algorithm)];
+		}
 
-		population::size_type least_idx;
+		fitness_vector r(points[0]);
+		for (population::size_type idx = 1 ; idx < points.size() ; ++idx) {
+			for (fitness_vector::size_type f_idx = 0 ; f_idx < r.size() ; ++f_idx) {
+				r[f_idx] = std::max(r[f_idx], points[idx][f_idx]);
+			}
+		}
+		for (fitness_vector::size_type f_idx = 0 ; f_idx < r.size() ; ++f_idx) {
+			r[f_idx] += 1.0;
+		}
 
-		if (m_hv_algorithm) {
-			least_idx = hypvol.least_contributor(r, m_hv_algorithm);
+		// Individuals tracked but no longer in the last front, and individuals in the last front not yet tracked.
+		std::vector<char> in_front(pop.size(), 0);
+		population::size_type n_new = 0, n_stale = 0;
+		for (population::size_type idx = 0 ; idx < last_front.size() ; ++idx) {
+			in_front[last_front[idx]] = 1;
+			n_new += (state.id_of[last_front[idx]] == selection_state::npos);
+		}
+		for (population::size_type idx = 0 ; idx < pop.size() ; ++idx) {
+			n_stale += (state.id_of[idx] != selection_state::npos && !in_front[idx]);
+		}
+
+		if (!state.hv || r != state.refpoint || 2 * (n_new + n_stale) > last_front.size()) {
+			state.refpoint = r;
+			state.hv.reset(new util::hv_algorithm::dynamic_hv(points, r, pop.get_hv_contributions(last_front, r)));
+			std::fill(state.id_of.begin(), state.id_of.end(), selection_state::npos);
+			for (population::size_type idx = 0 ; idx < last_front.size() ; ++idx) {
+				state.id_of[last_front[idx]] = idx;
+			}
 		} else {
-			least_idx = hypvol.least_contributor(r);
+			for (population::size_type idx = 0 ; idx < pop.size() ; ++idx) {
+				if (state.id_of[idx] != selection_state::npos && !in_front[idx]) {
+					state.hv->erase(state.id_of[idx]);
+					state.id_of[idx] = selection_state::npos;
+				}
+			}
+			for (population::size_type idx = 0 ; idx < last_front.size() ; ++idx) {
+				if (state.id_of[last_front[idx]] == selection_state::npos) {
+					state.id_of[last_front[idx]] = state.hv->insert(points[idx]);
+				}
+			}
+		}
+
+		// Ties go to the first individual of the front, as with hypervolume::least_contributor.
+		population::size_type least_idx = 0;
+		double least_c = state.hv->contribution(state.id_of[last_front[0]]);
+		for (population::size_type idx = 1 ; idx < last_front.size() ; ++idx) {
+			const double c = state.hv->contribution(state.id_of[last_front[idx]]);
+			if (c < least_c) {
+				least_c = c;
+				least_idx = idx;
+			}
 		}
 
 		return last_front[least_idx];
@@ -361,6 +428,8 @@ void sms_emoa::evolve(population &pop) const
 	
 	population::size_type parent1_idx, parent2_idx;
 	decision_vector child1(D), child2(D);
+	selection_state state;
+	state.id_of.assign(NP, selection_state::npos);
 	
 	// Main SMS-EMOA loop
 	for (int g = 0; g < m_gen; g++) {
@@ -372,7 +441,14 @@ void sms_emoa::evolve(population &pop) const
 		++m_fevals;
 		mutate(child1, pop);
 		pop.push_back(child1);
-		pop.erase(evaluate_s_metric_selection(pop));
+		state.id_of.push_back(selection_state::npos);
+
+		const population::size_type worst_idx = evaluate_s_metric_selection(pop, state);
+		if (state.id_of[worst_idx] != selection_state::npos) {
+			state.hv->erase(state.id_of[worst_idx]);
+		}
+		state.id_of.erase(state.id_of.begin() + worst_idx);
+		pop.erase(worst_idx);
 	}
 }
 
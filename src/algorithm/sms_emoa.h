@@ -61,7 +61,9 @@ private:
 	void validate_parameters();
 	void crossover(decision_vector&, decision_vector&, pagmo::population::size_type, pagmo::population::size_type,const pagmo::population&) const;
 	void mutate(decision_vector&, const pagmo::population&) const;
-	population::size_type evaluate_s_metric_selection(const population & pop) const;
+	// Hypervolume contributions of the last front, carried across the generations of an evolve() call.
+	struct selection_state;
+	population::size_type evaluate_s_metric_selection(const population & pop, selection_state &) const;
 	
 	friend class boost::serialization::access;
 	template <class Archive>
@@ -38,11 +38,40 @@
 #include "../problem/base.h"
 #include "../population.h"
 #include "../util/neighbourhood.h"
+#include "../util/pareto_dominance.h"
 #include "base.h"
 #include "spea2.h"
 
 
 namespace pagmo { namespace algorithm {
+
+namespace {
+
+// Counts, for each individual, the individuals it dominates.
+struct strength_counter
+{
+	strength_counter(std::vector<int> &S):m_S(S) {}
+	void operator()(population::size_type i, population::size_type)
+	{
+		m_S[i]++;
+	}
+	std::vector<int> &m_S;
+};
+
+// Adds the strength of each individual to the raw fitness of the individuals it dominates.
+struct raw_fitness_accumulator
+{
+	raw_fitness_accumulator(const std::vector<int> &S, std::vector<double> &F):m_S(S),m_F(F) {}
+	void operator()(population::size_type i, population::size_type j)
+	{
+		m_F[j] += m_S[i];
+	}
+	const std::vector<int> &m_S;
+	std::vector<double> &m_F;
+};
+
+}
+
 /// Constructor
  /**
  * Constructs a SPEA2 algorithm
@@ -179,39 +208,19 @@ void spea2::evolve(population &pop) const
 				fit_nd[i]	=	archive[i].f;
 			}
 
-			//computing K-NN distances for K=0,...,n_non_dominated
-			std::vector<std::vector<pagmo::population::size_type> > neighbours_nd;
-			pagmo::util::neighbourhood::euclidian::compute_neighbours(neighbours_nd, fit_nd);
-			std::vector<population::size_type> rv(n_non_dominated);
-			for(unsigned int i=0; i<n_non_dominated; ++i) rv[i] = i;
-
-			while(archive.size() > archive_size) {
-
-				//Calculate which is the worst element according to the distance sorter
-				pagmo::population::size_type idx_to_delete = *(std::max_element(rv.begin(), rv.end(), distance_sorter(neighbours_nd, fit_nd)));
-
-				//Remove the element from rv, archive and fit_nd
-				rv.erase(rv.end()-1);
-				archive.erase(archive.begin() + idx_to_delete);
-				fit_nd.erase(fit_nd.begin() + idx_to_delete);
-
-				//Remove the row of neighbours_nd coresponding to idx_to_delete
-				neighbours_nd.erase(neighbours_nd.begin() + idx_to_delete);
-
-				for(unsigned int i=0; i < neighbours_nd.size(); ++i) {
-					for(unsigned int j=0; j < neighbours_nd[i].size(); ++j) {
-						//Remove all the occurencies of idx_to_delete
-						if (neighbours_nd[i][j] == idx_to_delete) {
-							neighbours_nd[i].erase(neighbours_nd[i].begin() + j);
-							j--;
-						//Adjust all the indexes after idx_to_delete
-						} else if (neighbours_nd[i][j] > idx_to_delete) {
-							neighbours_nd[i][j]--;
-						}
-					}
+			//remove one at a time the individuals closest to their nearest neighbours (ties resolved by the next nearest)
+			pagmo::util::neighbourhood::archive_truncation truncation(fit_nd);
+			while(truncation.size() > archive_size) {
+				truncation.remove_one();
+			}
+			std::vector<spea2_individual> kept;
+			kept.reserve(archive_size);
+			for(unsigned int i = 0; i < n_non_dominated; ++i) {
+				if (truncation.contains(i)) {
+					kept.push_back(archive[i]);
 				}
-
 			}
+			archive.swap(kept);
 
 		} else { //fill with the best dominated individuals
 			for(unsigned int i = 0; i < archive_size; ++i) {
@@ -349,26 +358,40 @@ void spea2::compute_spea2_fitness(std::vector<double> &F,
 		fit[i]	=	pop[i].f;
 		cons[i]	=	pop[i].c;
 	}
-	std::vector<std::vector<pagmo::population::size_type> > neighbours;
-	pagmo::util::neighbourhood::euclidian::compute_neighbours(neighbours, fit);
-
-	std::vector<std::vector<population::size_type> > domination_list = compute_domination_list(prob, fit,cons);
-
-	for(unsigned int i=0; i<NP; ++i) {
-		S[i] = domination_list[i].size();
-	}
-
+	// Strength of each individual (number of individuals it dominates), then raw fitness (sum of the strengths of the
+	// individuals dominating it). The domination relation is evaluated twice rather than stored, as it can have O(NP^2) pairs.
 	std::fill(F.begin(), F.end(), 0);
+	if (!prob.get_c_dimension() && prob.has_pareto_dominance()) {
+		const pagmo::util::pareto_dominance dominance(fit);
+		strength_counter counter(S);
+		dominance.for_each_dominance(counter);
+		raw_fitness_accumulator accumulator(S, F);
+		dominance.for_each_dominance(accumulator);
+	} else {
+		for(unsigned int i=0; i<NP; ++i) {
+			for(unsigned int j=0; j<NP; ++j) {
+				if(prob.compare_fc(fit[i],cons[i],fit[j],cons[j])) {
+					S[i]++;
+				}
+			}
+		}
 
-	for(unsigned int i=0; i<NP; ++i) {
-		for(unsigned int j=0; j<domination_list[i].size(); ++j) {
-			F[domination_list[i][j]] += S[i];
+		for(unsigned int i=0; i<NP; ++i) {
+			for(unsigned int j=0; j<NP; ++j) {
+				if(prob.compare_fc(fit[i],cons[i],fit[j],cons[j])) {
+					F[j] += S[i];
+				}
+			}
 		}
 	}
 
+	// Density: distance to the K-th nearest neighbour (the individual itself being the 0-th)
+	const pagmo::util::neighbourhood::kd_tree tree(fit);
+	std::vector<population::size_type> neighbours;
+	std::vector<double> distances;
 	for(unsigned int i=0; i<NP; ++i) {
-		F[i] = F[i] +
-				(1.0 / (pagmo::util::neighbourhood::euclidian::distance(fit[i], fit[neighbours[i][K]]) + 2));
+		tree.find_neighbours(neighbours, distances, i, K);
+		F[i] = F[i] + (1.0 / ((distances.empty() ? 0. : distances.back()) + 2));
 	}
 }
 
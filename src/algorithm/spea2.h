@@ -32,36 +32,6 @@
 
 namespace pagmo { namespace algorithm {
 
-class  distance_sorter {
-public:
-	distance_sorter(const std::vector<std::vector<pagmo::population::size_type>  > &neighbours,
-					const std::vector<fitness_vector> &fit):
-		m_neighbours(neighbours),
-		m_fit(fit) {}
-	bool operator()(unsigned int a, unsigned int b) {
-		if(a>=m_fit.size() || a>=m_neighbours.size()){
-			pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-		}
-		if(b>=m_fit.size() || b>=m_neighbours.size()){
-			pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-		}
-		double delta_a, delta_b;
-		unsigned int i = 0;
-		do{
-			if(m_neighbours[b][i]>=m_fit.size() || m_neighbours[a][i]>=m_fit.size()){
-				pagmo_throw(value_error,"SPEA2 sorting of KNN values failure");
-			}
-			delta_a = pagmo::util::neighbourhood::euclidian::distance(m_fit[a], m_fit[m_neighbours[a][i]]);
-			delta_b = pagmo::util::neighbourhood::euclidian::distance(m_fit[b], m_fit[m_neighbours[b][i]]);
-			i++;
-		} while (i<m_neighbours[0].size() && delta_a == delta_b);
-		return delta_a > delta_b;
-	}
-private:
-	const std::vector<std::vector<pagmo::population::size_type>  > &m_neighbours;
-	const std::vector<fitness_vector> &m_fit;
-};
-
 /// "Strength Pareto Evolutionary Algorithm (SPEA2)"
 /**
  *
@@ -70,7 +40,9 @@ private:
  * K-th neighbour, where \f$ K=\sqrt{pop size + archive size} \f$
  * It uses an external archive in which are stored the non dominated solutions found so far.
  * The size of the archive is kept constant throughout the run by mean of a truncation operator taking into
- * consideration the distance of each individual to its closest neighbours.
+ * consideration the distance of each individual to its closest neighbours. The neighbours are found with
+ * util::neighbourhood::kd_tree, and the truncation is performed by util::neighbourhood::archive_truncation, so
+ * that no matrix of all the pairwise distances is needed.
  *
  * @author Andrea Mambrini (andrea.mambrini@gmail.com)
  * @author Annalisa Riccardi (nina1983@gmail.com)
@@ -24,14 +24,18 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
-#include <boost/thread/barrier.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/tuple/tuple_io.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 #include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -47,6 +51,7 @@
 #include "rng.h"
 #include "topology/base.h"
 #include "topology/unconnected.h"
+#include "util/thread_pool.h"
 
 namespace pagmo {
 
@@ -65,9 +70,9 @@ void archipelago::check_migr_attributes() const
  * @param[in] dt distribution type.
  * @param[in] md migration direction.
  */
-archipelago::archipelago(distribution_type dt, migration_direction md):m_islands_sync_point(),m_topology(new topology::unconnected()),
+archipelago::archipelago(distribution_type dt, migration_direction md):m_topology(new topology::unconnected()),
 	m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_slots(),m_urng(rng_generator::get<rng_uint32>()),m_migr_hist_count(0),m_pool_size(0),m_pool()
 {
 	check_migr_attributes();
 }
@@ -82,8 +87,8 @@ archipelago::archipelago(distribution_type dt, migration_direction md):m_islands
  * @param[in] md migration direction.
  */
 archipelago::archipelago(const topology::base &t, distribution_type dt, migration_direction md):
-	m_islands_sync_point(),m_topology(),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_topology(),m_dist_type(dt),m_migr_dir(md),
+	m_slots(),m_urng(rng_generator::get<rng_uint32>()),m_migr_hist_count(0),m_pool_size(0),m_pool()
 {
 	// NOTE: we cannot set the topology in the initialiser list directly,
 	// since we do not know if the topology is suitable. Set it here.
@@ -105,8 +110,8 @@ archipelago::archipelago(const topology::base &t, distribution_type dt, migratio
  * @param[in] md migration direction.
  */
 archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n, int m, const topology::base &t, distribution_type dt, migration_direction md):
-	m_islands_sync_point(),m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
-	m_migr_map(),m_drng(rng_generator::get<rng_double>()),m_urng(rng_generator::get<rng_uint32>()),m_migr_mutex()
+	m_topology(new topology::unconnected()),m_dist_type(dt),m_migr_dir(md),
+	m_slots(),m_urng(rng_generator::get<rng_uint32>()),m_migr_hist_count(0),m_pool_size(0),m_pool()
 {
 	check_migr_attributes();
 	for (size_type i = 0; i < boost::numeric_cast<size_type>(n); ++i) {
@@ -123,7 +128,7 @@ archipelago::archipelago(const algorithm::base &a, const problem::base &p, int n
  *
  * @param[in] a archipelago to be copied.
  */
-archipelago::archipelago(const archipelago &a)
+archipelago::archipelago(const archipelago &a):m_migr_hist_count(0),m_pool_size(a.m_pool_size),m_pool()
 {
 	a.join();
 	// Deep copy from islands pointers.
@@ -134,10 +139,11 @@ archipelago::archipelago(const archipelago &a)
 	m_topology = a.m_topology->clone();
 	m_dist_type = a.m_dist_type;
 	m_migr_dir = a.m_migr_dir;
-	m_migr_map = a.m_migr_map;
-	m_drng = a.m_drng;
+	for (size_type i = 0; i < a.m_slots.size(); ++i) {
+		m_slots.push_back(migration_slot_ptr(new migration_slot(*a.m_slots[i])));
+	}
 	m_urng = a.m_urng;
-	m_migr_hist = a.m_migr_hist;
+	m_migr_hist_count = a.m_migr_hist_count.load();
 }
 
 /// Assignment operator.
@@ -162,10 +168,13 @@ archipelago &archipelago::operator=(const archipelago &a)
 		m_topology = a.m_topology->clone();
 		m_dist_type = a.m_dist_type;
 		m_migr_dir = a.m_migr_dir;
-		m_migr_map = a.m_migr_map;
-		m_drng = a.m_drng;
+		m_slots.clear();
+		for (size_type i = 0; i < a.m_slots.size(); ++i) {
+			m_slots.push_back(migration_slot_ptr(new migration_slot(*a.m_slots[i])));
+		}
 		m_urng = a.m_urng;
-		m_migr_hist = a.m_migr_hist;
+		m_migr_hist_count = a.m_migr_hist_count.load();
+		set_pool_size(a.m_pool_size);
 	}
 	return *this;
 }
@@ -227,6 +236,7 @@ void archipelago::push_back(const base_island &isl)
 	m_container.back()->m_archi = this;
 	// Insert the island in the topology.
 	m_topology->push_back();
+	push_back_slot();
 }
 
 /// Set island algorithm.
@@ -360,15 +370,6 @@ bool archipelago::check_island(const base_island &isl) const
 	return true;
 }
 
-// Reset island synchronisation barrier. This method is intended as a shortcut,
-// do NOT use it if the archipelago has not been joined!
-void archipelago::reset_barrier(const size_type &size)
-{
-	if (size) {
-		m_islands_sync_point.reset(new boost::barrier(boost::numeric_cast<unsigned int>(size)));
-	}
-}
-
 // Return true if all islands in the archipelago have a m_archi pointer to this and the shared pointer count is 1, false otherwise. Used for debugging.
 bool archipelago::destruction_checks() const
 {
@@ -425,8 +426,93 @@ void archipelago::reevaluate_immigrants(std::vector<std::pair<population::size_t
  * @param[in] seed Seed for generating pseudo-random sequences
  */
 void archipelago::set_seeds(unsigned int seed) {
-	m_drng.seed(seed);
-	m_urng.seed(seed+1); // we do not care if it overflows
+	m_urng.seed(seed);
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		m_slots[i]->m_drng.seed(m_urng());
+		m_slots[i]->m_urng.seed(m_urng());
+	}
+}
+
+// Constructor of a migration slot with empty inbox and outbox, from the seeds of its rngs.
+archipelago::migration_slot::migration_slot(unsigned int dseed, unsigned int useed):
+	m_inbox(inbox_capacity),m_dropped(0),m_outbox(),m_drng(dseed),m_urng(useed),m_hist()
+{}
+
+// Deep copy of a migration slot. Must not be called while the slot is being used for migration.
+archipelago::migration_slot::migration_slot(const migration_slot &other):
+	m_inbox(other.m_inbox.get_capacity()),m_dropped(other.m_dropped.load()),m_outbox(other.m_outbox),m_drng(other.m_drng),
+	m_urng(other.m_urng),m_hist(other.m_hist)
+{
+	// The individuals in the parcels are immutable, so they can be shared with other.
+	std::vector<parcel> parcels;
+	other.m_inbox.copy_to(parcels);
+	for (std::vector<parcel>::iterator it = parcels.begin(); it != parcels.end(); ++it) {
+		deliver(*it);
+	}
+}
+
+// Put a parcel in the inbox, counting it as dropped if the inbox is full. Can be called concurrently.
+void archipelago::migration_slot::deliver(parcel &p)
+{
+	if (!m_inbox.push(p)) {
+		m_dropped.fetch_add(1,boost::memory_order_relaxed);
+	}
+}
+
+// Append the migration slot of a new island.
+void archipelago::push_back_slot()
+{
+	const unsigned int dseed = m_urng(), useed = m_urng();
+	m_slots.push_back(migration_slot_ptr(new migration_slot(dseed,useed)));
+}
+
+// Build the migration database in the format used for serialization. Must not be called during evolution.
+archipelago::migration_map_type archipelago::get_migration_map() const
+{
+	migration_map_type retval;
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		switch (m_migr_dir) {
+			case source:
+			{
+				std::vector<parcel> parcels;
+				m_slots[i]->m_inbox.copy_to(parcels);
+				for (std::vector<parcel>::const_iterator it = parcels.begin(); it != parcels.end(); ++it) {
+					std::vector<individual_type> &inds = retval[i][it->m_src];
+					inds.insert(inds.end(),it->m_individuals->begin(),it->m_individuals->end());
+				}
+				break;
+			}
+			case destination:
+				if (m_slots[i]->m_outbox) {
+					retval[i][i] = *m_slots[i]->m_outbox;
+				}
+		}
+	}
+	return retval;
+}
+
+// Fill the migration slots from a migration database in the format used for serialization.
+void archipelago::set_migration_map(const migration_map_type &migr_map)
+{
+	for (migration_map_type::const_iterator it = migr_map.begin(); it != migr_map.end(); ++it) {
+		if (it->first >= m_slots.size()) {
+			pagmo_throw(value_error,"invalid island index in the migration database");
+		}
+		for (boost::unordered_map<size_type,std::vector<individual_type> >::const_iterator it2 = it->second.begin();
+			it2 != it->second.end(); ++it2)
+		{
+			switch (m_migr_dir) {
+				case source:
+				{
+					parcel p = {it2->first,individuals_ptr(new std::vector<individual_type>(it2->second))};
+					m_slots[it->first]->deliver(p);
+					break;
+				}
+				case destination:
+					m_slots[it->first]->m_outbox = individuals_ptr(new std::vector<individual_type>(it2->second));
+			}
+		}
+	}
 }
 
 
@@ -443,29 +529,26 @@ void archipelago::pre_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	migration_slot &slot = *m_slots[isl_idx];
 	//1. Obtain immigrants.
 	std::vector<std::pair<population::size_type, individual_type> > immigrants;
 	switch (m_migr_dir) {
 		case source:
 		{
-			lock_type lock(m_migr_mutex);
-			// For source migration direction, migration map contains islands' "inboxes". Or, in other words, it contains
-			// the individuals that are destined to go into the island. Such inboxes have been assembled previously,
-			// during a post_evolution operation.
-			// Iterate over all the vectors of individuals provided by the different islands.
-			for (boost::unordered_map<size_type,std::vector<individual_type> >::iterator it = m_migr_map[isl_idx].begin();
-				it != m_migr_map[isl_idx].end(); ++it)
-			{
-				pagmo_assert(it->first < m_container.size());
-				build_immigrants_vector(immigrants,*m_container[it->first],isl,it->second);
+			// For source migration direction, the island's inbox contains the individuals that are destined to go into
+			// the island. They have been posted previously by other islands, during a post_evolution operation.
+			// Take all the parcels out of the inbox and iterate over them.
+			std::vector<parcel> parcels;
+			slot.m_inbox.pop_all(parcels);
+			for (std::vector<parcel>::const_iterator it = parcels.begin(); it != parcels.end(); ++it) {
+				pagmo_assert(it->m_src < m_container.size());
+				build_immigrants_vector(immigrants,*m_container[it->m_src],isl,*it->m_individuals);
 			}
-			// Delete stuff in the migration map.
-			m_migr_map.erase(isl_idx);
 			break;
 		}
 		case destination:
-			// For destination migration direction, items in the migration map behave like "outboxes", i.e. each one is a
-			// "database of best individuals" seen in the islands of the archipelago.
+			// For destination migration direction, islands' outboxes are "databases of best individuals" seen in the islands
+			// of the archipelago.
 			// Get neighbours connecting into isl.
 			const std::vector<topology::base::vertices_size_type> inv_adj_islands(m_topology->get_v_inv_adjacent_vertices(boost::numeric_cast<topology::base::vertices_size_type>(isl_idx)));
 			// Do something only if there are adjacent islands.
@@ -473,32 +556,33 @@ void archipelago::pre_evolution(base_island &isl)
 				switch (m_dist_type) {
 					case point_to_point:
 					{
-						lock_type lock(m_migr_mutex);
 						// Get the index of a random island connecting into isl.
 						boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,inv_adj_islands.size() - 1);
-						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(m_urng)]);
-						// Get the immigrants from the outbox of the random island. Note the redundant information in the last
-						// argument of the function.
-						pagmo_assert(m_migr_map[rn_isl_idx].size() <= 1);
-
-						double next_rng = m_drng();
+						const size_type rn_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[u_int(slot.m_urng)]);
+						double next_rng = slot.m_drng();
 						double migr_prob = m_topology->get_weight(rn_isl_idx, isl_idx);
 						if (next_rng < migr_prob) {
-							build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,m_migr_map[rn_isl_idx][rn_isl_idx]);
+							// Get the immigrants from the outbox of the random island. The snapshot we get stays valid even
+							// if the island publishes new emigrants in the meantime.
+							const individuals_ptr outbox(boost::atomic_load(&m_slots[rn_isl_idx]->m_outbox));
+							if (outbox) {
+								build_immigrants_vector(immigrants,*m_container[rn_isl_idx],isl,*outbox);
+							}
 						}
 						break;
 					}
 					case broadcast:
 					{
-						lock_type lock(m_migr_mutex);
 						// For broadcast migration fetch immigrants from all neighbour islands' databases.
 						for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < inv_adj_islands.size(); ++i) {
 							const size_type src_isl_idx = boost::numeric_cast<size_type>(inv_adj_islands[i]);
-							pagmo_assert(m_migr_map[src_isl_idx].size() <= 1);
-							double next_rng = m_drng();
+							double next_rng = slot.m_drng();
 							double migr_prob = m_topology->get_weight(src_isl_idx, isl_idx);
 							if (next_rng < migr_prob) {
-								build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,m_migr_map[src_isl_idx][src_isl_idx]);
+								const individuals_ptr outbox(boost::atomic_load(&m_slots[src_isl_idx]->m_outbox));
+								if (outbox) {
+									build_immigrants_vector(immigrants,*m_container[src_isl_idx],isl,*outbox);
+								}
 							}
 						}
 					}
@@ -514,13 +598,13 @@ void archipelago::pre_evolution(base_island &isl)
 		// We then insert the incoming individuals into the population, storing how many from where
 		std::vector<std::pair<population::size_type, size_type> > rec_history;
 		rec_history = isl.accept_immigrants(immigrants);
-		lock_type lock(m_migr_mutex);
-		// Record the migration history.
+		// Record the migration history in the island's own buffer. The sequence numbers allow to merge the
+		// buffers in chronological order.
 		for (size_t i =0; i< rec_history.size(); ++i) {
-			m_migr_hist.push_back( boost::make_tuple(
+			slot.m_hist.push_back(std::make_pair(m_migr_hist_count++,boost::make_tuple(
 				rec_history[i].first,
 				rec_history[i].second,
-				isl_idx)
+				isl_idx))
 			);
 		}
 	}
@@ -538,6 +622,7 @@ void archipelago::post_evolution(base_island &isl)
 	// Determine the island's index in the archipelago.
 	const size_type isl_idx = locate_island(isl);
 	pagmo_assert(isl_idx < m_container.size());
+	migration_slot &slot = *m_slots[isl_idx];
 	// Create the vector of emigrants.
 	std::vector<individual_type> emigrants;
 	switch (m_migr_dir) {
@@ -549,32 +634,33 @@ void archipelago::post_evolution(base_island &isl)
 				emigrants = isl.get_emigrants();
 				// Do something only if we have emigrants.
 				if (emigrants.size()) {
+					// The emigrants are swapped into a single immutable vector shared by all the parcels.
+					const boost::shared_ptr<std::vector<individual_type> > shared_emigrants(new std::vector<individual_type>());
+					shared_emigrants->swap(emigrants);
 					switch (m_dist_type)
 					{
 						case point_to_point:
 						{
-							lock_type lock(m_migr_mutex);
 							// For one-to-one migration choose a random neighbour island and put immigrants to its inbox.
 							boost::uniform_int<std::vector<topology::base::vertices_size_type>::size_type> u_int(0,adj_islands.size() - 1);
-							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(m_urng)]);
-							double next_rng = m_drng();
+							const size_type chosen_adj = boost::numeric_cast<size_type>(adj_islands[u_int(slot.m_urng)]);
+							double next_rng = slot.m_drng();
 							double migr_prob = m_topology->get_weight(isl_idx, chosen_adj);
 							if (next_rng < migr_prob) {
-								m_migr_map[chosen_adj][isl_idx].insert(m_migr_map[chosen_adj][isl_idx].end(),emigrants.begin(),emigrants.end());
+								parcel p = {isl_idx,shared_emigrants};
+								m_slots[chosen_adj]->deliver(p);
 							}
 							break;
 						}
 						case broadcast:
 						{
-							lock_type lock(m_migr_mutex);
 							// For broadcast migration put immigrants to all neighbour islands' inboxes.
 							for (std::vector<topology::base::vertices_size_type>::size_type i = 0; i < adj_islands.size(); ++i) {
-								double next_rng = m_drng();
+								double next_rng = slot.m_drng();
 								double migr_prob = m_topology->get_weight(isl_idx, adj_islands[i]);
 								if (next_rng < migr_prob) {
-									m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx]
-										.insert(m_migr_map[boost::numeric_cast<size_type>(adj_islands[i])][isl_idx].end(),
-										emigrants.begin(),emigrants.end());
+									parcel p = {isl_idx,shared_emigrants};
+									m_slots[boost::numeric_cast<size_type>(adj_islands[i])]->deliver(p);
 								}
 							}
 						}
@@ -587,28 +673,149 @@ void archipelago::post_evolution(base_island &isl)
 		{
 			// For destination migration direction, migration map behaves like "outboxes", i.e. each is a "database of best individuals" for corresponding island.
 			emigrants = isl.get_emigrants();
-			lock_type lock(m_migr_mutex);
-			pagmo_assert(m_migr_map[isl_idx].size() <= 1);
-			m_migr_map[isl_idx][isl_idx].swap(emigrants);
+			// Publish the new outbox: islands still reading the old one keep their snapshot alive.
+			const boost::shared_ptr<std::vector<individual_type> > outbox(new std::vector<individual_type>());
+			outbox->swap(emigrants);
+			boost::atomic_store(&slot.m_outbox,individuals_ptr(outbox));
+		}
+	}
+}
+
+// State of an evolution of some of the islands, shared by the tasks running it.
+struct archipelago::evolution_run
+{
+	evolution_run(const std::vector<size_type> &islands, std::size_t n, const boost::posix_time::time_duration &t):
+		m_islands(islands),m_deps(islands.size()),m_dependents(islands.size()),m_completed(islands.size()),
+		m_scheduled(islands.size()),m_start(islands.size()),m_n(n),m_t(t)
+	{
+		for (size_type i = 0; i < islands.size(); ++i) {
+			m_completed[i] = 0;
+			m_scheduled[i] = 0;
+		}
+	}
+	// Indices in the archipelago of the evolving islands. All the other vectors are indexed by position in m_islands.
+	const std::vector<size_type>			m_islands;
+	// Islands each island receives migrants from, and islands receiving migrants from each island.
+	std::vector<std::vector<size_type> >		m_deps;
+	std::vector<std::vector<size_type> >		m_dependents;
+	// Number of completed and scheduled evolutions. The count of completed evolutions of an island that has finished
+	// evolving is set to the maximum value, so that it never delays the other islands.
+	std::vector<boost::atomic<std::size_t> >		m_completed;
+	std::vector<boost::atomic<std::size_t> >		m_scheduled;
+	// Time at which each island started evolving.
+	std::vector<boost::posix_time::ptime>		m_start;
+	// Maximum number of evolutions, and minimum evolution time.
+	const std::size_t				m_n;
+	const boost::posix_time::time_duration		m_t;
+};
+
+// Evolve the islands with the given indices on the pool, until each one has either performed n evolutions or evolved
+// for at least t (but at least once). Must be called with the archipelago joined.
+void archipelago::start_evolution(const std::vector<size_type> &islands, std::size_t n, std::size_t t)
+{
+	if (!m_pool) {
+		m_pool.reset(new util::work_stealing_pool(m_pool_size));
+	}
+	const boost::posix_time::time_duration t_evo = (t == std::numeric_limits<std::size_t>::max()) ?
+		boost::posix_time::time_duration(boost::posix_time::pos_infin) : boost::posix_time::milliseconds(boost::numeric_cast<long>(t));
+	const evolution_run_ptr run(new evolution_run(islands,n,t_evo));
+	// Build the dependencies among the evolving islands from the topology.
+	std::vector<size_type> pos(m_container.size(),islands.size());
+	for (size_type i = 0; i < islands.size(); ++i) {
+		pos[islands[i]] = i;
+	}
+	for (size_type i = 0; i < islands.size(); ++i) {
+		const std::vector<topology::base::vertices_size_type> inv_adj(m_topology->get_v_inv_adjacent_vertices(
+			boost::numeric_cast<topology::base::vertices_size_type>(islands[i])));
+		for (std::vector<topology::base::vertices_size_type>::size_type j = 0; j < inv_adj.size(); ++j) {
+			const size_type src = pos[boost::numeric_cast<size_type>(inv_adj[j])];
+			if (src != islands.size() && src != i) {
+				run->m_deps[i].push_back(src);
+				run->m_dependents[src].push_back(i);
+			}
+		}
+	}
+	for (size_type i = 0; i < islands.size(); ++i) {
+		m_container[islands[i]]->task_start();
+	}
+	if (!n) {
+		for (size_type i = 0; i < islands.size(); ++i) {
+			m_container[islands[i]]->task_done();
+		}
+		return;
+	}
+	for (size_type i = 0; i < islands.size(); ++i) {
+		try_schedule(run,i);
+	}
+}
+
+// Submit the next evolution of the island at position i in run, if it is ready to start. Any number of threads can call this
+// concurrently: the compare-and-swap on the count of scheduled evolutions makes sure that the evolution is submitted only once.
+void archipelago::try_schedule(const evolution_run_ptr &run, size_type i)
+{
+	std::size_t k = run->m_scheduled[i];
+	// The previous evolution must be over (and the island must not have finished evolving).
+	if (run->m_completed[i] != k) {
+		return;
+	}
+	for (std::vector<size_type>::const_iterator it = run->m_deps[i].begin(); it != run->m_deps[i].end(); ++it) {
+		if (run->m_completed[*it] < k) {
+			return;
 		}
 	}
+	if (run->m_scheduled[i].compare_exchange_strong(k,k + 1)) {
+		m_pool->submit(boost::bind(&archipelago::run_step,this,run,i));
+	}
+}
+
+// Task performing an evolution of the island at position i in run, and scheduling the evolutions it was holding back.
+void archipelago::run_step(const evolution_run_ptr &run, size_type i)
+{
+	base_island &isl = *m_container[run->m_islands[i]];
+	const std::size_t k = run->m_completed[i];
+	if (!k) {
+		run->m_start[i] = boost::posix_time::microsec_clock::local_time();
+	}
+	const bool successful = isl.task_step();
+	const boost::posix_time::time_duration diff = boost::posix_time::microsec_clock::local_time() - run->m_start[i];
+	const bool finished = !successful || k + 1 == run->m_n || isl.task_interrupted() || (!diff.is_negative() && diff >= run->m_t);
+	if (finished) {
+		// We must take care of potentially low-accuracy clocks, where the time difference could be negative for
+		// _really_ short evolution times. In that case do not add anything to the total evolution time.
+		if (!diff.is_negative()) {
+			isl.m_evo_time += boost::numeric_cast<std::size_t>(diff.total_milliseconds());
+		}
+		run->m_completed[i] = std::numeric_limits<std::size_t>::max();
+	} else {
+		run->m_completed[i] = k + 1;
+		try_schedule(run,i);
+	}
+	for (std::vector<size_type>::const_iterator it = run->m_dependents[i].begin(); it != run->m_dependents[i].end(); ++it) {
+		try_schedule(run,*it);
+	}
+	// NOTE: this must be the last access to the archipelago, which can be destroyed as soon as all its islands are done.
+	if (finished) {
+		isl.task_done();
+	}
 }
 
 /// Run the evolution for the given number of iterations.
 /**
- * Will iteratively call island::evolve(n) on each island of the archipelago and then return.
+ * Will evolve n times each island of the archipelago, on the threads of the pool, and then return without waiting for the evolution to end.
  *
  * \param[in] n number of time each island will be evolved.
+ *
+ * @throws boost::numeric::bad_numeric_cast if n is negative.
  */
 void archipelago::evolve(int n)
 {
 	join();
-	const iterator it_f = m_container.end();
-	// Reset thread barrier.
-	reset_barrier(m_container.size());
-	for (iterator it = m_container.begin(); it != it_f; ++it) {
-		(*it)->evolve(n);
+	const std::size_t n_evo = boost::numeric_cast<std::size_t>(n);
+	std::vector<size_type> islands(m_container.size());
+	for (size_type i = 0; i < islands.size(); ++i) {
+		islands[i] = i;
 	}
+	start_evolution(islands,n_evo,std::numeric_limits<std::size_t>::max());
 }
 
 /// Run the evolution for the given number of iterations in batches
@@ -639,15 +846,13 @@ void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 		std::random_shuffle(pop_order.begin(), pop_order.end(), p_idx);
 	}
 	
+	const std::size_t n_evo = boost::numeric_cast<std::size_t>(n);
 	for(size_type p = 0; p < arch_size/b + 1; ++p) {
-		if(p == arch_size/b) { //for the last batch of islands decrease the barrier
-			reset_barrier(arch_size - p*b);
-		} else {
-			reset_barrier(b);
-		}
+		std::vector<size_type> batch;
 		for(size_type i=0; i<b && p*b+i < arch_size; ++i) {
-			m_container[pop_order[p*b+i]]->evolve(n);
+			batch.push_back(pop_order[p*b+i]);
 		}
+		start_evolution(batch,n_evo,std::numeric_limits<std::size_t>::max());
 		for(size_type i=0; i<b && p*b+i < arch_size; ++i) {
 			m_container[pop_order[p*b+i]]->join();
 		}
@@ -656,18 +861,48 @@ void archipelago::evolve_batch(int n, unsigned int b, bool randomize)
 
 /// Run the evolution for a minimum amount of time.
 /**
- * Will iteratively call island::evolve_t(n) on each island of the archipelago and then return.
+ * Will evolve each island of the archipelago at least once and until at least t milliseconds have elapsed, on the threads of the pool,
+ * and then return without waiting for the evolution to end.
  *
  * \param[in] t amount of time to evolve each island (in milliseconds).
+ *
+ * @throws boost::numeric::bad_numeric_cast if t is negative.
  */
 void archipelago::evolve_t(int t)
 {
 	join();
-	const iterator it_f = m_container.end();
-	reset_barrier(m_container.size());
-	for (iterator it = m_container.begin(); it != it_f; ++it) {
-		(*it)->evolve_t(t);
+	const std::size_t t_evo = boost::numeric_cast<std::size_t>(t);
+	std::vector<size_type> islands(m_container.size());
+	for (size_type i = 0; i < islands.size(); ++i) {
+		islands[i] = i;
 	}
+	start_evolution(islands,std::numeric_limits<std::size_t>::max(),t_evo);
+}
+
+/// Set the size of the thread pool.
+/**
+ * Set the number of threads used to evolve the islands. The default value of zero selects the number of hardware threads
+ * available on the machine. Note that islands whose evolution blocks while waiting for remote computations (e.g., mpi_island)
+ * occupy a thread of the pool meanwhile, so that a pool at least as large as the number of such islands might be desirable.
+ *
+ * @param[in] n number of threads.
+ */
+void archipelago::set_pool_size(unsigned int n)
+{
+	join();
+	if (n != m_pool_size) {
+		m_pool.reset(0);
+		m_pool_size = n;
+	}
+}
+
+/// Get the size of the thread pool.
+/**
+ * @return the number of threads used to evolve the islands.
+ */
+unsigned int archipelago::get_pool_size() const
+{
+	return m_pool_size ? m_pool_size : util::thread_pool::default_size();
 }
 
 /// Query the status of the archipelago.
@@ -755,13 +990,6 @@ std::vector<base_island_ptr> archipelago::get_islands() const
 	return retval;
 }
 
-// Synchronise the start of evolution in each island so that all threads are created and initialised
-// before actually doing any computation.
-void archipelago::sync_island_start() const
-{
-	m_islands_sync_point->wait();
-}
-
 /// Dumps the archipelago migration history
 /**
  * @return A string formatted as follows: (x1,y1,z1)\n(x2,y2,z2)..... where x is the number of individuals
@@ -770,11 +998,16 @@ void archipelago::sync_island_start() const
 std::string archipelago::dump_migr_history() const
 {
 	join();
+	// Merge the histories of the islands, ordering the items by sequence number.
+	std::map<std::size_t,migr_hist_item> hist;
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		hist.insert(m_slots[i]->m_hist.begin(),m_slots[i]->m_hist.end());
+	}
 	std::ostringstream oss;
-	for (migr_hist_type::const_iterator it = m_migr_hist.begin(); it != m_migr_hist.end(); ++it) {
-		oss << "(" << (*it).get<0>()
-			<< "," << (*it).get<1>()
-			<< "," << (*it).get<2>() << ")"
+	for (std::map<std::size_t,migr_hist_item>::const_iterator it = hist.begin(); it != hist.end(); ++it) {
+		oss << "(" << it->second.get<0>()
+			<< "," << it->second.get<1>()
+			<< "," << it->second.get<2>() << ")"
 			<< '\n';
 	}
 	return oss.str();
@@ -783,12 +1016,33 @@ std::string archipelago::dump_migr_history() const
 /// Clears the archipelago migration history
 /**
  * @return Empties the migration history. If dump_migr_history is called immediately after, 
- * it will return an empty string
+ * it will return an empty string. The count of dropped migrations is reset as well.
  */
 void archipelago::clear_migr_history()
 {
 	join();
-	m_migr_hist.clear();
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		m_slots[i]->m_hist.clear();
+		m_slots[i]->m_dropped.store(0);
+	}
+}
+
+/// Number of dropped migrations.
+/**
+ * In source migration, the individuals sent to an island wait in its inbox until its next evolution. An inbox holds
+ * at most 1024 parcels of individuals (e.g., when an island receives from many neighbours that evolve much faster than
+ * itself): the parcels sent to a full inbox are discarded and do not appear in the migration history.
+ *
+ * @return the number of parcels discarded since the construction of the archipelago or the last call to clear_migr_history().
+ */
+std::size_t archipelago::get_dropped_migrations() const
+{
+	join();
+	std::size_t retval = 0;
+	for (size_type i = 0; i < m_slots.size(); ++i) {
+		retval += m_slots[i]->m_dropped.load();
+	}
+	return retval;
 }
 
 /// Overload stream operator for pagmo::archipelago.
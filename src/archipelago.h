@@ -25,13 +25,13 @@
 #ifndef PAGMO_ARCHIPELAGO_H
 #define PAGMO_ARCHIPELAGO_H
 
+#include <boost/atomic.hpp>
 #include <boost/scoped_ptr.hpp>
-#include <boost/thread/barrier.hpp>
-#include <boost/thread/locks.hpp>
-#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/serialization/map.hpp>
 #include <boost/unordered_map.hpp>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -46,11 +46,23 @@
 #include "serialization.h"
 #include "topology/base.h"
 #include "topology/unconnected.h"
+#include "util/mpsc_queue.h"
+#include "util/work_stealing_pool.h"
 
 namespace pagmo {
 
 /// Archipelago class.
 /**
+ * \section archipelago_evolution Evolution
+ *
+ * The islands of an archipelago are not evolved in threads of their own. Each call to the islands' perform_evolution() (together
+ * with the migration taking place before and after it) is a task, executed by a fixed-size work-stealing pool of threads owned by the
+ * archipelago (see set_pool_size()). The threads are created at the first evolution and reused by the following ones.
+ *
+ * The tasks of the islands are ordered by the topology: the k-th evolution of an island starts only after the islands it receives
+ * migrants from have completed their (k-1)-th evolution (or have finished evolving). Neighbouring islands thus never drift apart
+ * by more than one evolution, however many islands share the threads of the pool.
+ *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
  */
@@ -109,17 +121,45 @@ class __PAGMO_VISIBLE archipelago
 		// Iterators.
 		typedef container_type::iterator iterator;
 		typedef container_type::const_iterator const_iterator;
-		// Container for migrating individuals. This a hash map containing hash maps as values.
+		// Serialized form of the migration database. This a hash map containing hash maps as values.
 		// Please NOTE carefully: in case of desination migration, item n in the outer hash map is supposed to contain a hash map with a single
 		// (n,emigrants vector) pair (in other words, containing redundantly n twice). In case of source migration, item n will contain a map of
 		// emigrants from other islands.
 		typedef boost::unordered_map<size_type,boost::unordered_map<size_type,std::vector<individual_type> > > migration_map_type;
-		// Lock type.
-		typedef boost::lock_guard<boost::mutex> lock_type;
+		// Migrating individuals. They are never modified once posted, so that they can be shared by several islands without copies.
+		typedef boost::shared_ptr<const std::vector<individual_type> > individuals_ptr;
+		// Individuals sent by island m_src into the inbox of another island (source migration).
+		struct parcel
+		{
+			size_type	m_src;
+			individuals_ptr	m_individuals;
+		};
 		// Migration history item: (n_individuals,orig_island,dest_island) tuple.
 		typedef boost::tuple<population::size_type,size_type,size_type> migr_hist_item;
 		// Container of migration history: vector of history items.
 		typedef std::vector<migr_hist_item> migr_hist_type;
+		// Migration state of an island. The inbox is filled by the islands connecting into the island, while the outbox
+		// is read by them: both are accessed without locks. Everything else is accessed only by the thread evolving the island.
+		struct migration_slot
+		{
+			migration_slot(unsigned int, unsigned int);
+			migration_slot(const migration_slot &);
+			void deliver(parcel &);
+			// Inbox of source migration.
+			util::mpsc_queue<parcel>					m_inbox;
+			// Number of parcels discarded because the inbox was full.
+			boost::atomic<std::size_t>					m_dropped;
+			// Best individuals of the island (destination migration), read and written through boost::atomic_load()/atomic_store().
+			individuals_ptr							m_outbox;
+			// Rngs used during migration.
+			rng_double							m_drng;
+			rng_uint32							m_urng;
+			// Migration history of the island, as (sequence number,history item) pairs.
+			std::vector<std::pair<std::size_t,migr_hist_item> >		m_hist;
+		};
+		typedef boost::shared_ptr<migration_slot> migration_slot_ptr;
+		// Maximum number of parcels waiting in an inbox. Parcels sent to a full inbox are discarded and counted.
+		static const std::size_t inbox_capacity = 1024;
 	public:
 		explicit archipelago(distribution_type = point_to_point, migration_direction = destination);
 		explicit archipelago(const topology::base &, distribution_type = point_to_point, migration_direction = destination);
@@ -145,23 +185,32 @@ class __PAGMO_VISIBLE archipelago
 		void interrupt();
 		std::string dump_migr_history() const;
 		void clear_migr_history();
+		std::size_t get_dropped_migrations() const;
 		void set_island(const size_type &, const base_island &);
 		std::vector<base_island_ptr> get_islands() const;
 		base_island_ptr get_island(const size_type &) const;
 		void set_seeds(unsigned int);
+		void set_pool_size(unsigned int);
+		unsigned int get_pool_size() const;
 	private:
+		struct evolution_run;
+		typedef boost::shared_ptr<evolution_run> evolution_run_ptr;
 		void pre_evolution(base_island &);
 		void post_evolution(base_island &);
-		void reset_barrier(const size_type &);
 		void build_immigrants_vector(std::vector<std::pair<population::size_type, individual_type > > &,
 			const base_island &, base_island &,
 			const std::vector<individual_type> &) const;
 		void check_migr_attributes() const;
-		void sync_island_start() const;
 		size_type locate_island(const base_island &) const;
 		bool destruction_checks() const;
 		void reevaluate_immigrants(std::vector<std::pair<population::size_type, individual_type> > &,
 			const base_island &) const;
+		void push_back_slot();
+		migration_map_type get_migration_map() const;
+		void set_migration_map(const migration_map_type &);
+		void start_evolution(const std::vector<size_type> &, std::size_t, std::size_t);
+		void try_schedule(const evolution_run_ptr &, size_type);
+		void run_step(const evolution_run_ptr &, size_type);
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -172,47 +221,79 @@ class __PAGMO_VISIBLE archipelago
 			ar & m_topology;
 			ar & m_dist_type;
 			ar & m_migr_dir;
-			ar & m_migr_map;
-			ar & m_drng;
-			ar & m_urng;
-			// NOTE: this would need tuple serialization...
-			//ar & m_migr_hist;
+			// NOTE: migration history would need tuple serialization...
 			boost::serialization::split_member(ar, *this, version);
 		}
 
 		template <class Archive>
-		void save(Archive &, const unsigned int) const
-		{}
+		void save(Archive &ar, const unsigned int) const
+		{
+			ar << m_urng;
+			ar << m_pool_size;
+			const migration_map_type migr_map(get_migration_map());
+			ar << migr_map;
+			for (size_type i = 0; i < m_slots.size(); ++i) {
+				ar << m_slots[i]->m_drng;
+				ar << m_slots[i]->m_urng;
+			}
+		}
 		template <class Archive>
-		void load(Archive &, const unsigned int)
+		void load(Archive &ar, const unsigned int version)
 		{
 			// NOTE: archi pointer is not saved during island serialization. Hence, upon loading,
 			// we are going to set the archi pointer of the islands to this. 
 			for (size_type i = 0; i < m_container.size(); ++i) {
 				m_container[i]->m_archi = this;
 			}
-			// NOTE: migr history is not saved, so upon loading we clear it.
-			m_migr_hist.clear();
+			// NOTE: migr history is not saved, so upon loading the new slots start with an empty one.
+			m_slots.clear();
+			m_migr_hist_count = 0;
+			migration_map_type migr_map;
+			if (version < 1) {
+				// Version 0: a single pair of migration rngs, shared by all the islands. The islands get new rngs
+				// seeded from the loaded m_urng, and the default pool size.
+				rng_double drng;
+				ar >> migr_map;
+				ar >> drng;
+				ar >> m_urng;
+				m_pool_size = 0;
+				for (size_type i = 0; i < m_container.size(); ++i) {
+					push_back_slot();
+				}
+				set_migration_map(migr_map);
+				return;
+			}
+			ar >> m_urng;
+			ar >> m_pool_size;
+			// The slots are created with dummy seeds, as their rngs are loaded below and m_urng must keep its loaded state.
+			for (size_type i = 0; i < m_container.size(); ++i) {
+				m_slots.push_back(migration_slot_ptr(new migration_slot(0,0)));
+			}
+			ar >> migr_map;
+			set_migration_map(migr_map);
+			for (size_type i = 0; i < m_slots.size(); ++i) {
+				ar >> m_slots[i]->m_drng;
+				ar >> m_slots[i]->m_urng;
+			}
 		}
 		// Container of islands.
 		container_type				m_container;
-		// A barrier used to synchronise the start time of islands.
-		boost::scoped_ptr<boost::barrier>	m_islands_sync_point;
 		// Topology.
 		topology::base_ptr			m_topology;
 		// Distribution type.
 		distribution_type			m_dist_type;
 		// Migration direction.
 		migration_direction			m_migr_dir;
-		// Migration container.
-		migration_map_type			m_migr_map;
-		// Rngs used during migration.
-		rng_double					m_drng;
+		// Migration state of the islands.
+		std::vector<migration_slot_ptr>		m_slots;
+		// Rng used to seed the migration rngs of the islands.
 		rng_uint32					m_urng;
-		// Migration mutex.
-		boost::mutex				m_migr_mutex;
-		// Migration history.
-		migr_hist_type				m_migr_hist;
+		// Number of migration history items recorded so far, used to merge the histories of the islands.
+		boost::atomic<std::size_t>		m_migr_hist_count;
+		// Number of threads of the pool (0 for the default).
+		unsigned int				m_pool_size;
+		// Pool of threads running the evolution of the islands, created on demand.
+		boost::scoped_ptr<util::work_stealing_pool>	m_pool;
 
 };
 
@@ -220,4 +301,7 @@ std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const archipelago
 
 }
 
+// Version 1: per-island migration rngs and mailboxes, pool size.
+BOOST_CLASS_VERSION(pagmo::archipelago,1)
+
 #endif
@@ -64,7 +64,8 @@ namespace pagmo
  */
 base_island::base_island(const algorithm::base &a, const problem::base &p, int n,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	m_algo(a.clone()),m_pop(p,n),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()) { }
+	m_algo(a.clone()),m_pop(p,n),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()),
+	m_task_running(false),m_task_interrupt(false) { }
 
 /// Copy constructor.
 /**
@@ -72,7 +73,7 @@ base_island::base_island(const algorithm::base &a, const problem::base &p, int n
  *
  * @param[in] isl island to be copied.
  */
-base_island::base_island(const base_island &isl):m_pop(isl.get_population())
+base_island::base_island(const base_island &isl):m_pop(isl.get_population()),m_task_running(false),m_task_interrupt(false)
 {
 	// Population has already been done and get_population() above already called join().
 	m_algo = isl.m_algo->clone();
@@ -96,7 +97,8 @@ base_island::base_island(const base_island &isl):m_pop(isl.get_population())
  */
 base_island::base_island(const algorithm::base &a, const population &pop,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	m_algo(a.clone()),m_pop(pop),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()) { }
+	m_algo(a.clone()),m_pop(pop),m_archi(0),m_evo_time(0),m_s_policy(s_policy.clone()),m_r_policy(r_policy.clone()),
+	m_task_running(false),m_task_interrupt(false) { }
 
 /// Assignment operator.
 /**
@@ -201,6 +203,10 @@ void base_island::join() const
 	if (m_evo_thread && m_evo_thread->joinable()) {
 		m_evo_thread->join();
 	}
+	boost::unique_lock<boost::mutex> lock(m_task_mutex);
+	while (m_task_running) {
+		m_task_cond.wait(lock);
+	}
 }
 
 /// Thread entry hook.
@@ -233,6 +239,64 @@ struct base_island::raii_thread_hook
 	base_island *m_ptr;
 };
 
+// A single evolution of the population, including migration if the island belongs to an archipelago.
+void base_island::evolution_step()
+{
+	// Call pre-evolve hooks.
+	if (m_archi) {
+		m_archi->pre_evolution(*this);
+	}
+	m_pop.problem().pre_evolution(m_pop);
+	// Call the evolution.
+	perform_evolution(*m_algo,m_pop);
+	// Post-evolve hooks.
+	if (m_archi) {
+		m_archi->post_evolution(*this);
+	}
+	m_pop.problem().post_evolution(m_pop);
+}
+
+// Mark the island as being evolved by the tasks of an archipelago.
+void base_island::task_start()
+{
+	boost::lock_guard<boost::mutex> lock(m_task_mutex);
+	m_task_running = true;
+	m_task_interrupt = false;
+}
+
+// Run a single evolution as a task of the archipelago's thread pool, with the thread hooks around it. Return false if the evolution failed.
+bool base_island::task_step()
+{
+	try {
+		const raii_thread_hook hook(this);
+		evolution_step();
+	} catch (const std::exception &e) {
+		std::cout << "Error during island evolution using " << m_algo->get_name() << ": " << e.what() << std::endl;
+		return false;
+	} catch (...) {
+		std::cout << "Error during island evolution using " << m_algo->get_name() << ", unknown exception caught. :(" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// Mark the end of the evolution started by task_start(), waking up the threads waiting in join().
+void base_island::task_done()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_task_mutex);
+		m_task_running = false;
+	}
+	m_task_cond.notify_all();
+}
+
+// Check whether interrupt() has been called during the evolution started by task_start().
+bool base_island::task_interrupted() const
+{
+	boost::lock_guard<boost::mutex> lock(m_task_mutex);
+	return m_task_interrupt;
+}
+
 // Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
 struct base_island::int_evolver {
 	int_evolver(base_island *i, const std::size_t &n):m_i(i),m_n(n) {}
@@ -245,24 +309,9 @@ struct base_island::int_evolver {
 void base_island::int_evolver::juice_impl(boost::posix_time::ptime &start)
 {
 	start = boost::posix_time::microsec_clock::local_time();
-	// Synchronise start with all other threads if we are in an archi.
-	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
-	}
 	const raii_thread_hook hook(m_i);
 	for (std::size_t i = 0; i < m_n; ++i) {
-		// Call pre-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		// Call the evolution.
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		// Post-evolve hooks.
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
+		m_i->evolution_step();
 		// Set the interruption point.
 		boost::this_thread::interruption_point();
 	}
@@ -329,21 +378,9 @@ void base_island::t_evolver::juice_impl(boost::posix_time::ptime &start)
 {
 	boost::posix_time::time_duration diff;
 	start = boost::posix_time::microsec_clock::local_time();
-	// Synchronise start.
-	if (m_i->m_archi) {
-		m_i->m_archi->sync_island_start();
-	}
 	const raii_thread_hook hook(m_i);
 	do {
-		if (m_i->m_archi) {
-			m_i->m_archi->pre_evolution(*m_i);
-		}
-		m_i->m_pop.problem().pre_evolution(m_i->m_pop);
-		m_i->perform_evolution(*m_i->m_algo,m_i->m_pop);
-		if (m_i->m_archi) {
-			m_i->m_archi->post_evolution(*m_i);
-		}
-		m_i->m_pop.problem().post_evolution(m_i->m_pop);
+		m_i->evolution_step();
 		// Set the interruption point.
 		boost::this_thread::interruption_point();
 		diff = boost::posix_time::microsec_clock::local_time() - start;
@@ -401,15 +438,20 @@ void base_island::evolve_t(int t)
 
 /// Interrupt evolution.
 /**
- * If an evolution is undergoing, the evolution will be stopped the first time the flow reaches one of the internal interruption points.
+ * If an evolution is undergoing, the evolution will be stopped the first time the flow reaches one of the internal interruption points
+ * (for an island evolved by an archipelago, at the end of the ongoing call to perform_evolution()).
  * The method will block until the interruption point has been reached.
  */
 void base_island::interrupt()
 {
 	if (m_evo_thread) {
 		m_evo_thread->interrupt();
-		join();
 	}
+	{
+		boost::lock_guard<boost::mutex> lock(m_task_mutex);
+		m_task_interrupt = m_task_running;
+	}
+	join();
 }
 
 /// Query the status of the island.
@@ -418,6 +460,12 @@ void base_island::interrupt()
  */
 bool base_island::busy() const
 {
+	{
+		boost::lock_guard<boost::mutex> lock(m_task_mutex);
+		if (m_task_running) {
+			return true;
+		}
+	}
 	if (!m_evo_thread) {
 		return false;
 	}
@@ -578,7 +626,7 @@ std::vector<std::pair<population::size_type, archipelago::size_type> > base_isla
 		pagmo_assert((*rep_it).first < m_pop.m_container.size() && (*rep_it).second < immigrants.size());
 		m_pop.m_container[(*rep_it).first] = immigrants[(*rep_it).second];
 		m_pop.update_champion((*rep_it).first);
-		m_pop.update_dom((*rep_it).first);
+		m_pop.invalidate_dom((*rep_it).first);
 		std::pair<population::size_type, archipelago::size_type> pair = std::make_pair(1.0, immigrant_pairs[(*rep_it).second].first);
 		std::vector<std::pair<population::size_type, archipelago::size_type> >::iterator where;
 		where = std::find_if(retval.begin(), retval.end(), unary_predicate(pair));
@@ -27,6 +27,8 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <cstddef>
 #include <iostream>
@@ -74,6 +76,8 @@ typedef boost::shared_ptr<base_island> base_island_ptr;
  *
  * When one of the evolution methods (evolve() or evolve_t()) is launched,
  * a local thread is opened and the perform_evolution() method is called from the new thread using as arguments the population and the algorithm stored in the island.
+ * Islands belonging to an archipelago are instead evolved by the archipelago, which runs each call to perform_evolution() as a task on its own pool of threads
+ * (see archipelago::evolve()). In both cases the thread hooks thread_entry() and thread_exit() are called around the evolution code in the thread executing it.
  *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Marek Ruciński (marek.rucinski@gmail.com)
@@ -147,6 +151,11 @@ class __PAGMO_VISIBLE base_island
 		// but this creates problems as at this point archipelago::siz_type is not defined and cannot be!!!
 		std::vector<std::pair<population::size_type, population::size_type> > accept_immigrants(std::vector<std::pair<population::size_type, population::individual_type> > &);
 		std::vector<population::individual_type> get_emigrants();
+		void evolution_step();
+		void task_start();
+		bool task_step();
+		void task_done();
+		bool task_interrupted() const;
 		// Evolver thread object. This is a callable helper object used to launch an evolution for a given number of iterations.
 		struct int_evolver;
 		// Time-dependent evolver thread object. This is a callable helper object used to launch an evolution for a specified amount of time.
@@ -170,6 +179,11 @@ class __PAGMO_VISIBLE base_island
 		/// Evolution thread.
 		boost::scoped_ptr<boost::thread>	m_evo_thread;
 	private:
+		// State of an evolution run by the archipelago as tasks on its thread pool, protected by the mutex.
+		mutable boost::mutex			m_task_mutex;
+		mutable boost::condition_variable	m_task_cond;
+		bool					m_task_running;
+		bool					m_task_interrupt;
 		friend class boost::serialization::access;
 		template <class Archive>
 		void serialize(Archive &ar, const unsigned int version)
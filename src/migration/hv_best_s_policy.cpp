@@ -33,9 +33,6 @@
 #include "hv_best_s_policy.h"
 #include "best_s_policy.h"
 #include "../exceptions.h"
-#include "../util/hypervolume.h"
-
-using namespace pagmo::util;
 
 namespace pagmo { namespace migration {
 
@@ -77,20 +74,16 @@ std::vector<population::individual_type> hv_best_s_policy::select(population &po
 	// Indices of fronts.
 	std::vector< std::vector< population::size_type> > fronts_i = pop.compute_pareto_fronts();
 
-	// Fitness vectors of individuals according to the indices above.
-	std::vector< std::vector< fitness_vector> > fronts_f (fronts_i.size());
-
 	// Nadir point is established manually later, first point is as a first "safe" candidate.
 	fitness_vector refpoint(pop.get_individual(0).cur_f);
 
 	for (unsigned int f_idx = 0 ; f_idx < fronts_i.size() ; ++f_idx) {
-		fronts_f[f_idx].resize(fronts_i[f_idx].size());
 		for (unsigned int p_idx = 0 ; p_idx < fronts_i[f_idx].size() ; ++p_idx) {
-			fronts_f[f_idx][p_idx] = fitness_vector(pop.get_individual(fronts_i[f_idx][p_idx]).cur_f);
+			const fitness_vector &f = pop.get_individual(fronts_i[f_idx][p_idx]).cur_f;
 
 			// Update the nadir point manually for efficiency.
-			for (unsigned int d_idx = 0 ; d_idx < fronts_f[f_idx][p_idx].size() ; ++d_idx) {
-				refpoint[d_idx] = std::max(refpoint[d_idx], fronts_f[f_idx][p_idx][d_idx]);
+			for (unsigned int d_idx = 0 ; d_idx < f.size() ; ++d_idx) {
+				refpoint[d_idx] = std::max(refpoint[d_idx], f[d_idx]);
 			}
 		}
 	}
@@ -105,7 +98,7 @@ std::vector<population::individual_type> hv_best_s_policy::select(population &po
 	unsigned int remaining_individuals = migration_rate;
 
 	while (remaining_individuals > 0) {
-		unsigned int front_size = fronts_f[front_idx].size();
+		unsigned int front_size = fronts_i[front_idx].size();
 
 		// If we need every individual from this front anyway skip the computation
 		if (remaining_individuals >= front_size) {
@@ -114,25 +107,19 @@ std::vector<population::individual_type> hv_best_s_policy::select(population &po
 			}
 			remaining_individuals -= front_size;
 		} else {
-			// Store the original (true) size of the front in case it gets extended
-			unsigned int true_front_size = fronts_f[front_idx].size();
-
-			// If there is a lower front available, merge it as well
-			if (front_idx + 1 < fronts_f.size()) {
-				// Make room for the new front
-				fronts_f[front_idx].resize(true_front_size + fronts_f[front_idx + 1].size());
-				for(unsigned int i = 0 ; i < fronts_f[front_idx + 1].size() ; ++i) {
-					fronts_f[front_idx][true_front_size + i] = fronts_f[front_idx + 1][i];
-				}
-
+			// Indices of the front, followed by those of the lower front if there is one
+			std::vector<population::size_type> merged_i(fronts_i[front_idx]);
+			if (front_idx + 1 < fronts_i.size()) {
+				merged_i.insert(merged_i.end(), fronts_i[front_idx + 1].begin(), fronts_i[front_idx + 1].end());
 			}
-			hypervolume hv(fronts_f[front_idx], false);
-			std::vector<double> c = hv.contributions(refpoint);
+
+			// Contributions are cached by the population, so selecting again from an unchanged population is free
+			std::vector<double> c = pop.get_hv_contributions(merged_i, refpoint);
 
 			std::vector<std::pair<unsigned int, double> > point_pairs;
-			point_pairs.resize(true_front_size);
+			point_pairs.resize(front_size);
 
-			for(unsigned int i = 0 ; i < true_front_size ; ++i) {
+			for(unsigned int i = 0 ; i < front_size ; ++i) {
 				point_pairs[i] = std::make_pair(i, c[i]);
 			}
 
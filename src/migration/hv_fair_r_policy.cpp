@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
+#include <numeric>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -34,11 +35,6 @@
 #include "hv_fair_r_policy.h"
 #include "fair_r_policy.h"
 
-#include "../util/hypervolume.h"
-
-
-using namespace pagmo::util;
-
 namespace pagmo { namespace migration {
 
 /// Constructor from rate and rate type.
@@ -121,21 +117,17 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Population fronts stored as indices of individuals.
 	std::vector< std::vector<population::size_type> > fronts_i = pop_copy.compute_pareto_fronts();
 
-	// Population fronts stored as fitness vectors of individuals.
-	std::vector< std::vector<fitness_vector> > fronts_f (fronts_i.size());
-
 	// Nadir point is established manually later, first point is a first "safe" candidate.
 	fitness_vector refpoint(pop_copy.get_individual(0).cur_f);
 
-	// Fill fronts_f with fitness vectors and establish the nadir point
+	// Establish the nadir point
 	for (unsigned int f_idx = 0 ; f_idx < fronts_i.size() ; ++f_idx) {
-		fronts_f[f_idx].resize(fronts_i[f_idx].size());
 		for (unsigned int p_idx = 0 ; p_idx < fronts_i[f_idx].size() ; ++p_idx) {
-			fronts_f[f_idx][p_idx] = fitness_vector(pop_copy.get_individual(fronts_i[f_idx][p_idx]).cur_f);
+			const fitness_vector &f = pop_copy.get_individual(fronts_i[f_idx][p_idx]).cur_f;
 
 			// Update the nadir point manually for efficiency.
-			for (unsigned int d_idx = 0 ; d_idx < fronts_f[f_idx][p_idx].size() ; ++d_idx) {
-				refpoint[d_idx] = std::max(refpoint[d_idx], fronts_f[f_idx][p_idx][d_idx]);
+			for (unsigned int d_idx = 0 ; d_idx < f.size() ; ++d_idx) {
+				refpoint[d_idx] = std::max(refpoint[d_idx], f[d_idx]);
 			}
 		}
 	}
@@ -170,28 +162,16 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 		if (current_point == point_pairs.size()) {
 			--front_idx;
 
-			// Compute contributions
-			std::vector<double> c;
-
-			// If there exist a dominated front for front at index front_idx
-			if (front_idx + 1 < fronts_f.size()) {
-				std::vector<fitness_vector> merged_front;
-				// Reserve the memory and copy the fronts
-				merged_front.reserve(fronts_f[front_idx].size() + fronts_f[front_idx + 1].size());
-
-				copy(fronts_f[front_idx].begin(), fronts_f[front_idx].end(), back_inserter(merged_front));
-				copy(fronts_f[front_idx + 1].begin(), fronts_f[front_idx +1].end(), back_inserter(merged_front));
-
-				hypervolume hv(merged_front, false);
-				c = hv.contributions(refpoint);
-			} else {
-				hypervolume hv(fronts_f[front_idx], false);
-				c = hv.contributions(refpoint);
+			// Compute contributions of the front, merged with the dominated front if there is one
+			std::vector<population::size_type> merged_i(fronts_i[front_idx]);
+			if (front_idx + 1 < fronts_i.size()) {
+				merged_i.insert(merged_i.end(), fronts_i[front_idx + 1].begin(), fronts_i[front_idx + 1].end());
 			}
+			std::vector<double> c = pop_copy.get_hv_contributions(merged_i, refpoint);
 
 			// Initiate the pairs and sort by second item (exclusive volume)
-			point_pairs.resize(fronts_f[front_idx].size());
-			for(unsigned int i = 0 ; i < fronts_f[front_idx].size() ; ++i) {
+			point_pairs.resize(fronts_i[front_idx].size());
+			for(unsigned int i = 0 ; i < fronts_i[front_idx].size() ; ++i) {
 				point_pairs[i] = std::make_pair(i, c[i]);
 			}
 			current_point = 0;
@@ -227,23 +207,19 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 		}
 	}
 
-	// Aggregate all points to establish the hypervolume contribution of available immigrants and discarded islanders
-	std::vector<fitness_vector> merged_fronts;
-	merged_fronts.reserve(pop_copy.size());
-
-	for(unsigned int idx = 0 ; idx < pop_copy.size() ; ++idx) {
-		merged_fronts.push_back(pop_copy.get_individual(idx).cur_f);
-	}
-
-	hypervolume hv(merged_fronts, false);
+	// Establish the hypervolume contribution of available immigrants and discarded islanders within the whole augmented
+	// population, all computed at once.
+	std::vector<population::size_type> all_i(pop_copy.size());
+	std::iota(all_i.begin(), all_i.end(), population::size_type(0));
+	const std::vector<double> all_c = pop_copy.get_hv_contributions(all_i, refpoint);
 	std::vector<std::pair<unsigned int, double> >::iterator it;
 
 	for(it = available_immigrants.begin() ; it != available_immigrants.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = all_c[(*it).first];
 	}
 
 	for(it = discarded_islanders.begin() ; it != discarded_islanders.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = all_c[(*it).first];
 	}
 
 	// Sort islanders and immigrants according to exclusive hypervolume
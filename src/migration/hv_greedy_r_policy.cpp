@@ -24,6 +24,8 @@
 
 #include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <numeric>
 #include <utility>
 #include <vector>
 #include <algorithm>
@@ -34,12 +36,27 @@
 #include "hv_greedy_r_policy.h"
 #include "fair_r_policy.h"
 
-#include "../util/hypervolume.h"
+#include "../util/hv_algorithm/dynamic_hv.h"
 
 using namespace pagmo::util;
 
 namespace pagmo { namespace migration {
 
+namespace {
+
+// Dynamic hypervolume of the given individuals, whose ids are their positions in front. The initial contributions are
+// taken from the cache of the population.
+hv_algorithm::dynamic_hv *new_front_hv(const population &pop, const std::vector<population::size_type> &front, const fitness_vector &refpoint)
+{
+	std::vector<fitness_vector> points(front.size());
+	for (std::vector<population::size_type>::size_type i = 0; i < front.size(); ++i) {
+		points[i] = pop.get_individual(front[i]).cur_f;
+	}
+	return new hv_algorithm::dynamic_hv(points, refpoint, pop.get_hv_contributions(front, refpoint));
+}
+
+}
+
 /// Constructor from rate and rate type.
 /**
  * @param[in] rate migration rate.
@@ -120,21 +137,17 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Population fronts stored as indices of individuals.
 	std::vector< std::vector<population::size_type> > fronts_i = pop_copy.compute_pareto_fronts();
 
-	// Population fronts stored as fitness vectors of individuals.
-	std::vector< std::vector<fitness_vector> > fronts_f (fronts_i.size());
-
 	// Nadir point is established manually later, first point is a first "safe" candidate.
 	fitness_vector refpoint(pop_copy.get_individual(0).cur_f);
 
-	// Fill fronts_f with fitness vectors and establish the nadir point
+	// Establish the nadir point
 	for (unsigned int f_idx = 0 ; f_idx < fronts_i.size() ; ++f_idx) {
-		fronts_f[f_idx].resize(fronts_i[f_idx].size());
 		for (unsigned int p_idx = 0 ; p_idx < fronts_i[f_idx].size() ; ++p_idx) {
-			fronts_f[f_idx][p_idx] = fitness_vector(pop_copy.get_individual(fronts_i[f_idx][p_idx]).cur_f);
+			const fitness_vector &f = pop_copy.get_individual(fronts_i[f_idx][p_idx]).cur_f;
 
 			// Update the nadir point manually for efficiency.
-			for (unsigned int d_idx = 0 ; d_idx < fronts_f[f_idx][p_idx].size() ; ++d_idx) {
-				refpoint[d_idx] = std::max(refpoint[d_idx], fronts_f[f_idx][p_idx][d_idx]);
+			for (unsigned int d_idx = 0 ; d_idx < f.size() ; ++d_idx) {
+				refpoint[d_idx] = std::max(refpoint[d_idx], f[d_idx]);
 			}
 		}
 	}
@@ -148,9 +161,8 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	unsigned int front_idx = fronts_i.size() - 1;
 	unsigned int processed_individuals = 0;
 
-	// Vector for maintaining the original indices of points for given front
-	std::vector<unsigned int> orig_indices(fronts_i[front_idx].size());
-	iota(orig_indices.begin(), orig_indices.end(), 0);
+	// Contributions of the current front, updated as its least contributors are discarded. Ids are the positions in the front.
+	boost::scoped_ptr<hv_algorithm::dynamic_hv> front_hv(new_front_hv(pop_copy, fronts_i[front_idx], refpoint));
 
 	// Vector for maintaining the original indices of points for augmented population as 0 and 1
 	std::vector<unsigned int> g_orig_indices(pop_copy.size(), 1);
@@ -164,20 +176,15 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 	// Stops when we reduce the augmented population to the size of the original population or when the number of discarded islanders reaches the limit
 	while (processed_individuals < filtered_immigrants.size() && discarded_islanders.size() < rate_limit) {
 		// If current front is depleted, load next front.
-		if (fronts_f[front_idx].size() == 0) {
-			// Decrease front and reset the orig_indices
+		if (front_hv->size() == 0) {
 			--front_idx;
-			orig_indices.resize(fronts_i[front_idx].size());
-			iota(orig_indices.begin(), orig_indices.end(), 0);
+			front_hv.reset(new_front_hv(pop_copy, fronts_i[front_idx], refpoint));
 		}
 
-		// Initiate the hypervolume object and compute the least contributor
-		hypervolume hv(fronts_f[front_idx], false);
-		hv.set_copy_points(false);
-		unsigned int lc_idx = hv.least_contributor(refpoint);
+		// Compute the least contributor
+		const hv_algorithm::dynamic_hv::id_type lc_idx = front_hv->least_contributor();
 
-		// Fix the index shift
-		unsigned int orig_lc_idx = fronts_i[front_idx][orig_indices[lc_idx]];
+		unsigned int orig_lc_idx = fronts_i[front_idx][lc_idx];
 
 		if (orig_lc_idx < dest.size()) {
 			discarded_islanders.push_back(std::make_pair(orig_lc_idx, 0.0));
@@ -188,9 +195,8 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 		// Flag given individual as discarded
 		g_orig_indices[orig_lc_idx] = 0;
 
-		// Drop the local index, and the point from the front
-		orig_indices.erase(orig_indices.begin() + lc_idx);
-		fronts_f[front_idx].erase(fronts_f[front_idx].begin() + lc_idx);
+		// Drop the point from the front
+		front_hv->erase(lc_idx);
 		++processed_individuals;
 	}
 
@@ -208,23 +214,19 @@ std::vector<std::pair<population::size_type,std::vector<population::individual_t
 		}
 	}
 
-	// Aggregate all points to establish the hypervolume contribution of available immigrants and discarded islanders
-	std::vector<fitness_vector> merged_fronts;
-	merged_fronts.reserve(pop_copy.size());
-
-	for(unsigned int idx = 0 ; idx < pop_copy.size() ; ++idx) {
-		merged_fronts.push_back(pop_copy.get_individual(idx).cur_f);
-	}
-
-	hypervolume hv(merged_fronts, false);
+	// Establish the hypervolume contribution of available immigrants and discarded islanders within the whole augmented
+	// population, all computed at once.
+	std::vector<population::size_type> all_i(pop_copy.size());
+	std::iota(all_i.begin(), all_i.end(), population::size_type(0));
+	const std::vector<double> all_c = pop_copy.get_hv_contributions(all_i, refpoint);
 	std::vector<std::pair<unsigned int, double> >::iterator it;
 
 	for(it = available_immigrants.begin() ; it != available_immigrants.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = all_c[(*it).first];
 	}
 
 	for(it = discarded_islanders.begin() ; it != discarded_islanders.end() ; ++it) {
-		(*it).second = hv.exclusive((*it).first, refpoint);
+		(*it).second = all_c[(*it).first];
 	}
 
 	// Sort islanders and immigrants according to exclusive hypervolume
@@ -22,22 +22,327 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+
+#include <boost/archive/archive_exception.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/utility.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
 #include <mpi.h>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "exceptions.h"
 #include "algorithm/base.h"
 #include "population.h"
+#include "problem/base.h"
 #include "mpi_environment.h"
+#include "util/snapshot.h"
 
 namespace pagmo
 {
 
+namespace {
+
+// Tags of the messages: size of a payload, payload, and wake-up of the progress thread.
+const int size_tag = 0;
+const int payload_tag = 1;
+const int wake_tag = 2;
+
+}
+
+/// Default constructor.
+/**
+ * Builds an empty delta, which leaves the population unchanged.
+ */
+mpi_population_delta::mpi_population_delta() {}
+
+/// Constructor from population.
+/**
+ * Stores the whole population.
+ *
+ * @param[in] pop population to be transmitted.
+ */
+mpi_population_delta::mpi_population_delta(const population &pop):m_pop(new population(pop)) {}
+
+/// Constructor from reference and current population.
+/**
+ * Stores the individuals of cur differing from those of ref, and the champion of cur. If the sizes of the two populations differ,
+ * cur is stored as a whole.
+ *
+ * @param[in] ref reference population.
+ * @param[in] cur population to be transmitted.
+ */
+mpi_population_delta::mpi_population_delta(const population &ref, const population &cur)
+{
+	if (ref.size() != cur.size()) {
+		m_pop.reset(new population(cur));
+		return;
+	}
+	std::ostringstream oss(std::ios::binary);
+	util::snapshot::save_delta(oss,ref,cur);
+	m_snapshot = oss.str();
+}
+
+/// Apply the delta.
+/**
+ * @param[in,out] target population to which the delta is applied. If the delta stores a whole population, target will be set to it.
+ *
+ * @throws value_error if the delta needs a reference population and target is null, or if it does not fit the target population.
+ */
+void mpi_population_delta::apply(boost::shared_ptr<population> &target) const
+{
+	if (m_pop) {
+		target = m_pop;
+		return;
+	}
+	if (!target) {
+		pagmo_throw(value_error,"cannot apply a population delta without a reference population");
+	}
+	if (!m_snapshot.empty()) {
+		util::snapshot::load(m_snapshot.data(),m_snapshot.size(),*target);
+	}
+}
+
+/// Default constructor.
+/**
+ * Builds a shutdown job.
+ */
+mpi_job::mpi_job():m_island(0) {}
+
+/// Default constructor.
+/**
+ * Builds the result of a failed job, leaving the population unchanged.
+ */
+mpi_result::mpi_result():m_resident(false) {}
+
+// Engine performing all the MPI communication of the root process in a dedicated thread. Each exchange sends a payload to a worker
+// and receives its reply through non-blocking operations: in multithread mode the thread blocks in MPI_Waitany, and a message sent to self
+// wakes it up when new exchanges are submitted; in serialized mode no other thread can call MPI, and the requests are polled with MPI_Testsome.
+class mpi_environment::progress_engine: private boost::noncopyable
+{
+		struct exchange_type
+		{
+			exchange_type(int dest, const std::string &payload):m_dest(dest),m_out(payload.begin(),payload.end()),
+				m_out_size(boost::numeric_cast<int>(m_out.size())),m_in_size(0),m_outstanding(0),m_done(false) {}
+			int			m_dest;
+			std::vector<char>	m_out;
+			int			m_out_size;
+			int			m_in_size;
+			std::vector<char>	m_in;
+			int			m_outstanding;
+			bool			m_done;
+		};
+		// Stages of the requests.
+		enum stage {send_size, send_payload, recv_size, recv_payload, wake};
+	public:
+		progress_engine():m_n_active(0),m_stop(false),m_waiting(false),m_wake_sent(false)
+		{
+			if (m_multithread) {
+				post(0,wake);
+			}
+			m_thread.reset(new boost::thread(&progress_engine::run,this));
+		}
+		~progress_engine()
+		{
+			bool send_wake = false;
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				m_stop = true;
+				send_wake = wake_needed();
+			}
+			m_cond.notify_all();
+			if (send_wake) {
+				send_wake_up();
+			}
+			m_thread->join();
+			if (m_multithread) {
+				// Dispose of the wake-up receive.
+				pagmo_assert(m_requests.size() == 1);
+				MPI_Cancel(&m_requests[0]);
+				MPI_Wait(&m_requests[0],MPI_STATUS_IGNORE);
+			}
+		}
+		std::string exchange(int dest, const std::string &payload)
+		{
+			exchange_type ex(dest,payload);
+			bool send_wake = false;
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			m_pending.push_back(&ex);
+			send_wake = wake_needed();
+			m_cond.notify_all();
+			if (send_wake) {
+				lock.unlock();
+				send_wake_up();
+				lock.lock();
+			}
+			while (!ex.m_done) {
+				m_done_cond.wait(lock);
+			}
+			return std::string(ex.m_in.begin(),ex.m_in.end());
+		}
+	private:
+		// Must be called with the mutex locked.
+		bool wake_needed()
+		{
+			if (m_multithread && m_waiting && !m_wake_sent) {
+				m_wake_sent = true;
+				return true;
+			}
+			return false;
+		}
+		static void send_wake_up()
+		{
+			MPI_Send(0,0,MPI_CHAR,0,wake_tag,MPI_COMM_WORLD);
+		}
+		void post(exchange_type *ex, stage s)
+		{
+			MPI_Request req;
+			switch (s) {
+				case send_size:
+					MPI_Isend(static_cast<void *>(&ex->m_out_size),1,MPI_INT,ex->m_dest,size_tag,MPI_COMM_WORLD,&req);
+					break;
+				case send_payload:
+					MPI_Isend(static_cast<void *>(&ex->m_out[0]),ex->m_out_size,MPI_CHAR,ex->m_dest,payload_tag,MPI_COMM_WORLD,&req);
+					break;
+				case recv_size:
+					MPI_Irecv(static_cast<void *>(&ex->m_in_size),1,MPI_INT,ex->m_dest,size_tag,MPI_COMM_WORLD,&req);
+					break;
+				case recv_payload:
+					ex->m_in.resize(boost::numeric_cast<std::vector<char>::size_type>(ex->m_in_size));
+					MPI_Irecv(static_cast<void *>(&ex->m_in[0]),ex->m_in_size,MPI_CHAR,ex->m_dest,payload_tag,MPI_COMM_WORLD,&req);
+					break;
+				case wake:
+					MPI_Irecv(0,0,MPI_CHAR,0,wake_tag,MPI_COMM_WORLD,&req);
+			}
+			if (ex) {
+				++ex->m_outstanding;
+			}
+			m_requests.push_back(req);
+			m_owners.push_back(std::make_pair(ex,s));
+		}
+		// Must be called with the mutex locked. Returns true if an exchange was completed.
+		bool complete(std::size_t idx)
+		{
+			exchange_type *ex = m_owners[idx].first;
+			const stage s = m_owners[idx].second;
+			if (s == wake) {
+				m_wake_sent = false;
+				post(0,wake);
+				return false;
+			}
+			if (s == recv_size) {
+				post(ex,recv_payload);
+			}
+			if (!--ex->m_outstanding) {
+				ex->m_done = true;
+				--m_n_active;
+				return true;
+			}
+			return false;
+		}
+		// Remove the completed requests.
+		void compact()
+		{
+			std::size_t j = 0;
+			for (std::size_t i = 0; i < m_requests.size(); ++i) {
+				if (m_requests[i] != MPI_REQUEST_NULL) {
+					m_requests[j] = m_requests[i];
+					m_owners[j] = m_owners[i];
+					++j;
+				}
+			}
+			m_requests.resize(j);
+			m_owners.resize(j);
+		}
+		void run()
+		{
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			const boost::posix_time::time_duration max_backoff = boost::posix_time::milliseconds(1);
+			boost::posix_time::time_duration backoff = boost::posix_time::microseconds(10);
+			std::vector<int> indices;
+			while (true) {
+				// Start the pending exchanges.
+				for (; !m_pending.empty(); m_pending.pop_front()) {
+					post(m_pending.front(),send_size);
+					post(m_pending.front(),send_payload);
+					post(m_pending.front(),recv_size);
+					++m_n_active;
+				}
+				if (!m_n_active) {
+					if (m_stop) {
+						break;
+					}
+					m_cond.wait(lock);
+					continue;
+				}
+				bool done = false;
+				// The requests cannot change while the lock is released, only this thread touches them.
+				if (m_multithread) {
+					m_waiting = true;
+					lock.unlock();
+					int idx;
+					MPI_Waitany(boost::numeric_cast<int>(m_requests.size()),&m_requests[0],&idx,MPI_STATUS_IGNORE);
+					lock.lock();
+					m_waiting = false;
+					pagmo_assert(idx != MPI_UNDEFINED);
+					done = complete(boost::numeric_cast<std::size_t>(idx));
+				} else {
+					indices.resize(m_requests.size());
+					int count;
+					lock.unlock();
+					MPI_Testsome(boost::numeric_cast<int>(m_requests.size()),&m_requests[0],&count,&indices[0],MPI_STATUSES_IGNORE);
+					lock.lock();
+					pagmo_assert(count != MPI_UNDEFINED);
+					for (int i = 0; i < count; ++i) {
+						done = complete(boost::numeric_cast<std::size_t>(indices[i])) || done;
+					}
+					if (count) {
+						backoff = boost::posix_time::microseconds(10);
+					} else if (m_pending.empty()) {
+						// Nothing happened: sleep, unless new exchanges are submitted in the meantime.
+						m_cond.timed_wait(lock,backoff);
+						backoff = std::min(backoff * 2,max_backoff);
+					}
+				}
+				compact();
+				if (done) {
+					m_done_cond.notify_all();
+				}
+			}
+		}
+
+		boost::mutex					m_mutex;
+		boost::condition_variable			m_cond;
+		boost::condition_variable			m_done_cond;
+		std::deque<exchange_type *>			m_pending;
+		std::size_t					m_n_active;
+		bool						m_stop;
+		bool						m_waiting;
+		bool						m_wake_sent;
+		std::vector<MPI_Request>			m_requests;
+		std::vector<std::pair<exchange_type *,stage> >	m_owners;
+		boost::scoped_ptr<boost::thread>		m_thread;
+};
+
 bool mpi_environment::m_initialised = false;
 bool mpi_environment::m_multithread = false;
+int mpi_environment::m_size = 0;
+int mpi_environment::m_rank = 0;
+boost::scoped_ptr<mpi_environment::progress_engine> mpi_environment::m_engine;
 
 /// Default constructor.
 /**
@@ -59,6 +364,8 @@ mpi_environment::mpi_environment()
 	if (thread_level_provided >= MPI_THREAD_MULTIPLE) {
 		m_multithread = true;
 	}
+	MPI_Comm_size(MPI_COMM_WORLD,&m_size);
+	MPI_Comm_rank(MPI_COMM_WORLD,&m_rank);
 	if (get_rank()) {
 		// If this is a slave, it will have to stop here, listen for jobs, execute them, and exit()
 		// when signalled to do so.
@@ -72,18 +379,20 @@ mpi_environment::mpi_environment()
 	if (get_size() < 2) {
 		pagmo_throw(std::runtime_error,"the size of the MPI world must be at least 2");
 	}
+	m_engine.reset(new progress_engine());
 }
 
 /// Destructor.
 /**
- * Will send a shutdown signal to all processes with nonzero rank and call MPI_Finalize().
+ * Will stop the progress thread, send a shutdown signal to all processes with nonzero rank and call MPI_Finalize().
  */
 mpi_environment::~mpi_environment()
 {
 	// In theory this should never be called by the slaves.
 	pagmo_assert(!get_rank());
 	pagmo_assert(m_initialised);
-	std::pair<boost::shared_ptr<population>,algorithm::base_ptr> shutdown_payload;
+	m_engine.reset();
+	const mpi_job shutdown_payload;
 	for (int i = 1; i < get_size(); ++i) {
 		// Send the shutdown signal to all slaves.
 		send(shutdown_payload,i);
@@ -120,7 +429,7 @@ bool mpi_environment::iprobe(int source)
 
 /// MPI world size.
 /**
- * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ * This method is always thread-safe.
  * 
  * @return the MPI world size.
  * 
@@ -129,14 +438,12 @@ bool mpi_environment::iprobe(int source)
 int mpi_environment::get_size()
 {
 	check_init();
-	int retval;
-	MPI_Comm_size(MPI_COMM_WORLD,&retval);
-	return retval;
+	return m_size;
 }
 
 /// MPI rank.
 /**
- * This method is thread-safe only if mpi_environment::is_multithread returns true.
+ * This method is always thread-safe.
  * 
  * @return the MPI rank of the process.
  * 
@@ -145,9 +452,7 @@ int mpi_environment::get_size()
 int mpi_environment::get_rank()
 {
 	check_init();
-	int retval;
-	MPI_Comm_rank(MPI_COMM_WORLD,&retval);
-	return retval;
+	return m_rank;
 }
 
 /// Thread-safety of the MPI implementation.
@@ -165,42 +470,102 @@ bool mpi_environment::is_multithread()
 	return m_multithread;
 }
 
+/// Exchange payloads with a worker.
+/**
+ * Send a serialised payload to the processor with ID destination and wait for its reply. The communication is performed
+ * by the progress thread of the root process, so that any number of threads can exchange payloads concurrently (with different
+ * destinations) regardless of the thread level of the MPI implementation. This method is thread-safe.
+ *
+ * @param[in] destination rank of the processor to which the payload will be sent.
+ * @param[in] payload serialised payload.
+ *
+ * @return the serialised reply of destination.
+ *
+ * @throws std::runtime_error if the MPI environment has not been initialised or this is not the root process.
+ */
+std::string mpi_environment::exchange(int destination, const std::string &payload)
+{
+	check_init();
+	if (!m_engine) {
+		pagmo_throw(std::runtime_error,"payloads can be exchanged only by the root process");
+	}
+	return m_engine->exchange(destination,payload);
+}
+
 void mpi_environment::listen()
 {
-	std::pair<boost::shared_ptr<population>,algorithm::base_ptr> payload;
+	// Populations of the islands resident on the worker.
+	std::map<std::size_t,boost::shared_ptr<population> > islands;
+	// Buffers of the reply being sent.
+	int reply_size = 0;
+	std::vector<char> reply;
+	MPI_Request reply_req[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
 	while (true) {
-		// Receive the payload from the master.
-		recv(payload,0);
-		// If the payload is empty, it is the shutdown payload.
-		if (payload.first.get() == 0) {
-			pagmo_assert(payload.second.get() == 0);
+		mpi_job job;
+		// Receive the job from the master.
+		recv(job,0);
+		// Island 0 is the shutdown signal.
+		if (!job.m_island) {
 			break;
 		}
-
-		// Create copy of data received
-		const boost::shared_ptr<population> pop_copy(new population(*payload.first));
+		for (std::size_t i = 0; i < job.m_evict.size(); ++i) {
+			islands.erase(job.m_evict[i]);
+		}
+		boost::shared_ptr<population> &pop = islands[job.m_island];
+		std::string algo_name("unknown algorithm");
+		mpi_result out;
+		out.m_resident = true;
 		try {
-			// Perform the evolution.
-			payload.second->evolve(*payload.first);
+			job.m_delta.apply(pop);
+			if (job.m_prob) {
+				population_access::get_problem_ptr(*pop) = job.m_prob;
+			}
+			if (!job.m_algo) {
+				pagmo_throw(value_error,"no algorithm available for the island");
+			}
+			algo_name = job.m_algo->get_name();
+			// Evolve a copy, so that the resident population is left untouched in case of errors.
+			const boost::shared_ptr<population> evolved(new population(*pop));
+			try {
+				job.m_algo->evolve(*evolved);
+				out.m_delta = mpi_population_delta(*pop,*evolved);
+				out.m_algo = job.m_algo;
+				out.m_prob = population_access::get_problem_ptr(*evolved);
+				pop = evolved;
+			} catch (const std::exception &e) {
+				std::cout << "MPI Remote Error during island evolution using " << algo_name << ": " << e.what() << std::endl;
+			} catch (...) {
+				std::cout << "MPI Remote Error during island evolution using " << algo_name << ", unknown exception caught. :(" << std::endl;
+			}
 		} catch (const std::exception &e) {
-			std::cout << "MPI Remote Error during island evolution using " << payload.second->get_name() << ": " << e.what() << std::endl;
-		} catch (...) {
-			std::cout << "MPI Remote Error during island evolution using " << payload.second->get_name() << ", unknown exception caught. :(" << std::endl;
+			// The state of the island is inconsistent: forget it, the master will resend everything.
+			std::cout << "MPI Remote Error during island setup: " << e.what() << std::endl;
+			islands.erase(job.m_island);
+			out.m_resident = false;
 		}
 
-		try {                
-			// Send back to the master the evolved population.
-			send(payload.first,0);
+		// Wait for the previous reply to be delivered before reusing its buffers.
+		MPI_Waitall(2,reply_req,MPI_STATUSES_IGNORE);
+		std::string buffer_str;
+		try {
+			buffer_str = pickle(out);
 		} catch (const boost::archive::archive_exception &e) {
-			std::cout << "MPI Send Error during island evolution using " << payload.second->get_name() << ": " << e.what() << std::endl;
-			// Send back to the master the original population.
-			send(pop_copy,0);
+			std::cout << "MPI Send Error during island evolution using " << algo_name << ": " << e.what() << std::endl;
+			// Send back an empty delta, the master will keep the original population.
+			buffer_str = pickle(mpi_result());
+			islands.erase(job.m_island);
 		} catch (...) {
-			std::cout << "MPI Send Error during island evolution using " << payload.second->get_name() << ", unknown exception caught. :(" << std::endl;
-			// Send back to the master the original population.
-			send(pop_copy,0);
-                }
+			std::cout << "MPI Send Error during island evolution using " << algo_name << ", unknown exception caught. :(" << std::endl;
+			buffer_str = pickle(mpi_result());
+			islands.erase(job.m_island);
+		}
+		// Send back to the master the changes, without waiting for the delivery.
+		reply.assign(buffer_str.begin(),buffer_str.end());
+		reply_size = boost::numeric_cast<int>(reply.size());
+		MPI_Isend(static_cast<void *>(&reply_size),1,MPI_INT,0,size_tag,MPI_COMM_WORLD,&reply_req[0]);
+		MPI_Isend(static_cast<void *>(&reply[0]),reply_size,MPI_CHAR,0,payload_tag,MPI_COMM_WORLD,&reply_req[1]);
 	}
+	MPI_Waitall(2,reply_req,MPI_STATUSES_IGNORE);
 	// Destroy the MPI environment before exiting.
 	MPI_Finalize();
 	std::exit(0);
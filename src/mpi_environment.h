@@ -28,13 +28,21 @@
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
+#include <cstddef>
 #include <mpi.h>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "algorithm/base.h"
 #include "config.h"
+#include "population.h"
+#include "problem/base.h"
+#include "serialization.h"
 
 /*!
 \page mpi_support MPI support in PaGMO
@@ -45,7 +53,7 @@ PaGMO can be configured to use MPI to dispatch parallel optimisation instances t
 
 \section mpi_requirements Requirements
 In order to enable and use MPI support in PaGMO a standard-compliant MPI implementation (e.g., Open MPI, MPICH2, etc.) must be available
-on all systems participating to the cluster. PaGMO uses basic MPI 1.2 calls such as MPI_Recv, MPI_Send etc., and does not employ any function
+on all systems participating to the cluster. PaGMO uses basic MPI 1.2 calls such as MPI_Recv, MPI_Isend, MPI_Waitany etc., and does not employ any function
 specific to MPI 2.x.
 
 For best performance, the root node of the MPI cluster (i.e., the node where mpiexec/mpirun is launched) should have a thread-safe
@@ -81,7 +89,19 @@ is tasked with the dispatch and coordination of jobs and does not perform any op
 
 Whenever an evolution method is called from from a pagmo::mpi_island, the island will check the list of available processors and, if a processor is available, will
 erase the processor ID from the list and dispatch the evolution to that processor. At the end of the evolution, the island retrieves the payload and adds the processor ID back
-to the list of available processors.
+to the list of available processors. An island prefers the processor that performed its previous evolution, if available.
+
+The processes with nonzero rank are persistent workers: they keep the population (and its problem) of each island they evolved resident in memory. When an island is
+evolved again on the same processor, only what changed since the previous evolution is transmitted: the individuals that differ (e.g., because of migration) and the champion,
+plus the problem if it has been modified. The worker replies in the same way with the individuals changed by the evolution, together with the evolved problem (so that,
+e.g., the number of function evaluations is kept up to date on the root process). Islands evolved on a different processor transmit their whole state, and the stale copy
+is discarded by the previous processor. The algorithm is instead sent along with every evolution and sent back with the state it reached (e.g., that of its random number
+generators), which the island keeps for the next evolution: the result of an evolution thus does not depend on the processor it was dispatched to.
+
+On the root process, all the MPI communication goes through a single progress thread using non-blocking sends and receives, so that the islands never block
+each other while waiting for their replies: each island thread serialises its own job and waits for the reply to be signalled. If the MPI implementation supports
+MPI_THREAD_MULTIPLE, the progress thread sleeps in MPI_Waitany and is woken up by a message to self when a new job is submitted; otherwise it polls its
+requests with MPI_Testsome, sleeping for a short (exponentially increasing) interval when nothing is happening.
 
 Whenever the number of MPI islands is at least equal to the MPI world size, it might happen that one or more islands are not able to acquire any processor at the beginning of
 the evolution, all the processors being busy. In such case a fair priority queue is created, and the islands waiting for a processor to be released are added to the
@@ -161,6 +181,88 @@ where hfile.txt is your hostfile.
 namespace pagmo
 {
 
+/// Changes of a population with respect to a reference population.
+/**
+ * Used to transmit a population to a process already knowing a previous state of it (the reference): only the
+ * individuals that differ from the reference and the champion are stored, as a binary util::snapshot record. If there is
+ * no reference, or the sizes of the populations differ, the whole population is stored instead.
+ *
+ * <b>NOTE</b>: this class is available only if PaGMO was compiled with MPI support.
+ */
+struct __PAGMO_VISIBLE mpi_population_delta
+{
+	mpi_population_delta();
+	explicit mpi_population_delta(const population &);
+	explicit mpi_population_delta(const population &, const population &);
+	void apply(boost::shared_ptr<population> &) const;
+	/// Whole population (null for a delta).
+	boost::shared_ptr<population>	m_pop;
+	/// Snapshot record of the changes (empty if there are none).
+	std::string			m_snapshot;
+	/// Serialization.
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & m_pop;
+		ar & m_snapshot;
+	}
+};
+
+/// Evolution job sent by the root process to a worker.
+/**
+ * <b>NOTE</b>: this class is available only if PaGMO was compiled with MPI support.
+ */
+struct __PAGMO_VISIBLE mpi_job
+{
+	mpi_job();
+	/// Identifier of the island (0 to shut down the worker).
+	std::size_t			m_island;
+	/// Algorithm evolving the population.
+	algorithm::base_ptr		m_algo;
+	/// Problem, if different from the one resident on the worker.
+	problem::base_ptr		m_prob;
+	/// Population, with respect to the one resident on the worker.
+	mpi_population_delta		m_delta;
+	/// Islands whose state can be discarded by the worker.
+	std::vector<std::size_t>	m_evict;
+	/// Serialization.
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & m_island;
+		ar & m_algo;
+		ar & m_prob;
+		ar & m_delta;
+		ar & m_evict;
+	}
+};
+
+/// Result of an evolution job sent by a worker to the root process.
+/**
+ * <b>NOTE</b>: this class is available only if PaGMO was compiled with MPI support.
+ */
+struct __PAGMO_VISIBLE mpi_result
+{
+	mpi_result();
+	/// Flag signalling whether the worker still holds the state of the island.
+	bool				m_resident;
+	/// Population, with respect to the one sent by the root process.
+	mpi_population_delta		m_delta;
+	/// Evolved algorithm (null if the evolution failed).
+	algorithm::base_ptr		m_algo;
+	/// Evolved problem (null if the evolution failed).
+	problem::base_ptr		m_prob;
+	/// Serialization.
+	template <class Archive>
+	void serialize(Archive &ar, const unsigned int)
+	{
+		ar & m_resident;
+		ar & m_delta;
+		ar & m_algo;
+		ar & m_prob;
+	}
+};
+
 /// MPI environment class.
 /**
  * This class is used to initialise the PaGMO MPI environment: an instance of this class should be created
@@ -201,10 +303,7 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 			MPI_Recv(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,source,1,MPI_COMM_WORLD,&status);
 			// Build the string from the vector.
 			const std::string buffer_str(buffer_char.begin(),buffer_char.end());
-			// Unpickle the payload.
-			std::stringstream ss(buffer_str);
-			boost::archive::text_iarchive ia(ss);
-			ia >> retval;
+			unpickle(retval,buffer_str);
 		}
 		/// Send MPI payload.
 		/**
@@ -218,10 +317,7 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 		static void send(const T &payload, int destination)
 		{
 			check_init();
-			std::stringstream ss;
-			boost::archive::text_oarchive oa(ss);
-			oa << payload;
-			const std::string buffer_str(ss.str());
+			const std::string buffer_str(pickle(payload));
 			std::vector<char> buffer_char(buffer_str.begin(),buffer_str.end());
 			// Send the size.
 			int size = boost::numeric_cast<int>(buffer_char.size());
@@ -230,11 +326,42 @@ class __PAGMO_VISIBLE mpi_environment: private boost::noncopyable
 			MPI_Send(static_cast<void *>(&buffer_char[0]),size,MPI_CHAR,destination,1,MPI_COMM_WORLD);
 		}
 		static bool iprobe(int);
+		static std::string exchange(int, const std::string &);
+		/// Serialise an object.
+		/**
+		 * @param[in] payload instance of class T that will be serialised.
+		 *
+		 * @return the serialised representation of payload.
+		 */
+		template <class T>
+		static std::string pickle(const T &payload)
+		{
+			std::stringstream ss;
+			boost::archive::text_oarchive oa(ss);
+			oa << payload;
+			return ss.str();
+		}
+		/// Deserialise an object.
+		/**
+		 * @param[out] retval instance of class T that will be deserialised.
+		 * @param[in] buffer serialised representation produced by pickle().
+		 */
+		template <class T>
+		static void unpickle(T &retval, const std::string &buffer)
+		{
+			std::stringstream ss(buffer);
+			boost::archive::text_iarchive ia(ss);
+			ia >> retval;
+		}
 	private:
+		class progress_engine;
 		static void listen();
 		static void check_init();
-		static bool	m_initialised;
-		static bool	m_multithread;
+		static bool					m_initialised;
+		static bool					m_multithread;
+		static int					m_size;
+		static int					m_rank;
+		static boost::scoped_ptr<progress_engine>	m_engine;
 };
 
 }
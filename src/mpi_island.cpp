@@ -29,10 +29,14 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <cstddef>
+#include <iostream>
 #include <list>
+#include <map>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "algorithm/base.h"
 #include "base_island.h"
@@ -49,9 +53,10 @@ namespace pagmo
 
 boost::mutex mpi_island::m_proc_mutex;
 boost::condition_variable mpi_island::m_proc_cond;
-boost::mutex mpi_island::m_mpi_mutex;
 std::list<mpi_island const *> mpi_island::m_queue;
 boost::scoped_ptr<std::set<int> > mpi_island::m_available_processors;
+std::size_t mpi_island::m_id_counter = 0;
+std::map<int,std::vector<std::size_t> > mpi_island::m_evictions;
 
 /// Constructor from problem::base, algorithm::base, number of individuals, migration probability and selection/replacement policies.
 /**
@@ -59,7 +64,7 @@ boost::scoped_ptr<std::set<int> > mpi_island::m_available_processors;
  */
 mpi_island::mpi_island(const algorithm::base &a, const problem::base &p, int n,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	base_island(a,p,n,s_policy,r_policy)
+	base_island(a,p,n,s_policy,r_policy),m_id(new_id()),m_worker(0)
 {}
 
 /// Constructor from population.
@@ -68,20 +73,34 @@ mpi_island::mpi_island(const algorithm::base &a, const problem::base &p, int n,
  */
 mpi_island::mpi_island(const algorithm::base &a, const population &pop,
 	const migration::base_s_policy &s_policy, const migration::base_r_policy &r_policy):
-	base_island(a,pop,s_policy,r_policy)
+	base_island(a,pop,s_policy,r_policy),m_id(new_id()),m_worker(0)
 {}
 
 /// Copy constructor.
 /**
+ * The state held by the workers is not shared with isl: the copy will transmit its whole state at the first evolution.
+ *
  * @see pagmo::base_island constructors.
  */
-mpi_island::mpi_island(const mpi_island &isl):base_island(isl)
+mpi_island::mpi_island(const mpi_island &isl):base_island(isl),m_id(new_id()),m_worker(0)
 {}
 
+/// Destructor.
+/**
+ * Waits for the end of the evolution and lets the worker holding the state of the island discard it.
+ */
+mpi_island::~mpi_island()
+{
+	join();
+	evict();
+}
+
 /// Assignment operator.
 mpi_island &mpi_island::operator=(const mpi_island &isl)
 {
 	base_island::operator=(isl);
+	// base_island has joined: the state held by the worker is now stale.
+	evict();
 	return *this;
 }
 
@@ -90,49 +109,72 @@ base_island_ptr mpi_island::clone() const
 	return base_island_ptr(new mpi_island(*this));
 }
 
-// Method that perform the actual evolution for the island population, and is used to distribute the computation load over multiple processors
+// Method that perform the actual evolution for the island population, and is used to distribute the computation load over multiple processors.
+// The worker holding the state of the island is preferred, so that only the changes need to be transmitted. The algorithm is
+// sent every time with the state it reached in the previous evolution, so that the outcome does not depend on which worker
+// performs the evolution.
 void mpi_island::perform_evolution(const algorithm::base &algo, population &pop) const
 {
-	// Create copy of data to be transmitted - will use a std::pair for packing everything in a single object.
-	const boost::shared_ptr<population> pop_copy(new population(pop));
-	const algorithm::base_ptr algo_copy = algo.clone();
-	const std::pair<boost::shared_ptr<population>,algorithm::base_ptr> out(pop_copy,algo_copy);
-	const int processor = acquire_processor();
-	if (mpi_environment::is_multithread()) {
-		mpi_environment::send(out,processor);
-	} else {
-		// Lock down MPI mutex before sending.
-		boost::lock_guard<boost::mutex> lock(m_mpi_mutex);
-		mpi_environment::send(out,processor);
+	if (m_algo_ref != m_algo) {
+		// The algorithm of the island was replaced: start from its current state.
+		m_algo_ref = m_algo;
+		m_remote_algo = algo.clone();
 	}
+	mpi_job job;
+	job.m_island = m_id;
+	job.m_algo = m_remote_algo;
+	const int processor = acquire_processor(job.m_evict);
 	bool successful = false;
-	boost::shared_ptr<population> in;
+	mpi_result in;
 	try {
-		if (mpi_environment::is_multithread()) {
-			mpi_environment::recv(in,processor);
+		if (processor == m_worker && m_remote_pop) {
+			job.m_delta = mpi_population_delta(*m_remote_pop,pop);
+			// The worker holds the problem evolved last time, the one of pop differs only if it was changed in the meantime.
+			if (!job.m_delta.m_pop && (!(pop.problem() == m_remote_pop->problem()) ||
+				pop.problem().get_fevals() != m_remote_pop->problem().get_fevals() ||
+				pop.problem().get_cevals() != m_remote_pop->problem().get_cevals()))
+			{
+				job.m_prob = pop.problem().clone();
+			}
 		} else {
-			while (true) {
-				{
-					boost::lock_guard<boost::mutex> lock(m_mpi_mutex);
-					if (mpi_environment::iprobe(processor)) {
-						mpi_environment::recv(in,processor);
-						break;
-					}
-				}
-				boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+			if (m_worker) {
+				// The state held by the previous worker is now stale.
+				boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+				m_evictions[m_worker].push_back(m_id);
 			}
+			job.m_delta = mpi_population_delta(pop);
+		}
+		// From now on, the worker's state is unknown until the reply is received.
+		m_worker = 0;
+		job.m_delta.apply(m_remote_pop);
+		if (job.m_prob) {
+			population_access::get_problem_ptr(*m_remote_pop) = job.m_prob;
+		}
+		mpi_environment::unpickle(in,mpi_environment::exchange(processor,mpi_environment::pickle(job)));
+		in.m_delta.apply(m_remote_pop);
+		if (in.m_algo) {
+			m_remote_algo = in.m_algo;
+		}
+		if (in.m_prob) {
+			population_access::get_problem_ptr(*m_remote_pop) = in.m_prob;
+		}
+		if (in.m_resident) {
+			m_worker = processor;
 		}
 		successful = true;
-	} catch (const boost::archive::archive_exception &e) {
-		std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
+	} catch (const std::exception &e) {
+		std::cout << "MPI Error during island evolution using " << algo.get_name() << ": " << e.what() << std::endl;
 	} catch (...) {
-		std::cout << "MPI Recv Error during island evolution using " << algo.get_name() << ", unknown exception caught. :(" << std::endl;
+		std::cout << "MPI Error during island evolution using " << algo.get_name() << ", unknown exception caught. :(" << std::endl;
+	}
+	if (!successful) {
+		// Whatever the worker holds is stale.
+		boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+		m_evictions[processor].push_back(m_id);
 	}
 	release_processor(processor);
 	if (successful) {
-		// NOTE: implement via population::swap (to be written) in order to avoid
-		// extra copying?
-		pop = *in;
+		pop = *m_remote_pop;
 	}
 }
 
@@ -159,7 +201,29 @@ void mpi_island::init_processors()
 	}
 }
 
-int mpi_island::acquire_processor() const
+std::size_t mpi_island::new_id()
+{
+	boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+	// 0 is reserved for the shutdown signal.
+	return ++m_id_counter;
+}
+
+// Let the worker holding the state of the island discard it.
+void mpi_island::evict() const
+{
+	boost::lock_guard<boost::mutex> lock(m_proc_mutex);
+	if (m_worker) {
+		m_evictions[m_worker].push_back(m_id);
+	}
+	m_worker = 0;
+	m_remote_pop.reset();
+	m_algo_ref.reset();
+	m_remote_algo.reset();
+}
+
+// Acquire a processor, preferring the one holding the state of the island. The islands whose state must be discarded
+// by the acquired processor are moved into evict.
+int mpi_island::acquire_processor(std::vector<std::size_t> &evict) const
 {
 	// Lock down before doing anything else.
 	boost::unique_lock<boost::mutex> lock(m_proc_mutex);
@@ -175,8 +239,17 @@ int mpi_island::acquire_processor() const
 		m_queue.pop_front();
 	}
 	pagmo_assert(!m_available_processors->empty());
-	const int retval = *m_available_processors->begin();
-	m_available_processors->erase(m_available_processors->begin());
+	std::set<int>::iterator it = m_available_processors->find(m_worker);
+	if (it == m_available_processors->end()) {
+		it = m_available_processors->begin();
+	}
+	const int retval = *it;
+	m_available_processors->erase(it);
+	std::map<int,std::vector<std::size_t> >::iterator ev = m_evictions.find(retval);
+	if (ev != m_evictions.end()) {
+		evict.swap(ev->second);
+		m_evictions.erase(ev);
+	}
 	return retval;
 }
 
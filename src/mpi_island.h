@@ -28,9 +28,13 @@
 #include <boost/scoped_ptr.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
 #include <list>
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base_island.h"
 #include "config.h"
@@ -88,6 +92,7 @@ class __PAGMO_VISIBLE mpi_island: public base_island
 		explicit mpi_island(const algorithm::base &, const population &,
 			const migration::base_s_policy & = migration::best_s_policy(),
 			const migration::base_r_policy & = migration::fair_r_policy());
+		~mpi_island();
 		mpi_island &operator=(const mpi_island &);
 		base_island_ptr clone() const;
 	protected:
@@ -103,14 +108,26 @@ class __PAGMO_VISIBLE mpi_island: public base_island
 			ar & boost::serialization::base_object<base_island>(*this);
 		}
 		static void init_processors();
-		int acquire_processor() const;
+		static std::size_t new_id();
+		int acquire_processor(std::vector<std::size_t> &) const;
 		void release_processor(int) const;
+		void evict() const;
 	private:
+		// Identifier of the island on the workers.
+		std::size_t					m_id;
+		// Worker holding the state of the island (0 if none) and copies of that state.
+		mutable int					m_worker;
+		mutable boost::shared_ptr<population>		m_remote_pop;
+		// Algorithm of the island and its state after the last evolution.
+		mutable algorithm::base_ptr			m_algo_ref;
+		mutable algorithm::base_ptr			m_remote_algo;
 		static boost::mutex				m_proc_mutex;
 		static boost::condition_variable		m_proc_cond;
-		static boost::mutex				m_mpi_mutex;
 		static boost::scoped_ptr<std::set<int> >	m_available_processors;
 		static std::list<mpi_island const *>		m_queue;
+		static std::size_t				m_id_counter;
+		// Islands to be discarded by each worker.
+		static std::map<int,std::vector<std::size_t> >	m_evictions;
 };
 
 }
@@ -28,6 +28,7 @@
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/uniform_real.hpp>
+#include <cstddef>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -40,6 +41,9 @@
 #include "population.h"
 #include "rng.h"
 #include "types.h"
+#include "util/hypervolume.h"
+#include "util/non_dominated_sorting.h"
+#include "util/pareto_dominance.h"
 #include "util/racing.h"
 #include "util/race_pop.h"
 
@@ -55,6 +59,89 @@ problem::base_ptr &population_access::get_problem_ptr(population &pop)
 	return pop.m_prob;
 }
 
+/// Overwrite an individual.
+/**
+ * The individual is copied as it is, without any check or evaluation. The champion is not updated.
+ *
+ * @param[in,out] pop population.
+ * @param[in] idx index of the individual.
+ * @param[in] ind new individual.
+ *
+ * @throws index_error if idx is out of range.
+ */
+void population_access::set_individual(population &pop, const population::size_type &idx, const population::individual_type &ind)
+{
+	if (idx >= pop.size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	pop.m_container[idx] = ind;
+	pop.invalidate_dom(idx);
+}
+
+/// Mutable access to an individual.
+/**
+ * The individual is marked as changed before being returned, so that the domination information is brought up to date when requested.
+ * Nothing else is checked or updated.
+ *
+ * @param[in,out] pop population.
+ * @param[in] idx index of the individual.
+ *
+ * @return reference to the individual at position idx.
+ *
+ * @throws index_error if idx is out of range.
+ */
+population::individual_type &population_access::get_individual(population &pop, const population::size_type &idx)
+{
+	if (idx >= pop.size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	pop.invalidate_dom(idx);
+	return pop.m_container[idx];
+}
+
+/// Overwrite the champion.
+/**
+ * @param[in,out] pop population.
+ * @param[in] champ new champion.
+ */
+void population_access::set_champion(population &pop, const population::champion_type &champ)
+{
+	pop.m_champion = champ;
+}
+
+/// Replace the individuals with empty ones.
+/**
+ * After the call, the population will contain n individuals with properly-sized current vectors, empty best vectors and no champion.
+ * No evaluation is performed: the individuals are meant to be overwritten with set_individual().
+ *
+ * @param[in,out] pop population.
+ * @param[in] n number of individuals.
+ */
+void population_access::reset(population &pop, const population::size_type &n)
+{
+	pop.clear();
+	for (population::size_type i = 0; i < n; ++i) {
+		pop.append_empty_individual();
+	}
+}
+
+/// Initialise randomly the velocity of an individual.
+/**
+ * The velocity is drawn as in push_back(), from the random number generator of the population.
+ *
+ * @param[in,out] pop population.
+ * @param[in] idx index of the individual.
+ *
+ * @throws index_error if idx is out of range.
+ */
+void population_access::init_velocity(population &pop, const population::size_type &idx)
+{
+	if (idx >= pop.size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	pop.init_velocity(idx);
+}
+
 /// Constructor from problem::base and number of individuals.
 /**
  * Will store a copy of the problem and will initialise the population to n randomly-generated individuals.
@@ -66,7 +153,8 @@ problem::base_ptr &population_access::get_problem_ptr(population &pop)
  *
  * @throw value_error if n is negative.
  */
-population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed)
+population::population(const problem::base &p, int n, const boost::uint32_t &seed):m_prob(p.clone()), m_n_dom_stale(0), m_pareto_rank(n), m_crowding_d(n), m_drng(seed),m_urng(seed),
+	m_epoch(0),m_hv_cache_epoch(0),m_hv_cache_hits(0),m_hv_cache_misses(0)
 {
 	if (n < 0) {
 		pagmo_throw(value_error,"number of individuals cannot be negative");
@@ -81,6 +169,7 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
 		m_container.push_back(individual_type());
 		m_dom_list.push_back(std::vector<size_type>());
 		m_dom_count.push_back(0);
+		m_dom_stale.push_back(0);
 		// Resize individual's elements.
 		m_container.back().cur_x.resize(p_size);
 		m_container.back().cur_v.resize(p_size);
@@ -89,9 +178,9 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
 		m_container.back().best_x.resize(p_size);
 		m_container.back().best_c.resize(c_size);
 		m_container.back().best_f.resize(f_size);
-		// Initialise randomly the individual.
-		reinit(i);
 	}
+	// Initialise randomly the individuals.
+	reinit();
 }
 
 /// Copy constructor.
@@ -100,9 +189,18 @@ population::population(const problem::base &p, int n, const boost::uint32_t &see
  *
  * @param[in] p population used to initialise this.
  */
-population::population(const population &p):m_prob(p.m_prob->clone()),m_container(p.m_container),m_dom_list(p.m_dom_list),m_dom_count(p.m_dom_count),
-	m_champion(p.m_champion), m_pareto_rank(p.m_pareto_rank), m_crowding_d(p.m_crowding_d),m_drng(p.m_drng),m_urng(p.m_urng)
-{}
+population::population(const population &p):m_prob(p.m_prob->clone()),m_container(p.m_container),m_champion(p.m_champion),
+	m_pareto_rank(p.m_pareto_rank), m_crowding_d(p.m_crowding_d),m_drng(p.m_drng),m_urng(p.m_urng),
+	m_epoch(p.m_epoch),m_hv_cache(p.m_hv_cache),m_hv_cache_epoch(p.m_hv_cache_epoch),m_hv_cache_hits(p.m_hv_cache_hits),
+	m_hv_cache_misses(p.m_hv_cache_misses)
+{
+	// Once p is synchronised, its domination information is not written by concurrent const accesses.
+	p.sync_dom();
+	m_dom_list = p.m_dom_list;
+	m_dom_count = p.m_dom_count;
+	m_dom_stale = p.m_dom_stale;
+	m_n_dom_stale = p.m_n_dom_stale;
+}
 
 /// Assignment operator.
 /**
@@ -119,19 +217,27 @@ population &population::operator=(const population &p)
 		// Perform the copies.
 		m_prob = p.m_prob->clone();
 		m_container = p.m_container;
+		p.sync_dom();
 		m_dom_list = p.m_dom_list;
 		m_dom_count = p.m_dom_count;
+		m_dom_stale = p.m_dom_stale;
+		m_n_dom_stale = p.m_n_dom_stale;
 		m_champion = p.m_champion;
 		m_pareto_rank = p.m_pareto_rank;
 		m_crowding_d = p.m_crowding_d;
 		m_drng = p.m_drng;
 		m_urng = p.m_urng;
+		m_epoch = p.m_epoch;
+		m_hv_cache = p.m_hv_cache;
+		m_hv_cache_epoch = p.m_hv_cache_epoch;
+		m_hv_cache_hits = p.m_hv_cache_hits;
+		m_hv_cache_misses = p.m_hv_cache_misses;
 	}
 	return *this;
 }
 
 // Update the domination list and the domination count when the individual at position n has changed
-void population::update_dom(const size_type &n)
+void population::update_dom(const size_type &n) const
 {
 	// The algorithm works as follow:
 	// 1) For each element in m_dom_list[n] decrease the domination count by one. (m_dom_count[m_dom_list[n][j]] -= 1)
@@ -152,10 +258,13 @@ void population::update_dom(const size_type &n)
 	// Reset the dom_count of individual at position n.
 	m_dom_count[n] = 0;
 
+	// With plain Pareto dominance both directions are checked at once.
+	const bool pareto = !m_prob->get_c_dimension() && m_prob->has_pareto_dominance();
 	for (size_type i = 0; i < size; ++i) {
 		if (i != n) {
+			const int cmp = pareto ? util::pareto_dominance::compare(m_container[i].best_f,m_container[n].best_f) : 0;
 			// Check if individual in position i dominates individual in position n.
-			if (m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[n].best_f,m_container[n].best_c)) {
+			if (pareto ? cmp > 0 : m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[n].best_f,m_container[n].best_c)) {
 				// Update the domination count in n.
 				m_dom_count[n]++;
 				// Update the domination list in i.
@@ -171,7 +280,7 @@ void population::update_dom(const size_type &n)
 				}
 			}
 			// Check if individual in position n dominates individual in position i.
-			if (m_prob->compare_fc(m_container[n].best_f,m_container[n].best_c,m_container[i].best_f,m_container[i].best_c)) {
+			if (pareto ? cmp < 0 : m_prob->compare_fc(m_container[n].best_f,m_container[n].best_c,m_container[i].best_f,m_container[i].best_c)) {
 				m_dom_list[n].push_back(i);
 				m_dom_count[i]++;
 			}
@@ -179,6 +288,59 @@ void population::update_dom(const size_type &n)
 	}
 }
 
+// Mark the domination information of the individual at position n as out of date.
+void population::invalidate_dom(const size_type &n)
+{
+	pagmo_assert(m_dom_stale.size() == m_container.size() && n < m_container.size());
+	touch();
+	if (!m_dom_stale[n]) {
+		m_dom_stale[n] = 1;
+		++m_n_dom_stale;
+	}
+}
+
+// Bring the domination lists and counts up to date. The update is done under a lock, so that const methods reading
+// the domination information can be called concurrently.
+void population::sync_dom() const
+{
+	boost::lock_guard<boost::mutex> lock(m_dom_mutex);
+	if (!m_n_dom_stale) {
+		return;
+	}
+	const size_type size = m_container.size();
+	pagmo_assert(m_dom_list.size() == size && m_dom_count.size() == size && m_dom_stale.size() == size);
+	// Updating an individual costs two comparisons with each of the others, rebuilding everything costs one
+	// comparison per ordered pair.
+	if (2 * m_n_dom_stale > size && !m_prob->get_c_dimension() && m_prob->has_pareto_dominance()) {
+		std::vector<fitness_vector> f(size);
+		for (size_type i = 0; i < size; ++i) {
+			f[i] = m_container[i].best_f;
+		}
+		util::pareto_dominance(f).compute_dominance(m_dom_list,m_dom_count);
+	} else if (2 * m_n_dom_stale > size) {
+		for (size_type i = 0; i < size; ++i) {
+			m_dom_list[i].clear();
+			m_dom_count[i] = 0;
+		}
+		for (size_type i = 0; i < size; ++i) {
+			for (size_type j = 0; j < size; ++j) {
+				if (i != j && m_prob->compare_fc(m_container[i].best_f,m_container[i].best_c,m_container[j].best_f,m_container[j].best_c)) {
+					m_dom_list[i].push_back(j);
+					m_dom_count[j]++;
+				}
+			}
+		}
+	} else {
+		for (size_type i = 0; i < size; ++i) {
+			if (m_dom_stale[i]) {
+				update_dom(i);
+			}
+		}
+	}
+	std::fill(m_dom_stale.begin(),m_dom_stale.end(),0);
+	m_n_dom_stale = 0;
+}
+
 // Init randomly the velocity of the individual in position idx.
 void population::init_velocity(const size_type &idx)
 {
@@ -213,13 +375,37 @@ double population::mean_velocity() const {
 
 /// Re-initialise all individuals
 /**
+ * Equivalent to calling reinit(const size_type &) on each individual, but the fitnesses of the new
+ * decision vectors are computed with a single call to problem::base::objfun_batch().
+ *
  * @see population::reinit(const size_type &).
  */
 void population::reinit()
 {
-	for (size_type i = 0; i < size(); ++i)
-	{
-		reinit(i);
+	const size_type size = this->size();
+	std::vector<decision_vector> x(size);
+	for (size_type i = 0; i < size; ++i) {
+		// Initialise randomly decision and velocity vectors.
+		init_x(i);
+		init_velocity(i);
+		// Fill in the constraints.
+		m_prob->compute_constraints(m_container[i].cur_c,m_container[i].cur_x);
+		x[i] = m_container[i].cur_x;
+	}
+	// Compute the fitnesses.
+	std::vector<fitness_vector> f;
+	m_prob->objfun_batch(f,x);
+	for (size_type i = 0; i < size; ++i) {
+		m_container[i].cur_f.swap(f[i]);
+		// Best decision vector is current decision vector, best fitness is current fitness, best constraints are current constraints.
+		m_container[i].best_x = m_container[i].cur_x;
+		m_container[i].best_f = m_container[i].cur_f;
+		m_container[i].best_c = m_container[i].cur_c;
+	}
+	// Update champion and domination lists only once all individuals have been evaluated.
+	for (size_type i = 0; i < size; ++i) {
+		update_champion(i);
+		invalidate_dom(i);
 	}
 }
 
@@ -238,15 +424,8 @@ void population::reinit(const size_type &idx)
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
-	const decision_vector::size_type p_size = m_prob->get_dimension(), i_size = m_prob->get_i_dimension();
-	// Initialise randomly the continuous part of the decision vector.
-	for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
-		m_container[idx].cur_x[j] = boost::uniform_real<double>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_drng);
-	}
-	// Initialise randomly the integer part of the decision vector.
-	for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
-		m_container[idx].cur_x[j] = boost::uniform_int<int>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_urng);
-	}
+	// Initialise randomly the decision vector.
+	init_x(idx);
 	// Initialise randomly the velocity vector.
 	init_velocity(idx);
 	// Fill in the constraints.
@@ -260,7 +439,21 @@ void population::reinit(const size_type &idx)
 	// Update the champion.
 	update_champion(idx);
 	// Update the domination lists.
-	update_dom(idx);
+	invalidate_dom(idx);
+}
+
+// Init randomly the decision vector of the individual in position idx.
+void population::init_x(const size_type &idx)
+{
+	const decision_vector::size_type p_size = m_prob->get_dimension(), i_size = m_prob->get_i_dimension();
+	// Initialise randomly the continuous part of the decision vector.
+	for (decision_vector::size_type j = 0; j < p_size - i_size; ++j) {
+		m_container[idx].cur_x[j] = boost::uniform_real<double>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_drng);
+	}
+	// Initialise randomly the integer part of the decision vector.
+	for (decision_vector::size_type j = p_size - i_size; j < p_size; ++j) {
+		m_container[idx].cur_x[j] = boost::uniform_int<int>(m_prob->get_lb()[j],m_prob->get_ub()[j])(m_urng);
+	}
 }
 
 
@@ -298,6 +491,7 @@ const std::vector<population::size_type> &population::get_domination_list(const
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
+	sync_dom();
 	return m_dom_list[idx];
 }
 
@@ -316,6 +510,7 @@ population::size_type population::get_domination_count(const size_type &idx) con
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid index");
 	}
+	sync_dom();
 	return m_dom_count[idx];
 }
 
@@ -378,7 +573,9 @@ struct one_dim_fit_comp {
 /**
  * Computes all pareto fronts, updates the pareto rank and the crowding distance of each individual.
  * Member variables for rank and crowding distance are set to zero and domination lists and
- * domination count are used to for the computation.
+ * domination count are used to for the computation. For unconstrained problems using plain Pareto
+ * dominance (see problem::base::has_pareto_dominance()), the ranks are instead computed by
+ * util::non_dominated_sorting in O(N log^(M-1) N), and the domination lists are left untouched.
  */
 
 void population::update_pareto_information() const {
@@ -390,6 +587,29 @@ void population::update_pareto_information() const {
 	std::fill(m_pareto_rank.begin(), m_pareto_rank.end(), 0);
 	std::fill(m_crowding_d.begin(), m_crowding_d.end(), 0);
 
+	if (!m_prob->get_c_dimension() && m_prob->has_pareto_dominance()) {
+		std::vector<fitness_vector> f;
+		f.reserve(size());
+		for (population::size_type idx = 0; idx < size(); ++idx) {
+			f.push_back(m_container[idx].best_f);
+		}
+		std::vector<std::size_t> rank;
+		util::non_dominated_sorting::compute_ranks(rank,f);
+		std::vector<std::vector<population::size_type> > fronts;
+		for (population::size_type idx = 0; idx < size(); ++idx) {
+			m_pareto_rank[idx] = rank[idx];
+			if (rank[idx] >= fronts.size()) {
+				fronts.resize(rank[idx] + 1);
+			}
+			fronts[rank[idx]].push_back(idx);
+		}
+		for (std::vector<std::vector<population::size_type> >::size_type i = 0; i < fronts.size(); ++i) {
+			population::update_crowding_d(fronts[i]);
+		}
+		return;
+	}
+	sync_dom();
+
 	// We define some utility vectors .....
 	std::vector<population::size_type> F,S;
 
@@ -536,6 +756,115 @@ fitness_vector population::compute_nadir() const {
 	return nadir;
 }
 
+namespace {
+
+// Maximum number of contribution vectors cached for a single epoch.
+const std::vector<double>::size_type hv_cache_capacity = 32;
+
+}
+
+// Start a new modification epoch.
+void population::touch()
+{
+	++m_epoch;
+}
+
+/// Modification epoch.
+/**
+ * The epoch is increased by every method modifying the individuals of the population, so that two queries made at the same
+ * epoch are guaranteed to see the same individuals. Copies of a population start from the epoch of the original.
+ *
+ * @return current modification epoch.
+ */
+boost::uint64_t population::get_epoch() const
+{
+	return m_epoch;
+}
+
+/// Hypervolume contributions of a group of individuals.
+/**
+ * Computes the exclusive hypervolume contributions of the current fitness vectors of the individuals at positions idx,
+ * with respect to r_point, using the hv algorithm chosen by util::hypervolume. The result is cached until the population
+ * is modified: repeating the query at the same epoch with the same indices (in the same order) and reference point returns
+ * the cached values without computing any hypervolume.
+ *
+ * @param[in] idx positional indices of the individuals.
+ * @param[in] r_point reference point.
+ *
+ * @return exclusive contributions, in the order of idx.
+ *
+ * @throws index_error if any element of idx is out of range.
+ * @throws value_error if idx is empty, or if the fitness vectors and the reference point are not compatible (see util::hypervolume).
+ */
+std::vector<double> population::get_hv_contributions(const std::vector<size_type> &idx, const fitness_vector &r_point) const
+{
+	if (idx.empty()) {
+		pagmo_throw(value_error,"cannot compute the contributions of an empty group of individuals");
+	}
+	for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+		if (idx[i] >= size()) {
+			pagmo_throw(index_error,"invalid individual position");
+		}
+	}
+	if (m_hv_cache_epoch != m_epoch) {
+		m_hv_cache.clear();
+		m_hv_cache_epoch = m_epoch;
+	}
+	for (std::vector<hv_cache_entry>::size_type i = 0; i < m_hv_cache.size(); ++i) {
+		if (m_hv_cache[i].idx == idx && m_hv_cache[i].r_point == r_point) {
+			++m_hv_cache_hits;
+			return m_hv_cache[i].contributions;
+		}
+	}
+	++m_hv_cache_misses;
+	std::vector<fitness_vector> points(idx.size());
+	for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+		points[i] = m_container[idx[i]].cur_f;
+	}
+	util::hypervolume hv(points, false);
+	hv.set_copy_points(false);
+	std::vector<double> c = hv.contributions(r_point);
+	// When full, keep the earliest entries: an unchanged population is typically queried again in the same sequence.
+	if (m_hv_cache.size() < hv_cache_capacity) {
+		m_hv_cache.push_back(hv_cache_entry());
+		m_hv_cache.back().idx = idx;
+		m_hv_cache.back().r_point = r_point;
+		m_hv_cache.back().contributions = c;
+	}
+	return c;
+}
+
+/// Number of hypervolume contribution requests served from the cache.
+/**
+ * Counts the calls to get_hv_contributions() on this population that did not compute any hypervolume. Copies of a population
+ * start from the counters of the original.
+ *
+ * @return number of cache hits since the construction of the population or the last call to reset_hv_cache_counters().
+ */
+boost::uint64_t population::get_hv_cache_hits() const
+{
+	return m_hv_cache_hits;
+}
+
+/// Number of hypervolume contribution requests computed.
+/**
+ * Counts the calls to get_hv_contributions() on this population that were not found in the cache. Copies of a population
+ * start from the counters of the original.
+ *
+ * @return number of cache misses since the construction of the population or the last call to reset_hv_cache_counters().
+ */
+boost::uint64_t population::get_hv_cache_misses() const
+{
+	return m_hv_cache_misses;
+}
+
+/// Reset the hypervolume cache counters of the population.
+void population::reset_hv_cache_counters()
+{
+	m_hv_cache_hits = 0;
+	m_hv_cache_misses = 0;
+}
+
 /// Crowded comparison functor.
 /**
  * A binary functor that can be used to sort population individuals with respect
@@ -849,6 +1178,7 @@ std::string population::human_readable() const
 {
 	std::ostringstream oss;
 	oss << human_readable_terse();
+	sync_dom();
 	if (size()) {
 		oss << "\nList of individuals:\n";
 		for (size_type i = 0; i < size(); ++i) {
@@ -900,6 +1230,78 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	m_prob->objfun(m_container[idx].cur_f,x);
 	// Update current constraints vector.
 	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	// Update bests, champion and domination lists.
+	update_bests(idx);
+}
+
+/// Set the decision vector of individual at position idx to x, whose fitness is already known.
+/**
+ * Same as set_x(idx,x), but the objective function is not called: f is taken to be the fitness of x as computed
+ * by the problem of the population (e.g., by a previous call to problem::base::objfun_batch()). This avoids evaluating
+ * x a second time once it has been evicted from the fitness cache of the problem.
+ *
+ * @param[in] idx positional index of the individual to be set.
+ * @param[in] x decision vector to be set for the individual at position idx.
+ * @param[in] f fitness vector of x.
+ *
+ * @throws value_error if problem::base::verify_x() returns false on x or if f has not the fitness dimension of the problem.
+ * @throws index_error if idx is not smaller than size().
+ */
+void population::set_x(const size_type &idx, const decision_vector &x, const fitness_vector &f)
+{
+	if (idx >= size()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	if (!m_prob->verify_x(x)) {
+		pagmo_throw(value_error,"decision vector is not compatible with problem");
+	}
+	if (f.size() != m_prob->get_f_dimension()) {
+		pagmo_throw(value_error,"fitness vector is not compatible with problem");
+	}
+	m_container[idx].cur_x = x;
+	m_container[idx].cur_f = f;
+	m_prob->compute_constraints(m_container[idx].cur_c,x);
+	update_bests(idx);
+}
+
+/// Set the decision vectors of a group of individuals.
+/**
+ * Equivalent to calling set_x(idx[i],x[i]) for each i, but the fitnesses are computed with a single call to
+ * problem::base::objfun_batch(). Nothing is modified if any of the indices or decision vectors is invalid.
+ *
+ * @param[in] idx positional indices of the individuals to be set.
+ * @param[in] x decision vectors to be set for the individuals at positions idx.
+ *
+ * @throws value_error if the sizes of idx and x differ or if problem::base::verify_x() returns false on any element of x.
+ * @throws index_error if any element of idx is not smaller than size().
+ */
+void population::set_x(const std::vector<size_type> &idx, const std::vector<decision_vector> &x)
+{
+	if (idx.size() != x.size()) {
+		pagmo_throw(value_error,"the number of indices and decision vectors must be the same");
+	}
+	for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+		if (idx[i] >= size()) {
+			pagmo_throw(index_error,"invalid individual position");
+		}
+		if (!m_prob->verify_x(x[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+	}
+	std::vector<fitness_vector> f;
+	m_prob->objfun_batch(f,x);
+	for (std::vector<size_type>::size_type i = 0; i < idx.size(); ++i) {
+		m_container[idx[i]].cur_x = x[i];
+		m_container[idx[i]].cur_f.swap(f[i]);
+		m_prob->compute_constraints(m_container[idx[i]].cur_c,x[i]);
+		update_bests(idx[i]);
+	}
+}
+
+// Update best vectors of the individual in position idx after its current vectors have been set, then update
+// the champion and the domination lists.
+void population::update_bests(const size_type &idx)
+{
 	// If needed, update the best decision, fitness and constraint vectors for the individual.
 	// NOTE: we update the bests in two cases:
 	// - the bests are empty, meaning they are not defined and we are being called by push_back()
@@ -916,7 +1318,7 @@ void population::set_x(const size_type &idx, const decision_vector &x)
 	// Update the champion.
 	update_champion(idx);
 	// Updated domination lists.
-	update_dom(idx);
+	invalidate_dom(idx);
 }
 
 /// Erase individual idx
@@ -936,6 +1338,9 @@ void population::erase(const population::size_type & idx) {
 	if (idx >= size()) {
 		pagmo_throw(index_error,"invalid individual position");
 	}
+	sync_dom();
+	touch();
+	m_dom_stale.erase(m_dom_stale.begin() + idx);
 	for (population::size_type i = 0; i < m_dom_list[idx].size(); ++i) {
 		m_dom_count[m_dom_list[idx][i]]--;
 	}
@@ -971,14 +1376,56 @@ void population::push_back(const decision_vector &x)
 		pagmo_throw(value_error,"decision vector is not compatible with problem");
 
 	}
+	// Push back an empty individual.
+	append_empty_individual();
+	// Set the individual.
+	set_x(m_container.size() - 1,x);
+	// Initialise randomly the velocity vector.
+	init_velocity(m_container.size() - 1);
+}
+
+/// Append individuals with given decision vectors.
+/**
+ * Equivalent to calling push_back() on each element of x, but the fitnesses are computed with a single call to
+ * problem::base::objfun_batch(). Nothing is appended if any of the decision vectors is invalid.
+ *
+ * @param[in] x decision vectors of the individuals to be appended.
+ *
+ * @throws value_error if problem::base::verify_x() returns false on any element of x.
+ */
+void population::push_back(const std::vector<decision_vector> &x)
+{
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (!m_prob->verify_x(x[i])) {
+			pagmo_throw(value_error,"decision vector is not compatible with problem");
+		}
+	}
+	std::vector<fitness_vector> f;
+	m_prob->objfun_batch(f,x);
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		append_empty_individual();
+		const size_type idx = m_container.size() - 1;
+		m_container[idx].cur_x = x[i];
+		m_container[idx].cur_f.swap(f[i]);
+		m_prob->compute_constraints(m_container[idx].cur_c,x[i]);
+		update_bests(idx);
+		init_velocity(idx);
+	}
+}
+
+// Push back an individual with properly-sized current vectors.
+void population::append_empty_individual()
+{
 	// Store sizes temporarily.
 	const fitness_vector::size_type f_size = m_prob->get_f_dimension();
 	const constraint_vector::size_type c_size = m_prob->get_c_dimension();
 	const decision_vector::size_type p_size = m_prob->get_dimension();
+	touch();
 	// Push back an empty individual.
 	m_container.push_back(individual_type());
 	m_dom_list.push_back(std::vector<size_type>());
 	m_dom_count.push_back(0);
+	m_dom_stale.push_back(0);
 	// Resize individual's elements.
 	m_container.back().cur_x.resize(p_size);
 	m_container.back().cur_v.resize(p_size);
@@ -986,10 +1433,6 @@ void population::push_back(const decision_vector &x)
 	m_container.back().cur_f.resize(f_size);
 	// NOTE: do not allocate space for bests, as they are not defined yet. set_x will take
 	// care of it.
-	// Set the individual.
-	set_x(m_container.size() - 1,x);
-	// Initialise randomly the velocity vector.
-	init_velocity(m_container.size() - 1);
 }
 
 /// Set the velocity vector of individual at position idx.
@@ -1007,8 +1450,9 @@ void population::set_v(const size_type &idx, const decision_vector &v)
 	if (v.size() != this->problem().get_dimension()) {
 		pagmo_throw(value_error,"velocity vector is not compatible with problem");
 	}
-	// Set decision vector.
+	// Set velocity vector.
 	m_container[idx].cur_v = v;
+	touch();
 }
 
 /// Get constant reference to internal problem::base object.
@@ -1052,9 +1496,12 @@ void population::clear()
 	m_container.clear();
 	m_dom_list.clear();
 	m_dom_count.clear();
+	m_dom_stale.clear();
+	m_n_dom_stale = 0;
 	m_crowding_d.clear();
 	m_pareto_rank.clear();
 	m_champion = champion_type();
+	touch();
 }
 
 /// Iterator to the beginning of the population.
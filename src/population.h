@@ -31,6 +31,10 @@
 #include <string>
 #include <vector>
 
+#include <boost/cstdint.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
 #include "config.h"
 #include "problem/base.h"
 #include "rng.h"
@@ -62,8 +66,20 @@ typedef boost::shared_ptr<base> base_ptr;
  * (identified by their positional index in the population) which I dominates, and a 'domination count' containing the number
  * of individuals that dominate I. Individual I1 is dominated by individual I2 if problem::base::compare_fc
  * on the fitness and constraints vectors of I1 and I2 respectively returns true.
+ * The domination lists are maintained lazily: modifying an individual only marks it, and the lists are brought up to date
+ * when they are requested (get_domination_list(), get_domination_count(), ...). The update is serialised by a mutex, so
+ * that these getters can be called concurrently on a population that is not being
+ * modified. Other const methods still update cached data without locking: update_pareto_information() and the methods
+ * calling it (compute_pareto_fronts(), get_best_idx(), ...), get_hv_contributions(), and those drawing random numbers.
+ * They must not be called concurrently on the same population. If the problem uses plain Pareto dominance
+ * (see problem::base::has_pareto_dominance()) and is unconstrained, Pareto ranks are computed by util::non_dominated_sorting
+ * without building the domination lists at all.
  * The best/worst individuals in the population are computed according to the crowding distance operator (in case of multi-objective problems)
  *
+ * Every modification of the individuals increases the modification epoch of the population (see get_epoch()). The hypervolume
+ * contributions requested through get_hv_contributions() are cached for the current epoch, so that selection and replacement
+ * schemes querying an unchanged population (e.g., the hypervolume-based migration policies) do not repeat the computation.
+ *
  * @author Francesco Biscani (bluescarni@gmail.com)
  * @author Dario Izzo (dario.izzo@googlemail.com)
  */
@@ -212,6 +228,13 @@ class __PAGMO_VISIBLE population
 		fitness_vector compute_ideal() const;
 		fitness_vector compute_nadir() const;
 
+		// Hypervolume stuff
+		boost::uint64_t get_epoch() const;
+		std::vector<double> get_hv_contributions(const std::vector<size_type> &, const fitness_vector &) const;
+		boost::uint64_t get_hv_cache_hits() const;
+		boost::uint64_t get_hv_cache_misses() const;
+		void reset_hv_cache_counters();
+
 		const problem::base &problem() const;
 		const champion_type &champion() const;
 		std::string human_readable_terse() const;
@@ -220,8 +243,11 @@ class __PAGMO_VISIBLE population
 		std::vector<size_type> get_best_idx(const size_type & N) const;
 		size_type get_worst_idx() const;
 		void set_x(const size_type &, const decision_vector &);
+		void set_x(const size_type &, const decision_vector &, const fitness_vector &);
+		void set_x(const std::vector<size_type> &, const std::vector<decision_vector> &);
 		void set_v(const size_type &, const decision_vector &);
 		void push_back(const decision_vector &);
+		void push_back(const std::vector<decision_vector> &);
 		void erase(const size_type &);
 		size_type size() const;
 		const_iterator begin() const;
@@ -260,13 +286,19 @@ class __PAGMO_VISIBLE population
 
 	private:
 		void init_velocity(const size_type &);
+		void init_x(const size_type &);
 		void update_champion(const size_type &);
+		void update_bests(const size_type &);
+		void append_empty_individual();
 
 		// Multi-objective stuff
 		void update_crowding_d(std::vector<size_type>) const;
+		void sync_dom() const;
 
 	protected:
-		void update_dom(const size_type &);
+		void update_dom(const size_type &) const;
+		void invalidate_dom(const size_type &);
+		void touch();
 
 	private:
 		// Data members + their serialization
@@ -278,12 +310,25 @@ class __PAGMO_VISIBLE population
 			ar & m_container;
 			ar & m_dom_list;
 			ar & m_dom_count;
+			ar & m_dom_stale;
+			ar & m_n_dom_stale;
 			ar & m_pareto_rank;
 			ar & m_crowding_d;
 			ar & m_champion;
 			ar & m_drng;
 			ar & m_urng;
+			// The hypervolume cache is not archived: a loaded population starts a new epoch.
+			if (Archive::is_loading::value) {
+				touch();
+			}
 		}
+		// Cached hypervolume contributions of a group of individuals.
+		struct hv_cache_entry
+		{
+			std::vector<size_type>	idx;
+			fitness_vector		r_point;
+			std::vector<double>	contributions;
+		};
 		// Problem.
 		problem::base_ptr				m_prob;
 	protected:
@@ -291,9 +336,14 @@ class __PAGMO_VISIBLE population
 		// the set_x mechanism avoiding function re-evaluations. (use this option at your own risk)
 		container_type					m_container;
 		// List of dominated individuals.
-		std::vector<std::vector<size_type> >		m_dom_list;
+		mutable std::vector<std::vector<size_type> >	m_dom_list;
 		// Domination Count (number of dominant individuals)
-		std::vector<size_type>				m_dom_count;
+		mutable std::vector<size_type>			m_dom_count;
+		// Flags marking the individuals whose domination information is out of date, and their number.
+		mutable std::vector<char>			m_dom_stale;
+		mutable size_type				m_n_dom_stale;
+		// Protects the lazy update of the domination information (not copied).
+		mutable boost::mutex				m_dom_mutex;
 	private:
 		// Population champion.
 		champion_type					m_champion;
@@ -305,6 +355,14 @@ class __PAGMO_VISIBLE population
 		mutable	rng_double				m_drng;
 		// uint32 random number generator.
 		mutable	rng_uint32				m_urng;
+		// Modification epoch.
+		boost::uint64_t					m_epoch;
+		// Hypervolume contributions computed at epoch m_hv_cache_epoch.
+		mutable std::vector<hv_cache_entry>		m_hv_cache;
+		mutable boost::uint64_t				m_hv_cache_epoch;
+		// Number of contribution requests served from the cache and computed.
+		mutable boost::uint64_t				m_hv_cache_hits;
+		mutable boost::uint64_t				m_hv_cache_misses;
 };
 
 // Streaming operator for the population
@@ -317,6 +375,11 @@ __PAGMO_VISIBLE_FUNC std::ostream &operator<<(std::ostream &, const population::
 struct __PAGMO_VISIBLE population_access
 {
 	static problem::base_ptr &get_problem_ptr(population &);
+	static void set_individual(population &, const population::size_type &, const population::individual_type &);
+	static void set_champion(population &, const population::champion_type &);
+	static void reset(population &, const population::size_type &);
+	static void init_velocity(population &, const population::size_type &);
+	static population::individual_type &get_individual(population &, const population::size_type &);
 };
 
 }
@@ -25,10 +25,12 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "ackley.h"
 
@@ -69,18 +71,17 @@ base_ptr ackley::clone() const
 void ackley::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	std::vector<double>::size_type n = x.size();
-	f[0]=0;
-
-	double omega = 2.0 * M_PI;
-	double s1=0.0, s2=0.0;
-	double nepero=exp(1.0);
+	util::kernels::ackley(&f[0],&x[0],1,x.size());
+}
 
-	for (std::vector<double>::size_type i=0; i<n; i++){
-		s1 += x[i]*x[i];
-		s2 += cos(omega*x[i]);
+/// Implementation of the batch objective function.
+void ackley::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
 	}
-	f[0] = -20*exp(-0.2 * sqrt(1.0/n * s1))-exp(1.0/n*s2)+ 20 + nepero;
+	util::kernels::evaluate(util::kernels::ackley,f,x);
 }
 
 std::string ackley::get_name() const
@@ -88,6 +89,11 @@ std::string ackley::get_name() const
 	return "Ackley";
 }
 
+bool ackley::is_thread_safe() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::ackley)
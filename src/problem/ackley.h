@@ -26,6 +26,7 @@
 #define PAGMO_PROBLEM_ACKLEY_H
 
 #include <string>
+#include <vector>
 
 #include "../serialization.h"
 #include "../types.h"
@@ -54,8 +55,10 @@ class __PAGMO_VISIBLE ackley : public base
 		ackley(int = 1);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void batch_objfun_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -25,11 +25,13 @@
 // 30/01/10 Created by Francesco Biscani.
 
 #include <algorithm>
+#include <boost/functional/hash.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <boost/numeric/conversion/bounds.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/random/uniform_real.hpp>
 #include <boost/ref.hpp>
+#include <boost/unordered_map.hpp>
 #include <cmath>
 #include <climits>
 #include <cstddef>
@@ -44,6 +46,7 @@
 #include "../exceptions.h"
 #include "../population.h"
 #include "../types.h"
+#include "../util/thread_pool.h"
 #include "base.h"
 
 namespace pagmo
@@ -66,15 +69,14 @@ base::base(int n, int ni, int nf, int nc, int nic, const double &c_tol): //TODO
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),
+	m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_eval_threads(1)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -112,15 +114,14 @@ base::base(int n, int ni, int nf, int nc, int nic, const std::vector<double> &c_
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),
+	m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_eval_threads(1)
 {
 	if (c_tol.size() != static_cast<constraint_vector::size_type>(nc) ) {
 		pagmo_throw(value_error,"invalid constraints vector dimension");
@@ -165,15 +166,14 @@ base::base(const double &l_value, const double &u_value, int n, int ni, int nf,
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),
+	m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_eval_threads(1)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -216,15 +216,14 @@ base::base(const decision_vector &lb, const decision_vector &ub, int ni, int nf,
 	m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 	m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 	m_c_tol(nc,c_tol),
-	m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-	m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-	m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity)),
+	m_fitness_cache(cache_capacity),
+	m_constraint_cache(cache_capacity),
 	m_best_x(0),
 	m_best_f(0),
 	m_best_c(0),
 	m_fevals(0),
-	m_cevals(0)
+	m_cevals(0),
+	m_eval_threads(1)
 {
 	if (c_tol < 0) {
 		pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -571,40 +570,196 @@ void base::objfun(fitness_vector &f, const decision_vector &x) const
 		pagmo_throw(value_error,"wrong decision vector size when calling objective function");
 	}
 	// Look into the cache.
-	typedef decision_vector_cache_type::iterator x_iterator;
-	typedef fitness_vector_cache_type::iterator f_iterator;
-	const x_iterator x_it = std::find(m_decision_vector_cache_f.begin(),m_decision_vector_cache_f.end(),x);
-	if (x_it == m_decision_vector_cache_f.end()) {
-		// Fitness is not into memory. Calculate it.
-		objfun_impl(f,x);
-		// Increase function evaluation counter.
-		m_fevals++;
-		// Make sure that the implementation of objfun_impl() in the derived class did not fuck up the dimension of the fitness vector.
-		if (f.size() != m_f_dimension) {
-			pagmo_throw(value_error,"fitness dimension was changed inside objfun_impl()");
+	if (m_fitness_cache.find(f,x)) {
+		return;
+	}
+	// Fitness is not into memory. Calculate it.
+	objfun_impl(f,x);
+	// Increase function evaluation counter.
+	m_fevals++;
+	// Make sure that the implementation of objfun_impl() in the derived class did not fuck up the dimension of the fitness vector.
+	if (f.size() != m_f_dimension) {
+		pagmo_throw(value_error,"fitness dimension was changed inside objfun_impl()");
+	}
+	// Store the decision vector and the newly-calculated fitness in the front of the buffers.
+	m_fitness_cache.insert(x,f);
+}
+
+namespace {
+
+// Hash and equality of decision vectors accessed through pointers.
+struct pointee_hash
+{
+	std::size_t operator()(const decision_vector *x) const
+	{
+		return boost::hash_range(x->begin(),x->end());
+	}
+};
+
+struct pointee_equal
+{
+	bool operator()(const decision_vector *a, const decision_vector *b) const
+	{
+		return *a == *b;
+	}
+};
+
+}
+
+/// Write fitnesses of a set of pagmo::decision_vector into a set of pagmo::fitness_vector.
+/**
+ * Batch version of objfun(). f will be resized to the size of x, and f[i] will contain the fitness of x[i].
+ * The decision vectors are first looked up in the cache; all the remaining ones (duplicates being evaluated only once)
+ * are then passed in a single call to batch_objfun_impl(). The function evaluation counter is increased by the number of
+ * decision vectors actually evaluated, so that the outcome is the same as calling objfun() on each element of x.
+ *
+ * @param[out] f vector of fitness vectors to which the fitnesses of the elements of x will be written.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ *
+ * @throws value_error if the dimension of any of the elements of x is different from the problem dimension,
+ * or if batch_objfun_impl() does not return properly-sized fitness vectors.
+ */
+void base::objfun_batch(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (x[i].size() != get_dimension()) {
+			pagmo_throw(value_error,"wrong decision vector size when calling objective function");
 		}
-		// Store the decision vector and the newly-calculated fitness in the front of the buffers.
-		m_decision_vector_cache_f.push_front(x);
-		m_fitness_vector_cache.push_front(f);
-	} else {
-		// Compute the corresponding iterator in the fitness vector cache.
-		f_iterator f_it = m_fitness_vector_cache.begin();
-		std::advance(f_it,std::distance(m_decision_vector_cache_f.begin(),x_it));
-		pagmo_assert(f_it != m_fitness_vector_cache.end());
-		// Assign to the fitness vector the value in the cache.
-		f = *f_it;
-		// Move the content of the current positions to the front of the buffers, and shift everything else down
-		// by one position.
-		x_iterator tmp_x_it = m_decision_vector_cache_f.begin();
-		f_iterator tmp_f_it = m_fitness_vector_cache.begin();
-		while (x_it != tmp_x_it) {
-			x_it->swap(*tmp_x_it);
-			f_it->swap(*tmp_f_it);
-			++tmp_x_it;
-			++tmp_f_it;
+	}
+	f.resize(x.size());
+	// Positions in x of the decision vectors that need to be evaluated.
+	std::vector<std::vector<decision_vector>::size_type> eval_idx;
+	// For each element of x, the position in eval_idx it is waiting for (or x.size() if it was found in the cache).
+	std::vector<std::vector<decision_vector>::size_type> pending(x.size(),x.size());
+	// Decision vectors already scheduled, to spot duplicates in constant time without copying them.
+	typedef boost::unordered_map<const decision_vector *,std::vector<decision_vector>::size_type,pointee_hash,pointee_equal> schedule_map;
+	schedule_map scheduled;
+	scheduled.rehash(x.size());
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		f[i].resize(m_f_dimension);
+		if (m_fitness_cache.find(f[i],x[i])) {
+			continue;
+		}
+		const std::pair<schedule_map::iterator,bool> res = scheduled.insert(std::make_pair(&x[i],eval_idx.size()));
+		pending[i] = res.first->second;
+		if (res.second) {
+			eval_idx.push_back(i);
 		}
-		pagmo_assert(tmp_f_it == f_it);
 	}
+	if (eval_idx.empty()) {
+		return;
+	}
+	// If no decision vector was cached or duplicated, the batch is evaluated in place.
+	const bool in_place = eval_idx.size() == x.size();
+	std::vector<decision_vector> x_eval;
+	std::vector<fitness_vector> f_eval;
+	if (!in_place) {
+		x_eval.reserve(eval_idx.size());
+		for (std::vector<decision_vector>::size_type j = 0; j < eval_idx.size(); ++j) {
+			x_eval.push_back(x[eval_idx[j]]);
+		}
+		f_eval.resize(eval_idx.size(),fitness_vector(m_f_dimension));
+	}
+	const std::vector<decision_vector> &xe = in_place ? x : x_eval;
+	std::vector<fitness_vector> &fe = in_place ? f : f_eval;
+	batch_objfun_impl(fe,xe);
+	if (fe.size() != xe.size()) {
+		pagmo_throw(value_error,"number of fitness vectors was changed inside batch_objfun_impl()");
+	}
+	for (std::vector<fitness_vector>::size_type j = 0; j < fe.size(); ++j) {
+		if (fe[j].size() != m_f_dimension) {
+			pagmo_throw(value_error,"fitness dimension was changed inside batch_objfun_impl()");
+		}
+	}
+	// Increase function evaluation counter, only once the batch is known to be valid.
+	m_fevals += boost::numeric_cast<unsigned int>(xe.size());
+	for (std::vector<fitness_vector>::size_type j = 0; j < fe.size(); ++j) {
+		m_fitness_cache.insert(xe[j],fe[j]);
+	}
+	if (!in_place) {
+		for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+			if (pending[i] != x.size()) {
+				f[i] = f_eval[pending[i]];
+			}
+		}
+	}
+}
+
+// Functor evaluating one element of a batch, used to distribute batch_objfun_impl() on the evaluation threads.
+struct base::objfun_task
+{
+	objfun_task(const base &p, std::vector<fitness_vector> &f, const std::vector<decision_vector> &x):m_p(p),m_f(f),m_x(x) {}
+	void operator()(std::size_t i) const
+	{
+		m_p.objfun_impl(m_f[i],m_x[i]);
+	}
+	const base				&m_p;
+	std::vector<fitness_vector>		&m_f;
+	const std::vector<decision_vector>	&m_x;
+};
+
+/// Batch objective function implementation.
+/**
+ * Takes a set of pagmo::decision_vector as input and writes their pagmo::fitness_vector to f. This function is not to be called directly,
+ * it is invoked by objfun_batch() with the decision vectors that could not be found in the cache. f is guaranteed to have the same
+ * size as x, and each of its elements to be already sized as the fitness dimension.
+ *
+ * The default implementation will call objfun_impl() on each element of x. Problems can override this method
+ * to amortise a fixed per-call cost over the whole set of decision vectors.
+ *
+ * @param[out] f fitness vectors into which the fitnesses of x will be written.
+ * @param[in] x decision vectors whose fitnesses will be calculated.
+ */
+void base::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	pagmo_assert(f.size() == x.size());
+	const unsigned int n_threads = get_eval_threads();
+	if (n_threads > 1 && x.size() > 1 && is_thread_safe()) {
+		util::thread_pool::shared(n_threads).parallel_for(x.size(),objfun_task(*this,f,x));
+		return;
+	}
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		objfun_impl(f[i],x[i]);
+	}
+}
+
+/// Thread safety of the objective function.
+/**
+ * Return true if objfun_impl() can be safely called concurrently from several threads on the same problem instance, i.e., if it
+ * does not modify any state (mutable temporaries, random number generators, inner problems' caches, ...). Only in that case
+ * batch_objfun_impl() will evaluate on more than one thread.
+ *
+ * Default implementation returns false.
+ *
+ * @return true if objfun_impl() is reentrant, false otherwise.
+ */
+bool base::is_thread_safe() const
+{
+	return false;
+}
+
+/// Set the number of evaluation threads.
+/**
+ * Set the number of threads the default batch_objfun_impl() will use if the problem is thread safe (see is_thread_safe()).
+ * A value of one (the default) means serial evaluation in the calling thread, while zero means one thread per hardware thread
+ * of the machine where the evaluation takes place: the value is stored (and serialized) as it is, and resolved at each use.
+ * The evaluations run on the process-wide pool of the requested size (see util::thread_pool::shared()), shared by all the problems.
+ *
+ * @param[in] n number of evaluation threads.
+ */
+void base::set_eval_threads(unsigned int n)
+{
+	m_eval_threads = n;
+}
+
+/// Get the number of evaluation threads.
+/**
+ * @return the number of threads used by the default batch_objfun_impl(), i.e., util::thread_pool::default_size() if
+ * set_eval_threads() was called with zero.
+ */
+unsigned int base::get_eval_threads() const
+{
+	return m_eval_threads ? m_eval_threads : util::thread_pool::default_size();
 }
 
 /// Compare fitness vectors.
@@ -651,6 +806,19 @@ bool base::compare_fitness_impl(const fitness_vector &v_f1, const fitness_vector
 	return ( ( (count1+count2) == v_f1.size()) && (count1>0) );
 }
 
+/// Pareto dominance.
+/**
+ * Tells whether compare_fitness_impl() is the default Pareto dominance, in which case populations rank their individuals
+ * with pagmo::util::non_dominated_sorting instead of comparing all the pairs of individuals. Problems that do not
+ * override compare_fitness_impl() can re-implement this method to return true.
+ *
+ * @return false.
+ */
+bool base::has_pareto_dominance() const
+{
+	return false;
+}
+
 /// Return human readable representation of the problem.
 /**
  * Will return a formatted string containing:
@@ -881,39 +1049,18 @@ void base::compute_constraints(constraint_vector &c, const decision_vector &x) c
 		return;
 	}
 	// Look into the cache.
-	typedef decision_vector_cache_type::iterator x_iterator;
-	typedef constraint_vector_cache_type::iterator c_iterator;
-	const x_iterator x_it = std::find(m_decision_vector_cache_c.begin(),m_decision_vector_cache_c.end(),x);
-	if (x_it == m_decision_vector_cache_c.end()) {
-		// Constraint vector is not into memory. Calculate it.
-		compute_constraints_impl(c,x);
-		m_cevals++;
-		// Make sure c was not fucked up in the implementation of constraints calculation.
-		if (c.size() != get_c_dimension()) {
-			pagmo_throw(value_error,"constraints dimension was changed inside compute_constraints_impl()");
-		}
-		// Store the decision vector and the newly-calculated constraint vector in the front of the buffers.
-		m_decision_vector_cache_c.push_front(x);
-		m_constraint_vector_cache.push_front(c);
-	} else {
-		// Compute the corresponding iterator in the constraint vector cache.
-		c_iterator c_it = m_constraint_vector_cache.begin();
-		std::advance(c_it,std::distance(m_decision_vector_cache_c.begin(),x_it));
-		pagmo_assert(c_it != m_constraint_vector_cache.end());
-		// Assign to the fitness vector the value in the cache.
-		c = *c_it;
-		// Move the content of the current positions to the front of the buffers, and shift everything else down
-		// by one position.
-		x_iterator tmp_x_it = m_decision_vector_cache_c.begin();
-		c_iterator tmp_c_it = m_constraint_vector_cache.begin();
-		while (x_it != tmp_x_it) {
-			x_it->swap(*tmp_x_it);
-			c_it->swap(*tmp_c_it);
-			++tmp_x_it;
-			++tmp_c_it;
-		}
-		pagmo_assert(tmp_c_it == c_it);
+	if (m_constraint_cache.find(c,x)) {
+		return;
+	}
+	// Constraint vector is not into memory. Calculate it.
+	compute_constraints_impl(c,x);
+	m_cevals++;
+	// Make sure c was not fucked up in the implementation of constraints calculation.
+	if (c.size() != get_c_dimension()) {
+		pagmo_throw(value_error,"constraints dimension was changed inside compute_constraints_impl()");
 	}
+	// Store the decision vector and the newly-calculated constraint vector in the cache.
+	m_constraint_cache.insert(x,c);
 }
 
 /// Compute constraints and return constraint vector.
@@ -1412,10 +1559,54 @@ void base::post_evolution(population &pop) const
  */
 void base::reset_caches() const
 {
-	m_decision_vector_cache_f = decision_vector_cache_type(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity));
-	m_fitness_vector_cache = fitness_vector_cache_type(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity));
-	m_decision_vector_cache_c = decision_vector_cache_type(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity));
-	m_constraint_vector_cache = constraint_vector_cache_type(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity));
+	m_fitness_cache.clear();
+	m_constraint_cache.clear();
+}
+
+/// Set the capacity of the internal caches.
+/**
+ * The fitness and constraint caches will be able to hold up to n entries each, and will evict entries according to the
+ * given policy once full. A capacity of zero disables caching. The content of the caches is discarded, while their
+ * hit/miss counters are preserved.
+ *
+ * @param[in] n new capacity of the caches.
+ * @param[in] eviction eviction policy.
+ */
+void base::set_cache_capacity(std::size_t n, util::vector_cache::eviction_type eviction)
+{
+	m_fitness_cache.set_capacity(n,eviction);
+	m_constraint_cache.set_capacity(n,eviction);
+}
+
+/// Get the capacity of the internal caches.
+/**
+ * @return the maximum number of entries held by the fitness and constraint caches.
+ */
+std::size_t base::get_cache_capacity() const
+{
+	return m_fitness_cache.get_capacity();
+}
+
+/// Get the fitness cache.
+/**
+ * Can be used to inspect the number of hits and misses of the cache of fitness vectors.
+ *
+ * @return const reference to the fitness cache.
+ */
+const util::vector_cache &base::get_fitness_cache() const
+{
+	return m_fitness_cache;
+}
+
+/// Get the constraint cache.
+/**
+ * Can be used to inspect the number of hits and misses of the cache of constraint vectors.
+ *
+ * @return const reference to the constraint cache.
+ */
+const util::vector_cache &base::get_constraint_cache() const
+{
+	return m_constraint_cache;
 }
 
 }} //namespaces
@@ -32,18 +32,19 @@
 // #define BOOST_CB_DISABLE_DEBUG 
 
 #include <algorithm>
-#include <boost/circular_buffer.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <cstddef>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../exceptions.h"
 #include "../serialization.h"
 #include "../types.h"
+#include "../util/vector_cache.h"
 //#include "base_meta.h"
 
 namespace pagmo
@@ -108,7 +109,8 @@ typedef boost::shared_ptr<base> base_ptr;
  *   than the second one, false otherwise),
  * - compute_constraints_impl(), to calculate the constraint vector associated to a decision vector,
  * - compare_constraints_impl(), to compare two constraint vectors,
- * - compare_fc_impl(), to perform a simultaneous fitness/constraint vector pairs comparison.
+ * - compare_fc_impl(), to perform a simultaneous fitness/constraint vector pairs comparison,
+ * - batch_objfun_impl(), to compute the fitness vectors of a whole set of decision vectors in a single call.
  *
  * Please note that while a problem is intended to provide methods for ranking decision and constraint vectors, such methods are not to be used
  * mandatorily by an algorithm: each algorithm can decide to use its own ranking schemes during an optimisation. The ranking methods provided
@@ -116,6 +118,19 @@ typedef boost::shared_ptr<base> base_ptr;
  *
  * \section Caching
  * A caching mechanism is implemented to make sure the objective function is never evaluated twice on the very same chromosome
+ * (as long as it is still in the cache). Fitness and constraint vectors are stored in two pagmo::util::vector_cache objects, hash tables
+ * holding up to cache_capacity entries by default. Capacity and eviction policy can be changed with set_cache_capacity(), while
+ * get_fitness_cache() and get_constraint_cache() give access to the hit/miss counters.
+ *
+ * \section batch_evaluation Batch evaluation
+ * objfun_batch() evaluates a set of decision vectors at once. After the cache has been consulted, all the decision vectors
+ * still needing an evaluation are handed in a single call to batch_objfun_impl(). Its default implementation simply calls objfun_impl()
+ * on each of them, problems with a high fixed cost per evaluation (or that can vectorise across candidates) can override it.
+ *
+ * If the number of evaluation threads has been set to more than one via set_eval_threads() and the problem declares
+ * its objfun_impl() to be reentrant by returning true from is_thread_safe(), the default batch_objfun_impl() will evaluate the decision
+ * vectors concurrently on a pool of threads. Caches, temporaries and evaluation counters are only ever touched by the calling thread,
+ * so the outcome is identical to the serial evaluation.
  *
  * \section Serialization
  * The problem classes are serialized for the purpose of transmitting their corresponding objects over a distributed environment, as being part of the population class.
@@ -149,13 +164,9 @@ class __PAGMO_VISIBLE base
 {
 		// Meta problems need to be able to access protected virtual functions
 		friend class base_meta;
-		// Underlying containers used for caching decision and fitness vectors.
-		typedef boost::circular_buffer<decision_vector> decision_vector_cache_type;
-		typedef boost::circular_buffer<fitness_vector> fitness_vector_cache_type;
-		typedef boost::circular_buffer<constraint_vector> constraint_vector_cache_type;
 	public:
-		/// Capacity of the internal caches.
-		static const std::size_t cache_capacity = 5;
+		/// Default capacity of the internal caches.
+		static const std::size_t cache_capacity = 32;
 		/// Problem's size type: the same as pagmo::decision_vector's size type.
 		typedef decision_vector::size_type size_type;
 		/// Fitness' size type: the same as pagmo::fitness_vector's size type.
@@ -187,10 +198,9 @@ class __PAGMO_VISIBLE base
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 			m_c_tol(nc,c_tol),
-			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_fitness_cache(cache_capacity),
+			m_constraint_cache(cache_capacity),
+			m_eval_threads(1)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -236,10 +246,9 @@ class __PAGMO_VISIBLE base
 			m_i_dimension(boost::numeric_cast<size_type>(ni)),m_f_dimension(boost::numeric_cast<f_size_type>(nf)),
 			m_c_dimension(boost::numeric_cast<c_size_type>(nc)),m_ic_dimension(boost::numeric_cast<c_size_type>(nic)),
 			m_c_tol(nc,c_tol),
-			m_decision_vector_cache_f(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_fitness_vector_cache(boost::numeric_cast<fitness_vector_cache_type::size_type>(cache_capacity)),
-			m_decision_vector_cache_c(boost::numeric_cast<decision_vector_cache_type::size_type>(cache_capacity)),
-			m_constraint_vector_cache(boost::numeric_cast<constraint_vector_cache_type::size_type>(cache_capacity))
+			m_fitness_cache(cache_capacity),
+			m_constraint_cache(cache_capacity),
+			m_eval_threads(1)
 		{
 			if (c_tol < 0) {
 				pagmo_throw(value_error,"constraints tolerance must be non-negative");
@@ -454,8 +463,17 @@ return base_ptr(new derived_problem(*this));
 		//@{
 		fitness_vector objfun(const decision_vector &) const;
 		void objfun(fitness_vector &, const decision_vector &) const;
+		void objfun_batch(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
+		virtual bool is_thread_safe() const;
+		void set_eval_threads(unsigned int);
+		unsigned int get_eval_threads() const;
 		bool compare_fitness(const fitness_vector &, const fitness_vector &) const;
+		virtual bool has_pareto_dominance() const;
 		void reset_caches() const;
+		void set_cache_capacity(std::size_t, util::vector_cache::eviction_type = util::vector_cache::lru);
+		std::size_t get_cache_capacity() const;
+		const util::vector_cache &get_fitness_cache() const;
+		const util::vector_cache &get_constraint_cache() const;
 	public:
 		const std::vector<constraint_vector>& get_best_c(void) const;
 		const std::vector<decision_vector>& get_best_x(void) const;
@@ -472,9 +490,11 @@ return base_ptr(new derived_problem(*this));
 		 * @param[in] x decision vector whose fitness will be calculated.
 		 */
 		virtual void objfun_impl(fitness_vector &f, const decision_vector &x) const = 0;
+		virtual void batch_objfun_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 		//@}
 	private:
 		void normalise_bounds();
+		struct objfun_task;
 		// Construct from iterators.
 		template <class Iterator1, class Iterator2>
 		void construct_from_iterators(Iterator1 start1, Iterator1 end1, Iterator2 start2, Iterator2 end2)
@@ -500,8 +520,12 @@ return base_ptr(new derived_problem(*this));
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
-		void serialize(Archive &ar, const unsigned int)
+		void serialize(Archive &ar, const unsigned int version)
 		{
+			// Version 0 archives stored the caches as circular buffers, they cannot be read into the hashed caches.
+			if (version < 1) {
+				pagmo_throw(value_error,"problem archives older than version 1 (circular buffer caches) are not supported");
+			}
 			ar & const_cast<size_type &>(m_i_dimension);
 			ar & const_cast<f_size_type &>(m_f_dimension);
 			ar & const_cast<c_size_type &>(m_c_dimension);
@@ -509,10 +533,8 @@ return base_ptr(new derived_problem(*this));
 			ar & m_lb;
 			ar & m_ub;
 			ar & const_cast<std::vector<double> &>(m_c_tol);
-			ar & m_decision_vector_cache_f;
-			ar & m_fitness_vector_cache;
-			ar & m_decision_vector_cache_c;
-			ar & m_constraint_vector_cache;
+			ar & m_fitness_cache;
+			ar & m_constraint_cache;
 			ar & m_tmp_f1;
 			ar & m_tmp_f2;
 			ar & m_tmp_c1;
@@ -522,6 +544,7 @@ return base_ptr(new derived_problem(*this));
 			ar & m_best_c;
 			ar & m_fevals;
 			ar & m_cevals;
+			ar & m_eval_threads;
 		}
 
 		// Data members.
@@ -539,14 +562,10 @@ return base_ptr(new derived_problem(*this));
 		decision_vector				m_ub;
 		// Tolerance for constraints analysis.
 		const std::vector<double>   m_c_tol;
-		// Decision vector cache for fitness.
-		mutable decision_vector_cache_type	m_decision_vector_cache_f;
-		// Fitness vector cache.
-		mutable fitness_vector_cache_type	m_fitness_vector_cache;
-		// Decision vector cache for constraints.
-		mutable decision_vector_cache_type	m_decision_vector_cache_c;
-		// Constraint vector cache.
-		mutable constraint_vector_cache_type	m_constraint_vector_cache;
+		// Cache of fitness vectors.
+		mutable util::vector_cache		m_fitness_cache;
+		// Cache of constraint vectors.
+		mutable util::vector_cache		m_constraint_cache;
 		// Temporary storage used during decision_vector comparisons.
 		mutable fitness_vector			m_tmp_f1;
 		mutable fitness_vector			m_tmp_f2;
@@ -562,6 +581,10 @@ return base_ptr(new derived_problem(*this));
 		// Number of function and constraints evaluations
 		mutable unsigned int                    m_fevals;
 		mutable unsigned int                    m_cevals;
+
+		// Number of threads used by the default batch_objfun_impl(), as requested (zero stands for one thread
+		// per hardware thread of the machine running the evaluation).
+		unsigned int					m_eval_threads;
 };
 
 std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
@@ -570,5 +593,7 @@ std::ostream __PAGMO_VISIBLE_FUNC &operator<<(std::ostream &, const base &);
 }
 
 BOOST_SERIALIZATION_ASSUME_ABSTRACT(pagmo::problem::base)
+// Version 1: hashed fitness and constraint caches (util::vector_cache).
+BOOST_CLASS_VERSION(pagmo::problem::base,1)
 
 #endif
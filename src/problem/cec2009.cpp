@@ -82,6 +82,11 @@ std::string cec2009::get_name() const
 	return retval;
 }
 
+bool cec2009::has_pareto_dominance() const
+{
+	return true;
+}
+
 /// Returns the dimension of the fitness vector
 fitness_vector::size_type cec2009::cec2009_fitness_dimension(int problem_id)
 {
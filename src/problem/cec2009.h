@@ -56,6 +56,7 @@ class __PAGMO_VISIBLE cec2009 : public base
 		cec2009(unsigned int = 1, problem::base::size_type = 30, bool = false);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool has_pareto_dominance() const;
 
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
@@ -32,6 +32,7 @@
 #include <iterator>
 
 
+#include "../Eigen/Dense"
 #include "../exceptions.h"
 #include "../types.h"
 #include "cec2013.h"
@@ -1048,24 +1049,14 @@ void cec2013::cf08 (const double *x, double *f, int nx, const double *Os,const d
 }
 
 void cec2013::shiftfunc (const double *x, double *xshift, int nx, const double *Os) const {
-	int i;
-	for (i=0; i<nx; i++)
-	{
-		xshift[i]=x[i]-Os[i];
-	}
+	Eigen::Map<Eigen::ArrayXd>(xshift,nx) = Eigen::Map<const Eigen::ArrayXd>(x,nx) - Eigen::Map<const Eigen::ArrayXd>(Os,nx);
 }
 
+// The rotation is the O(nx^2) hot spot of most functions: it is delegated to Eigen's vectorised matrix-vector product.
 void cec2013::rotatefunc (const double *x, double *xrot, int nx,const double *Mr) const
 {
-	int i,j;
-	for (i=0; i<nx; i++)
-	{
-		xrot[i]=0;
-			for (j=0; j<nx; j++)
-			{
-				xrot[i]=xrot[i]+x[j]*Mr[i*nx+j];
-			}
-	}
+	typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> matrix_type;
+	Eigen::Map<Eigen::VectorXd>(xrot,nx).noalias() = Eigen::Map<const matrix_type>(Mr,nx,nx) * Eigen::Map<const Eigen::VectorXd>(x,nx);
 }
 
 void cec2013::asyfunc (const double *x, double *xasy, int nx, double beta) const
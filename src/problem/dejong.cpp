@@ -24,9 +24,11 @@
 
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "dejong.h"
 
@@ -54,13 +56,17 @@ base_ptr dejong::clone() const {
 void dejong::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	decision_vector::size_type n = x.size();
-	double retval = 0.0;
+	util::kernels::dejong(&f[0],&x[0],1,x.size());
+}
 
-	for (decision_vector::size_type i=0; i<n; i++){
-		retval += x[i]*x[i];
+/// Implementation of the batch objective function.
+void dejong::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
 	}
-	f[0] = retval;
+	util::kernels::evaluate(util::kernels::dejong,f,x);
 }
 
 std::string dejong::get_name() const
@@ -68,6 +74,11 @@ std::string dejong::get_name() const
 	return "De Jong";
 }
 
+bool dejong::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::dejong)
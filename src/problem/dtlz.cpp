@@ -338,6 +338,16 @@ std::string dtlz::get_name() const
 	return retval;
 }
 
+bool dtlz::is_thread_safe() const
+{
+	return true;
+}
+
+bool dtlz::has_pareto_dominance() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::dtlz)
@@ -83,6 +83,8 @@ class __PAGMO_VISIBLE dtlz : public base_dtlz
 		dtlz(size_type id = 1, size_type k = 5, fitness_vector::size_type fdim = 3, const size_t alpha = 100);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
+		bool has_pareto_dominance() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
@@ -63,6 +63,11 @@ std::string fon::get_name() const
 	return "Fonseca and Fleming's study";
 }
 
+bool fon::has_pareto_dominance() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::fon)
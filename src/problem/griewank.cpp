@@ -24,9 +24,11 @@
 
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "griewank.h"
 
@@ -57,14 +59,17 @@ base_ptr griewank::clone() const
 void griewank::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	decision_vector::size_type n = x.size();
-	double fr=4000.0;
-	double retval = 0.0;
-	double p = 1.0;
+	util::kernels::griewank(&f[0],&x[0],1,x.size());
+}
 
-	for (decision_vector::size_type i=0; i<n; i++){ retval += x[i]*x[i];}
-	for (decision_vector::size_type i=0; i<n; i++){ p *= cos(x[i]/sqrt(i+1.0));}
-	f[0] = (retval/fr - p + 1);
+/// Implementation of the batch objective function.
+void griewank::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
+	}
+	util::kernels::evaluate(util::kernels::griewank,f,x);
 }
 
 std::string griewank::get_name() const
@@ -72,6 +77,11 @@ std::string griewank::get_name() const
 	return "Griewank";
 }
 
+bool griewank::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::griewank)
@@ -72,6 +72,11 @@ std::string kur::get_name() const
 {
 	return "Kursawe's study";
 }
+
+bool kur::has_pareto_dominance() const
+{
+	return true;
+}
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::kur)
@@ -55,6 +55,7 @@ class __PAGMO_VISIBLE kur : public base
 		kur(size_type = 10);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool has_pareto_dominance() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
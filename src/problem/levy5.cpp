@@ -25,9 +25,11 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "levy5.h"
 
@@ -61,22 +63,17 @@ base_ptr levy5::clone() const
 void levy5::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	decision_vector::size_type n = x.size();
-	double isum = 0.0;
-	double jsum = 0.0;
-	f[0] = 0;
+	util::kernels::levy5(&f[0],&x[0],1,x.size());
+}
 
-	for ( decision_vector::size_type j=0; j<n; j+=2 ) {
-		for ( int i=1; i<=5; i++ ) {
-			isum += (double)(i) * cos((double)(i-1)*x[j] + (double)(i));
-			jsum += (double)(i) * cos((double)(i+1)*x[j+1] + (double)(i));
-		}
+/// Implementation of the batch objective function.
+void levy5::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
 	}
-
-	f[0] = isum*jsum;
-	for ( decision_vector::size_type j=0; j<n; j+=2 )
-		f[0] += pow(x[j] + 1.42513,2) + pow(x[j+1] + 0.80032,2);
-
+	util::kernels::evaluate(util::kernels::levy5,f,x);
 }
 
 std::string levy5::get_name() const
@@ -84,6 +81,11 @@ std::string levy5::get_name() const
 	return "Levy5";
 }
 
+bool levy5::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::levy5)
@@ -22,11 +22,14 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <boost/bind.hpp>
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "michalewicz.h"
 
@@ -56,13 +59,17 @@ base_ptr michalewicz::clone() const {
 void michalewicz::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	decision_vector::size_type n = x.size();
-	double retval = 0.0;
+	util::kernels::michalewicz(&f[0],&x[0],1,x.size(),m_m);
+}
 
-	for (decision_vector::size_type i=0; i<n; i++){
-		retval -= sin(x[i]) * pow(sin((i+1)*x[i]*x[i]/boost::math::constants::pi<double>()) , 2*m_m);
+/// Implementation of the batch objective function.
+void michalewicz::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
 	}
-	f[0] = retval;
+	util::kernels::evaluate(boost::bind(util::kernels::michalewicz,_1,_2,_3,_4,m_m),f,x);
 }
 
 std::string michalewicz::get_name() const
@@ -70,6 +77,11 @@ std::string michalewicz::get_name() const
 	return "Michalewicz";
 }
 
+bool michalewicz::is_thread_safe() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::michalewicz)
@@ -76,6 +76,10 @@ std::string pol::get_name() const
 	return "Poloni's study";
 }
 
+bool pol::has_pareto_dominance() const
+{
+	return true;
+}
 
 }} //namespaces
 
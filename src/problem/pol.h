@@ -66,6 +66,7 @@ class __PAGMO_VISIBLE pol : public base
 		pol();
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool has_pareto_dominance() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 	private:
@@ -25,9 +25,11 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "rastrigin.h"
 
@@ -58,13 +60,17 @@ base_ptr rastrigin::clone() const
 void rastrigin::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	const double omega = 2.0 * boost::math::constants::pi<double>();
-	f[0] = 0;
-	const decision_vector::size_type n = x.size();
-	for (decision_vector::size_type i = 0; i < n; ++i) {
-		f[0] += x[i] * x[i] - 10.0 * std::cos(omega * x[i]);
+	util::kernels::rastrigin(&f[0],&x[0],1,x.size());
+}
+
+/// Implementation of the batch objective function.
+void rastrigin::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
 	}
-	f[0] += 10.0 * n;
+	util::kernels::evaluate(util::kernels::rastrigin,f,x);
 }
 
 std::string rastrigin::get_name() const
@@ -72,6 +78,11 @@ std::string rastrigin::get_name() const
 	return "Rastrigin";
 }
 
+bool rastrigin::is_thread_safe() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::rastrigin)
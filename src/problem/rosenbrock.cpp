@@ -23,9 +23,11 @@
  *****************************************************************************/
 
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "rosenbrock.h"
 
@@ -55,11 +57,18 @@ base_ptr rosenbrock::clone() const
 /// Implementation of the objective function.
 void rosenbrock::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
-	const decision_vector::size_type n = x.size();
-	f[0]=0;
-	for (decision_vector::size_type i=0; i<n-1; ++i){
-		f[0] += 100 * (x[i]*x[i] -x[i+1])*(x[i]*x[i] -x[i+1]) + (x[i]-1)*(x[i]-1);
+	pagmo_assert(f.size() == 1);
+	util::kernels::rosenbrock(&f[0],&x[0],1,x.size());
+}
+
+/// Implementation of the batch objective function.
+void rosenbrock::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
 	}
+	util::kernels::evaluate(util::kernels::rosenbrock,f,x);
 }
 
 std::string rosenbrock::get_name() const
@@ -67,6 +76,11 @@ std::string rosenbrock::get_name() const
 	return "Rosenbrock";
 }
 
+bool rosenbrock::is_thread_safe() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::rosenbrock)
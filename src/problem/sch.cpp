@@ -60,6 +60,11 @@ std::string sch::get_name() const
 	return "Shaffer's Study";
 }
 
+bool sch::has_pareto_dominance() const
+{
+	return true;
+}
+
 }} //namespaces
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::sch)
@@ -25,9 +25,11 @@
 #include <boost/math/constants/constants.hpp>
 #include <cmath>
 #include <string>
+#include <vector>
 
 #include "../exceptions.h"
 #include "../types.h"
+#include "../util/benchmark_kernels.h"
 #include "base.h"
 #include "schwefel.h"
 
@@ -58,13 +60,17 @@ base_ptr schwefel::clone() const
 void schwefel::objfun_impl(fitness_vector &f, const decision_vector &x) const
 {
 	pagmo_assert(f.size() == 1);
-	std::vector<double>::size_type n = x.size();
-	double value=0;
+	util::kernels::schwefel(&f[0],&x[0],1,x.size());
+}
 
-	for (std::vector<double>::size_type i=0; i<n; i++){
-		value += x[i] * sin(sqrt(fabs(x[i])));
-		}
-		f[0] = 418.9828872724338 * n - value;
+/// Implementation of the batch objective function.
+void schwefel::batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+{
+	if (get_eval_threads() > 1) {
+		base::batch_objfun_impl(f,x);
+		return;
+	}
+	util::kernels::evaluate(util::kernels::schwefel,f,x);
 }
 
 std::string schwefel::get_name() const
@@ -72,6 +78,11 @@ std::string schwefel::get_name() const
 	return "Schwefel";
 }
 
+bool schwefel::is_thread_safe() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::schwefel)
@@ -27,6 +27,7 @@
 
 #include <boost/numeric/conversion/cast.hpp>
 #include <string>
+#include <vector>
 
 #include "../config.h"
 #include "../serialization.h"
@@ -56,8 +57,10 @@ class __PAGMO_VISIBLE schwefel : public base
 		schwefel(int = 1);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
+		void batch_objfun_impl(std::vector<fitness_vector> &, const std::vector<decision_vector> &) const;
 	private:
 		friend class boost::serialization::access;
 		template <class Archive>
@@ -380,6 +380,16 @@ std::string zdt::get_name() const
 	return retval;
 }
 
+bool zdt::is_thread_safe() const
+{
+	return true;
+}
+
+bool zdt::has_pareto_dominance() const
+{
+	return true;
+}
+
 }}
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::problem::zdt)
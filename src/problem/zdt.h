@@ -137,6 +137,8 @@ class __PAGMO_VISIBLE zdt : public base_unc_mo
 		zdt(size_type = 1, size_type = 30);
 		base_ptr clone() const;
 		std::string get_name() const;
+		bool is_thread_safe() const;
+		bool has_pareto_dominance() const;
 	protected:
 		void objfun_impl(fitness_vector &, const decision_vector &) const;
 		double convergence_metric(const decision_vector &) const;
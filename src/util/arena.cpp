@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+
+#include "arena.h"
+
+namespace pagmo{ namespace util {
+
+const std::size_t arena::alignment;
+
+/// Constructor.
+/**
+ * No memory is allocated until the first call to allocate().
+ *
+ * @param[in] block_size size in bytes of the blocks requested to the heap. Larger allocations get a block of their own.
+ */
+arena::arena(std::size_t block_size):m_top(0),m_left(0),m_block_size(std::max(block_size,alignment)) {}
+
+/// Destructor.
+/**
+ * Frees all the blocks.
+ */
+arena::~arena()
+{
+	free_blocks();
+}
+
+/// Release all the allocations.
+/**
+ * All the memory handed out so far becomes invalid. If the previous allocations took several blocks, they are merged into
+ * a single block of the same total size, so that the same sequence of allocations will not touch the heap anymore.
+ */
+void arena::reset()
+{
+	if (m_blocks.size() > 1) {
+		const std::size_t total = std::accumulate(m_sizes.begin(),m_sizes.end(),std::size_t(0));
+		free_blocks();
+		add_block(total);
+	} else if (m_blocks.size() == 1) {
+		const std::size_t size = m_sizes[0];
+		m_top = m_blocks[0] + (alignment - reinterpret_cast<std::size_t>(m_blocks[0]) % alignment);
+		m_left = size;
+	}
+}
+
+/// Capacity.
+/**
+ * @return total size in bytes of the blocks currently owned by the arena.
+ */
+std::size_t arena::capacity() const
+{
+	return std::accumulate(m_sizes.begin(),m_sizes.end(),std::size_t(0));
+}
+
+void *arena::allocate_bytes(std::size_t n)
+{
+	// Round up to keep the next allocation aligned.
+	n = (n + alignment - 1) / alignment * alignment;
+	if (n > m_left) {
+		add_block(std::max(n,m_block_size));
+	}
+	void *retval = m_top;
+	m_top += n;
+	m_left -= n;
+	return retval;
+}
+
+// Allocate a new block with size usable bytes, and make it the current one. The space left in the previous block is lost.
+void arena::add_block(std::size_t size)
+{
+	char *block = new char[size + alignment];
+	m_blocks.push_back(block);
+	m_sizes.push_back(size);
+	m_top = block + (alignment - reinterpret_cast<std::size_t>(block) % alignment);
+	m_left = size;
+}
+
+void arena::free_blocks()
+{
+	for (std::vector<char *>::size_type i = 0; i < m_blocks.size(); ++i) {
+		delete[] m_blocks[i];
+	}
+	m_blocks.clear();
+	m_sizes.clear();
+	m_top = 0;
+	m_left = 0;
+}
+
+}}
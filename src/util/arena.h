@@ -0,0 +1,136 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_ARENA_H
+#define PAGMO_UTIL_ARENA_H
+
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+
+namespace pagmo{ namespace util {
+
+/// Bump allocator for scratch memory.
+/**
+ * Hands out uninitialised memory from large blocks by bumping a pointer, and gives it back all at once with reset() or on
+ * destruction. It is meant for algorithms allocating many arrays that share the same lifetime (e.g., the duration of a call),
+ * which then cost a pointer increment each instead of a heap allocation. Blocks are never moved, so the memory handed out stays
+ * valid until the next reset(). Every allocation is aligned to a cache line. Only types needing no construction nor destruction
+ * (numbers, pointers, ...) should be allocated in an arena.
+ *
+ * An arena must not be shared among threads.
+ */
+class __PAGMO_VISIBLE arena: private boost::noncopyable
+{
+	public:
+		/// Alignment of the allocations, in bytes.
+		static const std::size_t alignment = 64;
+		explicit arena(std::size_t = 65536);
+		~arena();
+		/// Allocate an array.
+		/**
+		 * @param[in] n number of elements.
+		 *
+		 * @return pointer to n uninitialised elements of type T.
+		 */
+		template <class T>
+		T *allocate(std::size_t n)
+		{
+			return static_cast<T *>(allocate_bytes(n * sizeof(T)));
+		}
+		void reset();
+		std::size_t capacity() const;
+	private:
+		void *allocate_bytes(std::size_t);
+		void add_block(std::size_t);
+		void free_blocks();
+
+		// Blocks allocated so far (as returned by new[], before alignment) and their usable size.
+		std::vector<char *>		m_blocks;
+		std::vector<std::size_t>	m_sizes;
+		// Next free byte of the current block, and number of free bytes left in it.
+		char				*m_top;
+		std::size_t			m_left;
+		const std::size_t		m_block_size;
+};
+
+/// Allocator drawing from an arena.
+/**
+ * Standard allocator handing out memory from a util::arena, for node-based containers (std::set, std::list, ...) whose nodes
+ * all die together with the arena's next reset(): deallocation does nothing, so the container must be destroyed (or cleared)
+ * before the arena is reset, and memory of erased elements is only recovered by the reset.
+ */
+template <class T>
+class arena_allocator
+{
+	template <class U>
+	friend class arena_allocator;
+	public:
+		/// Type of the allocated objects.
+		typedef T value_type;
+		/// Constructor from arena.
+		/**
+		 * @param[in] a arena providing the memory. It must outlive the allocator and its copies.
+		 */
+		explicit arena_allocator(arena &a):m_arena(&a) {}
+		/// Converting constructor.
+		/**
+		 * @param[in] other allocator whose arena will be used.
+		 */
+		template <class U>
+		arena_allocator(const arena_allocator<U> &other):m_arena(other.m_arena) {}
+		/// Allocate an array.
+		/**
+		 * @param[in] n number of objects.
+		 *
+		 * @return pointer to uninitialised storage for n objects.
+		 */
+		T *allocate(std::size_t n)
+		{
+			return m_arena->allocate<T>(n);
+		}
+		/// Deallocate an array (no-op).
+		void deallocate(T *, std::size_t) {}
+		/// Equality.
+		template <class U>
+		bool operator==(const arena_allocator<U> &other) const
+		{
+			return m_arena == other.m_arena;
+		}
+		/// Inequality.
+		template <class U>
+		bool operator!=(const arena_allocator<U> &other) const
+		{
+			return m_arena != other.m_arena;
+		}
+	private:
+		arena *m_arena;
+};
+
+}}
+
+#endif
@@ -0,0 +1,476 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// NOTE: this file is compiled without reassociation and contraction of floating point operations (see src/CMakeLists.txt).
+
+#include <algorithm>
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+#include "benchmark_kernels.h"
+
+// Kernels are cloned for the main x86-64 vector extensions, and the dynamic loader picks the best one for the CPU.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6 && defined(__x86_64__) && defined(__linux__)
+	#define PAGMO_KERNELS_DISPATCH
+	#define PAGMO_KERNEL __attribute__((target_clones("avx512f","avx2","default")))
+#else
+	#define PAGMO_KERNEL
+#endif
+
+#if defined(__GNUC__)
+	#define PAGMO_NOINLINE __attribute__((noinline))
+	#define PAGMO_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+	#define PAGMO_NOINLINE
+	#define PAGMO_ALWAYS_INLINE inline
+#endif
+
+namespace pagmo{ namespace util { namespace kernels {
+
+namespace {
+
+// Number of candidates whose accumulators are kept on the stack at the same time.
+const std::size_t block_size = 64;
+
+// Largest magnitude of the arguments passed to sine() and cosine(). Beyond it the range reduction loses accuracy, and
+// the kernels switch to the functions of the standard library.
+const double max_trig_arg = 1E6;
+
+// Sine (offset = 0) or cosine (offset = 1) of x. The argument is reduced to [-pi/4,pi/4] with a three-part
+// Cody-Waite reduction and approximated by the minimax polynomials of the Cephes library, selecting the polynomial
+// and the sign according to the quadrant without branches.
+inline double sin_or_cos(double x, int offset)
+{
+	const double two_over_pi = 0.63661977236758134308;
+	const double pio2_1 = 1.57079625129699707031;
+	const double pio2_2 = 7.54978941586159635335E-8;
+	const double pio2_3 = 5.39030285815811905290E-15;
+	const double y = x * two_over_pi;
+	const int j = static_cast<int>(y < 0. ? y - .5 : y + .5);
+	const double dj = j;
+	const double r = ((x - dj * pio2_1) - dj * pio2_2) - dj * pio2_3;
+	const double z = r * r;
+	const double s = r + r * z * (((((1.58962301576546568060E-10 * z - 2.50507477628578072866E-8) * z + 2.75573136213857245213E-6) * z
+		- 1.98412698295895385996E-4) * z + 8.33333333332211858878E-3) * z - 1.66666666666666307295E-1);
+	const double c = 1. - .5 * z + z * z * (((((-1.13585365213876817300E-11 * z + 2.08757008419747316778E-9) * z
+		- 2.75573141792967388112E-7) * z + 2.48015872888517045348E-5) * z - 1.38888888888730564116E-3) * z + 4.16666666666665929218E-2);
+	const int q = j + offset;
+	const double v = (q & 1) ? c : s;
+	return (q & 2) ? -v : v;
+}
+
+inline double sine(double x)
+{
+	return sin_or_cos(x,0);
+}
+
+inline double cosine(double x)
+{
+	return sin_or_cos(x,1);
+}
+
+// Trigonometric functions used by the kernel bodies: the inline approximations above, for arguments up to max_trig_arg...
+struct fast_trig
+{
+	static double sin(double x)
+	{
+		return sine(x);
+	}
+	static double cos(double x)
+	{
+		return cosine(x);
+	}
+};
+
+// ... or the standard library, for larger arguments. Kept out of line, so that the loops are not vectorised with the vector variants of the functions.
+struct libm_trig
+{
+	static PAGMO_NOINLINE double sin(double x)
+	{
+		return std::sin(x);
+	}
+	static PAGMO_NOINLINE double cos(double x)
+	{
+		return std::cos(x);
+	}
+};
+
+// Whether all the n values in x have magnitude not greater than bound. NaNs are never within the bound.
+PAGMO_ALWAYS_INLINE bool within(const double *x, std::size_t n, double bound)
+{
+	bool retval = true;
+	for (std::size_t i = 0; i < n; ++i) {
+		retval &= std::fabs(x[i]) <= bound;
+	}
+	return retval;
+}
+
+// Final step of the Ackley function. Kept out of line, as the vectorisation of a loop calling exp() would switch to
+// the vector variant of the function, whose results differ slightly from the scalar one.
+PAGMO_NOINLINE double ackley_fitness(double s1, double s2, std::size_t d)
+{
+	return -20 * std::exp(-.2 * std::sqrt(1. / d * s1)) - std::exp(1. / d * s2) + 20 + std::exp(1.);
+}
+
+// Bodies of the kernels, on the trigonometric functions given by Trig. The public kernels below pick fast_trig if the
+// arguments of all the trigonometric functions are within max_trig_arg, libm_trig otherwise.
+template <class Trig>
+PAGMO_ALWAYS_INLINE void ackley_impl(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	const double omega = 2. * boost::math::constants::pi<double>();
+	double s1[block_size], s2[block_size];
+	for (std::size_t c0 = 0; c0 < n; c0 += block_size) {
+		const std::size_t m = std::min(block_size,n - c0);
+		std::fill(s1,s1 + m,0.);
+		std::fill(s2,s2 + m,0.);
+		for (std::size_t i = 0; i < d; ++i) {
+			const double *xi = x + i * n + c0;
+			for (std::size_t c = 0; c < m; ++c) {
+				s1[c] += xi[c] * xi[c];
+				s2[c] += Trig::cos(omega * xi[c]);
+			}
+		}
+		for (std::size_t c = 0; c < m; ++c) {
+			f[c0 + c] = ackley_fitness(s1[c],s2[c],d);
+		}
+	}
+}
+
+template <class Trig>
+PAGMO_ALWAYS_INLINE void rastrigin_impl(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	const double omega = 2. * boost::math::constants::pi<double>();
+	std::fill(f,f + n,0.);
+	for (std::size_t i = 0; i < d; ++i) {
+		const double *xi = x + i * n;
+		for (std::size_t c = 0; c < n; ++c) {
+			f[c] += xi[c] * xi[c] - 10. * Trig::cos(omega * xi[c]);
+		}
+	}
+	for (std::size_t c = 0; c < n; ++c) {
+		f[c] += 10. * d;
+	}
+}
+
+template <class Trig>
+PAGMO_ALWAYS_INLINE void griewank_impl(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	double p[block_size];
+	for (std::size_t c0 = 0; c0 < n; c0 += block_size) {
+		const std::size_t m = std::min(block_size,n - c0);
+		double *s = f + c0;
+		std::fill(s,s + m,0.);
+		std::fill(p,p + m,1.);
+		for (std::size_t i = 0; i < d; ++i) {
+			const double *xi = x + i * n + c0;
+			const double w = std::sqrt(i + 1.);
+			for (std::size_t c = 0; c < m; ++c) {
+				s[c] += xi[c] * xi[c];
+				p[c] *= Trig::cos(xi[c] / w);
+			}
+		}
+		for (std::size_t c = 0; c < m; ++c) {
+			s[c] = s[c] / 4000. - p[c] + 1;
+		}
+	}
+}
+
+template <class Trig>
+PAGMO_ALWAYS_INLINE void schwefel_impl(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	std::fill(f,f + n,0.);
+	for (std::size_t i = 0; i < d; ++i) {
+		const double *xi = x + i * n;
+		for (std::size_t c = 0; c < n; ++c) {
+			f[c] += xi[c] * Trig::sin(std::sqrt(std::fabs(xi[c])));
+		}
+	}
+	for (std::size_t c = 0; c < n; ++c) {
+		f[c] = 418.9828872724338 * d - f[c];
+	}
+}
+
+template <class Trig>
+PAGMO_ALWAYS_INLINE void michalewicz_impl(double *f, const double *x, std::size_t n, std::size_t d, int m)
+{
+	const double pi = boost::math::constants::pi<double>();
+	double t[block_size], b[block_size], p[block_size];
+	for (std::size_t c0 = 0; c0 < n; c0 += block_size) {
+		const std::size_t l = std::min(block_size,n - c0);
+		double *s = f + c0;
+		std::fill(s,s + l,0.);
+		for (std::size_t i = 0; i < d; ++i) {
+			const double *xi = x + i * n + c0;
+			for (std::size_t c = 0; c < l; ++c) {
+				const double u = Trig::sin((i + 1) * xi[c] * xi[c] / pi);
+				t[c] = Trig::sin(xi[c]);
+				b[c] = u * u;
+				p[c] = 1.;
+			}
+			// Power by repeated squaring: the exponent is the same for all the candidates, hence the loops stay vectorisable.
+			for (int k = m; k > 0; k >>= 1) {
+				if (k & 1) {
+					for (std::size_t c = 0; c < l; ++c) {
+						p[c] *= b[c];
+					}
+				}
+				for (std::size_t c = 0; c < l; ++c) {
+					b[c] *= b[c];
+				}
+			}
+			for (std::size_t c = 0; c < l; ++c) {
+				s[c] -= t[c] * p[c];
+			}
+		}
+	}
+}
+
+template <class Trig>
+PAGMO_ALWAYS_INLINE void levy5_impl(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	double isum[block_size], jsum[block_size];
+	for (std::size_t c0 = 0; c0 < n; c0 += block_size) {
+		const std::size_t m = std::min(block_size,n - c0);
+		double *s = f + c0;
+		std::fill(isum,isum + m,0.);
+		std::fill(jsum,jsum + m,0.);
+		std::fill(s,s + m,0.);
+		for (std::size_t j = 0; j < d; j += 2) {
+			const double *xi = x + j * n + c0, *xj = xi + n;
+			if (j + 1 < d) {
+				for (int i = 1; i <= 5; ++i) {
+					for (std::size_t c = 0; c < m; ++c) {
+						isum[c] += i * Trig::cos((i - 1) * xi[c] + i);
+						jsum[c] += i * Trig::cos((i + 1) * xj[c] + i);
+					}
+				}
+				for (std::size_t c = 0; c < m; ++c) {
+					s[c] += (xi[c] + 1.42513) * (xi[c] + 1.42513) + (xj[c] + 0.80032) * (xj[c] + 0.80032);
+				}
+			} else {
+				for (int i = 1; i <= 5; ++i) {
+					for (std::size_t c = 0; c < m; ++c) {
+						isum[c] += i * Trig::cos((i - 1) * xi[c] + i);
+					}
+				}
+				for (std::size_t c = 0; c < m; ++c) {
+					s[c] += (xi[c] + 1.42513) * (xi[c] + 1.42513);
+				}
+			}
+		}
+		for (std::size_t c = 0; c < m; ++c) {
+			s[c] += isum[c] * jsum[c];
+		}
+	}
+}
+
+}
+
+/// Ackley kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::ackley.
+ */
+PAGMO_KERNEL
+void ackley(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	const double omega = 2. * boost::math::constants::pi<double>();
+	if (within(x,n * d,max_trig_arg / omega)) {
+		ackley_impl<fast_trig>(f,x,n,d);
+	} else {
+		ackley_impl<libm_trig>(f,x,n,d);
+	}
+}
+
+/// Rastrigin kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::rastrigin.
+ */
+PAGMO_KERNEL
+void rastrigin(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	const double omega = 2. * boost::math::constants::pi<double>();
+	if (within(x,n * d,max_trig_arg / omega)) {
+		rastrigin_impl<fast_trig>(f,x,n,d);
+	} else {
+		rastrigin_impl<libm_trig>(f,x,n,d);
+	}
+}
+
+/// Rosenbrock kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::rosenbrock.
+ */
+PAGMO_KERNEL
+void rosenbrock(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	std::fill(f,f + n,0.);
+	for (std::size_t i = 0; i + 1 < d; ++i) {
+		const double *xi = x + i * n, *xj = xi + n;
+		for (std::size_t c = 0; c < n; ++c) {
+			const double t = xi[c] * xi[c] - xj[c];
+			f[c] += 100 * t * t + (xi[c] - 1) * (xi[c] - 1);
+		}
+	}
+}
+
+/// Griewank kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::griewank.
+ */
+PAGMO_KERNEL
+void griewank(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	if (within(x,n * d,max_trig_arg)) {
+		griewank_impl<fast_trig>(f,x,n,d);
+	} else {
+		griewank_impl<libm_trig>(f,x,n,d);
+	}
+}
+
+/// Schwefel kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::schwefel.
+ */
+PAGMO_KERNEL
+void schwefel(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	if (within(x,n * d,max_trig_arg * max_trig_arg)) {
+		schwefel_impl<fast_trig>(f,x,n,d);
+	} else {
+		schwefel_impl<libm_trig>(f,x,n,d);
+	}
+}
+
+/// De Jong kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::dejong.
+ */
+PAGMO_KERNEL
+void dejong(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	std::fill(f,f + n,0.);
+	for (std::size_t i = 0; i < d; ++i) {
+		const double *xi = x + i * n;
+		for (std::size_t c = 0; c < n; ++c) {
+			f[c] += xi[c] * xi[c];
+		}
+	}
+}
+
+/// Michalewicz kernel.
+/**
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ * @param[in] m steepness parameter of the problem.
+ *
+ * @see problem::michalewicz.
+ */
+PAGMO_KERNEL
+void michalewicz(double *f, const double *x, std::size_t n, std::size_t d, int m)
+{
+	// The largest argument is d * x^2 / pi.
+	const double pi = boost::math::constants::pi<double>();
+	if (within(x,n * d,std::min(max_trig_arg,std::sqrt(max_trig_arg * pi / d)))) {
+		michalewicz_impl<fast_trig>(f,x,n,d,m);
+	} else {
+		michalewicz_impl<libm_trig>(f,x,n,d,m);
+	}
+}
+
+/// Levy5 kernel.
+/**
+ * Components are taken in pairs. If d is odd, the last component contributes only to the terms involving
+ * the first component of a pair.
+ *
+ * @param[out] f fitnesses of the n candidates.
+ * @param[in] x candidates, dimension-major.
+ * @param[in] n number of candidates.
+ * @param[in] d dimension of the candidates.
+ *
+ * @see problem::levy5.
+ */
+PAGMO_KERNEL
+void levy5(double *f, const double *x, std::size_t n, std::size_t d)
+{
+	// The largest argument is 6 * x + 5.
+	if (within(x,n * d,(max_trig_arg - 5.) / 6.)) {
+		levy5_impl<fast_trig>(f,x,n,d);
+	} else {
+		levy5_impl<libm_trig>(f,x,n,d);
+	}
+}
+
+/// Instruction set used by the kernels.
+/**
+ * @return "avx512f" or "avx2" if the kernels compiled for those extensions were selected at load time, "default" otherwise.
+ */
+std::string isa()
+{
+#if defined(PAGMO_KERNELS_DISPATCH)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return "avx512f";
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return "avx2";
+	}
+#endif
+	return "default";
+}
+
+}}}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_BENCHMARK_KERNELS_H
+#define PAGMO_UTIL_BENCHMARK_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../config.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Vectorised kernels of the standard benchmark problems.
+/**
+ * Each kernel evaluates the objective function of a benchmark problem on n candidate solutions of dimension d at once. The candidates
+ * are stored dimension-major in x (x[i * n + c] is the i-th component of the c-th candidate) and the n fitnesses are written to f. With
+ * this layout the inner loops of the kernels run across candidates, so that they are vectorised without reordering the floating point
+ * operations performed on each candidate: the fitness of a candidate does not depend on how many other candidates are evaluated with it,
+ * nor on the instruction set. For n = 1 the layout coincides with a plain decision vector, which is how the objfun_impl() of the problems
+ * use them.
+ *
+ * Trigonometric functions are computed by inline polynomial approximations accurate to a couple of ulps for arguments of magnitude up to
+ * 1E6 (well beyond the bounds of all problems), since library calls would prevent vectorisation. If any candidate leads to larger arguments,
+ * the kernel evaluates all the candidates with the trigonometric functions of the standard library instead. On x86-64 Linux builds made with GCC
+ * the kernels are compiled for several instruction sets and the best one supported by the CPU is selected when the library is loaded (see isa()).
+ */
+namespace kernels {
+
+__PAGMO_VISIBLE_FUNC void ackley(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC void rastrigin(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC void rosenbrock(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC void griewank(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC void schwefel(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC void dejong(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC void michalewicz(double *, const double *, std::size_t, std::size_t, int);
+__PAGMO_VISIBLE_FUNC void levy5(double *, const double *, std::size_t, std::size_t);
+__PAGMO_VISIBLE_FUNC std::string isa();
+
+/// Evaluate a set of decision vectors with a kernel.
+/**
+ * Transposes the decision vectors into dimension-major blocks and hands them to the kernel, which is any callable with the signature
+ * of the kernels above (minus the trailing problem parameters, which can be bound beforehand). Writes the first component of the fitness vectors.
+ *
+ * @param[in] kernel kernel to be used.
+ * @param[out] f fitness vectors.
+ * @param[in] x decision vectors, all of the same dimension.
+ */
+template <class Kernel>
+inline void evaluate(const Kernel &kernel, std::vector<fitness_vector> &f, const std::vector<decision_vector> &x)
+{
+	// Candidates are evaluated in blocks, to keep the transposed buffer in cache.
+	const std::size_t block_size = 256;
+	if (x.empty()) {
+		return;
+	}
+	const std::size_t d = x[0].size();
+	std::vector<double> buffer(block_size * d), retval(block_size);
+	for (std::size_t c0 = 0; c0 < x.size(); c0 += block_size) {
+		const std::size_t n = std::min(block_size,x.size() - c0);
+		for (std::size_t c = 0; c < n; ++c) {
+			for (std::size_t i = 0; i < d; ++i) {
+				buffer[i * n + c] = x[c0 + c][i];
+			}
+		}
+		kernel(&retval[0],&buffer[0],n,d);
+		for (std::size_t c = 0; c < n; ++c) {
+			f[c0 + c][0] = retval[c];
+		}
+	}
+}
+
+}
+
+}}
+
+#endif
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <cstddef>
+
+#include "../exceptions.h"
+#include "de_kernels.h"
+
+namespace pagmo{ namespace util { namespace de_kernels {
+
+/// Constructor.
+/**
+ * @param[in] n size of the range [0,n) of the sampled indices.
+ */
+index_sampler::index_sampler(std::size_t n)
+{
+	resize(n);
+}
+
+/// Set the size of the range of the sampled indices.
+/**
+ * @param[in] n size of the range [0,n) of the sampled indices.
+ */
+void index_sampler::resize(std::size_t n)
+{
+	m_perm.resize(n);
+	m_pos.resize(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		m_perm[i] = i;
+		m_pos[i] = i;
+	}
+}
+
+namespace {
+
+// Mutations of the strategies, in the order of the odd jDE variants (1, 2, 3, 4, 5 are also DE 1 ... 5).
+typedef mutation<BEST,R2,R3> best_1;
+typedef mutation<R1,R2,R3> rand_1;
+typedef mutation<CURRENT,BEST,CURRENT,R1,R2> rand_to_best_1;
+typedef mutation<BEST,R1,R3,R2,R4> best_2;
+typedef mutation<R5,R1,R3,R2,R4> rand_2;
+typedef mutation<BEST,R1,R2,R3,R4,R5,R6> best_3;
+typedef mutation<R7,R1,R2,R3,R4,R5,R6> rand_3;
+typedef mutation<R7,R1,CURRENT,R3,R4> rand_to_current_2;
+typedef mutation<R7,R1,CURRENT,BEST,R4> rand_to_best_and_current_2;
+
+const trial_function trial_table[18] = {
+	&exponential_trial<best_1>,
+	&exponential_trial<rand_1>,
+	&exponential_trial<rand_to_best_1>,
+	&exponential_trial<best_2>,
+	&exponential_trial<rand_2>,
+	&binomial_trial<best_1>,
+	&binomial_trial<rand_1>,
+	&binomial_trial<rand_to_best_1>,
+	&binomial_trial<best_2>,
+	&binomial_trial<rand_2>,
+	&exponential_trial<best_3>,
+	&binomial_trial<best_3>,
+	&exponential_trial<rand_3>,
+	&binomial_trial<rand_3>,
+	&exponential_trial<rand_to_current_2>,
+	&binomial_trial<rand_to_current_2>,
+	&exponential_trial<rand_to_best_and_current_2>,
+	&binomial_trial<rand_to_best_and_current_2>
+};
+
+// Base and differences of the self-adapted parameters of jDE. They follow the vectors, except for 15 and 16 which add
+// the (R5,R6) difference.
+const int parameter_table[9][7] = {
+	{BEST,R2,R3,NONE,NONE,NONE,NONE},
+	{R1,R2,R3,NONE,NONE,NONE,NONE},
+	{CURRENT,BEST,CURRENT,R1,R2,NONE,NONE},
+	{BEST,R1,R3,R2,R4,NONE,NONE},
+	{R5,R1,R3,R2,R4,NONE,NONE},
+	{BEST,R1,R2,R3,R4,R5,R6},
+	{R7,R1,R2,R3,R4,R5,R6},
+	{R7,R1,CURRENT,R3,R4,R5,R6},
+	{R7,R1,CURRENT,BEST,R4,NONE,NONE}
+};
+
+}
+
+/// Trial function of a strategy.
+/**
+ * Strategies 1 ... 10 are those of DE (best/1, rand/1, rand-to-best/1, best/2, rand/2 with exponential and then binomial
+ * crossover), 11 ... 18 the additional ones of jDE (best/3, rand/3, rand-to-current/2, rand-to-best-and-current/2, each with
+ * exponential and binomial crossover).
+ *
+ * @param[in] variant strategy index (1 ... 18).
+ *
+ * @return the trial function of the strategy.
+ *
+ * @throws value_error if the index is not in [1,18].
+ */
+trial_function trial(int variant)
+{
+	if (variant < 1 || variant > 18) {
+		pagmo_throw(value_error,"strategy index must be one of 1 ... 18");
+	}
+	return trial_table[variant - 1];
+}
+
+/// Roles of the self-adapted parameters of a strategy.
+/**
+ * @param[in] variant strategy index (1 ... 18).
+ *
+ * @return seven roles: the base and three differences, unused ones being NONE.
+ *
+ * @throws value_error if the index is not in [1,18].
+ */
+const int *parameter_roles(int variant)
+{
+	if (variant < 1 || variant > 18) {
+		pagmo_throw(value_error,"strategy index must be one of 1 ... 18");
+	}
+	return parameter_table[variant <= 10 ? (variant - 1) % 5 : 5 + (variant - 11) / 2];
+}
+
+}}}
@@ -0,0 +1,265 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_DE_KERNELS_H
+#define PAGMO_UTIL_DE_KERNELS_H
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../rng.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Kernels shared by the differential evolution algorithms.
+/**
+ * A DE trial vector is built from up to nine vectors of the population, identified by their role: the best vector, the current
+ * (target) one and seven distinct random ones. The mutation strategies are templates on the roles they combine, and the crossover
+ * is applied through a mask computed before the mutation, so that the mutant is evaluated with straight loops over contiguous
+ * buffers and the trial never needs a copy of the target. The algorithms select the trial function of their strategy with trial()
+ * once per evolve() (or look it up per individual, if the strategy is adapted), and draw the random vectors with an
+ * index_sampler, which needs no rejection loops.
+ *
+ * The random numbers of the crossover are drawn in the same order as in the original DE code (one per mutated component for the
+ * exponential crossover, one per component for the binomial one).
+ */
+namespace de_kernels {
+
+/// Roles of the vectors combined by the DE strategies.
+/**
+ * The trial functions take an array of pointers to the vectors indexed by role.
+ */
+enum role {
+	BEST = 0, ///< Best vector of the previous generation
+	CURRENT = 1, ///< Target vector
+	R1 = 2, R2 = 3, R3 = 4, R4 = 5, R5 = 6, R6 = 7, R7 = 8, ///< Distinct random vectors, different from the target
+	NONE = 9 ///< Unused
+};
+
+/// Number of random vectors (R1 ... R7).
+const std::size_t n_random = 7;
+
+/// Uniform random index in [0,n).
+/**
+ * Maps a 32-bit draw to [0,n) with a multiplication (Lemire's method), without the division and the construction of a distribution
+ * object needed by boost::uniform_int. The result is exactly uniform: the few biased draws are rejected.
+ *
+ * @param[in] rng 32-bit random engine.
+ * @param[in] n size of the range, at most 2^32.
+ *
+ * @return a random index in [0,n).
+ */
+template <class Rng>
+inline std::size_t uniform_index(Rng &rng, std::size_t n)
+{
+	boost::uint64_t m = boost::uint64_t(boost::uint32_t(rng())) * n;
+	boost::uint32_t l = boost::uint32_t(m);
+	if (l < n) {
+		const boost::uint32_t t = boost::uint32_t(-boost::uint32_t(n)) % boost::uint32_t(n);
+		while (l < t) {
+			m = boost::uint64_t(boost::uint32_t(rng())) * n;
+			l = boost::uint32_t(m);
+		}
+	}
+	return std::size_t(m >> 32);
+}
+
+/// Sampler of distinct random indices.
+/**
+ * Keeps a permutation of [0,n) and the position of each index in it. The excluded indices are swapped to the end, and a partial
+ * Fisher-Yates shuffle of the rest yields k distinct indices with k draws, whatever the order the permutation was left in by the
+ * previous call.
+ */
+class __PAGMO_VISIBLE index_sampler
+{
+	public:
+		/// Marker of a missing second excluded index.
+		static const std::size_t npos = static_cast<std::size_t>(-1);
+		explicit index_sampler(std::size_t = 0);
+		void resize(std::size_t);
+		/// Sample distinct indices.
+		/**
+		 * @param[out] out array of at least k elements, receiving the sampled indices in random order.
+		 * @param[in] k number of indices to sample. It must not exceed the number of indices that are not excluded.
+		 * @param[in] rng 32-bit random engine.
+		 * @param[in] ex1 index that is not sampled.
+		 * @param[in] ex2 second index that is not sampled (npos if none).
+		 */
+		template <class Rng>
+		void sample(std::size_t *out, std::size_t k, Rng &rng, std::size_t ex1, std::size_t ex2 = npos)
+		{
+			std::size_t n = m_perm.size();
+			swap_slots(m_pos[ex1],--n);
+			if (ex2 != npos && ex2 != ex1) {
+				swap_slots(m_pos[ex2],--n);
+			}
+			for (std::size_t j = 0; j < k; ++j) {
+				swap_slots(j,j + uniform_index(rng,n - j));
+				out[j] = m_perm[j];
+			}
+		}
+	private:
+		void swap_slots(std::size_t a, std::size_t b)
+		{
+			std::swap(m_perm[a],m_perm[b]);
+			m_pos[m_perm[a]] = a;
+			m_pos[m_perm[b]] = b;
+		}
+		std::vector<std::size_t>	m_perm;
+		std::vector<std::size_t>	m_pos;
+};
+
+/// DE mutation.
+/**
+ * The mutant is Base + F * (A1 - B1) + F * (A2 - B2) + F * (A3 - B3), where the template parameters are roles and unused
+ * differences are NONE.
+ */
+template <int Base, int A1, int B1, int A2 = NONE, int B2 = NONE, int A3 = NONE, int B3 = NONE>
+struct mutation
+{
+	/// Component j of the mutant.
+	static double component(const double * const *v, double F, std::size_t j)
+	{
+		double retval = v[Base][j] + F * (v[A1][j] - v[B1][j]);
+		if (A2 != NONE) {
+			retval += F * (v[A2][j] - v[B2][j]);
+		}
+		if (A3 != NONE) {
+			retval += F * (v[A3][j] - v[B3][j]);
+		}
+		return retval;
+	}
+	/// Write the components [begin,end) of the mutant to out.
+	static void apply(double *out, const double * const *v, double F, std::size_t begin, std::size_t end)
+	{
+		for (std::size_t j = begin; j < end; ++j) {
+			out[j] = component(v,F,j);
+		}
+	}
+	/// Write the first n components of the mutant to out where mask is set, and those of the target elsewhere.
+	static void apply_masked(double *out, const double * const *v, double F, const char *mask, std::size_t n)
+	{
+		const double *cur = v[CURRENT];
+		for (std::size_t j = 0; j < n; ++j) {
+			const double m = component(v,F,j);
+			out[j] = mask[j] ? m : cur[j];
+		}
+	}
+};
+
+/// Exponential crossover.
+/**
+ * Mutates L consecutive components (circularly in the continuous part) starting from n, where L is drawn as in the original DE
+ * code, and copies the target elsewhere.
+ */
+template <class Mutation>
+inline void exponential_trial(double *trial, const double * const *v, double F, double CR, std::size_t n, std::size_t Dc, std::size_t D, char *, rng_double &drng)
+{
+	std::size_t L = 0;
+	do {
+		++L;
+	} while ((drng() < CR) && (L < Dc));
+	std::copy(v[CURRENT],v[CURRENT] + D,trial);
+	Mutation::apply(trial,v,F,n,std::min(n + L,Dc));
+	if (n + L > Dc) {
+		Mutation::apply(trial,v,F,0,n + L - Dc);
+	}
+}
+
+/// Binomial crossover.
+/**
+ * Draws the mask of the mutated components first (starting from component n, the last one of the cycle is always mutated), and
+ * then blends mutant and target.
+ */
+template <class Mutation>
+inline void binomial_trial(double *trial, const double * const *v, double F, double CR, std::size_t n, std::size_t Dc, std::size_t D, char *mask, rng_double &drng)
+{
+	for (std::size_t L = 0; L < Dc; ++L) {
+		mask[n] = (drng() < CR) || L + 1 == Dc;
+		n = (n + 1 == Dc) ? 0 : n + 1;
+	}
+	Mutation::apply_masked(trial,v,F,mask,Dc);
+	std::copy(v[CURRENT] + Dc,v[CURRENT] + D,trial + Dc);
+}
+
+/// Trial function.
+/**
+ * Builds the trial vector (of size D, the first Dc components being the continuous part) from the vectors indexed by role, with
+ * the weight F, the crossover probability CR and the first crossover component n. The mask must hold at least Dc elements.
+ */
+typedef void (*trial_function)(double *, const double * const *, double, double, std::size_t, std::size_t, std::size_t, char *, rng_double &);
+
+__PAGMO_VISIBLE_FUNC trial_function trial(int);
+__PAGMO_VISIBLE_FUNC const int *parameter_roles(int);
+
+/// Resample the out-of-bounds components of the continuous part uniformly within the bounds.
+inline void repair(double *x, const decision_vector &lb, const decision_vector &ub, std::size_t Dc, rng_double &drng)
+{
+	for (std::size_t j = 0; j < Dc; ++j) {
+		if ((x[j] < lb[j]) || (x[j] > ub[j])) {
+			x[j] = drng() * (ub[j] - lb[j]) + lb[j];
+		}
+	}
+}
+
+/// Self-adapted F or CR of jDE (adaptive variant 2).
+/**
+ * The parameter is combined like the vectors of the strategy: the value of the base role plus, for each difference, a
+ * normally distributed multiple of half the difference of the values of its roles (see parameter_roles()).
+ *
+ * @param[in] variant strategy index (1 ... 18).
+ * @param[in] p values of the parameter of the individuals.
+ * @param[in] best value of the parameter of the best individual.
+ * @param[in] i index of the current individual.
+ * @param[in] r indices of the n_random random individuals.
+ * @param[in] n_dist generator of normally distributed numbers.
+ *
+ * @return the adapted value.
+ */
+template <class Gen>
+inline double adapted_parameter(int variant, const std::vector<double> &p, double best, std::size_t i, const std::size_t *r, Gen &n_dist)
+{
+	const int *roles = parameter_roles(variant);
+	double value[NONE];
+	value[BEST] = best;
+	value[CURRENT] = p[i];
+	for (std::size_t k = 0; k < n_random; ++k) {
+		value[R1 + k] = p[r[k]];
+	}
+	double retval = value[roles[0]];
+	for (int k = 1; k < 7 && roles[k] != NONE; k += 2) {
+		retval += n_dist() * 0.5 * (value[roles[k]] - value[roles[k + 1]]);
+	}
+	return retval;
+}
+
+}
+
+}}
+
+#endif
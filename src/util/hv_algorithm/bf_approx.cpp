@@ -24,6 +24,7 @@
 
 
 #include "bf_approx.h"
+#include <limits>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
@@ -264,6 +265,8 @@ void bf_approx::sampling_round(const std::vector<fitness_vector> &points, const
 				const fitness_vector &refpoint = m_boxes[idx];
 				hypervolume hv_obj = hypervolume(sub_front, false);
 				hv_obj.set_copy_points(false);
+				// The point of the fallback is the exact value.
+				hv_obj.set_approx_threshold(std::numeric_limits<double>::infinity());
 				double hv = hv_obj.compute(refpoint);
 				m_approx_volume[idx] = m_box_volume[idx] - hv;
 			}
@@ -24,18 +24,110 @@
 
 
 #include "bf_fpras.h"
+#include "../thread_pool.h"
 #include <algorithm>
+#include <cstddef>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+namespace {
+
+// Number of samples of a block.
+const std::size_t block_size = 256;
+// Number of trials drawn at once for a sample.
+const unsigned int trial_batch = 8;
+
+// Boxes spanned by the points and the reference point. The coordinates are stored dimension-major (coordinate d of point
+// j at d * n + j), so that a batch of trials reads each dimension from a single array.
+struct boxes
+{
+	boxes(const std::vector<fitness_vector> &points, const fitness_vector &r_point):
+		n(points.size()),dim(r_point.size()),coords(n * dim),sums(n),r(r_point)
+	{
+		double V = 0.0;
+		for(unsigned int j = 0 ; j < n ; ++j) {
+			for(unsigned int d = 0 ; d < dim ; ++d) {
+				coords[d * n + j] = points[j][d];
+			}
+			V = (sums[j] = V + base::volume_between(points[j], r_point));
+		}
+	}
+	const unsigned int n;
+	const unsigned int dim;
+	std::vector<double> coords;
+	// Partial sums of the volumes of the boxes
+	std::vector<double> sums;
+	const fitness_vector r;
+};
+
+// Draws the samples of the blocks first, first + 1, ..., and stores the number of trials each one took. A sample is a
+// point drawn uniformly in a box chosen with probability proportional to its volume, and a trial picks a box at random
+// until one containing the point is found.
+struct sample_blocks
+{
+	sample_blocks(const boxes &b, std::vector<unsigned int> &trials, std::size_t first, rng_uint32::result_type seed):
+		m_boxes(b),m_trials(trials),m_first(first),m_seed(seed) {}
+	void operator()(std::size_t i) const
+	{
+		const unsigned int n = m_boxes.n, dim = m_boxes.dim;
+		const double *coords = &m_boxes.coords[0];
+		const double V = m_boxes.sums.back();
+		// The stream of a block depends only on the seed and on the index of the block.
+		rng_uint32 urng(static_cast<rng_uint32::result_type>(m_seed + m_first + i));
+		rng_double drng(urng());
+		std::vector<double> x(dim);
+		unsigned int idx[trial_batch];
+		int hit[trial_batch];
+		for(std::size_t s = 0 ; s < block_size ; ++s) {
+			const unsigned int box = std::min<unsigned int>(n - 1,
+				static_cast<unsigned int>(std::lower_bound(m_boxes.sums.begin(), m_boxes.sums.end(), drng() * V) - m_boxes.sums.begin()));
+			for(unsigned int d = 0 ; d < dim ; ++d) {
+				x[d] = coords[d * n + box] + drng() * (m_boxes.r[d] - coords[d * n + box]);
+			}
+			unsigned int t = 0;
+			while(true) {
+				for(unsigned int k = 0 ; k < trial_batch ; ++k) {
+					idx[k] = static_cast<unsigned int>((static_cast<boost::uint64_t>(urng()) * n) >> 32);
+					hit[k] = 1;
+				}
+				// All the trials of the batch are tested without early exits.
+				for(unsigned int d = 0 ; d < dim ; ++d) {
+					const double *c = coords + d * n;
+					for(unsigned int k = 0 ; k < trial_batch ; ++k) {
+						hit[k] &= (c[idx[k]] <= x[d]);
+					}
+				}
+				unsigned int k = 0;
+				while(k < trial_batch && !hit[k]) {
+					++k;
+				}
+				if (k < trial_batch) {
+					t += k + 1;
+					break;
+				}
+				t += trial_batch;
+			}
+			m_trials[i * block_size + s] = t;
+		}
+	}
+	const boxes			&m_boxes;
+	std::vector<unsigned int>	&m_trials;
+	const std::size_t		m_first;
+	const rng_uint32::result_type	m_seed;
+};
+
+}
+
 /// Constructor
 /**
  * Constructs an instance of the algorithm
  *
  * @param[in] eps accuracy of the approximation
  * @param[in] delta confidence of the approximation
+ * @param[in] n_threads number of threads used by compute(). If zero, util::thread_pool::default_size() will be used.
  */
-bf_fpras::bf_fpras(const double eps, const double delta) : m_eps(eps), m_delta(delta) { }
+bf_fpras::bf_fpras(const double eps, const double delta, const unsigned int n_threads) :
+	m_eps(eps), m_delta(delta), m_n_threads(n_threads ? n_threads : util::thread_pool::default_size()) { }
 
 /// Verify before compute
 /**
@@ -65,54 +157,37 @@ void bf_fpras::verify_before_compute(const std::vector<fitness_vector> &points,
 double bf_fpras::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
 	unsigned int n = points.size();
-	unsigned int dim = r_point.size();
 	boost::uint_fast64_t T = static_cast<boost::uint_fast64_t>( 12. * std::log( 1. / m_delta ) / std::log( 2. ) * n / m_eps / m_eps );
 
-	// Partial sums of consecutive boxes
-	std::vector<double> sums(n, 0.0);
+	const boxes b(points, r_point);
+	const double V = b.sums.back();
 
-	// points iterator
-	std::vector<fitness_vector>::iterator it_p;
+	// Seed of the random streams of the blocks.
+	const rng_uint32::result_type seed = static_cast<rng_uint32::result_type>(m_drng() * 4294967296.);
 
-	// volume iterator - used for finding the contributor using std::lower_bound
-	std::vector<double>::iterator it_sums;
-
-	unsigned int i = 0;
-
-	// Total sum of every box
-	double V = 0.0;
-	for(it_p = points.begin() ; it_p != points.end() ; ++it_p) {
-		V = (sums[i++] = V + base::volume_between(*it_p, r_point));
-	}
+	// A wave is a single block in a serial run, a few blocks per thread otherwise.
+	const std::size_t wave = (m_n_threads == 1) ? 1 : 4u * m_n_threads;
+	util::thread_pool *pool = (m_n_threads > 1) ? &util::thread_pool::shared(m_n_threads) : 0;
+	std::vector<unsigned int> trials(wave * block_size);
 
 	unsigned long long M = 0; // Round counter
 	unsigned long long M_sum = 0; // Total number of samples over every round so far
 
-	// Container for the random point
-	fitness_vector rnd_point(dim, 0.0);
-
-	while(true) {
-		// Get the random volume in-between [0, V] range, in order to choose the box with probability sums[i] / V
-		double r = m_drng() * V;
-
-		// Find the contributor using binary search
-		it_sums = std::lower_bound(sums.begin(), sums.end(), r);
-		i = std::distance(sums.begin(), it_sums);
-
-		// Sample a point inside the 'box' (r_point, points[i])
-		for(unsigned int d_idx = 0 ; d_idx < dim ; ++d_idx) {
-			rnd_point[d_idx] = (points[i][d_idx] + m_drng() * (r_point[d_idx] - points[i][d_idx]));
+	for(std::size_t first = 0 ; ; first += wave) {
+		const sample_blocks f(b, trials, first, seed);
+		if (pool) {
+			pool->parallel_for(wave, f);
+		} else {
+			f(0);
 		}
-
-		unsigned int j = 0;
-		do {
-			if ( M_sum >= T ) {
+		// Stop at the first sample which does not complete within T trials.
+		for(std::vector<unsigned int>::size_type k = 0 ; k < trials.size() ; ++k) {
+			if (M_sum + trials[k] > T) {
 				return (T * V) / static_cast<double>(n * M);
 			}
-			j = static_cast<unsigned int>(n * m_drng());
-			++M_sum;
-		} while (!(base::dom_cmp(rnd_point, points[j]) == base::DOM_CMP_B_DOMINATES_A));
-		++M;
+			M_sum += trials[k];
+			++M;
+		}
 	}
 }
 
@@ -41,6 +41,11 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 /**
  * This class contains the implementation of the Bringmann-Friedrich approximation scheme (FPRAS), reduced to a special case of approximating the hypervolume indicator.
  *
+ * The samples are drawn in blocks of fixed size, each block with its own random stream, and the stopping rule is checked
+ * after every wave of blocks: the computation stops as soon as the number of trials required by (eps, delta) is reached.
+ * The blocks of a wave can be drawn by several threads. As the random stream of a block depends only on its position in
+ * the sequence, the result does not depend on the number of threads.
+ *
  * @see "Approximating the volume of unions and intersections of high-dimensional geometric objects", Karl Bringmann, Tobias Friedrich.
  *
  * @author Krzysztof Nowak (kn@kiryx.net)
@@ -48,7 +53,7 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 class __PAGMO_VISIBLE bf_fpras : public base
 {
 public:
-	bf_fpras(const double eps = 1e-2, const double delta = 1e-2);
+	bf_fpras(const double eps = 1e-2, const double delta = 1e-2, const unsigned int n_threads = 1);
 
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
 
@@ -66,6 +71,8 @@ private:
 	const double m_eps;
 	// probabiltiy of error
 	const double m_delta;
+	// number of threads drawing the samples
+	const unsigned int m_n_threads;
 
 	mutable rng_double m_drng;
 
@@ -76,6 +83,7 @@ private:
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<double &>(m_eps);
 		ar & const_cast<double &>(m_delta);
+		ar & const_cast<unsigned int &>(m_n_threads);
 		ar & m_drng;
 	}
 };
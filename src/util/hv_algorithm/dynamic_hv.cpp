@@ -0,0 +1,473 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <boost/next_prior.hpp>
+
+#include "../../exceptions.h"
+#include "../hypervolume.h"
+#include "dynamic_hv.h"
+#include "hv3d.h"
+#include "hv4d.h"
+#include "wfg.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+namespace {
+
+// Volume of the box between a point and the reference point.
+double box_volume(const fitness_vector &p, const fitness_vector &r)
+{
+	double v = 1.0;
+	for (fitness_vector::size_type i = 0; i < r.size(); ++i) {
+		v *= r[i] - p[i];
+	}
+	return v;
+}
+
+// True if a weakly dominates b.
+bool weakly_dominates(const fitness_vector &a, const fitness_vector &b)
+{
+	for (fitness_vector::size_type i = 0; i < a.size(); ++i) {
+		if (a[i] > b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+/// Constructor from the reference point
+/**
+ * Constructs an empty set.
+ *
+ * @param[in] r_point reference point
+ *
+ * @throws value_error if the reference point has less than two dimensions
+ */
+dynamic_hv::dynamic_hv(const fitness_vector &r_point):m_refpoint(r_point),m_front_2d(cmp_2d(m_points))
+{
+	if (m_refpoint.size() < 2) {
+		pagmo_throw(value_error, "the dynamic hypervolume requires at least two dimensions");
+	}
+}
+
+/// Constructor from a set of points
+/**
+ * Constructs the set from the given points, whose ids will be their positions in the vector. The initial contributions
+ * are computed in bulk (with HyCon3D in three dimensions), which is faster than inserting the points one by one.
+ *
+ * @param[in] points initial points
+ * @param[in] r_point reference point
+ *
+ * @throws value_error if the reference point has less than two dimensions, if any point has the wrong dimension or
+ * lies outside the reference point, or if in two dimensions a point is strictly dominated by another one
+ */
+dynamic_hv::dynamic_hv(const std::vector<fitness_vector> &points, const fitness_vector &r_point):
+	m_refpoint(r_point),m_front_2d(cmp_2d(m_points))
+{
+	build(points, 0);
+}
+
+/// Constructor from a set of points and their contributions
+/**
+ * As the constructor from a set of points, but the initial contributions are taken from c instead of being computed
+ * (e.g., when they are available from population::get_hv_contributions()). They must be the exclusive contributions of
+ * the points with respect to r_point.
+ *
+ * @param[in] points initial points
+ * @param[in] r_point reference point
+ * @param[in] c exclusive contributions of the points
+ *
+ * @throws value_error if the reference point has less than two dimensions, if any point has the wrong dimension or
+ * lies outside the reference point, if in two dimensions a point is strictly dominated by another one, or if the sizes
+ * of points and c differ
+ */
+dynamic_hv::dynamic_hv(const std::vector<fitness_vector> &points, const fitness_vector &r_point, const std::vector<double> &c):
+	m_refpoint(r_point),m_front_2d(cmp_2d(m_points))
+{
+	if (c.size() != points.size()) {
+		pagmo_throw(value_error, "the number of contributions must be equal to the number of points");
+	}
+	build(points, &c);
+}
+
+// Fill the set with the given points, taking their contributions from c if not null.
+void dynamic_hv::build(const std::vector<fitness_vector> &points, const std::vector<double> *c)
+{
+	if (m_refpoint.size() < 2) {
+		pagmo_throw(value_error, "the dynamic hypervolume requires at least two dimensions");
+	}
+	for (std::vector<fitness_vector>::size_type i = 0; i < points.size(); ++i) {
+		check_point(points[i]);
+	}
+	m_points = points;
+	m_alive.assign(points.size(), 1);
+	m_contributions.assign(points.size(), 0.0);
+	if (points.empty()) {
+		return;
+	}
+	if (m_refpoint.size() == 2) {
+		for (id_type id = 0; id < m_points.size(); ++id) {
+			m_front_2d.insert(id);
+		}
+		for (front_2d_type::const_iterator it = m_front_2d.begin(); boost::next(it) != m_front_2d.end(); ++it) {
+			if (dominates_2d(it, boost::next(it))) {
+				pagmo_throw(value_error, "in two dimensions the points must be mutually non-dominated");
+			}
+		}
+		if (!c) {
+			for (front_2d_type::const_iterator it = m_front_2d.begin(); it != m_front_2d.end(); ++it) {
+				update_2d(it);
+			}
+			return;
+		}
+	}
+	std::vector<double> c_computed;
+	if (!c) {
+		if (points.size() == 1) {
+			c_computed.push_back(box_volume(points[0], m_refpoint));
+		} else {
+			hypervolume hv(points, false);
+			hv.set_copy_points(false);
+			c_computed = hv.contributions(m_refpoint);
+		}
+		c = &c_computed;
+	}
+	for (id_type id = 0; id < m_points.size(); ++id) {
+		set_contribution(id, (*c)[id]);
+	}
+}
+
+/// Insert a point
+/**
+ * Adds a point to the set and updates the contributions it affects.
+ *
+ * @param[in] p point to insert
+ *
+ * @return id of the new point
+ *
+ * @throws value_error if the point has the wrong dimension or lies outside the reference point, or if in two dimensions
+ * it dominates or is dominated by a point of the set (the set is left unchanged)
+ */
+dynamic_hv::id_type dynamic_hv::insert(const fitness_vector &p)
+{
+	check_point(p);
+	const id_type id = store(p);
+	if (m_refpoint.size() == 2) {
+		front_2d_type::const_iterator it = m_front_2d.insert(id).first;
+		if ((it != m_front_2d.begin() && dominates_2d(boost::prior(it), it)) ||
+			(boost::next(it) != m_front_2d.end() && dominates_2d(it, boost::next(it))))
+		{
+			m_front_2d.erase(it);
+			m_by_contribution.erase(std::make_pair(0.0, id));
+			m_alive[id] = 0;
+			m_free.push_back(id);
+			pagmo_throw(value_error, "in two dimensions the points must be mutually non-dominated");
+		}
+		update_2d(it);
+		if (it != m_front_2d.begin()) {
+			update_2d(boost::prior(it));
+		}
+		if (boost::next(it) != m_front_2d.end()) {
+			update_2d(boost::next(it));
+		}
+		return id;
+	}
+	// Find the affected points before the contributions change.
+	std::vector<id_type> affected;
+	for (id_type q = 0; q < m_points.size(); ++q) {
+		if (q != id && m_alive[q] && is_affected(q, id)) {
+			affected.push_back(q);
+		}
+	}
+	for (std::vector<id_type>::size_type i = 0; i < affected.size(); ++i) {
+		set_contribution(affected[i], exclusive(affected[i]));
+	}
+	set_contribution(id, exclusive(id));
+	return id;
+}
+
+/// Erase a point
+/**
+ * Removes a point from the set and updates the contributions it affects. The id of the point may be reused by a later
+ * insertion.
+ *
+ * @param[in] id id of the point to erase
+ *
+ * @throws index_error if the id does not refer to a point in the set
+ */
+void dynamic_hv::erase(const id_type id)
+{
+	check_id(id);
+	m_by_contribution.erase(std::make_pair(m_contributions[id], id));
+	if (m_refpoint.size() == 2) {
+		front_2d_type::iterator it = m_front_2d.find(id);
+		pagmo_assert(it != m_front_2d.end());
+		front_2d_type::const_iterator prev = m_front_2d.end(), next = boost::next(it);
+		if (it != m_front_2d.begin()) {
+			prev = boost::prior(it);
+		}
+		m_front_2d.erase(it);
+		m_alive[id] = 0;
+		m_free.push_back(id);
+		if (prev != m_front_2d.end()) {
+			update_2d(prev);
+		}
+		if (next != m_front_2d.end()) {
+			update_2d(next);
+		}
+		return;
+	}
+	std::vector<id_type> affected;
+	for (id_type q = 0; q < m_points.size(); ++q) {
+		if (q != id && m_alive[q] && is_affected(q, id)) {
+			affected.push_back(q);
+		}
+	}
+	m_alive[id] = 0;
+	m_free.push_back(id);
+	for (std::vector<id_type>::size_type i = 0; i < affected.size(); ++i) {
+		set_contribution(affected[i], exclusive(affected[i]));
+	}
+}
+
+/// Exclusive contribution of a point
+/**
+ * @param[in] id id of the point
+ *
+ * @return hypervolume contributed exclusively by the point
+ *
+ * @throws index_error if the id does not refer to a point in the set
+ */
+double dynamic_hv::contribution(const id_type id) const
+{
+	check_id(id);
+	return m_contributions[id];
+}
+
+/// Least contributor
+/**
+ * Ties are broken in favour of the smallest id.
+ *
+ * @return id of the point contributing the least hypervolume
+ *
+ * @throws value_error if the set is empty
+ */
+dynamic_hv::id_type dynamic_hv::least_contributor() const
+{
+	if (m_by_contribution.empty()) {
+		pagmo_throw(value_error, "the set of points is empty");
+	}
+	return m_by_contribution.begin()->second;
+}
+
+/// Coordinates of a point
+/**
+ * @param[in] id id of the point
+ *
+ * @return reference to the point
+ *
+ * @throws index_error if the id does not refer to a point in the set
+ */
+const fitness_vector &dynamic_hv::get_point(const id_type id) const
+{
+	check_id(id);
+	return m_points[id];
+}
+
+/// Number of points in the set.
+std::vector<fitness_vector>::size_type dynamic_hv::size() const
+{
+	return m_by_contribution.size();
+}
+
+/// Reference point.
+const fitness_vector &dynamic_hv::get_refpoint() const
+{
+	return m_refpoint;
+}
+
+dynamic_hv::cmp_2d::cmp_2d(const std::vector<fitness_vector> &points):m_points(&points) {}
+
+bool dynamic_hv::cmp_2d::operator()(const id_type a, const id_type b) const
+{
+	const fitness_vector &pa = (*m_points)[a], &pb = (*m_points)[b];
+	if (pa[0] != pb[0]) {
+		return pa[0] < pb[0];
+	}
+	if (pa[1] != pb[1]) {
+		return pa[1] > pb[1];
+	}
+	return a < b;
+}
+
+void dynamic_hv::check_point(const fitness_vector &p) const
+{
+	if (p.size() != m_refpoint.size()) {
+		pagmo_throw(value_error, "the dimension of the point does not match the dimension of the reference point");
+	}
+	for (fitness_vector::size_type i = 0; i < p.size(); ++i) {
+		if (!(p[i] <= m_refpoint[i])) {
+			pagmo_throw(value_error, "the point lies outside the reference point boundary");
+		}
+	}
+}
+
+void dynamic_hv::check_id(const id_type id) const
+{
+	if (id >= m_points.size() || !m_alive[id]) {
+		pagmo_throw(index_error, "the id does not refer to a point in the set");
+	}
+}
+
+// Store a point in a free slot, without computing its contribution.
+dynamic_hv::id_type dynamic_hv::store(const fitness_vector &p)
+{
+	id_type id;
+	if (m_free.empty()) {
+		id = m_points.size();
+		m_points.push_back(p);
+		m_contributions.push_back(0.0);
+		m_alive.push_back(1);
+	} else {
+		id = m_free.back();
+		m_free.pop_back();
+		m_points[id] = p;
+		m_alive[id] = 1;
+	}
+	// Keep the ordering by contribution consistent until the real value is known.
+	m_contributions[id] = 0.0;
+	m_by_contribution.insert(std::make_pair(0.0, id));
+	return id;
+}
+
+void dynamic_hv::set_contribution(const id_type id, const double c)
+{
+	m_by_contribution.erase(std::make_pair(m_contributions[id], id));
+	m_contributions[id] = c;
+	m_by_contribution.insert(std::make_pair(c, id));
+}
+
+// Recompute the contribution of a point of the two-dimensional set from its neighbours.
+void dynamic_hv::update_2d(const front_2d_type::const_iterator &it)
+{
+	const fitness_vector &p = m_points[*it];
+	front_2d_type::const_iterator next = boost::next(it);
+	const double w = (next == m_front_2d.end() ? m_refpoint[0] : m_points[*next][0]) - p[0];
+	const double h = (it == m_front_2d.begin() ? m_refpoint[1] : m_points[*boost::prior(it)][1]) - p[1];
+	set_contribution(*it, w * h);
+}
+
+// Whether the point at a, which precedes b in the two-dimensional ordering, is strictly better than b in both objectives.
+// As the first objectives are ordered, this is the only kind of dominance the neighbour-based update cannot handle.
+bool dynamic_hv::dominates_2d(const front_2d_type::const_iterator &a, const front_2d_type::const_iterator &b) const
+{
+	const fitness_vector &pa = m_points[*a], &pb = m_points[*b];
+	return pa[0] < pb[0] && pa[1] < pb[1];
+}
+
+// Whether the contribution of q may change when p enters or leaves the set: the region dominated by both is not
+// dominated by any other point.
+bool dynamic_hv::is_affected(const id_type q, const id_type p) const
+{
+	const fitness_vector &a = m_points[q], &b = m_points[p];
+	const fitness_vector::size_type dim = m_refpoint.size();
+	for (id_type t = 0; t < m_points.size(); ++t) {
+		if (t == q || t == p || !m_alive[t]) {
+			continue;
+		}
+		const fitness_vector &c = m_points[t];
+		fitness_vector::size_type i = 0;
+		for (; i < dim && c[i] <= std::max(a[i], b[i]); ++i) {}
+		if (i == dim) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Exclusive contribution of a point with respect to all the other points in the set, computed as the volume of its box
+// minus the hypervolume of the non-dominated part of its limit set.
+double dynamic_hv::exclusive(const id_type id) const
+{
+	const fitness_vector &a = m_points[id];
+	const fitness_vector::size_type dim = m_refpoint.size();
+	std::vector<fitness_vector> limited;
+	fitness_vector j(dim);
+	for (id_type t = 0; t < m_points.size(); ++t) {
+		if (t == id || !m_alive[t]) {
+			continue;
+		}
+		bool degenerate = false;
+		for (fitness_vector::size_type i = 0; i < dim; ++i) {
+			j[i] = std::max(a[i], m_points[t][i]);
+			degenerate |= (j[i] >= m_refpoint[i]);
+		}
+		if (degenerate) {
+			continue;
+		}
+		if (weakly_dominates(m_points[t], a)) {
+			return 0.0;
+		}
+		// Drop the points of the limit set dominated by j, and j itself if it is dominated.
+		bool dominated = false;
+		for (std::vector<fitness_vector>::size_type k = 0; k < limited.size();) {
+			if (weakly_dominates(limited[k], j)) {
+				dominated = true;
+				break;
+			}
+			if (weakly_dominates(j, limited[k])) {
+				limited[k].swap(limited.back());
+				limited.pop_back();
+			} else {
+				++k;
+			}
+		}
+		if (!dominated) {
+			limited.push_back(j);
+		}
+	}
+	const double v = box_volume(a, m_refpoint);
+	if (limited.empty()) {
+		return v;
+	}
+	if (limited.size() == 1) {
+		return v - box_volume(limited[0], m_refpoint);
+	}
+	// The limit sets are small, and wfg beats fpl on them from five dimensions on.
+	double limited_hv;
+	if (dim == 3) {
+		limited_hv = hv3d().compute(limited, m_refpoint);
+	} else if (dim == 4) {
+		limited_hv = hv4d().compute(limited, m_refpoint);
+	} else {
+		limited_hv = wfg().compute(limited, m_refpoint);
+	}
+	return std::max(0.0, v - limited_hv);
+}
+
+} } }
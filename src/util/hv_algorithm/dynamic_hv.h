@@ -0,0 +1,113 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_HV_ALGORITHM_DYNAMIC_HV_H
+#define PAGMO_UTIL_HV_ALGORITHM_DYNAMIC_HV_H
+
+#include <boost/noncopyable.hpp>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../../config.h"
+#include "../../types.h"
+
+namespace pagmo { namespace util { namespace hv_algorithm {
+
+/// Dynamic hypervolume contributions
+/**
+ * This class maintains the exclusive hypervolume contributions of a changing set of points with respect to a fixed
+ * reference point. Points can be inserted and erased one at a time, and the least contributor is available at any moment
+ * in logarithmic time. It is meant for steady-state selection schemes (e.g., SMS-EMOA or greedy migration policies), which
+ * would otherwise recompute all the contributions from scratch after every single change of the front.
+ *
+ * Each point is identified by the id returned at insertion (or by its position in the vector passed to the constructor).
+ * Ids of erased points are recycled by later insertions.
+ *
+ * In two dimensions the points are kept sorted along the first objective, and inserting or erasing a point updates the
+ * contributions of its two neighbours only, in logarithmic time. This requires the set to be mutually non-dominated:
+ * a point strictly better than another one in both objectives is rejected with a value_error. Duplicates and points
+ * sharing one coordinate are allowed.
+ *
+ * In three or more dimensions the contribution of a point q changes after inserting or erasing p only if the
+ * componentwise maximum of p and q is not weakly dominated by any other point of the set. The points passing this
+ * test are recomputed exactly, on the limit set of the other points, using hv3d, hv4d or wfg depending on the
+ * dimension. The set may contain dominated points. The test scans the whole set for each point, so an update costs
+ * O(N^2 D) on top of the recomputations: it is not incremental, it only saves the exclusive hypervolume computations
+ * of the points that are not affected.
+ *
+ * Contributions are always recomputed from the coordinates rather than adjusted by differences, so that rounding errors
+ * do not accumulate over long sequences of updates.
+ */
+class __PAGMO_VISIBLE dynamic_hv: private boost::noncopyable
+{
+public:
+	/// Identifier of a point in the set.
+	typedef std::vector<fitness_vector>::size_type id_type;
+
+	explicit dynamic_hv(const fitness_vector &);
+	dynamic_hv(const std::vector<fitness_vector> &, const fitness_vector &);
+	dynamic_hv(const std::vector<fitness_vector> &, const fitness_vector &, const std::vector<double> &);
+
+	id_type insert(const fitness_vector &);
+	void erase(const id_type);
+	double contribution(const id_type) const;
+	id_type least_contributor() const;
+	const fitness_vector &get_point(const id_type) const;
+	std::vector<fitness_vector>::size_type size() const;
+	const fitness_vector &get_refpoint() const;
+
+private:
+	// Orders the ids of a two-dimensional set by increasing first objective, then decreasing second objective, then id.
+	struct cmp_2d
+	{
+		explicit cmp_2d(const std::vector<fitness_vector> &);
+		bool operator()(const id_type, const id_type) const;
+		const std::vector<fitness_vector> *m_points;
+	};
+	typedef std::set<id_type, cmp_2d> front_2d_type;
+
+	void build(const std::vector<fitness_vector> &, const std::vector<double> *);
+	void check_point(const fitness_vector &) const;
+	void check_id(const id_type) const;
+	id_type store(const fitness_vector &);
+	void set_contribution(const id_type, const double);
+	void update_2d(const front_2d_type::const_iterator &);
+	bool dominates_2d(const front_2d_type::const_iterator &, const front_2d_type::const_iterator &) const;
+	bool is_affected(const id_type, const id_type) const;
+	double exclusive(const id_type) const;
+
+	const fitness_vector				m_refpoint;
+	std::vector<fitness_vector>			m_points;
+	std::vector<double>				m_contributions;
+	std::vector<char>				m_alive;
+	std::vector<id_type>				m_free;
+	std::set<std::pair<double, id_type> >		m_by_contribution;
+	front_2d_type					m_front_2d;
+};
+
+} } }
+
+#endif
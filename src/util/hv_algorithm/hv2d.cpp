@@ -24,10 +24,132 @@
 
 
 #include "hv2d.h"
-#include "hv3d.h"
+#include "../thread_workspace.h"
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+namespace {
+
+// A point of a 2-dimensional front, with its position in the input.
+struct point_2d
+{
+	double		x;
+	double		y;
+	unsigned int	idx;
+};
+
+bool cmp_y(const point_2d &a, const point_2d &b)
+{
+	return a.y < b.y;
+}
+
+bool cmp_xy(const point_2d &a, const point_2d &b)
+{
+	return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Points of the front, reused across the calls made by a thread.
+typedef std::vector<point_2d> hv2d_workspace;
+
+void load(hv2d_workspace &s, const std::vector<fitness_vector> &points)
+{
+	s.resize(points.size());
+	for (std::vector<fitness_vector>::size_type i = 0; i < points.size(); ++i) {
+		s[i].x = points[i][0];
+		s[i].y = points[i][1];
+		s[i].idx = i;
+	}
+}
+
+void load(hv2d_workspace &s, const double *points, unsigned int n_points)
+{
+	s.resize(n_points);
+	for (unsigned int i = 0; i < n_points; ++i) {
+		s[i].x = points[2 * i];
+		s[i].y = points[2 * i + 1];
+		s[i].idx = i;
+	}
+}
+
+// Area dominated by the (at least two) points in s, sorting them by increasing second coordinate first if requested.
+double sweep(hv2d_workspace &s, const double *r_point, const bool sorting)
+{
+	if (sorting) {
+		std::sort(s.begin(), s.end(), cmp_y);
+	}
+
+	double hypervolume = 0.0;
+
+	// width of the sweeping line
+	double w = r_point[0] - s[0].x;
+	for(hv2d_workspace::size_type idx = 0 ; idx < s.size() - 1 ; ++idx) {
+		hypervolume += (s[idx + 1].y - s[idx].y) * w;
+		w = std::max(w, r_point[0] - s[idx + 1].x);
+	}
+	hypervolume += (r_point[1] - s.back().y) * w;
+
+	return hypervolume;
+}
+
+// Area of the box between p and the upper corner (ux, uy) which is not dominated by the points in [first, last), all of
+// them dominated by p and sorted by increasing first coordinate.
+double free_area(const point_2d &p, const point_2d *first, const point_2d *last, const double ux, const double uy)
+{
+	// Area of the union of the boxes between the points and the upper corner, swept along the first coordinate.
+	double covered = 0.0, x = ux, y_min = uy;
+	for (; first != last; ++first) {
+		if (first->y >= uy) {
+			continue;
+		}
+		if (y_min < uy) {
+			covered += (first->x - x) * (uy - y_min);
+		}
+		x = first->x;
+		y_min = std::min(y_min, first->y);
+	}
+	if (y_min < uy) {
+		covered += (ux - x) * (uy - y_min);
+	}
+	return (ux - p.x) * (uy - p.y) - covered;
+}
+
+// Exclusive contributions of the (at least one) points in s, written to c in the order of the input.
+//
+// Once sorted by the first coordinate (then the second), a point is dominated iff the last non-dominated point before it is
+// at least as good in the second coordinate. A dominated point contributes nothing. The contribution of a non-dominated
+// point is the box bounded by its two non-dominated neighbours (or the reference point), minus the part of it dominated
+// by the points it dominates: those are the dominated points following it in the sorted order, up to the next
+// non-dominated point. Duplicates of a non-dominated point take its contribution to zero.
+void contributions_sweep(hv2d_workspace &s, const double *r_point, double *c)
+{
+	for (hv2d_workspace::size_type i = 0; i < s.size(); ++i) {
+		c[i] = 0.0;
+	}
+	std::sort(s.begin(), s.end(), cmp_xy);
+
+	// Position of the last non-dominated point, whether it has a duplicate, and second coordinate of the previous one.
+	hv2d_workspace::size_type last = 0;
+	bool duplicate = false;
+	double y_prev = r_point[1];
+	for (hv2d_workspace::size_type k = 1; k <= s.size(); ++k) {
+		if (k < s.size() && s[k].y >= s[last].y) {
+			duplicate = duplicate || (s[k].x == s[last].x && s[k].y == s[last].y);
+			continue;
+		}
+		if (!duplicate) {
+			const double x_next = k < s.size() ? s[k].x : r_point[0];
+			c[s[last].idx] = free_area(s[last], &s[0] + last + 1, &s[0] + k, x_next, y_prev);
+		}
+		if (k < s.size()) {
+			y_prev = s[last].y;
+			last = k;
+			duplicate = false;
+		}
+	}
+}
+
+}
+
 /// Constructor
 hv2d::hv2d(const bool initial_sorting) : m_initial_sorting(initial_sorting) { }
 
@@ -50,21 +172,35 @@ double hv2d::compute(std::vector<fitness_vector> &points, const fitness_vector &
 		return base::volume_between(points[0], r_point);
 	}
 
-	if (m_initial_sorting) {
-		sort(points.begin(), points.end(), fitness_vector_cmp(1, '<'));
-	}
-
-	double hypervolume = 0.0;
+	thread_workspace<hv2d_workspace> ws;
+	load(*ws, points);
+	return sweep(*ws, &r_point[0], m_initial_sorting);
+}
 
-	// width of the sweeping line
-	double w = r_point[0] - points[0][0];
-	for(unsigned int idx = 0 ; idx < points.size() - 1 ; ++idx) {
-		hypervolume += (points[idx + 1][1] - points[idx][1]) * w;
-		w = std::max(w, r_point[0] - points[idx+1][0]);
+/// Compute hypervolume method.
+/**
+ * Flat version of the method above: no allocation is made once the buffers of the calling thread have grown to the size
+ * of the input. The input is not modified: when initial sorting is enabled, the points are sorted in a copy.
+ *
+ * Computational complexity: n*log(n)
+ *
+ * @param[in] points array of n_points 2-dimensional points, stored contiguously (x0, y0, x1, y1, ...)
+ * @param[in] n_points number of points
+ * @param[in] r_point 2-dimensional reference point for the points
+ *
+ * @return hypervolume
+ */
+double hv2d::compute(const double *points, unsigned int n_points, const double *r_point) const
+{
+	if (n_points == 0) {
+		return 0.0;
+	} else if (n_points == 1) {
+		return (r_point[0] - points[0]) * (r_point[1] - points[1]);
 	}
-	hypervolume += (r_point[1] - points[points.size() - 1][1]) * w;
 
-	return hypervolume;
+	thread_workspace<hv2d_workspace> ws;
+	load(*ws, points, n_points);
+	return sweep(*ws, r_point, m_initial_sorting);
 }
 
 /// Comparison function for arrays of double.
@@ -117,7 +253,11 @@ double hv2d::compute(double** points, unsigned int n_points, double* r_point) co
 
 /// Contributions method
 /**
- * Computes the contributions of each point by invoking the HV3D algorithm with mock third dimension.
+ * Computes the contributions of all the points in a single sweep: once the points are sorted by the first coordinate, the
+ * contribution of a non-dominated point is the rectangle bounded by its two non-dominated neighbours, minus the part of
+ * it covered by the points it dominates. Dominated points and duplicates contribute nothing.
+ *
+ * Computational complexity: n*log(n)
  *
  * @param[in] points vector of points containing the 2-dimensional points for which we compute the hypervolume
  * @param[in] r_point reference point for the points
@@ -125,19 +265,35 @@ double hv2d::compute(double** points, unsigned int n_points, double* r_point) co
  */
 std::vector<double> hv2d::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	std::vector<fitness_vector> new_points(points.size(), fitness_vector(3, 0.0));
-	fitness_vector new_r(r_point);
-	new_r.push_back(1.0);
-
-	for(unsigned int i = 0 ; i < points.size() ; ++i) {
-		new_points[i][0] = points[i][0];
-		new_points[i][1] = points[i][1];
-		new_points[i][2] = 0.0;
+	std::vector<double> c(points.size());
+	if (!points.empty()) {
+		thread_workspace<hv2d_workspace> ws;
+		load(*ws, points);
+		contributions_sweep(*ws, &r_point[0], &c[0]);
 	}
-	// Set sorting to off since contributions are sorted by third dimension
-	return hv3d(false).contributions(new_points, new_r);
+	return c;
 }
 
+/// Contributions method
+/**
+ * Flat version of the method above: no allocation is made once the buffers of the calling thread have grown to the size
+ * of the input.
+ *
+ * @param[in] points array of n_points 2-dimensional points, stored contiguously (x0, y0, x1, y1, ...)
+ * @param[in] n_points number of points
+ * @param[in] r_point 2-dimensional reference point for the points
+ * @param[out] c array of n_points exclusive contributions, in the order of the points
+ */
+void hv2d::contributions(const double *points, unsigned int n_points, const double *r_point, double *c) const
+{
+	if (n_points == 0) {
+		return;
+	}
+
+	thread_workspace<hv2d_workspace> ws;
+	load(*ws, points, n_points);
+	contributions_sweep(*ws, r_point, c);
+}
 
 /// Comparison function for sorting of pairs (point, index)
 /**
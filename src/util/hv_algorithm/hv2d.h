@@ -38,6 +38,11 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 /**
  * This is the class containing the implementation of the hypervolume algorithm for the 2-dimensional fronts.
  * This method achieves the lower bound of n*log(n) time by sorting the initial set of points and then computing the partial areas linearly.
+ * The contributions of all the points are computed in a single sweep of the same complexity.
+ *
+ * Besides the interface common to all the algorithms, hv2d offers flat versions of compute and contributions, taking the points as
+ * a contiguous array of coordinates. The sorting is done in buffers kept by the calling thread, so that the many small fronts
+ * processed by steady-state selection schemes do not cost any allocation.
  *
  * @author Krzysztof Nowak (kn@kiryx.net)
  */
@@ -47,7 +52,9 @@ public:
 	hv2d(const bool initial_sorting = true);
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
 	double compute(double**, unsigned int n_points, double*) const;
+	double compute(const double *, unsigned int n_points, const double *) const;
 	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &) const;
+	void contributions(const double *, unsigned int n_points, const double *, double *) const;
 
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
@@ -23,11 +23,142 @@
  *****************************************************************************/
 
 
+#include <limits>
+
 #include "hv3d.h"
 #include "wfg.h"
+#include "../arena.h"
+#include "../thread_workspace.h"
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
+namespace {
+
+// Orders points stored contiguously by increasing third coordinate.
+struct cmp_z
+{
+	bool operator()(const double *a, const double *b) const
+	{
+		return a[2] < b[2];
+	}
+};
+
+// Orders points stored contiguously by decreasing first coordinate.
+struct cmp_x_desc
+{
+	bool operator()(const double *a, const double *b) const
+	{
+		return a[0] > b[0];
+	}
+};
+
+// Orders the indices of points stored in a flat array (3 coordinates each) by decreasing first coordinate.
+struct cmp_idx_x_desc
+{
+	explicit cmp_idx_x_desc(const double *p):m_p(p) {}
+	bool operator()(const int a, const int b) const
+	{
+		return m_p[3 * a] > m_p[3 * b];
+	}
+	const double *m_p;
+};
+
+// Orders the indices of points stored in a flat array (3 coordinates each) by increasing third coordinate.
+struct cmp_idx_z
+{
+	explicit cmp_idx_z(const double *p):m_p(p) {}
+	bool operator()(const unsigned int a, const unsigned int b) const
+	{
+		return m_p[3 * a + 2] < m_p[3 * b + 2];
+	}
+	const double *m_p;
+};
+
+}
+
+// Buffers reused across the calls made by a thread. Nodes of the sweeping trees are allocated from the arena, which is reset at
+// the beginning of every call.
+struct hv3d::workspace
+{
+	util::arena			mem;
+	std::vector<double>		flat;
+	std::vector<const double *>	order;
+	std::vector<unsigned int>	perm;
+	std::vector<double>		p;
+	std::vector<double>		c;
+	std::vector<int>		d;
+	// Boxes of the HyCon3D lists, linked by position in the vector, and first/last box of the list of every point.
+	std::vector<box3d>		boxes;
+	std::vector<int>		prev;
+	std::vector<int>		next;
+	std::vector<int>		head;
+	std::vector<int>		tail;
+
+	// Copy the points into the flat buffer.
+	const double *flatten(const std::vector<fitness_vector> &points)
+	{
+		flat.resize(3 * points.size());
+		for (std::vector<fitness_vector>::size_type i = 0; i < points.size(); ++i) {
+			flat[3 * i] = points[i][0];
+			flat[3 * i + 1] = points[i][1];
+			flat[3 * i + 2] = points[i][2];
+		}
+		return flat.empty() ? 0 : &flat[0];
+	}
+	// Empty the box lists of n points.
+	void reset_lists(const unsigned int n)
+	{
+		boxes.clear();
+		prev.clear();
+		next.clear();
+		head.assign(n, -1);
+		tail.assign(n, -1);
+	}
+	bool empty(const int l) const
+	{
+		return head[l] < 0;
+	}
+	box3d &front(const int l)
+	{
+		return boxes[head[l]];
+	}
+	box3d &back(const int l)
+	{
+		return boxes[tail[l]];
+	}
+	void push_back(const int l, const box3d &b)
+	{
+		const int k = boxes.size();
+		boxes.push_back(b);
+		prev.push_back(tail[l]);
+		next.push_back(-1);
+		if (tail[l] < 0) {
+			head[l] = k;
+		} else {
+			next[tail[l]] = k;
+		}
+		tail[l] = k;
+	}
+	void pop_front(const int l)
+	{
+		head[l] = next[head[l]];
+		if (head[l] < 0) {
+			tail[l] = -1;
+		} else {
+			prev[head[l]] = -1;
+		}
+	}
+	void pop_back(const int l)
+	{
+		tail[l] = prev[tail[l]];
+		if (tail[l] < 0) {
+			head[l] = -1;
+		} else {
+			next[tail[l]] = -1;
+		}
+	}
+};
+
 /// Constructor
 /**
  * Constructor of the algorithm object.
@@ -55,28 +186,62 @@ hv3d::hv3d(bool initial_sorting) : m_initial_sorting(initial_sorting) { }
  */
 double hv3d::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
+	thread_workspace<workspace> ws;
+	return compute(*ws, ws->flatten(points), points.size(), &r_point[0]);
+}
+
+/// Compute hypervolume
+/**
+ * Flat version of the method above: no allocation is made once the buffers of the calling thread have grown to the size
+ * of the input. The input is not modified: when initial sorting is enabled, the points are sorted in a copy.
+ *
+ * @param[in] points array of n_points 3-dimensional points, stored contiguously (x0, y0, z0, x1, y1, z1, ...)
+ * @param[in] n_points number of points
+ * @param[in] r_point 3-dimensional reference point for the points
+ *
+ * @return hypervolume.
+ */
+double hv3d::compute(const double *points, unsigned int n_points, const double *r_point) const
+{
+	thread_workspace<workspace> ws;
+	return compute(*ws, points, n_points, r_point);
+}
+
+// Beume's sweep on the given workspace.
+double hv3d::compute(workspace &ws, const double *points, const unsigned int n_points, const double *r_point) const
+{
+	if (n_points == 0) {
+		return 0.0;
+	}
+	std::vector<const double *> &order = ws.order;
+	order.resize(n_points);
+	for (unsigned int i = 0; i < n_points; ++i) {
+		order[i] = points + 3 * i;
+	}
 	if (m_initial_sorting) {
-		sort(points.begin(), points.end(), fitness_vector_cmp(2,'<'));
+		std::sort(order.begin(), order.end(), cmp_z());
 	}
 	double V = 0.0; // hypervolume
 	double A = 0.0; // area of the sweeping plane
-	std::multiset<fitness_vector, fitness_vector_cmp> T(fitness_vector_cmp(0, '>'));
+	ws.mem.reset();
+	typedef std::multiset<const double *, cmp_x_desc, arena_allocator<const double *> > tree_t;
+	tree_t T((cmp_x_desc()), arena_allocator<const double *>(ws.mem));
 
 	// sentinel points (r_point[0], -INF, r_point[2]) and (-INF, r_point[1], r_point[2])
 	const double INF = std::numeric_limits<double>::max();
-	fitness_vector sA(r_point.begin(), r_point.end()); sA[1] = -INF;
-	fitness_vector sB(r_point.begin(), r_point.end()); sB[0] = -INF;
+	const double sA[3] = {r_point[0], -INF, r_point[2]};
+	const double sB[3] = {-INF, r_point[1], r_point[2]};
 
 	T.insert(sA);
 	T.insert(sB);
-	double z3 = points[0][2];
-	T.insert(points[0]);
-	A = fabs((points[0][0] - r_point[0]) * (points[0][1] - r_point[1]));
-
-	std::multiset<fitness_vector>::iterator p;
-	std::multiset<fitness_vector>::iterator q;
-	for(std::vector<fitness_vector>::size_type idx = 1 ; idx < points.size() ; ++idx) {
-		p = T.insert(points[idx]);
+	double z3 = order[0][2];
+	T.insert(order[0]);
+	A = fabs((order[0][0] - r_point[0]) * (order[0][1] - r_point[1]));
+
+	tree_t::iterator p;
+	tree_t::iterator q;
+	for(unsigned int idx = 1 ; idx < n_points ; ++idx) {
+		p = T.insert(order[idx]);
 		q = (p);
 		++q; //setup q to be a successor of p
 		if ( (*q)[1] <= (*p)[1] ) { // current point is dominated
@@ -84,11 +249,11 @@ double hv3d::compute(std::vector<fitness_vector> &points, const fitness_vector &
 		} else {
 			V += A * fabs(z3 - (*p)[2]);
 			z3 = (*p)[2];
-			std::multiset<fitness_vector>::reverse_iterator rev_it(q);
+			tree_t::reverse_iterator rev_it(q);
 			++rev_it;
 
-			std::multiset<fitness_vector>::reverse_iterator erase_begin (rev_it);
-			std::multiset<fitness_vector>::reverse_iterator rev_it_pred;
+			tree_t::reverse_iterator erase_begin (rev_it);
+			tree_t::reverse_iterator rev_it_pred;
 			while((*rev_it)[1] >= (*p)[1] ) {
 				rev_it_pred = rev_it;
 				++rev_it_pred;
@@ -104,12 +269,6 @@ double hv3d::compute(std::vector<fitness_vector> &points, const fitness_vector &
 	return V;
 }
 
-/// Comparator method for hycon3d algorithm's tree structure
-bool hv3d::hycon3d_tree_cmp::operator()(const std::pair<fitness_vector, int> &a, const std::pair<fitness_vector, int> &b)
-{
-	return a.first[0] > b.first[0];
-}
-
 /// Box volume method
 /**
  * Returns the volume of the box3d object
@@ -119,12 +278,6 @@ double hv3d::box_volume(const box3d &b)
 	return fabs((b.ux - b.lx) * (b.uy - b.ly) * (b.uz - b.lz));
 }
 
-/// Comparator method for the hycon3d algorithm's sorting procedure
-bool hv3d::hycon3d_sort_cmp(const std::pair<fitness_vector, unsigned int> &a, const std::pair<fitness_vector, unsigned int> &b)
-{
-	return a.first[2] < b.first[2];
-}
-
 /// Contributions method
 /*
  * This method is the implementation of the HyCon3D algorithm.
@@ -138,89 +291,124 @@ bool hv3d::hycon3d_sort_cmp(const std::pair<fitness_vector, unsigned int> &a, co
  */
 std::vector<double> hv3d::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	// Make a copy of the original set of points
-	std::vector<fitness_vector> p(points.begin(), points.end());
+	std::vector<double> c(points.size());
+	if (!points.empty()) {
+		thread_workspace<workspace> ws;
+		contributions(*ws, ws->flatten(points), points.size(), &r_point[0], &c[0]);
+	}
+	return c;
+}
 
-	std::vector<std::pair<fitness_vector, unsigned int> > point_pairs;
-	point_pairs.reserve(p.size());
-	for(unsigned int i = 0 ; i < p.size() ; ++i) {
-		point_pairs.push_back(std::make_pair(p[i], i));
+/// Contributions method
+/**
+ * Flat version of the method above: no allocation is made once the buffers of the calling thread have grown to the size
+ * of the input (unless the points are not mutually non-dominated, in which case the computation is left to wfg).
+ *
+ * @param[in] points array of n_points 3-dimensional points, stored contiguously (x0, y0, z0, x1, y1, z1, ...)
+ * @param[in] n_points number of points
+ * @param[in] r_point 3-dimensional reference point for the points
+ * @param[out] c array of n_points exclusive contributions, in the order of the points
+ */
+void hv3d::contributions(const double *points, unsigned int n_points, const double *r_point, double *c) const
+{
+	if (n_points == 0) {
+		return;
 	}
-	if (m_initial_sorting) {
-		sort(point_pairs.begin(), point_pairs.end(), hycon3d_sort_cmp);
+	thread_workspace<workspace> ws;
+	contributions(*ws, points, n_points, r_point, c);
+}
+
+// HyCon3D on the given workspace.
+void hv3d::contributions(workspace &ws, const double *points, const unsigned int n, const double *r_point, double *contribs) const
+{
+	// Sort a copy of the points, keeping track of their original positions.
+	std::vector<unsigned int> &perm = ws.perm;
+	perm.resize(n);
+	for(unsigned int i = 0 ; i < n ; ++i) {
+		perm[i] = i;
 	}
-	for(unsigned int i = 0 ; i < p.size() ; ++i) {
-		p[i] = point_pairs[i].first;
+	if (m_initial_sorting) {
+		std::sort(perm.begin(), perm.end(), cmp_idx_z(points));
 	}
 
-
-	typedef std::multiset<std::pair<fitness_vector, int>, hycon3d_tree_cmp > tree_t;
-
-	unsigned int n = p.size();
 	const double INF = std::numeric_limits<double>::max();
 
 	// Placeholder value for undefined lower z value.
 	const double NaN = INF;
 
-	// Contributions
-	std::vector<double> c(n, 0.0);
-
-	// Sentinel points
-	fitness_vector s_x(3, -INF); s_x[0] = r_point[0]; // (r,oo,oo)
-	fitness_vector s_y(3, -INF); s_y[1] = r_point[1]; // (oo,r,oo)
-	fitness_vector s_z(3, -INF); s_z[2] = r_point[2]; // (oo,oo,r)
+	// Sorted points, followed by the sentinels (oo,oo,r) as p[n], (r,oo,oo) as p[n + 1] and (oo,r,oo) as p[n + 2]
+	std::vector<double> &p_flat = ws.p;
+	p_flat.resize(3 * (n + 3));
+	for(unsigned int i = 0 ; i < n ; ++i) {
+		std::copy(points + 3 * perm[i], points + 3 * perm[i] + 3, &p_flat[3 * i]);
+	}
+	const double sentinels[9] = {-INF, -INF, r_point[2], r_point[0], -INF, -INF, -INF, r_point[1], -INF};
+	std::copy(sentinels, sentinels + 9, &p_flat[3 * n]);
+	const double *p = &p_flat[0];
 
-	p.push_back(s_z); // p[n]
-	p.push_back(s_x); // p[n + 1]
-	p.push_back(s_y); // p[n + 2]
+	// Contributions (the sentinels collect some volume too)
+	std::vector<double> &c = ws.c;
+	c.assign(n + 3, 0.0);
 
-	tree_t T;
-	T.insert(std::make_pair(p[0], 0));
-	T.insert(std::make_pair(s_x, n + 1));
-	T.insert(std::make_pair(s_y, n + 2));
+	ws.mem.reset();
+	typedef std::multiset<int, cmp_idx_x_desc, arena_allocator<int> > tree_t;
+	tree_t T(cmp_idx_x_desc(p), arena_allocator<int>(ws.mem));
+	T.insert(0);
+	T.insert(n + 1);
+	T.insert(n + 2);
 
 	// Boxes
-	std::vector<std::deque<box3d> > L(n + 3);
+	ws.reset_lists(n + 3);
+	ws.boxes.reserve(3 * n + 3);
+	ws.prev.reserve(3 * n + 3);
+	ws.next.reserve(3 * n + 3);
 
-	box3d b(r_point[0], r_point[1], NaN, p[0][0], p[0][1], p[0][2]);
-	L[0].push_front(b);
+	ws.push_back(0, box3d(r_point[0], r_point[1], NaN, p[0], p[1], p[2]));
 
+	std::vector<int> &d = ws.d;
 	for (unsigned int i = 1 ; i < n + 1 ; ++i) {
-		std::pair<fitness_vector, int> pi(p[i], i);
+		const double *pi = p + 3 * i;
 
-		tree_t::iterator it = T.lower_bound(pi);
+		tree_t::iterator it = T.lower_bound(i);
 
 		// Point is dominated
-		if (p[i][1] >= (*it).first[1]) {
-			return wfg(2).contributions(points, r_point);
+		if (pi[1] >= p[3 * (*it) + 1]) {
+			std::vector<fitness_vector> points_v(n, fitness_vector(3));
+			for (unsigned int j = 0 ; j < n ; ++j) {
+				std::copy(points + 3 * j, points + 3 * j + 3, points_v[j].begin());
+			}
+			const fitness_vector r_v(r_point, r_point + 3);
+			const std::vector<double> c_wfg = wfg(2).contributions(points_v, r_v);
+			std::copy(c_wfg.begin(), c_wfg.end(), contribs);
+			return;
 		}
 
 		tree_t::reverse_iterator r_it(it);
 
-		std::vector<int> d;
+		d.clear();
 
-		while((*r_it).first[1] > p[i][1]) {
-			d.push_back((*r_it).second);
+		while(p[3 * (*r_it) + 1] > pi[1]) {
+			d.push_back(*r_it);
 			++r_it;
 		}
 
-		int r = (*it).second;
-		int t = (*r_it).second;
+		int r = *it;
+		int t = *r_it;
 
 		T.erase(r_it.base(), it);
 
 		// Process right neighbor region, region R
-		while(!L[r].empty()) {
-			box3d& b = L[r].front();
-			if(b.ux >= p[i][0]) {
-				b.lz = p[i][2];
+		while(!ws.empty(r)) {
+			box3d& b = ws.front(r);
+			if(b.ux >= pi[0]) {
+				b.lz = pi[2];
 				c[r] += box_volume(b);
-				L[r].pop_front();
-			} else if(b.lx > p[i][0]) {
-				b.lz = p[i][2];
+				ws.pop_front(r);
+			} else if(b.lx > pi[0]) {
+				b.lz = pi[2];
 				c[r] += box_volume(b);
-				b.lx = p[i][0];
-				b.uz = p[i][2];
+				b.lx = pi[0];
+				b.uz = pi[2];
 				b.lz = NaN;
 				break;
 			} else {
@@ -229,47 +417,45 @@ std::vector<double> hv3d::contributions(std::vector<fitness_vector> &points, con
 		}
 
 		// Process dominated points, region M
-		double xleft = p[t][0];
+		double xleft = p[3 * t];
 		std::vector<int>::reverse_iterator r_it_idx = d.rbegin();
 		std::vector<int>::reverse_iterator r_it_idx_e = d.rend();
 		for(;r_it_idx != r_it_idx_e ; ++r_it_idx) {
 			int jdom = *r_it_idx;
-			while(!L[jdom].empty()) {
-				box3d& b = L[jdom].front();
-				b.lz = p[i][2];
+			while(!ws.empty(jdom)) {
+				box3d& b = ws.front(jdom);
+				b.lz = pi[2];
 				c[jdom] += box_volume(b);
-				L[jdom].pop_front();
+				ws.pop_front(jdom);
 			}
-			L[i].push_back(box3d(xleft, p[jdom][1], NaN, p[jdom][0], p[i][1], p[i][2]));
-			xleft = p[jdom][0];
+			ws.push_back(i, box3d(xleft, p[3 * jdom + 1], NaN, p[3 * jdom], pi[1], pi[2]));
+			xleft = p[3 * jdom];
 		}
-		L[i].push_back(box3d(xleft, p[r][1], NaN, p[i][0], p[i][1], p[i][2]));
-		xleft = p[t][0];
+		ws.push_back(i, box3d(xleft, p[3 * r + 1], NaN, pi[0], pi[1], pi[2]));
+		xleft = p[3 * t];
 
 		// Process left neighbor region, region L
-		while(!L[t].empty()) {
-			box3d &b = L[t].back();
-			if(b.ly > p[i][1]) {
-				b.lz = p[i][2];
+		while(!ws.empty(t)) {
+			box3d &b = ws.back(t);
+			if(b.ly > pi[1]) {
+				b.lz = pi[2];
 				c[t] += box_volume(b);
 				xleft = b.lx;
-				L[t].pop_back();
+				ws.pop_back(t);
 			} else {
 				break;
 			}
 		}
-		if (xleft > p[t][0]) {
-			L[t].push_back(box3d(xleft, p[i][1], NaN, p[t][0], p[t][1], p[i][2]));
+		if (xleft > p[3 * t]) {
+			ws.push_back(t, box3d(xleft, pi[1], NaN, p[3 * t], p[3 * t + 1], pi[2]));
 		}
-		T.insert(std::make_pair(p[i], i));
+		T.insert(i);
 	}
 
 	// Fix the indices
-	std::vector<double> contribs(n, 0.0);
-	for(unsigned int i=0;i < c.size();++i) {
-		contribs[point_pairs[i].second] = c[i];
+	for(unsigned int i=0;i < n;++i) {
+		contribs[perm[i]] = c[i];
 	}
-	return contribs;
 }
 
 /// Verify before compute
@@ -44,6 +44,10 @@ namespace pagmo { namespace util { namespace hv_algorithm {
  * 'compute' method relies on the efficient algorithm as it was presented by Nicola Beume et al.
  * 'least[greatest]_contributor' methods rely on the HyCon3D algorithm by Emmerich and Fonseca.
  *
+ * Both are also available in flat versions, taking the points as a contiguous array of coordinates. The sweeping structures
+ * live in buffers kept by the calling thread (the nodes of the sweeping trees come from an arena), so that repeated calls
+ * on small fronts do not cost any allocation.
+ *
  * @see "On the Complexity of Computing the Hypervolume Indicator", Nicola Beume, Carlos M. Fonseca, Manuel Lopez-Ibanez, Luis Paquete, Jan Vahrenhold. IEEE TRANSACTIONS ON EVOLUTIONARY COMPUTATION, VOL. 13, NO. 5, OCTOBER 2009
  * @see "Computing hypervolume contribution in low dimensions: asymptotically optimal algorithm and complexity results", Michael T. M. Emmerich, Carlos M. Fonseca
  *
@@ -54,7 +58,9 @@ class __PAGMO_VISIBLE hv3d : public base
 public:
 	hv3d(bool initial_sorting = true);
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
+	double compute(const double *, unsigned int n_points, const double *) const;
 	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &) const;
+	void contributions(const double *, unsigned int n_points, const double *, double *) const;
 
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
@@ -76,12 +82,10 @@ private:
 		double uz;
 	};
 
-	struct hycon3d_tree_cmp
-	{
-		bool operator()(const std::pair<fitness_vector, int> &, const std::pair<fitness_vector, int> &);
-	};
+	struct workspace;
 
-	static bool hycon3d_sort_cmp(const std::pair<fitness_vector, unsigned int> &, const std::pair<fitness_vector, unsigned int> &);
+	double compute(workspace &, const double *, const unsigned int, const double *) const;
+	void contributions(workspace &, const double *, const unsigned int, const double *, double *) const;
 	static double box_volume(const box3d &b);
 
 	friend class boost::serialization::access;
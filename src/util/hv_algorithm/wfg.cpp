@@ -26,29 +26,116 @@
 #include "hv2d.h"
 #include "wfg.h"
 #include "base.h"
+#include "../arena.h"
+#include "../thread_pool.h"
 #include <algorithm>
 #include <boost/bind.hpp>
+#include <limits>
+#include <numeric>
 
 namespace pagmo { namespace util { namespace hv_algorithm {
 
-/// Comparator function for sorting
+/// State of a computation.
 /**
- * Comparison function for WFG. Can't be static in order to have access to member variable m_current_slice.
+ * Holds the point sets ('frames') of the recursion levels, allocated on first use from an arena owned by the computation.
+ * The points of a frame are stored contiguously (with a stride equal to the dimension of the front), and accessed through
+ * an array of row pointers, which is what gets sorted and compacted.
  */
-bool wfg::cmp_points(double* a, double* b) const
+struct wfg::state
 {
-	for(int i = m_current_slice - 1; i >= 0 ; --i){
-		if (a[i] > b[i]) {
-			return true;
-		} else if(a[i] < b[i]) {
-			return false;
+	state(const std::vector<fitness_vector> &points, const fitness_vector &r_point):
+		mem(sizeof(double) * points.size() * r_point.size() * 2),max_points(points.size()),max_dim(r_point.size()),current_slice(r_point.size())
+	{
+		refpoint = mem.allocate<double>(max_dim);
+		std::copy(r_point.begin(),r_point.end(),refpoint);
+		// WFG with slicing will not go recursively deeper than the dimension size.
+		frames = mem.allocate<double **>(max_dim + 1);
+		frames_size = mem.allocate<unsigned int>(max_dim + 1);
+		std::fill(frames,frames + max_dim + 1,static_cast<double **>(0));
+		cmp_results = mem.allocate<int>(max_points);
+		// Copy the initial set into the frame at index 0.
+		double **fr = frame(0);
+		for(unsigned int p_idx = 0 ; p_idx < max_points ; ++p_idx) {
+			std::copy(points[p_idx].begin(),points[p_idx].end(),fr[p_idx]);
 		}
+		frames_size[0] = max_points;
 	}
-	return false;
+	// Start from the initial frame of another state, in its current order, with fresh working memory.
+	explicit state(const state &other):
+		mem(sizeof(double) * other.max_points * other.max_dim * 2),max_points(other.max_points),max_dim(other.max_dim),
+		current_slice(other.current_slice)
+	{
+		refpoint = mem.allocate<double>(max_dim);
+		std::copy(other.refpoint,other.refpoint + max_dim,refpoint);
+		frames = mem.allocate<double **>(max_dim + 1);
+		frames_size = mem.allocate<unsigned int>(max_dim + 1);
+		std::fill(frames,frames + max_dim + 1,static_cast<double **>(0));
+		cmp_results = mem.allocate<int>(max_points);
+		double **fr = frame(0);
+		for(unsigned int p_idx = 0 ; p_idx < max_points ; ++p_idx) {
+			std::copy(other.frames[0][p_idx],other.frames[0][p_idx] + max_dim,fr[p_idx]);
+		}
+		frames_size[0] = max_points;
+	}
+	// Frame of a recursion level.
+	double **frame(unsigned int level)
+	{
+		if (!frames[level]) {
+			double **fr = mem.allocate<double *>(max_points);
+			double *data = mem.allocate<double>(max_points * max_dim);
+			for(unsigned int i = 0 ; i < max_points ; ++i) {
+				fr[i] = data + i * max_dim;
+			}
+			frames[level] = fr;
+			frames_size[level] = 0;
+		}
+		return frames[level];
+	}
+
+	util::arena		mem;
+	const unsigned int	max_points;
+	const unsigned int	max_dim;
+	// Current slice depth
+	unsigned int		current_slice;
+	double			*refpoint;
+	double			***frames;
+	// Number of points of the frame at each recursion level.
+	unsigned int		*frames_size;
+	// Scratch array of limitset().
+	int			*cmp_results;
+};
+
+namespace {
+
+// Sorts the points in descending order by the dimensions preceding the slice, last one first.
+struct cmp_points
+{
+	explicit cmp_points(unsigned int slice):m_slice(slice) {}
+	bool operator()(const double *a, const double *b) const
+	{
+		for(int i = m_slice - 1; i >= 0 ; --i){
+			if (a[i] > b[i]) {
+				return true;
+			} else if(a[i] < b[i]) {
+				return false;
+			}
+		}
+		return false;
+	}
+	const unsigned int m_slice;
+};
+
 }
 
 /// Constructor
-wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_stop_dimension(stop_dimension)
+/**
+ * @param[in] stop_dimension dimension at which the slicing stops and the remaining sets are handed to a dedicated algorithm
+ * @param[in] n_threads number of threads used by compute() and contributions(). If zero, util::thread_pool::default_size() will be used.
+ *
+ * @throws value_error if stop_dimension is smaller than 2
+ */
+wfg::wfg(const unsigned int stop_dimension, const unsigned int n_threads) :
+	m_stop_dimension(stop_dimension), m_n_threads(n_threads ? n_threads : util::thread_pool::default_size())
 {
 	if (stop_dimension < 2 ) {
 		pagmo_throw(value_error, "Stop dimension for WFG must be greater than or equal to 2");
@@ -66,10 +153,45 @@ wfg::wfg(const unsigned int stop_dimension) : m_current_slice(0), m_stop_dimensi
  */
 double wfg::compute(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	allocate_wfg_members(points, r_point);
-	double hv = compute_hv(1);
-	free_wfg_members();
-	return hv;
+	state s(points, r_point);
+	// Cases handled without the main loop.
+	if (s.max_points <= 2 || s.current_slice == m_stop_dimension) {
+		return compute_hv(s, 1);
+	}
+
+	// The outermost level of compute_hv(), with the terms of the sum computed separately and added up in order, so that
+	// the result is the same for any number of threads.
+	std::sort(s.frames[0], s.frames[0] + s.max_points, cmp_points(s.current_slice));
+	std::vector<double> terms(s.max_points);
+	const std::size_t blocks = n_blocks(s.max_points);
+	if (blocks == 1) {
+		compute_block(s, terms, 1, 0);
+	} else {
+		util::thread_pool::shared(m_n_threads).parallel_for(blocks, boost::bind(&wfg::compute_block, this, boost::cref(s), boost::ref(terms), blocks, _1));
+	}
+	return std::accumulate(terms.begin(), terms.end(), 0.0);
+}
+
+// Number of blocks of work for a loop over n points: one in a serial run, otherwise a few per thread. Blocks take the
+// points with a stride, as the points at the beginning of the front are the most expensive.
+std::size_t wfg::n_blocks(const unsigned int n) const
+{
+	if (m_n_threads == 1) {
+		return 1;
+	}
+	return std::min<std::size_t>(n, static_cast<std::size_t>(m_n_threads) * 4u);
+}
+
+// Terms of the outermost loop of compute_hv() for the points block, block + n_blocks, ...
+void wfg::compute_block(const state &top, std::vector<double> &terms, const std::size_t n_blocks, const std::size_t block) const
+{
+	state st(top);
+	--st.current_slice;
+	double **points = st.frames[0];
+	for(std::size_t p_idx = block ; p_idx < st.max_points ; p_idx += n_blocks) {
+		limitset(st, p_idx + 1, p_idx, 1);
+		terms[p_idx] = fabs((points[p_idx][st.current_slice] - st.refpoint[st.current_slice]) * exclusive_hv(st, p_idx, 1));
+	}
 }
 
 /// Contributions method
@@ -87,220 +209,173 @@ double wfg::compute(std::vector<fitness_vector> &points, const fitness_vector &r
  */
 std::vector<double> wfg::contributions(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
 {
-	std::vector<double> c;
-	c.reserve(points.size());
+	std::vector<double> c(points.size());
 
-	// Allocate the same members as for 'compute' method
-	allocate_wfg_members(points, r_point);
-
-	// Prepare the memory for first front
-	double** fr = new double*[m_max_points];
-	for(unsigned int i = 0 ; i < m_max_points ; ++i) {
-		fr[i]=new double[m_current_slice];
-	}
-	m_frames[m_n_frames] = fr;
-	m_frames_size[m_n_frames] = 0;
-	++m_n_frames;
-
-	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
-		limitset(0, p_idx, 1);
-		c.push_back(exclusive_hv(p_idx, 1));
+	state s(points, r_point);
+	const std::size_t blocks = n_blocks(s.max_points);
+	if (blocks == 1) {
+		contributions_block(s, c, 1, 0);
+	} else {
+		util::thread_pool::shared(m_n_threads).parallel_for(blocks, boost::bind(&wfg::contributions_block, this, boost::cref(s), boost::ref(c), blocks, _1));
 	}
 
-	// Free the contributions and the remaining WFG members
-	free_wfg_members();
-
 	return c;
 }
 
-/// Allocate the memory for the 'compute' method
-void wfg::allocate_wfg_members(std::vector<fitness_vector> &points, const fitness_vector &r_point) const
+// Exclusive contributions of the points block, block + n_blocks, ...
+void wfg::contributions_block(const state &top, std::vector<double> &c, const std::size_t n_blocks, const std::size_t block) const
 {
-	m_max_points = points.size();
-	m_max_dim = r_point.size();
-
-	m_refpoint = new double[m_max_dim];
-	for(unsigned int d_idx = 0 ; d_idx < m_max_dim ; ++d_idx) {
-		m_refpoint[d_idx] = r_point[d_idx];
+	state st(top);
+	for(std::size_t p_idx = block ; p_idx < st.max_points ; p_idx += n_blocks) {
+		limitset(st, 0, p_idx, 1);
+		c[p_idx] = exclusive_hv(st, p_idx, 1);
 	}
-
-	// Reserve the space beforehand for each level or recursion.
-	// WFG with slicing feature will not go recursively deeper than the dimension size.
-	m_frames = new double**[m_max_dim];
-	m_frames_size = new unsigned int[m_max_dim];
-
-	// Copy the initial set into the frame at index 0.
-	double** fr = new double*[m_max_points];
-	for(unsigned int p_idx = 0 ; p_idx < m_max_points ; ++p_idx) {
-		fr[p_idx] = new double[m_max_dim];
-		for(unsigned int d_idx = 0 ; d_idx < m_max_dim ; ++d_idx) {
-			fr[p_idx][d_idx] = points[p_idx][d_idx];
-		}
-	}
-	m_frames[0] = fr;
-	m_frames_size[0] = m_max_points;
-	m_n_frames = 1;
-
-	// Variable holding the current "depth" of dimension slicing. We progress by slicing dimensions from the end.
-	m_current_slice = m_max_dim;
 }
 
-/// Free the previously allocated memory
-void wfg::free_wfg_members() const
+/// Dominance comparison over contiguous coordinates
+/**
+ * Same result as base::dom_cmp(), but the coordinates are all compared without early exits, so that the loop is vectorised.
+ * It is faster on the low-dimensional points WFG works with.
+ */
+int wfg::dom_cmp_flat(const double *a, const double *b, unsigned int size)
 {
-	// Free the memory.
-	delete[] m_refpoint;
-
-	for(unsigned int fr_idx = 0 ; fr_idx < m_n_frames ; ++fr_idx) {
-		for(unsigned int p_idx = 0; p_idx < m_max_points ; ++p_idx) {
-			delete[] m_frames[fr_idx][p_idx];
-		}
-		delete[] m_frames[fr_idx];
+	int better = 0, worse = 0;
+	for(unsigned int i = 0; i < size; ++i) {
+		better |= a[i] < b[i];
+		worse |= a[i] > b[i];
+	}
+	if (worse) {
+		return better ? DOM_CMP_INCOMPARABLE : DOM_CMP_B_DOMINATES_A;
 	}
-	delete[] m_frames;
-	delete[] m_frames_size;
+	return better ? DOM_CMP_A_DOMINATES_B : DOM_CMP_A_B_EQUAL;
 }
 
 /// Limit the set of points to point at p_idx
-void wfg::limitset(const unsigned int begin_idx, const unsigned int p_idx, const unsigned int rec_level) const
+void wfg::limitset(state &st, const unsigned int begin_idx, const unsigned int p_idx, const unsigned int rec_level) const
 {
-	double **points = m_frames[rec_level - 1];
-	unsigned int n_points = m_frames_size[rec_level - 1];
+	double **points = st.frames[rec_level - 1];
+	const unsigned int n_points = st.frames_size[rec_level - 1];
+	const unsigned int slice = st.current_slice;
 
 	int no_points = 0;
 
-	double* p = points[p_idx];
-	double** frame = m_frames[rec_level];
+	const double* p = points[p_idx];
+	double** frame = st.frame(rec_level);
+	int *cmp_results = st.cmp_results;
 
 	for(unsigned int idx = begin_idx; idx < n_points; ++idx) {
 		if (idx == p_idx) {
 			continue;
 		}
 
-		for(fitness_vector::size_type f_idx = 0; f_idx < m_current_slice; ++f_idx) {
-			frame[no_points][f_idx] = std::max(points[idx][f_idx], p[f_idx]);
-		}
-
-		std::vector<int> cmp_results;
-		cmp_results.resize(no_points);
 		double* s = frame[no_points];
+		const double *q = points[idx];
+		for(unsigned int f_idx = 0; f_idx < slice; ++f_idx) {
+			s[f_idx] = std::max(q[f_idx], p[f_idx]);
+		}
 
 		bool keep_s = true;
 
 		// Check whether any point is dominating the point 's'.
 		for(int q_idx = 0; q_idx < no_points; ++q_idx) {
-			cmp_results[q_idx] = base::dom_cmp(s, frame[q_idx], m_current_slice);
+			cmp_results[q_idx] = dom_cmp_flat(s, frame[q_idx], slice);
 			if (cmp_results[q_idx] == base::DOM_CMP_B_DOMINATES_A) {
 				keep_s = false;
 				break;
 			}
 		}
 		// If neither is, remove points dominated by 's' (we store that during the first loop).
+		// The rows are compacted by swapping their pointers, so no coordinates are copied.
 		if( keep_s ) {
 			int prev = 0;
 			int next = 0;
 			while(next < no_points) {
 				if( cmp_results[next] != base::DOM_CMP_A_DOMINATES_B && cmp_results[next] != base::DOM_CMP_A_B_EQUAL) {
 					if(prev < next) {
-						for(unsigned int d_idx = 0; d_idx < m_current_slice ; ++d_idx) {
-							frame[prev][d_idx] = frame[next][d_idx];
-						}
+						std::swap(frame[prev], frame[next]);
 					}
 					++prev;
 				}
 				++next;
 			}
-			// Append 's' at the end, if prev==next it's not necessary as it's already there.
+			// Move 's' right after the kept points, if prev==next it's already there.
 			if(prev < next) {
-				for(unsigned int d_idx = 0; d_idx < m_current_slice ; ++d_idx) {
-					frame[prev][d_idx] = s[d_idx];
-				}
+				std::swap(frame[prev], frame[next]);
 			}
 			no_points = prev + 1;
 		}
 	}
 
-	m_frames_size[rec_level] = no_points;
+	st.frames_size[rec_level] = no_points;
 }
 
 /// Compute the hypervolume recursively
-double wfg::compute_hv(const unsigned int rec_level) const
+double wfg::compute_hv(state &st, const unsigned int rec_level) const
 {
-	double **points = m_frames[rec_level - 1];
-	unsigned int n_points = m_frames_size[rec_level - 1];
+	double **points = st.frames[rec_level - 1];
+	const unsigned int n_points = st.frames_size[rec_level - 1];
+	double *refpoint = st.refpoint;
 
 	// Simple inclusion-exclusion for one and two points
 	if (n_points == 1) {
-		return base::volume_between(points[0], m_refpoint, m_current_slice);
+		return base::volume_between(points[0], refpoint, st.current_slice);
 	}
 	else if (n_points == 2) {
-		double hv = base::volume_between(points[0], m_refpoint, m_current_slice)
-			+ base::volume_between(points[1], m_refpoint, m_current_slice);
+		double hv = base::volume_between(points[0], refpoint, st.current_slice)
+			+ base::volume_between(points[1], refpoint, st.current_slice);
 		double isect = 1.0;
-		for(unsigned int i=0;i<m_current_slice;++i) {
-			isect *= (m_refpoint[i] - std::max(points[0][i], points[1][i]));
+		for(unsigned int i=0;i<st.current_slice;++i) {
+			isect *= (refpoint[i] - std::max(points[0][i], points[1][i]));
 		}
 		return hv - isect;
 	}
 
 	// If already sliced to dimension at which we use another algorithm.
-	if (m_current_slice == m_stop_dimension) {
+	if (st.current_slice == m_stop_dimension) {
 
 		if (m_stop_dimension == 2) {
 			// Use a very efficient version of hv2d
-			return hv2d().compute(points, n_points, m_refpoint);
+			return hv2d().compute(points, n_points, refpoint);
 		} else {
 			// Let hypervolume object pick the best method otherwise.
 			std::vector<fitness_vector> points_cpy;
 			points_cpy.reserve(n_points);
 			for(unsigned int i = 0 ; i < n_points ; ++i) {
-				points_cpy.push_back(fitness_vector(points[i], points[i] + m_current_slice));
+				points_cpy.push_back(fitness_vector(points[i], points[i] + st.current_slice));
 			}
-			fitness_vector r_cpy(m_refpoint, m_refpoint + m_current_slice);
+			fitness_vector r_cpy(refpoint, refpoint + st.current_slice);
 
 			hypervolume hv = hypervolume(points_cpy, false);
 			hv.set_copy_points(false);
+			hv.set_approx_threshold(std::numeric_limits<double>::infinity());
 			return hv.compute(r_cpy);
 		}
 	} else {
 		// Otherwise, sort the points in preparation for the next recursive step
-		// Bind the object under "this" pointer to the cmp_points method so it can be used as a valid comparator function for std::sort
-		// We need that in order for the cmp_points to have acces to the m_current_slice member variable.
-		std::sort(points, points + n_points, boost::bind(&wfg::cmp_points, this, _1, _2));
+		std::sort(points, points + n_points, cmp_points(st.current_slice));
 	}
 
 	double H = 0.0;
-	--m_current_slice;
-
-	if(rec_level >= m_n_frames) {
-		double** fr = new double*[m_max_points];
-		for(unsigned int i = 0 ; i < m_max_points ; ++i) {
-			fr[i]=new double[m_current_slice];
-		}
-		m_frames[m_n_frames] = fr;
-		m_frames_size[m_n_frames] = 0;
-		++m_n_frames;
-	}
+	--st.current_slice;
 
 	for(unsigned int p_idx = 0 ; p_idx < n_points ; ++p_idx) {
-		limitset(p_idx + 1, p_idx, rec_level);
+		limitset(st, p_idx + 1, p_idx, rec_level);
 
-		H += fabs((points[p_idx][m_current_slice] - m_refpoint[m_current_slice]) * exclusive_hv(p_idx, rec_level));
+		H += fabs((points[p_idx][st.current_slice] - refpoint[st.current_slice]) * exclusive_hv(st, p_idx, rec_level));
 	}
-	++m_current_slice;
+	++st.current_slice;
 	return H;
 }
 
 /// Compute the exclusive hypervolume of point at p_idx
-double wfg::exclusive_hv(const unsigned int p_idx, const unsigned int rec_level) const
+double wfg::exclusive_hv(state &st, const unsigned int p_idx, const unsigned int rec_level) const
 {
-	//double H = base::volume_between(points[p_idx], m_refpoint, m_current_slice);
-	double H = base::volume_between(m_frames[rec_level - 1][p_idx], m_refpoint, m_current_slice);
+	double H = base::volume_between(st.frames[rec_level - 1][p_idx], st.refpoint, st.current_slice);
 
-	if (m_frames_size[rec_level] == 1) {
-		H -= base::volume_between(m_frames[rec_level][0], m_refpoint, m_current_slice);
-	} else if (m_frames_size[rec_level] > 1) {
-		H -= compute_hv(rec_level + 1);
+	if (st.frames_size[rec_level] == 1) {
+		H -= base::volume_between(st.frames[rec_level][0], st.refpoint, st.current_slice);
+	} else if (st.frames_size[rec_level] > 1) {
+		H -= compute_hv(st, rec_level + 1);
 	}
 
 	return H;
@@ -332,6 +407,12 @@ std::string wfg::get_name() const
 	return "WFG algorithm";
 }
 
+/// Number of threads used by compute() and contributions().
+unsigned int wfg::get_n_threads() const
+{
+	return m_n_threads;
+}
+
 } } }
 
 BOOST_CLASS_EXPORT_IMPLEMENT(pagmo::util::hv_algorithm::wfg)
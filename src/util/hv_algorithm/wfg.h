@@ -28,6 +28,7 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstddef>
 #include <algorithm>
 #include <iterator>
 
@@ -40,6 +41,16 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 /**
  * This is the class containing the implementation of the WFG algorithm for the computation of hypervolume indicator.
  *
+ * All the working memory of a computation (the point sets of the recursion levels and the scratch arrays) is taken from an
+ * arena owned by the call, with the points of each set stored contiguously. No state is kept in the object, so the same
+ * instance can be used by several threads at the same time.
+ *
+ * With more than one thread, compute() distributes the iterations of the outermost loop (one exclusive hypervolume per
+ * point of the sorted front) and contributions() the exclusive contributions themselves among the threads of the shared
+ * util::thread_pool of that size (see util::thread_pool::shared()), each thread working on its own copy of the state.
+ * The partial results are combined in the same order as in a serial run, so the results do not depend on the number of
+ * threads.
+ *
  * @see "While, Lyndon, Lucas Bradstreet, and Luigi Barone. "A fast way of calculating exact hypervolumes." Evolutionary Computation, IEEE Transactions on 16.1 (2012): 86-95."
  * @see "Lyndon While and Lucas Bradstreet. Applying the WFG Algorithm To Calculate Incremental Hypervolumes. 2012 IEEE Congress on Evolutionary Computation. CEC 2012, pages 489-496. IEEE, June 2012."
  *
@@ -48,57 +59,28 @@ namespace pagmo { namespace util { namespace hv_algorithm {
 class __PAGMO_VISIBLE wfg : public base
 {
 public:
-	wfg(const unsigned int stop_dimension = 2);
+	wfg(const unsigned int stop_dimension = 2, const unsigned int n_threads = 1);
 	double compute(std::vector<fitness_vector> &, const fitness_vector &) const;
 	std::vector<double> contributions(std::vector<fitness_vector> &, const fitness_vector &) const;
 	void verify_before_compute(const std::vector<fitness_vector> &, const fitness_vector &) const;
 	base_ptr clone() const;
 	std::string get_name() const;
+	unsigned int get_n_threads() const;
 
 private:
-	void limitset(const unsigned int, const unsigned int, const unsigned int) const;
-	double exclusive_hv(const unsigned int, const unsigned int) const;
-	double compute_hv(const unsigned int) const;
-
-	bool cmp_points(double* a, double* b) const;
-
-	void allocate_wfg_members(std::vector<fitness_vector> &, const fitness_vector &) const;
-	void free_wfg_members() const;
-
-	/**
-	 * 'compute' and 'extreme_contributor' method variables section.
-	 *
-	 * Variables below (especially the pointers m_frames, m_frames_size and m_refpoint) are initialized
-	 * at the beginning of the 'compute' and 'extreme_contributor' methods, and freed afterwards.
-	 * The state of the variables is irrelevant outside the scope of the these methods.
-	 */
-
-	// Current slice depth
-	mutable unsigned int m_current_slice;
-
-	// Array of point sets for each recursive level.
-	mutable double*** m_frames;
-
-	// Maintains the number of points at given recursion level.
-	mutable unsigned int* m_frames_size;
-
-	// Keeps track of currently allocated number of frames.
-	mutable unsigned int m_n_frames;
-
-	// Copy of the reference point
-	mutable double* m_refpoint;
-
-	// Size of the original front
-	mutable unsigned int m_max_points;
-
-	// Size of the dimension
-	mutable unsigned int m_max_dim;
-	/**
-	 * End of 'compute' method variables section.
-	 */
+	struct state;
+	void limitset(state &, const unsigned int, const unsigned int, const unsigned int) const;
+	double exclusive_hv(state &, const unsigned int, const unsigned int) const;
+	double compute_hv(state &, const unsigned int) const;
+	static int dom_cmp_flat(const double *, const double *, unsigned int);
+	void compute_block(const state &, std::vector<double> &, const std::size_t, const std::size_t) const;
+	void contributions_block(const state &, std::vector<double> &, const std::size_t, const std::size_t) const;
+	std::size_t n_blocks(const unsigned int) const;
 
 	// Dimension at which WFG stops the slicing
 	const unsigned int m_stop_dimension;
+	// Number of threads used by compute() and contributions()
+	const unsigned int m_n_threads;
 
 	friend class boost::serialization::access;
 	template <class Archive>
@@ -106,6 +88,7 @@ private:
 	{
 		ar & boost::serialization::base_object<base>(*this);
 		ar & const_cast<unsigned int &>(m_stop_dimension);
+		ar & const_cast<unsigned int &>(m_n_threads);
 	}
 };
 
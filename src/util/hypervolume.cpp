@@ -32,9 +32,12 @@
 #include "hv_algorithm/bf_fpras.h"
 #include "hv_algorithm/hoy.h"
 #include "hv_algorithm/fpl.h"
+#include "thread_pool.h"
 
 namespace pagmo { namespace util {
 
+const double hypervolume::default_approx_threshold = 1e9;
+
 /// Constructor from population
 /**
  * Constructs a hypervolume object, where points are elicited from the referenced population object.
@@ -42,7 +45,7 @@ namespace pagmo { namespace util {
  * @param[in] pop reference to population object from which Pareto front is computed
  * @param[in] verify flag stating whether the points should be verified after the construction. This turns off the validation for the further computation as well, use 'set_verify' flag to alter it later.
  */
-hypervolume::hypervolume(boost::shared_ptr<population> pop, const bool verify) : m_copy_points(true), m_verify(verify)
+hypervolume::hypervolume(boost::shared_ptr<population> pop, const bool verify) : m_copy_points(true), m_verify(verify), m_threads(1), m_approx_threshold(default_approx_threshold)
 	{
 	m_points.resize(pop->size());
 	for (population::size_type idx = 0 ; idx < pop->size() ; ++idx) {
@@ -61,7 +64,7 @@ hypervolume::hypervolume(boost::shared_ptr<population> pop, const bool verify) :
  * @param[in] points vector of points for which the hypervolume is computed
  * @param[in] verify flag stating whether the points should be verified after the construction. This turns off the validation for the further computation as well, use 'set_verify' flag to alter it later.
  */
-hypervolume::hypervolume(const std::vector<fitness_vector> &points, const bool verify) : m_points(points), m_copy_points(true), m_verify(verify)
+hypervolume::hypervolume(const std::vector<fitness_vector> &points, const bool verify) : m_points(points), m_copy_points(true), m_verify(verify), m_threads(1), m_approx_threshold(default_approx_threshold)
 {
 	if (m_verify) {
 		verify_after_construct();
@@ -74,14 +77,15 @@ hypervolume::hypervolume(const std::vector<fitness_vector> &points, const bool v
  *
  * @param[in] hv hypervolume object to be copied
  */
-hypervolume::hypervolume(const hypervolume &hv): m_points(hv.m_points), m_copy_points(hv.m_copy_points), m_verify(hv.m_verify) { }
+hypervolume::hypervolume(const hypervolume &hv): m_points(hv.m_points), m_copy_points(hv.m_copy_points), m_verify(hv.m_verify), m_threads(hv.m_threads),
+	m_approx_threshold(hv.m_approx_threshold) { }
 
 /// Default constructor
 /**
  * Initiates hypervolume with empty set of points.
  * Used for serialization purposes.
  */
-hypervolume::hypervolume() : m_copy_points(true), m_verify(true)
+hypervolume::hypervolume() : m_copy_points(true), m_verify(true), m_threads(1), m_approx_threshold(default_approx_threshold)
 {
 	m_points.resize(0);
 }
@@ -128,6 +132,50 @@ bool hypervolume::get_verify()
 	return m_verify;
 }
 
+/// Setter for the number of threads
+/**
+ * Sets the number of threads used by the algorithms picked automatically for the computation. Only WFG runs in parallel
+ * as of yet, and with more than one thread it is preferred to FPL for five-dimensional fronts. The results do not depend on
+ * the number of threads.
+ *
+ * @param[in] n number of threads. If zero, the number of hardware threads will be used.
+ */
+void hypervolume::set_threads(const unsigned int n)
+{
+	m_threads = n ? n : thread_pool::default_size();
+}
+
+/// Getter for the number of threads
+unsigned int hypervolume::get_threads() const
+{
+	return m_threads;
+}
+
+/// Setter for the approximation threshold
+/**
+ * Sets the expected number of operations (see get_expected_operations()) above which compute() approximates the
+ * hypervolume of fronts with five or more dimensions, using bf_fpras with eps = delta = 0.01, instead of computing it
+ * exactly. The default of 1e9 corresponds to exact computations of the order of a minute. Use an infinite threshold to
+ * always compute the exact hypervolume.
+ *
+ * @param[in] threshold expected number of operations
+ *
+ * @throws value_error if the threshold is negative or NaN
+ */
+void hypervolume::set_approx_threshold(const double threshold)
+{
+	if (!(threshold >= 0.0)) {
+		pagmo_throw(value_error, "The approximation threshold must be non-negative.");
+	}
+	m_approx_threshold = threshold;
+}
+
+/// Getter for the approximation threshold
+double hypervolume::get_approx_threshold() const
+{
+	return m_approx_threshold;
+}
+
 /// Verify after construct method
 /**
  * Verifies whether basic requirements are met for the initial set of points.
@@ -169,9 +217,19 @@ void hypervolume::verify_before_compute(const fitness_vector &r_point, hv_algori
 /// Choose the best hypervolume algorithm for given task
 /**
  * Returns the best method for given hypervolume computation problem.
- * As of yet, only the dimension size is taken into account.
+ * From five dimensions on, the FPRAS approximation (bf_fpras) is chosen when the expected number of operations of an
+ * exact computation exceeds the threshold set with set_approx_threshold(). Otherwise, only the dimension size is taken into account.
  */
 hv_algorithm::base_ptr hypervolume::get_best_compute(const fitness_vector &r_point) const
+{
+	if (r_point.size() >= 5 && get_expected_operations(m_points.size(), r_point.size()) > m_approx_threshold) {
+		return hv_algorithm::bf_fpras(1e-2, 1e-2, m_threads).clone();
+	}
+	return get_best_exact(r_point);
+}
+
+// Best exact algorithm for given task.
+hv_algorithm::base_ptr hypervolume::get_best_exact(const fitness_vector &r_point) const
 {
 	unsigned int fdim = r_point.size();
 	unsigned int n = m_points.size();
@@ -181,18 +239,18 @@ hv_algorithm::base_ptr hypervolume::get_best_compute(const fitness_vector &r_poi
 		return hv_algorithm::hv3d().clone();
 	} else if (fdim == 4) {
 		return hv_algorithm::hv4d().clone();
-	} else if (fdim == 5 && n < 80) {
+	} else if (fdim == 5 && n < 80 && m_threads == 1) {
 		return hv_algorithm::fpl().clone();
 	} else {
-		return hv_algorithm::wfg().clone();
+		return hv_algorithm::wfg(2, m_threads).clone();
 	}
 }
 
 hv_algorithm::base_ptr hypervolume::get_best_exclusive(const unsigned int p_idx, const fitness_vector &r_point) const
 {
 	(void)p_idx;
-	// Exclusive contribution and compute method share the same "best" set of algorithms.
-	return get_best_compute(r_point);
+	// Exclusive contribution and compute method share the same "best" set of exact algorithms.
+	return get_best_exact(r_point);
 }
 
 hv_algorithm::base_ptr hypervolume::get_best_contributions(const fitness_vector &r_point) const
@@ -203,7 +261,7 @@ hv_algorithm::base_ptr hypervolume::get_best_contributions(const fitness_vector
 	} else if (fdim == 3) {
 		return hv_algorithm::hv3d().clone();
 	} else {
-		return hv_algorithm::wfg().clone();
+		return hv_algorithm::wfg(2, m_threads).clone();
 	}
 }
 
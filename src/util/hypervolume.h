@@ -75,6 +75,13 @@ public:
 	bool get_copy_points();
 	void set_verify(const bool);
 	bool get_verify();
+	void set_threads(const unsigned int);
+	unsigned int get_threads() const;
+	void set_approx_threshold(const double);
+	double get_approx_threshold() const;
+
+	/// Default value of the approximation threshold.
+	static const double default_approx_threshold;
 
 	fitness_vector get_nadir_point(const double epsilon = 0.0) const;
 
@@ -83,6 +90,7 @@ public:
 
 private:
 	hv_algorithm::base_ptr get_best_compute(const fitness_vector &) const;
+	hv_algorithm::base_ptr get_best_exact(const fitness_vector &) const;
 	hv_algorithm::base_ptr get_best_exclusive(const unsigned int, const fitness_vector &) const;
 	hv_algorithm::base_ptr get_best_contributions(const fitness_vector &) const;
 	void verify_after_construct() const;
@@ -91,20 +99,30 @@ private:
 	std::vector<fitness_vector> m_points;
 	bool m_copy_points;
 	bool m_verify;
-
+	unsigned int m_threads;
+	double m_approx_threshold;
 
 	friend class boost::serialization::access;
 	template <class Archive>
-	void serialize(Archive &ar, const unsigned int)
+	void serialize(Archive &ar, const unsigned int version)
 	{
 		ar & m_points;
 		ar & m_copy_points;
 		ar & m_verify;
+		if (version >= 1) {
+			ar & m_threads;
+			ar & m_approx_threshold;
+		} else {
+			m_threads = 1;
+			m_approx_threshold = default_approx_threshold;
+		}
 	}
 };
 
 }}
 
 BOOST_CLASS_EXPORT_KEY(pagmo::util::hypervolume)
+// Version 1: number of threads and approximation threshold.
+BOOST_CLASS_VERSION(pagmo::util::hypervolume,1)
 
 #endif
@@ -0,0 +1,178 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_MPSC_QUEUE_H
+#define PAGMO_UTIL_MPSC_QUEUE_H
+
+#include <algorithm>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../config.h"
+
+namespace pagmo{ namespace util {
+
+/// Bounded multiple-producer single-consumer queue.
+/**
+ * Any number of threads can push() concurrently, while a single thread at a time can drain the queue with pop_all().
+ * Producers link their node at the head of an intrusive list with a compare-and-swap, and the consumer detaches the
+ * whole list with an atomic exchange (so that nodes are never freed while a producer could still be looking at them,
+ * and the ABA problem cannot arise). The queue itself takes no locks, but push() allocates its node with new and
+ * pop_all() frees them with delete: both are lock-free only as far as the memory allocator is.
+ *
+ * The number of queued elements is bounded by the capacity given at construction. A push() into a full queue fails
+ * and leaves its argument untouched.
+ *
+ * Elements are swapped in and out of the queue, so that objects with a cheap swap() are handed off without copies.
+ */
+template <class T>
+class mpsc_queue: private boost::noncopyable
+{
+		struct node
+		{
+			node():m_value(),m_next(0) {}
+			T	m_value;
+			node	*m_next;
+		};
+	public:
+		/// Value type.
+		typedef T value_type;
+		/// Constructor from capacity.
+		/**
+		 * @param[in] capacity maximum number of elements in the queue.
+		 */
+		explicit mpsc_queue(std::size_t capacity):m_capacity(capacity),m_head(0),m_size(0) {}
+		/// Destructor.
+		~mpsc_queue()
+		{
+			free_list(m_head.load(boost::memory_order_acquire));
+		}
+		/// Push an element.
+		/**
+		 * Can be called concurrently by any number of threads.
+		 *
+		 * @param[in,out] value element that will be swapped into the queue if the push succeeds (value is then left
+		 * default-constructed).
+		 *
+		 * @return false if the queue was full, true otherwise.
+		 */
+		bool push(T &value)
+		{
+			// Allocate before reserving a place, so that a throwing allocation leaves the size untouched. The place is
+			// reserved before linking the node, so that the bound holds at any time.
+			node *n = new node();
+			if (m_size.fetch_add(1,boost::memory_order_relaxed) >= m_capacity) {
+				m_size.fetch_sub(1,boost::memory_order_relaxed);
+				delete n;
+				return false;
+			}
+			using std::swap;
+			swap(n->m_value,value);
+			n->m_next = m_head.load(boost::memory_order_relaxed);
+			while (!m_head.compare_exchange_weak(n->m_next,n,boost::memory_order_release,boost::memory_order_relaxed)) {}
+			return true;
+		}
+		/// Remove all the elements.
+		/**
+		 * The elements in the queue are appended to retval in the order in which they were pushed. Must not be
+		 * called concurrently by more than one thread.
+		 *
+		 * @param[out] retval vector to which the elements will be appended.
+		 */
+		void pop_all(std::vector<T> &retval)
+		{
+			node *list = m_head.exchange(0,boost::memory_order_acquire);
+			// The list goes from the newest element to the oldest one: reverse it.
+			node *prev = 0;
+			std::size_t count = 0;
+			while (list) {
+				node *next = list->m_next;
+				list->m_next = prev;
+				prev = list;
+				list = next;
+				++count;
+			}
+			retval.reserve(retval.size() + count);
+			using std::swap;
+			for (node *n = prev; n; n = n->m_next) {
+				retval.push_back(T());
+				swap(retval.back(),n->m_value);
+			}
+			free_list(prev);
+			m_size.fetch_sub(count,boost::memory_order_relaxed);
+		}
+		/// Copy the elements.
+		/**
+		 * Like pop_all(), but the queue is left untouched. Must not be called while other threads are accessing the queue.
+		 *
+		 * @param[out] retval vector to which copies of the elements will be appended.
+		 */
+		void copy_to(std::vector<T> &retval) const
+		{
+			const typename std::vector<T>::size_type first = retval.size();
+			for (node *n = m_head.load(boost::memory_order_acquire); n; n = n->m_next) {
+				retval.push_back(n->m_value);
+			}
+			std::reverse(retval.begin() + first,retval.end());
+		}
+		/// Capacity.
+		/**
+		 * @return the maximum number of elements in the queue.
+		 */
+		std::size_t get_capacity() const
+		{
+			return m_capacity;
+		}
+		/// Size.
+		/**
+		 * The value is only indicative if other threads are accessing the queue.
+		 *
+		 * @return the number of elements in the queue.
+		 */
+		std::size_t get_size() const
+		{
+			return m_size.load(boost::memory_order_relaxed);
+		}
+	private:
+		static void free_list(node *n)
+		{
+			while (n) {
+				node *next = n->m_next;
+				delete n;
+				n = next;
+			}
+		}
+
+		const std::size_t		m_capacity;
+		boost::atomic<node *>		m_head;
+		boost::atomic<std::size_t>	m_size;
+};
+
+}}
+
+#endif
@@ -11,9 +11,53 @@
 using namespace std;
 namespace pagmo{ namespace util {namespace neighbourhood {
 
+namespace {
+
+// Order of the neighbours of a vector: by distance, the vector itself first, then by index.
+struct neighbour_less
+{
+	neighbour_less(const std::vector<double> &d, population::size_type self):m_d(d),m_self(self) {}
+	bool operator()(population::size_type a, population::size_type b) const
+	{
+		if (m_d[a] != m_d[b]) {
+			return m_d[a] < m_d[b];
+		}
+		if ((a == m_self) != (b == m_self)) {
+			return a == m_self;
+		}
+		return a < b;
+	}
+	const std::vector<double> &m_d;
+	population::size_type m_self;
+};
+
+// Order of the vectors along one coordinate.
+struct coordinate_less
+{
+	coordinate_less(const std::vector<std::vector<double> > &points, std::vector<double>::size_type dim):m_points(points),m_dim(dim) {}
+	bool operator()(population::size_type a, population::size_type b) const
+	{
+		return m_points[a][m_dim] < m_points[b][m_dim];
+	}
+	const std::vector<std::vector<double> > &m_points;
+	std::vector<double>::size_type m_dim;
+};
+
+// Maximum number of vectors in a leaf of the kd-tree.
+const population::size_type leaf_size = 8;
+
+// Dimension above which the kd-tree is not used to compute neighbourhoods.
+const std::vector<double>::size_type max_kd_tree_dimension = 8;
+
+// Number of neighbours initially kept by archive_truncation for each vector.
+const population::size_type initial_neighbours = 3;
+
+}
+
 /**
  * Compute the neighbourhood graph. At the end of the call retval[i][j] will contain the j-th closest vector
- * (according to the euclidian distance) to the i-th vector.
+ * (according to the euclidian distance) to the i-th vector. The i-th vector comes first, and vectors at the same
+ * distance are ordered by index.
  * @param[out] retval a matrix representing the neigborhood graph
  * @param[in]  weights the vector of real vectors
  */
@@ -23,7 +67,49 @@ void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::si
 		for(unsigned int j = 0; j < weights.size(); ++j) {
 			distances.push_back(distance(weights[i],weights[j]));
 		}
-		retval.push_back(order(distances));
+		std::vector<population::size_type> row(weights.size());
+		for(unsigned int j = 0; j < weights.size(); ++j) {
+			row[j] = j;
+		}
+		std::sort(row.begin(), row.end(), neighbour_less(distances, i));
+		retval.push_back(row);
+	}
+}
+
+/**
+ * Compute the k nearest neighbours of each vector. At the end of the call retval[i] will contain the first
+ * min(k, weights.size()) elements of the corresponding row computed by the other overload, without sorting all
+ * the distances. In low dimension the neighbours are found with a kd_tree, otherwise the k closest vectors are
+ * selected among the distances to all the others.
+ * @param[out] retval a matrix representing the neigborhood graph
+ * @param[in]  weights the vector of real vectors
+ * @param[in]  k the number of neighbours of each vector (itself included)
+ */
+void euclidian::compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &retval, const std::vector<std::vector<double> > &weights, const pagmo::population::size_type &k) {
+	const population::size_type n = weights.size(), n_neighbours = std::min(k, n);
+	retval.assign(n, std::vector<population::size_type>());
+	if (!n_neighbours) {
+		return;
+	}
+	if (weights[0].size() <= max_kd_tree_dimension) {
+		const kd_tree tree(weights);
+		std::vector<double> distances;
+		for(population::size_type i = 0; i < n; ++i) {
+			tree.find_neighbours(retval[i], distances, i, n_neighbours - 1);
+			retval[i].insert(retval[i].begin(), i);
+		}
+		return;
+	}
+	std::vector<double> distances(n);
+	std::vector<population::size_type> row(n);
+	for(population::size_type i = 0; i < n; ++i) {
+		for(population::size_type j = 0; j < n; ++j) {
+			distances[j] = distance(weights[i],weights[j]);
+			row[j] = j;
+		}
+		std::nth_element(row.begin(), row.begin() + (n_neighbours - 1), row.end(), neighbour_less(distances, i));
+		std::sort(row.begin(), row.begin() + (n_neighbours - 1), neighbour_less(distances, i));
+		retval[i].assign(row.begin(), row.begin() + n_neighbours);
 	}
 }
 
@@ -41,4 +127,312 @@ double euclidian::distance(const std::vector<double> &a, const std::vector<doubl
 	return sqrt(rtr);
 }
 
+/// Constructor.
+/**
+ * Builds the tree in O(N log N). The vectors are not copied and must outlive the tree.
+ *
+ * @param[in] points the vectors to be indexed, all of the same size.
+ */
+kd_tree::kd_tree(const std::vector<std::vector<double> > &points):m_points(points),m_perm(points.size()),m_leaf(points.size()),
+	m_present(points.size(),1),m_size(points.size())
+{
+	for (size_type i = 0; i < m_perm.size(); ++i) {
+		m_perm[i] = i;
+	}
+	if (m_size) {
+		build(0,m_size,0);
+	}
+}
+
+/// Nearest neighbours of a vector.
+/**
+ * @param[out] idx indices of the nearest vectors, closest first (ties broken by index).
+ * @param[out] d distances of the nearest vectors.
+ * @param[in] i index of the vector whose neighbours are searched (it need not be in the tree anymore).
+ * @param[in] k number of neighbours: if fewer than k other vectors are in the tree, all of them are returned.
+ *
+ * @throws index_error if i is out of range.
+ */
+void kd_tree::find_neighbours(std::vector<size_type> &idx, std::vector<double> &d, const size_type &i, const size_type &k) const
+{
+	if (i >= m_points.size()) {
+		pagmo_throw(index_error,"invalid vector index");
+	}
+	std::vector<neighbour_type> heap;
+	if (k && !m_nodes.empty()) {
+		heap.reserve(k + 1);
+		search(0,i,k,heap);
+	}
+	std::sort_heap(heap.begin(),heap.end());
+	idx.resize(heap.size());
+	d.resize(heap.size());
+	for (size_type j = 0; j < heap.size(); ++j) {
+		d[j] = heap[j].first;
+		idx[j] = heap[j].second;
+	}
+}
+
+/// Remove a vector.
+/**
+ * @param[in] i index of the vector.
+ *
+ * @throws value_error if the vector has already been removed.
+ */
+void kd_tree::erase(const size_type &i)
+{
+	if (!contains(i)) {
+		pagmo_throw(value_error,"the vector is not in the tree");
+	}
+	m_present[i] = 0;
+	--m_size;
+	for (size_type n = m_leaf[i];; n = m_nodes[n].parent) {
+		--m_nodes[n].count;
+		if (!n) {
+			break;
+		}
+	}
+}
+
+/// Check whether a vector is in the tree.
+/**
+ * @param[in] i index of the vector.
+ *
+ * @return true if i is a valid index and the vector has not been removed.
+ */
+bool kd_tree::contains(const size_type &i) const
+{
+	return i < m_present.size() && m_present[i];
+}
+
+/// Number of vectors in the tree.
+/**
+ * @return the number of vectors not removed.
+ */
+kd_tree::size_type kd_tree::size() const
+{
+	return m_size;
+}
+
+// Build the subtree of the vectors in positions [begin,end) of m_perm, splitting along the coordinate of largest spread.
+kd_tree::size_type kd_tree::build(const size_type &begin, const size_type &end, const size_type &parent)
+{
+	const size_type idx = m_nodes.size();
+	node n;
+	n.begin = begin;
+	n.end = end;
+	n.left = n.right = 0;
+	n.parent = parent;
+	n.count = end - begin;
+	n.dim = 0;
+	n.split = 0;
+	m_nodes.push_back(n);
+	if (end - begin <= leaf_size) {
+		for (size_type j = begin; j < end; ++j) {
+			m_leaf[m_perm[j]] = idx;
+		}
+		return idx;
+	}
+	double max_spread = -1;
+	for (std::vector<double>::size_type k = 0; k < m_points[m_perm[begin]].size(); ++k) {
+		double lo = m_points[m_perm[begin]][k], hi = lo;
+		for (size_type j = begin + 1; j < end; ++j) {
+			lo = std::min(lo,m_points[m_perm[j]][k]);
+			hi = std::max(hi,m_points[m_perm[j]][k]);
+		}
+		if (hi - lo > max_spread) {
+			max_spread = hi - lo;
+			m_nodes[idx].dim = k;
+		}
+	}
+	const size_type mid = begin + (end - begin) / 2;
+	std::nth_element(m_perm.begin() + begin,m_perm.begin() + mid,m_perm.begin() + end,coordinate_less(m_points,m_nodes[idx].dim));
+	m_nodes[idx].split = m_points[m_perm[mid]][m_nodes[idx].dim];
+	const size_type left = build(begin,mid,idx);
+	const size_type right = build(mid,end,idx);
+	m_nodes[idx].left = left;
+	m_nodes[idx].right = right;
+	return idx;
+}
+
+// Collect in the max-heap the k nearest vectors to vector i in subtree n.
+void kd_tree::search(const size_type &n, const size_type &i, const size_type &k, std::vector<neighbour_type> &heap) const
+{
+	const node &nd = m_nodes[n];
+	if (!nd.count) {
+		return;
+	}
+	if (!nd.left) {
+		for (size_type j = nd.begin; j < nd.end; ++j) {
+			const size_type p = m_perm[j];
+			if (p == i || !m_present[p]) {
+				continue;
+			}
+			const neighbour_type cand(euclidian::distance(m_points[i],m_points[p]),p);
+			if (heap.size() < k) {
+				heap.push_back(cand);
+				std::push_heap(heap.begin(),heap.end());
+			} else if (cand < heap.front()) {
+				std::pop_heap(heap.begin(),heap.end());
+				heap.back() = cand;
+				std::push_heap(heap.begin(),heap.end());
+			}
+		}
+		return;
+	}
+	// The vectors on the other side of the split are at least |diff| away. Equal distances are not pruned,
+	// as they may win on the index.
+	const double diff = m_points[i][nd.dim] - nd.split;
+	search(diff < 0 ? nd.left : nd.right,i,k,heap);
+	if (heap.size() < k || std::fabs(diff) <= heap.front().first) {
+		search(diff < 0 ? nd.right : nd.left,i,k,heap);
+	}
+}
+
+/// Constructor.
+/**
+ * @param[in] points the vectors, all of the same size.
+ */
+archive_truncation::archive_truncation(const std::vector<std::vector<double> > &points):m_tree(points),m_neighbours(points.size()),
+	m_reverse(points.size()),m_first_d(points.size()),m_in_first(points.size(),0)
+{
+	for (size_type i = 0; i < points.size(); ++i) {
+		fill(i,initial_neighbours);
+	}
+}
+
+/// Remove a vector.
+/**
+ * @return the index of the removed vector.
+ *
+ * @throws value_error if all the vectors have been removed.
+ */
+archive_truncation::size_type archive_truncation::remove_one()
+{
+	if (!size()) {
+		pagmo_throw(value_error,"no vectors left");
+	}
+	size_type retval = 0;
+	if (m_first.empty()) {
+		// A single vector is left.
+		while (!m_tree.contains(retval)) {
+			++retval;
+		}
+	} else {
+		// The smallest list starts with the smallest distance to a nearest neighbour.
+		std::vector<size_type> candidates;
+		for (std::set<neighbour_type>::const_iterator it = m_first.begin(); it != m_first.end() && it->first == m_first.begin()->first; ++it) {
+			candidates.push_back(it->second);
+		}
+		// The candidates are sorted by index, which resolves complete ties.
+		retval = candidates[0];
+		for (size_type j = 1; j < candidates.size(); ++j) {
+			if (less(candidates[j],retval)) {
+				retval = candidates[j];
+			}
+		}
+	}
+	m_tree.erase(retval);
+	m_neighbours[retval].clear();
+	set_first(retval);
+	for (size_type j = 0; j < m_reverse[retval].size(); ++j) {
+		const size_type i = m_reverse[retval][j];
+		if (!m_tree.contains(i)) {
+			continue;
+		}
+		std::vector<neighbour_type> &list = m_neighbours[i];
+		size_type pos = 0;
+		while (pos < list.size() && list[pos].second != retval) {
+			++pos;
+		}
+		if (pos == list.size()) {
+			continue;
+		}
+		list.erase(list.begin() + pos);
+		if (list.empty()) {
+			fill(i,initial_neighbours);
+		} else if (!pos) {
+			set_first(i);
+		}
+	}
+	std::vector<size_type>().swap(m_reverse[retval]);
+	return retval;
+}
+
+/// Check whether a vector has not been removed yet.
+/**
+ * @param[in] i index of the vector.
+ *
+ * @return true if the vector is still present.
+ */
+bool archive_truncation::contains(const size_type &i) const
+{
+	return m_tree.contains(i);
+}
+
+/// Number of vectors left.
+/**
+ * @return the number of vectors not removed yet.
+ */
+archive_truncation::size_type archive_truncation::size() const
+{
+	return m_tree.size();
+}
+
+// Query the first k entries of the list of vector i. The current list is a prefix of the new one, so only the new
+// entries are registered in the reverse lists.
+void archive_truncation::fill(const size_type &i, const size_type &k)
+{
+	const size_type old_size = m_neighbours[i].size();
+	std::vector<size_type> idx;
+	std::vector<double> d;
+	m_tree.find_neighbours(idx,d,i,k);
+	m_neighbours[i].resize(idx.size());
+	for (size_type j = 0; j < idx.size(); ++j) {
+		m_neighbours[i][j] = neighbour_type(d[j],idx[j]);
+		if (j >= old_size) {
+			m_reverse[idx[j]].push_back(i);
+		}
+	}
+	set_first(i);
+}
+
+// Make sure entry l of the list of vector i is available. Returns false if the list is shorter.
+bool archive_truncation::extend(const size_type &i, const size_type &l)
+{
+	const size_type n = m_neighbours[i].size();
+	if (l < n) {
+		return true;
+	}
+	if (n + 1 >= size()) {
+		return false;
+	}
+	fill(i,std::max(2 * n,l + 1));
+	return l < m_neighbours[i].size();
+}
+
+// Lexicographic comparison of the lists of a and b.
+bool archive_truncation::less(const size_type &a, const size_type &b)
+{
+	for (size_type l = 0; extend(a,l) && extend(b,l); ++l) {
+		if (m_neighbours[a][l].first != m_neighbours[b][l].first) {
+			return m_neighbours[a][l].first < m_neighbours[b][l].first;
+		}
+	}
+	return false;
+}
+
+// Update the entry of vector i in the set of distances to the nearest neighbours.
+void archive_truncation::set_first(const size_type &i)
+{
+	if (m_in_first[i]) {
+		m_first.erase(neighbour_type(m_first_d[i],i));
+		m_in_first[i] = 0;
+	}
+	if (!m_neighbours[i].empty()) {
+		m_first_d[i] = m_neighbours[i][0].first;
+		m_first.insert(neighbour_type(m_first_d[i],i));
+		m_in_first[i] = 1;
+	}
+}
+
 }}} //namespaces
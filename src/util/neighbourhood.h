@@ -26,6 +26,8 @@
 #define PAGMO_UTIL_NEIGHBOURHOOD_H
 
 #include <iostream>
+#include <set>
+#include <utility>
 #include <vector>
 #include <math.h>
 #include <algorithm>
@@ -69,9 +71,89 @@ template<class T> std::vector<population::size_type> order(const std::vector<T>
 class __PAGMO_VISIBLE euclidian {
 public:
 	static void compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &, const std::vector<std::vector<double> > &);
+	static void compute_neighbours(std::vector<std::vector<pagmo::population::size_type> > &, const std::vector<std::vector<double> > &, const pagmo::population::size_type &);
 	static double distance(const std::vector<double> &, const std::vector<double> &);
 };
 
+/// KD-tree for nearest neighbour queries.
+/**
+ * Indexes a set of real vectors of the same size, so that the k nearest neighbours (according to
+ * euclidian::distance()) of one of them can be found in O(k log N) on average in low dimension, instead of computing
+ * the distances to all the others. Neighbours at the same distance are ordered by index, so that the result
+ * is the same as with a full sort. Vectors can be removed from the tree, after which they are not returned
+ * by queries anymore.
+ *
+ * @see J.H. Friedman, J.L. Bentley, R.A. Finkel, "An algorithm for finding best matches in logarithmic expected time", ACM TOMS 3(3), 1977.
+ */
+class __PAGMO_VISIBLE kd_tree {
+public:
+	/// Index of a vector.
+	typedef pagmo::population::size_type size_type;
+	explicit kd_tree(const std::vector<std::vector<double> > &);
+	void find_neighbours(std::vector<size_type> &, std::vector<double> &, const size_type &, const size_type &) const;
+	void erase(const size_type &);
+	bool contains(const size_type &) const;
+	size_type size() const;
+private:
+	struct node {
+		// Range of the node in m_perm, children (0 for leaves), parent and number of vectors not removed.
+		size_type begin, end, left, right, parent, count;
+		// Splitting coordinate and value.
+		std::vector<double>::size_type dim;
+		double split;
+	};
+	typedef std::pair<double,size_type> neighbour_type;
+	size_type build(const size_type &, const size_type &, const size_type &);
+	void search(const size_type &, const size_type &, const size_type &, std::vector<neighbour_type> &) const;
+
+	const std::vector<std::vector<double> >	&m_points;
+	std::vector<size_type>			m_perm;
+	std::vector<node>			m_nodes;
+	std::vector<size_type>			m_leaf;
+	std::vector<char>			m_present;
+	size_type				m_size;
+};
+
+/// Truncation by nearest neighbour distances.
+/**
+ * Removes vectors one at a time, each time the one whose sorted list of distances to the remaining vectors is
+ * lexicographically smallest (i.e. the one closest to its nearest neighbour, ties being resolved by the second nearest
+ * and so on), the one with the smallest index in case of complete ties. This is the archive truncation of SPEA2.
+ *
+ * Instead of the full matrix of sorted distances, each vector keeps only the first few entries of its list, queried
+ * from a kd_tree. When a vector is removed, only the lists containing it are updated, and a list is extended only when
+ * the comparison of two vectors needs entries past its end.
+ *
+ * The vectors are not copied and must outlive this object.
+ *
+ * @see E. Zitzler, M. Laumanns, L. Thiele, "SPEA2: Improving the Strength Pareto Evolutionary Algorithm", TIK-Report 103, 2001.
+ */
+class __PAGMO_VISIBLE archive_truncation {
+public:
+	/// Index of a vector.
+	typedef pagmo::population::size_type size_type;
+	explicit archive_truncation(const std::vector<std::vector<double> > &);
+	size_type remove_one();
+	bool contains(const size_type &) const;
+	size_type size() const;
+private:
+	typedef std::pair<double,size_type> neighbour_type;
+	void fill(const size_type &, const size_type &);
+	bool extend(const size_type &, const size_type &);
+	bool less(const size_type &, const size_type &);
+	void set_first(const size_type &);
+
+	kd_tree						m_tree;
+	// Nearest remaining neighbours of each vector, with their distance.
+	std::vector<std::vector<neighbour_type> >	m_neighbours;
+	// The vectors whose neighbour lists may contain each vector.
+	std::vector<std::vector<size_type> >		m_reverse;
+	// Distance to the nearest neighbour of each vector, sorted, and the entry of each vector in it.
+	std::set<neighbour_type>			m_first;
+	std::vector<double>				m_first_d;
+	std::vector<char>				m_in_first;
+};
+
 }}}
 
 #endif
@@ -0,0 +1,312 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../types.h"
+#include "non_dominated_sorting.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Lexicographic order of fitness vectors given by their position.
+struct lex_less
+{
+	lex_less(const std::vector<fitness_vector> &f):m_f(f) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		return m_f[a] < m_f[b];
+	}
+	const std::vector<fitness_vector> &m_f;
+};
+
+// Order of the points along one objective, ties broken by position.
+struct objective_less
+{
+	objective_less(const std::vector<const fitness_vector *> &p, fitness_vector::size_type k):m_p(p),m_k(k) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		const double fa = (*m_p[a])[m_k], fb = (*m_p[b])[m_k];
+		return fa < fb || (fa == fb && a < b);
+	}
+	const std::vector<const fitness_vector *> &m_p;
+	fitness_vector::size_type m_k;
+};
+
+// The sorter works on distinct points sorted lexicographically and identified by their position in that order.
+// A point can then only be dominated by points preceding it, and weak dominance on all the objectives is
+// equivalent to dominance.
+//
+// helper_a(S,k) ranks the points of S among themselves, given that objectives after k do not matter in S.
+// helper_b(L,H,k) raises the ranks of the points in H according to the (final) ranks of the points in L, given
+// that points of H never dominate points of L and that every point of L is not worse than every point of H on
+// the objectives after k. The recursion ends with a sweep on the first two objectives, which uses a Fenwick tree
+// over the ranks of the second objective to find the highest rank among the dominating points.
+class sorter
+{
+	public:
+		typedef std::vector<std::size_t> index_vector;
+
+		sorter(const std::vector<const fitness_vector *> &p):m_p(p),m_rank(p.size(),0),m_y(p.size()),m_tree(p.size() + 1,0)
+		{
+			// Dense ranks of the values of the second objective.
+			index_vector idx(p.size());
+			for (std::size_t i = 0; i < idx.size(); ++i) {
+				idx[i] = i;
+			}
+			std::sort(idx.begin(),idx.end(),objective_less(m_p,1));
+			std::size_t y = 0;
+			for (std::size_t i = 0; i < idx.size(); ++i) {
+				if (i && (*m_p[idx[i]])[1] != (*m_p[idx[i - 1]])[1]) {
+					++y;
+				}
+				m_y[idx[i]] = y;
+			}
+		}
+		void run()
+		{
+			index_vector all(m_p.size());
+			for (std::size_t i = 0; i < all.size(); ++i) {
+				all[i] = i;
+			}
+			const fitness_vector::size_type k = m_p[0]->size() - 1;
+			if (k == 1) {
+				sweep_a(all);
+			} else {
+				helper_a(all,k);
+			}
+		}
+		const index_vector &get_ranks() const
+		{
+			return m_rank;
+		}
+	private:
+		void helper_a(const index_vector &s, fitness_vector::size_type k)
+		{
+			if (s.size() < 2) {
+				return;
+			}
+			// Split at the median of objective k. Ties are broken by position, so that no point of h can dominate
+			// a point of l.
+			index_vector tmp(s);
+			const objective_less comp(m_p,k);
+			std::nth_element(tmp.begin(),tmp.begin() + tmp.size() / 2,tmp.end(),comp);
+			const std::size_t pivot = tmp[tmp.size() / 2];
+			index_vector l, h;
+			for (std::size_t i = 0; i < s.size(); ++i) {
+				if (comp(s[i],pivot)) {
+					l.push_back(s[i]);
+				} else {
+					h.push_back(s[i]);
+				}
+			}
+			helper_a(l,k);
+			helper_b(l,h,k - 1);
+			helper_a(h,k);
+		}
+		void helper_b(const index_vector &l, const index_vector &h, fitness_vector::size_type k)
+		{
+			if (l.empty() || h.empty()) {
+				return;
+			}
+			if (l.size() == 1 || h.size() == 1) {
+				for (std::size_t i = 0; i < h.size(); ++i) {
+					for (std::size_t j = 0; j < l.size(); ++j) {
+						if (weakly_dominates(l[j],h[i],k)) {
+							m_rank[h[i]] = std::max(m_rank[h[i]],m_rank[l[j]] + 1);
+						}
+					}
+				}
+				return;
+			}
+			if (k == 1) {
+				sweep_b(l,h);
+				return;
+			}
+			double l_min = (*m_p[l[0]])[k], l_max = l_min, h_min = (*m_p[h[0]])[k], h_max = h_min;
+			std::vector<double> values;
+			values.reserve(l.size() + h.size());
+			for (std::size_t i = 0; i < l.size(); ++i) {
+				const double v = (*m_p[l[i]])[k];
+				l_min = std::min(l_min,v);
+				l_max = std::max(l_max,v);
+				values.push_back(v);
+			}
+			for (std::size_t i = 0; i < h.size(); ++i) {
+				const double v = (*m_p[h[i]])[k];
+				h_min = std::min(h_min,v);
+				h_max = std::max(h_max,v);
+				values.push_back(v);
+			}
+			if (l_max <= h_min) {
+				// Objective k does not discriminate anymore.
+				helper_b(l,h,k - 1);
+				return;
+			}
+			if (l_min > h_max) {
+				// No point of l can dominate a point of h.
+				return;
+			}
+			std::nth_element(values.begin(),values.begin() + values.size() / 2,values.end());
+			const double median = values[values.size() / 2];
+			// Values equal to the median go to the lower half, unless the median is the maximum (in which case
+			// the lower half would contain everything).
+			const bool ties_low = median < std::max(l_max,h_max);
+			index_vector l1, l2, h1, h2;
+			split(l,k,median,ties_low,l1,l2);
+			split(h,k,median,ties_low,h1,h2);
+			helper_b(l1,h1,k);
+			helper_b(l1,h2,k - 1);
+			helper_b(l2,h2,k);
+		}
+		void split(const index_vector &s, fitness_vector::size_type k, double median, bool ties_low, index_vector &low, index_vector &high) const
+		{
+			for (std::size_t i = 0; i < s.size(); ++i) {
+				const double v = (*m_p[s[i]])[k];
+				if (v < median || (ties_low && v == median)) {
+					low.push_back(s[i]);
+				} else {
+					high.push_back(s[i]);
+				}
+			}
+		}
+		// Sweep on the first two objectives ranking the points of s among themselves.
+		void sweep_a(const index_vector &s)
+		{
+			for (std::size_t i = 0; i < s.size(); ++i) {
+				m_rank[s[i]] = std::max(m_rank[s[i]],tree_query(m_y[s[i]]));
+				tree_insert(m_y[s[i]],m_rank[s[i]] + 1);
+			}
+			for (std::size_t i = 0; i < s.size(); ++i) {
+				tree_reset(m_y[s[i]]);
+			}
+		}
+		// Sweep on the first two objectives raising the ranks of h according to l. Points are processed by
+		// position, so that the points of l inserted before a point of h are not worse on the first objective.
+		void sweep_b(const index_vector &l, const index_vector &h)
+		{
+			std::size_t i = 0;
+			for (std::size_t j = 0; j < h.size(); ++j) {
+				for (; i < l.size() && l[i] < h[j]; ++i) {
+					tree_insert(m_y[l[i]],m_rank[l[i]] + 1);
+				}
+				m_rank[h[j]] = std::max(m_rank[h[j]],tree_query(m_y[h[j]]));
+			}
+			for (std::size_t j = 0; j < i; ++j) {
+				tree_reset(m_y[l[j]]);
+			}
+		}
+		bool weakly_dominates(std::size_t a, std::size_t b, fitness_vector::size_type k) const
+		{
+			for (fitness_vector::size_type i = 0; i <= k; ++i) {
+				if ((*m_p[a])[i] > (*m_p[b])[i]) {
+					return false;
+				}
+			}
+			return true;
+		}
+		// Fenwick tree storing the maximum of rank + 1 over prefixes of the second objective (0 means empty).
+		void tree_insert(std::size_t y, std::size_t value)
+		{
+			for (std::size_t i = y + 1; i < m_tree.size(); i += i & (~i + 1)) {
+				m_tree[i] = std::max(m_tree[i],value);
+			}
+		}
+		std::size_t tree_query(std::size_t y) const
+		{
+			std::size_t retval = 0;
+			for (std::size_t i = y + 1; i > 0; i -= i & (~i + 1)) {
+				retval = std::max(retval,m_tree[i]);
+			}
+			return retval;
+		}
+		void tree_reset(std::size_t y)
+		{
+			for (std::size_t i = y + 1; i < m_tree.size(); i += i & (~i + 1)) {
+				m_tree[i] = 0;
+			}
+		}
+
+		const std::vector<const fitness_vector *>	&m_p;
+		index_vector					m_rank;
+		index_vector					m_y;
+		index_vector					m_tree;
+};
+
+}
+
+/// Compute the Pareto ranks of a set of fitness vectors.
+/**
+ * After the call, rank[i] will contain the index of the non-dominated front f[i] belongs to.
+ *
+ * @param[out] rank vector that will contain the Pareto ranks.
+ * @param[in] f fitness vectors to be ranked.
+ *
+ * @throws value_error if the fitness vectors do not have all the same non-null dimension.
+ */
+void non_dominated_sorting::compute_ranks(std::vector<std::size_t> &rank, const std::vector<fitness_vector> &f)
+{
+	rank.assign(f.size(),0);
+	if (f.empty()) {
+		return;
+	}
+	const fitness_vector::size_type m = f[0].size();
+	for (std::size_t i = 0; i < f.size(); ++i) {
+		if (!f[i].size() || f[i].size() != m) {
+			pagmo_throw(value_error,"fitness vectors must all have the same, non-null dimension");
+		}
+	}
+	// Sort lexicographically and merge identical vectors.
+	std::vector<std::size_t> order(f.size());
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		order[i] = i;
+	}
+	std::sort(order.begin(),order.end(),lex_less(f));
+	std::vector<const fitness_vector *> points;
+	std::vector<std::size_t> point_of(f.size());
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		if (!i || f[order[i]] != f[order[i - 1]]) {
+			points.push_back(&f[order[i]]);
+		}
+		point_of[order[i]] = points.size() - 1;
+	}
+	if (m == 1) {
+		// Every value dominates all the larger ones.
+		for (std::size_t i = 0; i < f.size(); ++i) {
+			rank[i] = point_of[i];
+		}
+		return;
+	}
+	sorter s(points);
+	s.run();
+	for (std::size_t i = 0; i < f.size(); ++i) {
+		rank[i] = s.get_ranks()[point_of[i]];
+	}
+}
+
+}}
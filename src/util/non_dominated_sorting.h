@@ -0,0 +1,56 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_NON_DOMINATED_SORTING_H
+#define PAGMO_UTIL_NON_DOMINATED_SORTING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Non-dominated sorting of fitness vectors.
+/**
+ * Computes the Pareto rank (index of the non-dominated front, starting from 0) of a set of fitness vectors, assuming
+ * all objectives are to be minimised. Instead of comparing all the pairs of vectors, the divide-and-conquer algorithm
+ * of Jensen is used, in the version generalised by Fortin et al. to handle equal objective values. Its complexity is
+ * O(N log^(M-1) N) for N vectors of M objectives (O(N log N) for one or two objectives).
+ *
+ * Identical fitness vectors do not dominate each other and get the same rank.
+ *
+ * @see M.T. Jensen, "Reducing the run-time complexity of multiobjective EAs: The NSGA-II and other algorithms", IEEE TEC 7(5), 2003.
+ * @see F.A. Fortin, S. Grenier, M. Parizeau, "Generalizing the improved run-time complexity algorithm for non-dominated sorting", GECCO 2013.
+ */
+class __PAGMO_VISIBLE non_dominated_sorting
+{
+	public:
+		static void compute_ranks(std::vector<std::size_t> &, const std::vector<fitness_vector> &);
+};
+
+}}
+
+#endif
@@ -0,0 +1,182 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <vector>
+
+#include "../exceptions.h"
+#include "pareto_dominance.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Visitor building the domination lists and counts.
+struct dominance_builder
+{
+	dominance_builder(std::vector<std::vector<pareto_dominance::size_type> > &dom_list, std::vector<pareto_dominance::size_type> &dom_count):
+		m_dom_list(dom_list),m_dom_count(dom_count) {}
+	void operator()(const pareto_dominance::size_type &i, const pareto_dominance::size_type &j)
+	{
+		m_dom_list[i].push_back(j);
+		++m_dom_count[j];
+	}
+	std::vector<std::vector<pareto_dominance::size_type> >	&m_dom_list;
+	std::vector<pareto_dominance::size_type>		&m_dom_count;
+};
+
+}
+
+/// Constructor from fitness vectors.
+/**
+ * The fitness vectors are copied into a packed array.
+ *
+ * @param[in] f fitness vectors, all of the same dimension.
+ *
+ * @throws value_error if the fitness vectors have different dimensions.
+ */
+pareto_dominance::pareto_dominance(const std::vector<fitness_vector> &f):m_size(f.size()),m_f_dimension(f.empty() ? 0 : f[0].size())
+{
+	m_f.reserve(m_size * m_f_dimension + 1);
+	for (size_type i = 0; i < m_size; ++i) {
+		if (f[i].size() != m_f_dimension) {
+			pagmo_throw(value_error,"fitness vectors must all have the same dimension");
+		}
+		m_f.insert(m_f.end(),f[i].begin(),f[i].end());
+	}
+	// Never empty, so that the address of the first element can always be taken.
+	m_f.push_back(0.);
+}
+
+/// Number of fitness vectors.
+/**
+ * @return the number of fitness vectors.
+ */
+pareto_dominance::size_type pareto_dominance::size() const
+{
+	return m_size;
+}
+
+/// Fitness dimension.
+/**
+ * @return the dimension of the fitness vectors.
+ */
+fitness_vector::size_type pareto_dominance::get_f_dimension() const
+{
+	return m_f_dimension;
+}
+
+/// Compare two of the fitness vectors.
+/**
+ * @param[in] i index of the first fitness vector.
+ * @param[in] j index of the second fitness vector.
+ *
+ * @return 1 if the i-th vector dominates the j-th one, -1 if it is dominated by it, 0 otherwise.
+ *
+ * @throws index_error if i or j are out of range.
+ */
+int pareto_dominance::compare(const size_type &i, const size_type &j) const
+{
+	if (i >= m_size || j >= m_size) {
+		pagmo_throw(index_error,"fitness vector index out of range");
+	}
+	return compare(&m_f[0] + i * m_f_dimension,&m_f[0] + j * m_f_dimension,m_f_dimension);
+}
+
+/// Domination lists and counts.
+/**
+ * Computes, for each fitness vector, the indices of the vectors it dominates (in increasing order) and the number of
+ * vectors dominating it, as population does.
+ *
+ * @param[out] dom_list domination lists.
+ * @param[out] dom_count domination counts.
+ */
+void pareto_dominance::compute_dominance(std::vector<std::vector<size_type> > &dom_list, std::vector<size_type> &dom_count) const
+{
+	dom_list.resize(m_size);
+	for (size_type i = 0; i < m_size; ++i) {
+		dom_list[i].clear();
+	}
+	dom_count.assign(m_size,0);
+	dominance_builder builder(dom_list,dom_count);
+	for_each_dominance(builder);
+}
+
+/// Compare two fitness vectors.
+/**
+ * @param[in] a first fitness vector.
+ * @param[in] b second fitness vector.
+ * @param[in] m number of objectives.
+ *
+ * @return 1 if a dominates b, -1 if b dominates a, 0 otherwise.
+ */
+int pareto_dominance::compare(const double *a, const double *b, const fitness_vector::size_type &m)
+{
+	switch (m) {
+		case 2:
+			return kernel<2>::compare(a,b,m);
+		case 3:
+			return kernel<3>::compare(a,b,m);
+		case 4:
+			return kernel<4>::compare(a,b,m);
+		default:
+			return kernel<0>::compare(a,b,m);
+	}
+}
+
+/// Compare two fitness vectors.
+/**
+ * @param[in] a first fitness vector.
+ * @param[in] b second fitness vector.
+ *
+ * @return 1 if a dominates b, -1 if b dominates a, 0 otherwise.
+ *
+ * @throws value_error if the vectors have different dimensions.
+ */
+int pareto_dominance::compare(const fitness_vector &a, const fitness_vector &b)
+{
+	if (a.size() != b.size()) {
+		pagmo_throw(value_error,"fitness vectors must have the same dimension");
+	}
+	if (a.empty()) {
+		return 0;
+	}
+	return compare(&a[0],&b[0],a.size());
+}
+
+/// Dominance test.
+/**
+ * @param[in] a first fitness vector.
+ * @param[in] b second fitness vector.
+ * @param[in] m number of objectives.
+ *
+ * @return true if a dominates b.
+ */
+bool pareto_dominance::dominates(const double *a, const double *b, const fitness_vector::size_type &m)
+{
+	return compare(a,b,m) > 0;
+}
+
+}}
@@ -0,0 +1,161 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_PARETO_DOMINANCE_H
+#define PAGMO_UTIL_PARETO_DOMINANCE_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Pareto dominance kernels.
+/**
+ * Dominance tests between fitness vectors, all objectives being minimised: a dominates b if it is not worse on any
+ * objective and strictly better on at least one. This is the relation implemented by the default
+ * problem::base::compare_fitness_impl(), which problems declaring problem::base::has_pareto_dominance() use.
+ *
+ * A single pass over the objectives tells which of the two vectors (if any) dominates the other. The kernels are
+ * templated on the number of objectives: for two, three and four objectives the loop is fully unrolled and free of
+ * branches, so that it is compiled into a few vector comparisons, while for any other number the objectives are
+ * compared in blocks of four, stopping as soon as the vectors are known to be incomparable.
+ *
+ * A pareto_dominance object packs a set of fitness vectors into a single contiguous array, and visits all the
+ * dominance relations among them comparing each unordered pair once (see for_each_dominance()).
+ */
+class __PAGMO_VISIBLE pareto_dominance
+{
+	public:
+		/// Size type.
+		typedef std::vector<fitness_vector>::size_type size_type;
+		explicit pareto_dominance(const std::vector<fitness_vector> &);
+		size_type size() const;
+		fitness_vector::size_type get_f_dimension() const;
+		int compare(const size_type &, const size_type &) const;
+		void compute_dominance(std::vector<std::vector<size_type> > &, std::vector<size_type> &) const;
+		template <class Visitor>
+		void for_each_dominance(Visitor &) const;
+		static int compare(const double *, const double *, const fitness_vector::size_type &);
+		static int compare(const fitness_vector &, const fitness_vector &);
+		static bool dominates(const double *, const double *, const fitness_vector::size_type &);
+	private:
+		template <unsigned int M>
+		struct kernel;
+		template <unsigned int M, class Visitor>
+		void visit(Visitor &) const;
+
+		// Fitness vectors, one after the other.
+		std::vector<double>		m_f;
+		size_type			m_size;
+		fitness_vector::size_type	m_f_dimension;
+};
+
+// Comparison of two vectors of M objectives (of m objectives if M is zero). Returns 1 if a dominates b, -1 if b
+// dominates a, 0 otherwise. Given that a is nowhere worse than b, it is strictly better somewhere exactly when b is
+// not nowhere worse than a, so that two flags are enough.
+template <unsigned int M>
+struct pareto_dominance::kernel
+{
+	static int compare(const double *a, const double *b, const fitness_vector::size_type &)
+	{
+		bool le = true, ge = true;
+		for (unsigned int k = 0; k < M; ++k) {
+			le &= a[k] <= b[k];
+			ge &= b[k] <= a[k];
+		}
+		return (le && !ge) ? 1 : ((ge && !le) ? -1 : 0);
+	}
+};
+
+template <>
+struct pareto_dominance::kernel<0>
+{
+	static int compare(const double *a, const double *b, const fitness_vector::size_type &m)
+	{
+		bool le = true, ge = true;
+		fitness_vector::size_type k = 0;
+		for (; k + 4 <= m; k += 4) {
+			le &= (a[k] <= b[k]) & (a[k + 1] <= b[k + 1]) & (a[k + 2] <= b[k + 2]) & (a[k + 3] <= b[k + 3]);
+			ge &= (b[k] <= a[k]) & (b[k + 1] <= a[k + 1]) & (b[k + 2] <= a[k + 2]) & (b[k + 3] <= a[k + 3]);
+			if (!le && !ge) {
+				return 0;
+			}
+		}
+		for (; k < m; ++k) {
+			le &= a[k] <= b[k];
+			ge &= b[k] <= a[k];
+		}
+		return (le && !ge) ? 1 : ((ge && !le) ? -1 : 0);
+	}
+};
+
+/// Visit all the dominance relations.
+/**
+ * Call v(i,j) for each pair of vectors such that the i-th one dominates the j-th one. The pairs are compared in
+ * lexicographic order of (min(i,j),max(i,j)), each unordered pair being compared only once.
+ *
+ * @param[in,out] v visitor, called with two size_type arguments.
+ */
+template <class Visitor>
+inline void pareto_dominance::for_each_dominance(Visitor &v) const
+{
+	switch (m_f_dimension) {
+		case 2:
+			visit<2>(v);
+			break;
+		case 3:
+			visit<3>(v);
+			break;
+		case 4:
+			visit<4>(v);
+			break;
+		default:
+			visit<0>(v);
+	}
+}
+
+template <unsigned int M, class Visitor>
+inline void pareto_dominance::visit(Visitor &v) const
+{
+	const fitness_vector::size_type m = m_f_dimension;
+	for (size_type i = 0; i < m_size; ++i) {
+		const double *a = &m_f[0] + i * m;
+		for (size_type j = i + 1; j < m_size; ++j) {
+			const int c = kernel<M>::compare(a,&m_f[0] + j * m,m);
+			if (c > 0) {
+				v(i,j);
+			} else if (c < 0) {
+				v(j,i);
+			}
+		}
+	}
+}
+
+}}
+
+#endif
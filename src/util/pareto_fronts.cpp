@@ -0,0 +1,475 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../problem/base.h"
+#include "../types.h"
+#include "pareto_dominance.h"
+#include "pareto_fronts.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Order of the points along one objective, ties broken by identifier.
+struct objective_less
+{
+	objective_less(const std::vector<fitness_vector> &f, fitness_vector::size_type k):m_f(f),m_k(k) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		const double fa = m_f[a][m_k], fb = m_f[b][m_k];
+		return fa < fb || (fa == fb && a < b);
+	}
+	const std::vector<fitness_vector> &m_f;
+	fitness_vector::size_type m_k;
+};
+
+// Lexicographic order of the points, ties broken by identifier.
+struct lex_less
+{
+	lex_less(const std::vector<fitness_vector> &f):m_f(f) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		return m_f[a] < m_f[b] || (m_f[a] == m_f[b] && a < b);
+	}
+	const std::vector<fitness_vector> &m_f;
+};
+
+}
+
+/// Constructor.
+/**
+ * Plain Pareto dominance (all objectives minimised) is used, unless a problem whose problem::base::has_pareto_dominance()
+ * returns false is passed, in which case the points are compared with problem::base::compare_fitness(). The problem
+ * is not copied and must outlive this object.
+ *
+ * @param[in] f_dimension number of objectives.
+ * @param[in] prob optional problem defining the dominance relation.
+ *
+ * @throws value_error if f_dimension is zero.
+ */
+pareto_fronts::pareto_fronts(fitness_vector::size_type f_dimension, const problem::base *prob):
+	m_f_dimension(f_dimension),m_prob((prob && !prob->has_pareto_dominance()) ? prob : 0),m_size(0)
+{
+	if (!f_dimension) {
+		pagmo_throw(value_error,"the number of objectives must be positive");
+	}
+}
+
+/// Insert a point.
+/**
+ * @param[in] id identifier of the point.
+ * @param[in] f fitness vector of the point.
+ *
+ * @throws value_error if a point with the same identifier is already present, or if f has the wrong size.
+ */
+void pareto_fronts::insert(const size_type &id, const fitness_vector &f)
+{
+	if (f.size() != m_f_dimension) {
+		pagmo_throw(value_error,"fitness vector has the wrong dimension");
+	}
+	if (contains(id)) {
+		pagmo_throw(value_error,"a point with the same identifier is already present");
+	}
+	if (id >= m_f.size()) {
+		m_f.resize(id + 1);
+		m_present.resize(id + 1,0);
+		m_rank.resize(id + 1,0);
+		m_crowding_d.resize(id + 1,0);
+		m_terms.resize((id + 1) * m_f_dimension,0);
+	}
+	m_f[id] = f;
+	m_present[id] = 1;
+	++m_size;
+	// The first front in which nothing dominates the new point. Fronts further down are dominated
+	// by the fronts above them, so the search can be binary.
+	size_type lo = 0, hi = m_fronts.size();
+	while (lo < hi) {
+		const size_type mid = lo + (hi - lo) / 2;
+		if (front_dominates(mid,id)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	// Push the points dominated by the newcomers one front down, as long as there are any.
+	std::vector<size_type> moving(1,id), next;
+	for (size_type r = lo; !moving.empty(); ++r) {
+		if (r == m_fronts.size()) {
+			m_fronts.push_back(front_type(m_f_dimension));
+		}
+		next.clear();
+		const std::vector<size_type> &members = m_fronts[r][0];
+		for (size_type i = first_candidate(r,moving); i < members.size(); ++i) {
+			for (size_type j = 0; j < moving.size(); ++j) {
+				if (dominates(moving[j],members[i])) {
+					next.push_back(members[i]);
+					break;
+				}
+			}
+		}
+		for (size_type i = 0; i < next.size(); ++i) {
+			remove_from_front(r,next[i]);
+		}
+		for (size_type i = 0; i < moving.size(); ++i) {
+			add_to_front(r,moving[i]);
+		}
+		moving.swap(next);
+	}
+	refresh_crowding_d();
+}
+
+/// Remove a point.
+/**
+ * The points that were dominated only by the removed one in their previous front are moved one front up, cascading
+ * down the fronts as needed.
+ *
+ * @param[in] id identifier of the point.
+ *
+ * @throws value_error if no point with the given identifier is present.
+ */
+void pareto_fronts::erase(const size_type &id)
+{
+	if (!contains(id)) {
+		pagmo_throw(value_error,"no point with the given identifier is present");
+	}
+	const size_type r = m_rank[id];
+	remove_from_front(r,id);
+	m_present[id] = 0;
+	--m_size;
+	std::vector<size_type> removed(1,id), moved, cand;
+	for (size_type level = r; !removed.empty() && level + 1 < m_fronts.size(); ++level) {
+		cand.clear();
+		const std::vector<size_type> &below = m_fronts[level + 1][0];
+		for (size_type i = first_candidate(level + 1,removed); i < below.size(); ++i) {
+			for (size_type j = 0; j < removed.size(); ++j) {
+				if (dominates(removed[j],below[i])) {
+					cand.push_back(below[i]);
+					break;
+				}
+			}
+		}
+		// A dominating point precedes the points it dominates in lexicographic order, so that moving
+		// the candidates up in this order checks each of them against the ones already moved.
+		std::sort(cand.begin(),cand.end(),lex_less(m_f));
+		moved.clear();
+		for (size_type i = 0; i < cand.size(); ++i) {
+			if (!front_dominates(level,cand[i])) {
+				remove_from_front(level + 1,cand[i]);
+				add_to_front(level,cand[i]);
+				moved.push_back(cand[i]);
+			}
+		}
+		removed.swap(moved);
+	}
+	remove_empty_fronts();
+	refresh_crowding_d();
+}
+
+/// Remove all the points.
+void pareto_fronts::clear()
+{
+	m_fronts.clear();
+	m_f.clear();
+	m_present.clear();
+	m_rank.clear();
+	m_crowding_d.clear();
+	m_terms.clear();
+	m_dirty.clear();
+	m_size = 0;
+}
+
+/// Check whether a point is present.
+/**
+ * @param[in] id identifier of the point.
+ *
+ * @return true if a point with identifier id is present.
+ */
+bool pareto_fronts::contains(const size_type &id) const
+{
+	return id < m_present.size() && m_present[id];
+}
+
+/// Number of points.
+/**
+ * @return the number of points currently present.
+ */
+pareto_fronts::size_type pareto_fronts::size() const
+{
+	return m_size;
+}
+
+/// Number of fronts.
+/**
+ * @return the number of non-empty non-dominated fronts.
+ */
+pareto_fronts::size_type pareto_fronts::n_fronts() const
+{
+	return m_fronts.size();
+}
+
+/// Points of a front.
+/**
+ * @param[in] r rank of the front, starting from 0 for the non-dominated points.
+ *
+ * @return the identifiers of the points of the front, sorted along the first objective.
+ *
+ * @throws index_error if r is not smaller than n_fronts().
+ */
+const std::vector<pareto_fronts::size_type> &pareto_fronts::get_front(const size_type &r) const
+{
+	if (r >= m_fronts.size()) {
+		pagmo_throw(index_error,"invalid front index");
+	}
+	return m_fronts[r][0];
+}
+
+/// Pareto rank of a point.
+/**
+ * @param[in] id identifier of the point.
+ *
+ * @return the index of the front of the point.
+ *
+ * @throws index_error if no point with the given identifier is present.
+ */
+pareto_fronts::size_type pareto_fronts::get_pareto_rank(const size_type &id) const
+{
+	if (!contains(id)) {
+		pagmo_throw(index_error,"invalid point identifier");
+	}
+	return m_rank[id];
+}
+
+/// Crowding distance of a point.
+/**
+ * @param[in] id identifier of the point.
+ *
+ * @return the crowding distance of the point within its front.
+ *
+ * @throws index_error if no point with the given identifier is present.
+ */
+double pareto_fronts::get_crowding_d(const size_type &id) const
+{
+	if (!contains(id)) {
+		pagmo_throw(index_error,"invalid point identifier");
+	}
+	return m_crowding_d[id];
+}
+
+/// Pareto ranks of all the points.
+/**
+ * @return a vector indexed by identifier. Entries of identifiers not present are meaningless.
+ */
+const std::vector<pareto_fronts::size_type> &pareto_fronts::get_pareto_ranks() const
+{
+	return m_rank;
+}
+
+/// Crowding distances of all the points.
+/**
+ * @return a vector indexed by identifier. Entries of identifiers not present are meaningless.
+ */
+const std::vector<double> &pareto_fronts::get_crowding_d() const
+{
+	return m_crowding_d;
+}
+
+/// Worst point.
+/**
+ * The worst point according to the crowded comparison operator, i.e. the point of the last front with the smallest
+ * crowding distance (the first one along the first objective in case of ties).
+ *
+ * @return the identifier of the worst point.
+ *
+ * @throws value_error if there are no points.
+ */
+pareto_fronts::size_type pareto_fronts::get_worst() const
+{
+	if (!m_size) {
+		pagmo_throw(value_error,"no points present");
+	}
+	const std::vector<size_type> &last = m_fronts.back()[0];
+	size_type retval = last[0];
+	for (size_type i = 1; i < last.size(); ++i) {
+		if (m_crowding_d[last[i]] < m_crowding_d[retval]) {
+			retval = last[i];
+		}
+	}
+	return retval;
+}
+
+// Dominance between two points.
+bool pareto_fronts::dominates(const size_type &a, const size_type &b) const
+{
+	if (m_prob) {
+		return m_prob->compare_fitness(m_f[a],m_f[b]);
+	}
+	return pareto_dominance::dominates(&m_f[a][0],&m_f[b][0],m_f_dimension);
+}
+
+// Whether some point of front r dominates point id.
+bool pareto_fronts::front_dominates(const size_type &r, const size_type &id) const
+{
+	const std::vector<size_type> &members = m_fronts[r][0];
+	for (size_type i = 0; i < members.size(); ++i) {
+		// With plain dominance, the dominating points precede id along the first objective.
+		if (!m_prob && m_f[id][0] < m_f[members[i]][0]) {
+			break;
+		}
+		if (dominates(members[i],id)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Position along the first objective of front r from which points may be dominated by some of the points in ids.
+pareto_fronts::size_type pareto_fronts::first_candidate(const size_type &r, const std::vector<size_type> &ids) const
+{
+	if (m_prob) {
+		return 0;
+	}
+	double min_f = m_f[ids[0]][0];
+	for (size_type i = 1; i < ids.size(); ++i) {
+		min_f = std::min(min_f,m_f[ids[i]][0]);
+	}
+	const std::vector<size_type> &members = m_fronts[r][0];
+	size_type lo = 0, hi = members.size();
+	while (lo < hi) {
+		const size_type mid = lo + (hi - lo) / 2;
+		if (m_f[members[mid]][0] < min_f) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+// Add point id to front r, updating the crowding terms of its neighbours.
+void pareto_fronts::add_to_front(const size_type &r, const size_type &id)
+{
+	m_rank[id] = r;
+	for (fitness_vector::size_type k = 0; k < m_f_dimension; ++k) {
+		std::vector<size_type> &order = m_fronts[r][k];
+		const size_type pos = std::lower_bound(order.begin(),order.end(),id,objective_less(m_f,k)) - order.begin();
+		order.insert(order.begin() + pos,id);
+		const size_type n = order.size();
+		if (pos == 0 || pos == n - 1) {
+			// The extent of the front changed: all the terms along k are affected.
+			update_terms(r,k,0,n);
+		} else {
+			update_terms(r,k,pos - 1,pos + 2);
+		}
+	}
+}
+
+// Remove point id from front r, updating the crowding terms of its neighbours.
+void pareto_fronts::remove_from_front(const size_type &r, const size_type &id)
+{
+	for (fitness_vector::size_type k = 0; k < m_f_dimension; ++k) {
+		std::vector<size_type> &order = m_fronts[r][k];
+		const size_type pos = std::lower_bound(order.begin(),order.end(),id,objective_less(m_f,k)) - order.begin();
+		pagmo_assert(pos < order.size() && order[pos] == id);
+		order.erase(order.begin() + pos);
+		const size_type n = order.size();
+		if (pos == 0 || pos == n) {
+			update_terms(r,k,0,n);
+		} else {
+			update_terms(r,k,pos - 1,pos + 1);
+		}
+	}
+}
+
+// Recompute the crowding terms along objective k of the points of front r in positions [first,last).
+void pareto_fronts::update_terms(const size_type &r, const fitness_vector::size_type &k, const size_type &first, const size_type &last)
+{
+	const std::vector<size_type> &order = m_fronts[r][k];
+	if (order.empty()) {
+		return;
+	}
+	const size_type n = order.size();
+	const double df = m_f[order[n - 1]][k] - m_f[order[0]][k];
+	for (size_type j = first; j < last; ++j) {
+		double &term = m_terms[order[j] * m_f_dimension + k];
+		if (j == 0 || j == n - 1) {
+			term = std::numeric_limits<double>::max();
+		} else if (df == 0.0) {
+			term = 0.0;
+		} else {
+			term = (m_f[order[j + 1]][k] - m_f[order[j - 1]][k]) / df;
+		}
+		m_dirty.push_back(order[j]);
+	}
+}
+
+// Sum the crowding terms of the points whose terms changed.
+void pareto_fronts::refresh_crowding_d()
+{
+	for (size_type i = 0; i < m_dirty.size(); ++i) {
+		const size_type id = m_dirty[i];
+		if (!m_present[id]) {
+			continue;
+		}
+		const double *terms = &m_terms[id * m_f_dimension];
+		double d = 0.0;
+		for (fitness_vector::size_type k = 0; k < m_f_dimension; ++k) {
+			if (terms[k] == std::numeric_limits<double>::max()) {
+				d = terms[k];
+				break;
+			}
+			d += terms[k];
+		}
+		m_crowding_d[id] = d;
+	}
+	m_dirty.clear();
+}
+
+// Drop the fronts left empty by a removal and renumber the following ones.
+void pareto_fronts::remove_empty_fronts()
+{
+	size_type r = 0;
+	for (size_type i = 0; i < m_fronts.size(); ++i) {
+		if (m_fronts[i][0].empty()) {
+			continue;
+		}
+		if (r != i) {
+			m_fronts[r].swap(m_fronts[i]);
+			const std::vector<size_type> &members = m_fronts[r][0];
+			for (size_type j = 0; j < members.size(); ++j) {
+				m_rank[members[j]] = r;
+			}
+		}
+		++r;
+	}
+	m_fronts.resize(r);
+}
+
+}}
@@ -0,0 +1,102 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_PARETO_FRONTS_H
+#define PAGMO_UTIL_PARETO_FRONTS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../problem/base.h"
+#include "../types.h"
+
+namespace pagmo{ namespace util {
+
+/// Incrementally maintained Pareto fronts.
+/**
+ * Keeps the non-dominated fronts, Pareto ranks and crowding distances of a set of fitness vectors while points are
+ * inserted and removed one at a time, as needed by steady-state algorithms. Points are identified by user-chosen
+ * non-negative integers (e.g. slots of a pool), which need not be contiguous.
+ *
+ * Ranks are updated with the efficient non-domination level update approach: an inserted point goes to the first
+ * front in which no point dominates it, and the points it dominates there are pushed one front down, cascading only
+ * through the fronts that actually change. Removals are handled symmetrically. Each front also keeps its points
+ * sorted along every objective, so that the crowding distance is refreshed only for the neighbours of the points
+ * that moved, unless the extent of the front changes.
+ *
+ * The crowding distance follows population::update_crowding_d(): points at the boundary of a front along any
+ * objective get std::numeric_limits<double>::max(), the others the sum over the objectives of the normalised
+ * distance between their two neighbours. Ties along an objective are broken by identifier.
+ *
+ * @see K. Li, K. Deb, Q. Zhang, Q. Zhang, "Efficient non-domination level update method for steady-state evolutionary multiobjective optimization", IEEE Transactions on Cybernetics 47(9), 2017.
+ */
+class __PAGMO_VISIBLE pareto_fronts
+{
+	public:
+		/// Identifier of a point.
+		typedef std::size_t size_type;
+		explicit pareto_fronts(fitness_vector::size_type, const problem::base * = 0);
+		void insert(const size_type &, const fitness_vector &);
+		void erase(const size_type &);
+		void clear();
+		bool contains(const size_type &) const;
+		size_type size() const;
+		size_type n_fronts() const;
+		const std::vector<size_type> &get_front(const size_type &) const;
+		size_type get_pareto_rank(const size_type &) const;
+		double get_crowding_d(const size_type &) const;
+		const std::vector<size_type> &get_pareto_ranks() const;
+		const std::vector<double> &get_crowding_d() const;
+		size_type get_worst() const;
+	private:
+		// Points of a front sorted along each objective.
+		typedef std::vector<std::vector<size_type> > front_type;
+		bool dominates(const size_type &, const size_type &) const;
+		bool front_dominates(const size_type &, const size_type &) const;
+		size_type first_candidate(const size_type &, const std::vector<size_type> &) const;
+		void add_to_front(const size_type &, const size_type &);
+		void remove_from_front(const size_type &, const size_type &);
+		void update_terms(const size_type &, const fitness_vector::size_type &, const size_type &, const size_type &);
+		void refresh_crowding_d();
+		void remove_empty_fronts();
+
+		const fitness_vector::size_type		m_f_dimension;
+		const problem::base			*m_prob;
+		std::vector<front_type>			m_fronts;
+		std::vector<fitness_vector>		m_f;
+		std::vector<char>			m_present;
+		std::vector<size_type>			m_rank;
+		std::vector<double>			m_crowding_d;
+		// Per-objective contributions to the crowding distance, m_f_dimension values per point.
+		std::vector<double>			m_terms;
+		// Scratch space for the points whose crowding distance must be refreshed.
+		std::vector<size_type>			m_dirty;
+		size_type				m_size;
+};
+
+}}
+
+#endif
@@ -54,6 +54,7 @@ void racing_population::set_x_noeval(const size_type idx, const decision_vector
 	}
 	// Set decision vector.
 	m_container[idx].cur_x = x;
+	touch();
 }
 
 /// Update directly fitness and constraint
@@ -84,7 +85,7 @@ void racing_population::set_fc(const size_type idx, const fitness_vector &f, con
 	// to respect more the concept of racing
 	m_container[idx].best_f = f;
 	m_container[idx].best_c = c;
-	update_dom(idx);
+	invalidate_dom(idx);
 }
 
 
@@ -114,6 +115,7 @@ void racing_population::push_back_noeval(const decision_vector &x)
 	m_container.push_back(individual_type());
 	m_dom_list.push_back(std::vector<size_type>());
 	m_dom_count.push_back(0);
+	m_dom_stale.push_back(0);
 	// Resize individual's elements.
 	m_container.back().cur_x.resize(p_size);
 	m_container.back().cur_v.resize(p_size);
@@ -127,6 +129,8 @@ void racing_population::push_back_noeval(const decision_vector &x)
 	
 	// Set the individual.
 	set_x_noeval(m_container.size() - 1, x);
+	// The domination lists of the new individual are filled in lazily, once its fitness is known.
+	invalidate_dom(m_container.size() - 1);
 }
 
 
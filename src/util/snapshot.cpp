@@ -0,0 +1,615 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "../archipelago.h"
+#include "../exceptions.h"
+#include "../population.h"
+#include "../problem/base.h"
+#include "snapshot.h"
+
+namespace pagmo { namespace util {
+
+namespace {
+
+// Record layout (all sizes in bytes, native byte order):
+// magic (4), byte-order mark (4), version (2), flags (2), stream (4), population size (8), number of rows (8),
+// decision/fitness/constraint dimensions (4 each), champion flag (4), payload size (8).
+// The payload contains, padded to multiples of 8 bytes:
+// - for deltas, the positions of the rows (8 each),
+// - the columns cur_x, cur_v (rows * D doubles each), cur_f (rows * F), cur_c (rows * C),
+// - for compressed records, a bitmap of the rows whose best vectors coincide with the current ones,
+// - the columns best_x, best_f, best_c for all the rows (or for the rows not in the bitmap),
+// - the champion x, f, c (if the champion flag is set).
+const char magic[4] = {'P','G','S','R'};
+const boost::uint32_t bom = 0x01020304u;
+const std::size_t header_size = 56;
+// Flag bits stored in the header, on top of snapshot::flags_type.
+const boost::uint16_t delta_flag = 0x8000u;
+
+std::size_t padded(std::size_t n)
+{
+	return (n + 7u) & ~static_cast<std::size_t>(7u);
+}
+
+class record_writer
+{
+	public:
+		template <class T>
+		void put(const T &value)
+		{
+			const char *p = reinterpret_cast<const char *>(&value);
+			m_buffer.insert(m_buffer.end(),p,p + sizeof(T));
+		}
+		void put(const std::vector<double> &v, std::size_t size)
+		{
+			if (v.size() != size) {
+				pagmo_throw(value_error,"individual is not compatible with the dimensions of the population");
+			}
+			if (size) {
+				const char *p = reinterpret_cast<const char *>(&v[0]);
+				m_buffer.insert(m_buffer.end(),p,p + size * sizeof(double));
+			}
+		}
+		void put_bytes(const std::vector<char> &bytes)
+		{
+			m_buffer.insert(m_buffer.end(),bytes.begin(),bytes.end());
+			m_buffer.resize(padded(m_buffer.size()));
+		}
+		std::vector<char> &buffer()
+		{
+			return m_buffer;
+		}
+	private:
+		std::vector<char> m_buffer;
+};
+
+// Read values from a record, converting the byte order if needed.
+class record_reader
+{
+	public:
+		record_reader(const char *begin, const char *end):m_ptr(begin),m_end(end),m_swap(false) {}
+		void set_swap(bool swap)
+		{
+			m_swap = swap;
+		}
+		template <class T>
+		T get()
+		{
+			T retval;
+			read(reinterpret_cast<char *>(&retval),sizeof(T),sizeof(T));
+			return retval;
+		}
+		void get(std::vector<double> &v, std::size_t size)
+		{
+			v.resize(size);
+			if (size) {
+				read(reinterpret_cast<char *>(&v[0]),size * sizeof(double),sizeof(double));
+			}
+		}
+		const char *get_bytes(std::size_t size)
+		{
+			check(padded(size));
+			const char *retval = m_ptr;
+			m_ptr += padded(size);
+			return retval;
+		}
+		const char *position() const
+		{
+			return m_ptr;
+		}
+		void seek(const char *ptr)
+		{
+			m_ptr = ptr;
+		}
+		std::size_t remaining() const
+		{
+			return static_cast<std::size_t>(m_end - m_ptr);
+		}
+	private:
+		void check(std::size_t size) const
+		{
+			if (remaining() < size) {
+				pagmo_throw(value_error,"truncated snapshot record");
+			}
+		}
+		void read(char *out, std::size_t size, std::size_t word)
+		{
+			check(size);
+			std::memcpy(out,m_ptr,size);
+			m_ptr += size;
+			if (m_swap) {
+				for (std::size_t i = 0; i < size; i += word) {
+					std::reverse(out + i,out + i + word);
+				}
+			}
+		}
+
+		const char	*m_ptr;
+		const char	*m_end;
+		bool		m_swap;
+};
+
+bool same_best(const population::individual_type &ind)
+{
+	return ind.best_x == ind.cur_x && ind.best_f == ind.cur_f && ind.best_c == ind.cur_c;
+}
+
+}
+
+const boost::uint16_t snapshot::version;
+
+/// Check if two individuals differ.
+/**
+ * @param[in] a first individual.
+ * @param[in] b second individual.
+ *
+ * @return true if any of the vectors of a differs from the corresponding vector of b.
+ */
+bool snapshot::differs(const population::individual_type &a, const population::individual_type &b)
+{
+	return a.cur_x != b.cur_x || a.cur_v != b.cur_v || a.cur_f != b.cur_f || a.cur_c != b.cur_c ||
+		a.best_x != b.best_x || a.best_f != b.best_f || a.best_c != b.best_c;
+}
+
+/// Save a population.
+/**
+ * Appends to the stream a record containing the whole population.
+ *
+ * @param[out] os output stream (opened in binary mode).
+ * @param[in] pop population to be saved.
+ * @param[in] flags combination of snapshot::flags_type values.
+ * @param[in] stream identifier of the population among the records of the snapshot.
+ *
+ * @throws value_error if the vectors of an individual do not match the dimensions of the problem.
+ */
+void snapshot::save(std::ostream &os, const population &pop, unsigned int flags, boost::uint32_t stream)
+{
+	write(os,pop,0,flags,stream);
+}
+
+/// Save the changes of a population.
+/**
+ * Appends to the stream a record containing the individuals of cur differing from those of ref, and the champion of cur.
+ * If the sizes of the populations differ, cur is saved as a whole.
+ *
+ * @param[out] os output stream (opened in binary mode).
+ * @param[in] ref reference population (i.e., the state of the stream after the previous records).
+ * @param[in] cur population to be saved.
+ * @param[in] flags combination of snapshot::flags_type values.
+ * @param[in] stream identifier of the population among the records of the snapshot.
+ *
+ * @throws value_error if the vectors of an individual do not match the dimensions of the problem.
+ */
+void snapshot::save_delta(std::ostream &os, const population &ref, const population &cur, unsigned int flags, boost::uint32_t stream)
+{
+	if (ref.size() != cur.size()) {
+		write(os,cur,0,flags,stream);
+		return;
+	}
+	std::vector<population::size_type> rows;
+	for (population::size_type i = 0; i < cur.size(); ++i) {
+		if (differs(ref.get_individual(i),cur.get_individual(i))) {
+			rows.push_back(i);
+		}
+	}
+	write(os,cur,&rows,flags,stream);
+}
+
+void snapshot::write(std::ostream &os, const population &pop, const std::vector<population::size_type> *rows, unsigned int flags, boost::uint32_t stream)
+{
+	const problem::base &prob = pop.problem();
+	const boost::uint32_t d = boost::numeric_cast<boost::uint32_t>(prob.get_dimension()),
+		f = boost::numeric_cast<boost::uint32_t>(prob.get_f_dimension()),
+		c = boost::numeric_cast<boost::uint32_t>(prob.get_c_dimension());
+	const boost::uint64_t n_rows = rows ? rows->size() : pop.size();
+	const bool compressed = (flags & compress) != 0;
+	// Individuals to be written.
+	std::vector<const population::individual_type *> ind;
+	ind.reserve(n_rows);
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		ind.push_back(&pop.get_individual(rows ? (*rows)[i] : i));
+	}
+	const bool has_champion = pop.size() && pop.champion().x.size();
+	record_writer w;
+	w.buffer().insert(w.buffer().end(),magic,magic + 4);
+	w.put(bom);
+	w.put(version);
+	w.put(static_cast<boost::uint16_t>((compressed ? compress : none) | (rows ? delta_flag : 0)));
+	w.put(stream);
+	w.put(static_cast<boost::uint64_t>(pop.size()));
+	w.put(n_rows);
+	w.put(d);
+	w.put(f);
+	w.put(c);
+	w.put(static_cast<boost::uint32_t>(has_champion));
+	// The payload size is filled in at the end.
+	w.put(static_cast<boost::uint64_t>(0));
+	pagmo_assert(w.buffer().size() == header_size);
+	if (rows) {
+		for (std::size_t i = 0; i < n_rows; ++i) {
+			w.put(static_cast<boost::uint64_t>((*rows)[i]));
+		}
+	}
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		w.put(ind[i]->cur_x,d);
+	}
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		w.put(ind[i]->cur_v,d);
+	}
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		w.put(ind[i]->cur_f,f);
+	}
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		w.put(ind[i]->cur_c,c);
+	}
+	std::vector<char> bitmap;
+	if (compressed) {
+		bitmap.resize((n_rows + 7u) / 8u,0);
+		for (std::size_t i = 0; i < n_rows; ++i) {
+			if (same_best(*ind[i])) {
+				bitmap[i / 8u] = static_cast<char>(bitmap[i / 8u] | (1 << (i % 8u)));
+			}
+		}
+		w.put_bytes(bitmap);
+	}
+	std::vector<const population::individual_type *> best;
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		if (!compressed || !(bitmap[i / 8u] & (1 << (i % 8u)))) {
+			best.push_back(ind[i]);
+		}
+	}
+	for (std::size_t i = 0; i < best.size(); ++i) {
+		w.put(best[i]->best_x,d);
+	}
+	for (std::size_t i = 0; i < best.size(); ++i) {
+		w.put(best[i]->best_f,f);
+	}
+	for (std::size_t i = 0; i < best.size(); ++i) {
+		w.put(best[i]->best_c,c);
+	}
+	if (has_champion) {
+		w.put(pop.champion().x,d);
+		w.put(pop.champion().f,f);
+		w.put(pop.champion().c,c);
+	}
+	const boost::uint64_t payload_size = w.buffer().size() - header_size;
+	std::memcpy(&w.buffer()[header_size - sizeof(boost::uint64_t)],&payload_size,sizeof(boost::uint64_t));
+	os.write(&w.buffer()[0],boost::numeric_cast<std::streamsize>(w.buffer().size()));
+}
+
+/// Load populations from a buffer.
+/**
+ * Replays in order the records contained in the buffer, applying each record to the element of pops corresponding to its stream.
+ * The populations must have been constructed with the problems they are to be loaded into.
+ *
+ * @param[in] data pointer to the beginning of the buffer (e.g., a memory-mapped snapshot file).
+ * @param[in] size size of the buffer in bytes.
+ * @param[in,out] pops populations to be loaded.
+ *
+ * @return the number of records loaded.
+ *
+ * @throws value_error if the buffer does not contain valid records, or the records do not fit the problems of the populations.
+ * @throws index_error if a record refers to a stream not in pops.
+ */
+std::size_t snapshot::load(const char *data, std::size_t size, std::vector<population> &pops)
+{
+	std::vector<population *> ptrs;
+	for (std::size_t i = 0; i < pops.size(); ++i) {
+		ptrs.push_back(&pops[i]);
+	}
+	return load_records(data,size,ptrs);
+}
+
+std::size_t snapshot::load_records(const char *data, std::size_t size, const std::vector<population *> &pops)
+{
+	record_reader r(data,data + size);
+	std::size_t n_records = 0;
+	while (r.remaining()) {
+		if (r.remaining() < header_size || !std::equal(magic,magic + 4,r.position())) {
+			pagmo_throw(value_error,"invalid snapshot record");
+		}
+		r.seek(r.position() + 4);
+		const boost::uint32_t mark = r.get<boost::uint32_t>();
+		if (mark != bom) {
+			r.set_swap(true);
+			r.seek(r.position() - 4);
+			if (r.get<boost::uint32_t>() != bom) {
+				pagmo_throw(value_error,"invalid byte order mark in snapshot record");
+			}
+		}
+		if (r.get<boost::uint16_t>() > version) {
+			pagmo_throw(value_error,"snapshot record was written by a newer version of the format");
+		}
+		const boost::uint16_t flags = r.get<boost::uint16_t>();
+		const boost::uint32_t stream = r.get<boost::uint32_t>();
+		const boost::uint64_t pop_size = r.get<boost::uint64_t>(), n_rows = r.get<boost::uint64_t>();
+		const boost::uint32_t d = r.get<boost::uint32_t>(), f = r.get<boost::uint32_t>(), c = r.get<boost::uint32_t>();
+		const bool has_champion = r.get<boost::uint32_t>() != 0;
+		const boost::uint64_t payload_size = r.get<boost::uint64_t>();
+		if (r.remaining() < payload_size) {
+			pagmo_throw(value_error,"truncated snapshot record");
+		}
+		const char *next = r.position() + payload_size;
+		if (stream >= pops.size()) {
+			pagmo_throw(index_error,"snapshot record refers to an unknown population");
+		}
+		population &pop = *pops[stream];
+		if (d != pop.problem().get_dimension() || f != pop.problem().get_f_dimension() || c != pop.problem().get_c_dimension()) {
+			pagmo_throw(value_error,"snapshot record is not compatible with the problem of the population");
+		}
+		const bool delta = (flags & delta_flag) != 0;
+		const bool compressed = (flags & compress) != 0;
+		if (delta ? pop_size != pop.size() : n_rows != pop_size) {
+			pagmo_throw(value_error,"snapshot record is not compatible with the size of the population");
+		}
+		// Every row stores at least its current vectors (and its index in a delta), which are not empty as the dimension of the
+		// problem is positive: the header must not claim more rows than the payload can hold, so that a corrupted header cannot
+		// trigger huge allocations.
+		const boost::uint64_t row_bytes = (2u * static_cast<boost::uint64_t>(d) + f + c + (delta ? 1u : 0u)) * sizeof(double);
+		if (n_rows > payload_size / row_bytes) {
+			pagmo_throw(value_error,"inconsistent number of rows in snapshot record");
+		}
+		std::vector<population::size_type> rows(boost::numeric_cast<std::size_t>(n_rows));
+		for (std::size_t i = 0; i < rows.size(); ++i) {
+			rows[i] = delta ? boost::numeric_cast<population::size_type>(r.get<boost::uint64_t>()) : i;
+			if (rows[i] >= pop_size) {
+				pagmo_throw(value_error,"invalid row in snapshot record");
+			}
+		}
+		std::vector<population::individual_type> ind(rows.size());
+		for (std::size_t i = 0; i < ind.size(); ++i) {
+			r.get(ind[i].cur_x,d);
+		}
+		for (std::size_t i = 0; i < ind.size(); ++i) {
+			r.get(ind[i].cur_v,d);
+		}
+		for (std::size_t i = 0; i < ind.size(); ++i) {
+			r.get(ind[i].cur_f,f);
+		}
+		for (std::size_t i = 0; i < ind.size(); ++i) {
+			r.get(ind[i].cur_c,c);
+		}
+		const char *bitmap = compressed ? r.get_bytes((ind.size() + 7u) / 8u) : 0;
+		std::vector<population::individual_type *> best;
+		for (std::size_t i = 0; i < ind.size(); ++i) {
+			if (bitmap && (bitmap[i / 8u] & (1 << (i % 8u)))) {
+				ind[i].best_x = ind[i].cur_x;
+				ind[i].best_f = ind[i].cur_f;
+				ind[i].best_c = ind[i].cur_c;
+			} else {
+				best.push_back(&ind[i]);
+			}
+		}
+		for (std::size_t i = 0; i < best.size(); ++i) {
+			r.get(best[i]->best_x,d);
+		}
+		for (std::size_t i = 0; i < best.size(); ++i) {
+			r.get(best[i]->best_f,f);
+		}
+		for (std::size_t i = 0; i < best.size(); ++i) {
+			r.get(best[i]->best_c,c);
+		}
+		population::champion_type champion;
+		if (has_champion) {
+			r.get(champion.x,d);
+			r.get(champion.f,f);
+			r.get(champion.c,c);
+		}
+		if (r.position() != next) {
+			pagmo_throw(value_error,"inconsistent payload size in snapshot record");
+		}
+		// Everything was read successfully: apply the record.
+		if (!delta) {
+			population_access::reset(pop,rows.size());
+		}
+		for (std::size_t i = 0; i < ind.size(); ++i) {
+			population_access::set_individual(pop,rows[i],ind[i]);
+		}
+		if (has_champion) {
+			population_access::set_champion(pop,champion);
+		}
+		r.set_swap(false);
+		++n_records;
+	}
+	return n_records;
+}
+
+/// Load a population from a buffer.
+/**
+ * Equivalent to the previous method with a single population: all the records must belong to stream 0.
+ *
+ * @param[in] data pointer to the beginning of the buffer.
+ * @param[in] size size of the buffer in bytes.
+ * @param[in,out] pop population to be loaded.
+ *
+ * @return the number of records loaded.
+ */
+std::size_t snapshot::load(const char *data, std::size_t size, population &pop)
+{
+	return load_records(data,size,std::vector<population *>(1,&pop));
+}
+
+/// Load a population from a stream.
+/**
+ * Reads the stream until its end and loads the records it contains.
+ *
+ * @param[in] is input stream (opened in binary mode).
+ * @param[in,out] pop population to be loaded.
+ *
+ * @return the number of records loaded.
+ */
+std::size_t snapshot::load(std::istream &is, population &pop)
+{
+	const std::vector<char> buffer((std::istreambuf_iterator<char>(is)),std::istreambuf_iterator<char>());
+	return buffer.empty() ? 0 : load(&buffer[0],buffer.size(),pop);
+}
+
+/// Load populations from a file.
+/**
+ * The file is memory-mapped, and the records are read from the mapping without copying the file into a buffer first.
+ *
+ * @param[in] filename name of the snapshot file.
+ * @param[in,out] pops populations to be loaded.
+ *
+ * @return the number of records loaded.
+ *
+ * @throws value_error if the file cannot be mapped.
+ */
+std::size_t snapshot::load_file(const std::string &filename, std::vector<population> &pops)
+{
+	std::ifstream probe(filename.c_str(),std::ios::binary | std::ios::ate);
+	if (!probe) {
+		pagmo_throw(value_error,"cannot open snapshot file " + filename);
+	}
+	if (!probe.tellg()) {
+		return 0;
+	}
+	probe.close();
+	try {
+		const boost::interprocess::file_mapping file(filename.c_str(),boost::interprocess::read_only);
+		const boost::interprocess::mapped_region region(file,boost::interprocess::read_only);
+		return load(static_cast<const char *>(region.get_address()),region.get_size(),pops);
+	} catch (const boost::interprocess::interprocess_exception &e) {
+		pagmo_throw(value_error,std::string("cannot map snapshot file: ") + e.what());
+	}
+}
+
+/// Constructor.
+/**
+ * Creates (or truncates) the checkpoint file.
+ *
+ * @param[in] filename name of the checkpoint file.
+ * @param[in] flags combination of snapshot::flags_type values used for all the records.
+ *
+ * @throws value_error if the file cannot be opened.
+ */
+checkpoint::checkpoint(const std::string &filename, unsigned int flags):
+	m_file(filename.c_str(),std::ios::binary | std::ios::out | std::ios::trunc),m_flags(flags)
+{
+	if (!m_file) {
+		pagmo_throw(value_error,"cannot open checkpoint file " + filename);
+	}
+}
+
+/// Write the populations of an archipelago.
+/**
+ * The population of the i-th island is written to stream i.
+ *
+ * @param[in] a archipelago (joined before reading its populations).
+ */
+void checkpoint::write(const archipelago &a)
+{
+	a.join();
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		write(a.get_island(i)->get_population(),boost::numeric_cast<boost::uint32_t>(i));
+	}
+	flush();
+}
+
+/// Write a population.
+/**
+ * The population is written to stream 0.
+ *
+ * @param[in] pop population.
+ */
+void checkpoint::write(const population &pop)
+{
+	write(pop,0);
+	flush();
+}
+
+void checkpoint::write(const population &pop, boost::uint32_t stream)
+{
+	if (stream < m_last.size()) {
+		snapshot::save_delta(m_file,m_last[stream],pop,m_flags,stream);
+		m_last[stream] = pop;
+	} else {
+		pagmo_assert(stream == m_last.size());
+		snapshot::save(m_file,pop,m_flags,stream);
+		m_last.push_back(pop);
+	}
+}
+
+/// Flush the checkpoint file.
+/**
+ * @throws std::runtime_error if writing to the file failed.
+ */
+void checkpoint::flush()
+{
+	m_file.flush();
+	if (!m_file) {
+		pagmo_throw(std::runtime_error,"error writing checkpoint file");
+	}
+}
+
+/// Restore an archipelago.
+/**
+ * The populations of the islands are replaced by the ones stored in the checkpoint file. The islands must have
+ * been set up with the same problems as when the checkpoint was written.
+ *
+ * @param[in] filename name of the checkpoint file.
+ * @param[in,out] a archipelago to be restored.
+ */
+void checkpoint::restore(const std::string &filename, archipelago &a)
+{
+	a.join();
+	std::vector<base_island_ptr> islands = a.get_islands();
+	std::vector<population> pops;
+	for (std::size_t i = 0; i < islands.size(); ++i) {
+		pops.push_back(islands[i]->get_population());
+	}
+	snapshot::load_file(filename,pops);
+	for (std::size_t i = 0; i < islands.size(); ++i) {
+		islands[i]->set_population(pops[i]);
+		a.set_island(i,*islands[i]);
+	}
+}
+
+/// Restore a population.
+/**
+ * @param[in] filename name of the checkpoint file.
+ * @param[in,out] pop population to be restored.
+ */
+void checkpoint::restore(const std::string &filename, population &pop)
+{
+	std::vector<population> pops(1,pop);
+	snapshot::load_file(filename,pops);
+	pop = pops[0];
+}
+
+}}
@@ -0,0 +1,116 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_SNAPSHOT_H
+#define PAGMO_UTIL_SNAPSHOT_H
+
+#include <boost/cstdint.hpp>
+#include <boost/utility.hpp>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../config.h"
+#include "../population.h"
+
+namespace pagmo {
+
+class archipelago;
+
+namespace util {
+
+/// Binary columnar snapshots of populations.
+/**
+ * A snapshot is a sequence of records, each one storing the state of a population (or the changes of a population with respect to
+ * the previous record of the same stream) as contiguous arrays of doubles: the current decision, velocity, fitness and constraint
+ * vectors of all the individuals, followed by the best vectors and the champion. Compared to Boost.Serialization, saving and loading
+ * copy the arrays as they are instead of formatting each value. The arrays are aligned, so that they can be read directly from a
+ * memory-mapped file, but loading still copies them into the individuals.
+ *
+ * Each record starts with a fixed-size header (magic number, byte-order mark, format version, flags, stream identifier and sizes),
+ * so that records can be appended to a file and replayed in order. Records written on a machine with a different byte order are
+ * converted on load. The problem, the random number generators and the Pareto information of the population are not stored: a snapshot
+ * is loaded into a population which already knows its problem.
+ *
+ * With the compress flag, the best vectors of an individual are omitted when they coincide with the current ones (as it happens for most
+ * individuals of many algorithms).
+ *
+ * @see pagmo::util::checkpoint for incremental checkpoints of archipelagos.
+ */
+class __PAGMO_VISIBLE snapshot
+{
+	public:
+		/// Record flags.
+		enum flags_type {
+			/// Plain record.
+			none = 0,
+			/// Omit the best vectors coinciding with the current ones.
+			compress = 1
+		};
+		/// Version of the format.
+		static const boost::uint16_t version = 1;
+		static void save(std::ostream &, const population &, unsigned int = none, boost::uint32_t = 0);
+		static void save_delta(std::ostream &, const population &, const population &, unsigned int = none, boost::uint32_t = 0);
+		static std::size_t load(const char *, std::size_t, std::vector<population> &);
+		static std::size_t load(const char *, std::size_t, population &);
+		static std::size_t load(std::istream &, population &);
+		static std::size_t load_file(const std::string &, std::vector<population> &);
+		static bool differs(const population::individual_type &, const population::individual_type &);
+	private:
+		static void write(std::ostream &, const population &, const std::vector<population::size_type> *, unsigned int, boost::uint32_t);
+		static std::size_t load_records(const char *, std::size_t, const std::vector<population *> &);
+};
+
+/// Incremental checkpoints.
+/**
+ * Writes the populations of a pagmo::archipelago (or a single pagmo::population) to a snapshot file, appending only the individuals
+ * changed since the previous write: the first write of each population stores it as a whole, the following ones store deltas.
+ * The file is created (or truncated) on construction and flushed after each write, so that it can be restored at any moment with
+ * restore(), which memory-maps the file and replays its records.
+ *
+ * The checkpoint keeps a copy of the last populations written. To bound the size of the file, start a new checkpoint from time to time.
+ */
+class __PAGMO_VISIBLE checkpoint: private boost::noncopyable
+{
+	public:
+		explicit checkpoint(const std::string &, unsigned int = snapshot::none);
+		void write(const archipelago &);
+		void write(const population &);
+		void flush();
+		static void restore(const std::string &, archipelago &);
+		static void restore(const std::string &, population &);
+	private:
+		void write(const population &, boost::uint32_t);
+
+		std::ofstream		m_file;
+		unsigned int		m_flags;
+		std::vector<population>	m_last;
+};
+
+}}
+
+#endif
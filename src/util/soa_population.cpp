@@ -0,0 +1,212 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <vector>
+
+#include "../exceptions.h"
+#include "../population.h"
+#include "../problem/base.h"
+#include "soa_population.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Copy a vector into the i-th row of a matrix.
+void set_row(soa_population::matrix_type &m, soa_population::size_type i, const std::vector<double> &v)
+{
+	if (static_cast<soa_population::matrix_type::Index>(v.size()) != m.cols()) {
+		pagmo_throw(value_error,"individual is not compatible with the dimensions of the population");
+	}
+	std::copy(v.begin(),v.end(),m.data() + i * m.cols());
+}
+
+// Copy the i-th row of a matrix into a vector.
+void get_row(std::vector<double> &v, const soa_population::matrix_type &m, soa_population::size_type i)
+{
+	const double *begin = m.data() + i * m.cols();
+	v.assign(begin,begin + m.cols());
+}
+
+}
+
+/// Default constructor.
+/**
+ * Builds an empty store.
+ */
+soa_population::soa_population() {}
+
+/// Constructor from population.
+/**
+ * @param[in] pop population whose individuals will be copied into the store.
+ *
+ * @see load().
+ */
+soa_population::soa_population(const population &pop)
+{
+	load(pop);
+}
+
+/// Load a population.
+/**
+ * Resizes the matrices according to the size of the population and the dimensions of its problem, and copies the individuals and the
+ * champion into them. The memory already allocated is reused if the sizes do not change.
+ *
+ * @param[in] pop population to be loaded.
+ *
+ * @throws value_error if the vectors of an individual are not compatible with the dimensions of the problem.
+ */
+void soa_population::load(const population &pop)
+{
+	const size_type n = pop.size();
+	const problem::base &prob = pop.problem();
+	const matrix_type::Index d = prob.get_dimension(), f = prob.get_f_dimension(), c = prob.get_c_dimension();
+	cur_x.resize(n,d);
+	cur_v.resize(n,d);
+	cur_c.resize(n,c);
+	cur_f.resize(n,f);
+	best_x.resize(n,d);
+	best_c.resize(n,c);
+	best_f.resize(n,f);
+	for (size_type i = 0; i < n; ++i) {
+		const population::individual_type &ind = pop.get_individual(i);
+		set_row(cur_x,i,ind.cur_x);
+		set_row(cur_v,i,ind.cur_v);
+		set_row(cur_c,i,ind.cur_c);
+		set_row(cur_f,i,ind.cur_f);
+		set_row(best_x,i,ind.best_x);
+		set_row(best_c,i,ind.best_c);
+		set_row(best_f,i,ind.best_f);
+	}
+	champion = pop.champion();
+}
+
+/// Store into a population.
+/**
+ * Copies the individuals and the champion of the store into the population, without evaluating them: the vectors are copied
+ * as they are. If the size of the population differs from the size of the store, the population is resized.
+ *
+ * @param[in,out] pop population where the individuals will be stored.
+ *
+ * @throws value_error if the dimensions of the matrices are not compatible with the problem of the population.
+ */
+void soa_population::store(population &pop) const
+{
+	const problem::base &prob = pop.problem();
+	if (cur_x.cols() != static_cast<matrix_type::Index>(prob.get_dimension()) || cur_f.cols() != static_cast<matrix_type::Index>(prob.get_f_dimension())
+		|| cur_c.cols() != static_cast<matrix_type::Index>(prob.get_c_dimension()))
+	{
+		pagmo_throw(value_error,"the store is not compatible with the problem of the population");
+	}
+	const size_type n = size();
+	if (pop.size() != n) {
+		population_access::reset(pop,n);
+	}
+	for (size_type i = 0; i < n; ++i) {
+		population::individual_type &ind = population_access::get_individual(pop,i);
+		get_row(ind.cur_x,cur_x,i);
+		get_row(ind.cur_v,cur_v,i);
+		get_row(ind.cur_c,cur_c,i);
+		get_row(ind.cur_f,cur_f,i);
+		get_row(ind.best_x,best_x,i);
+		get_row(ind.best_c,best_c,i);
+		get_row(ind.best_f,best_f,i);
+	}
+	population_access::set_champion(pop,champion);
+}
+
+/// Size of the store.
+/**
+ * @return the number of individuals in the store.
+ */
+soa_population::size_type soa_population::size() const
+{
+	return static_cast<size_type>(cur_x.rows());
+}
+
+/// Individual access.
+/**
+ * @param[in] i index of the individual.
+ *
+ * @return views of the rows of the i-th individual.
+ *
+ * @throws index_error if i is out of range.
+ */
+soa_population::individual_view soa_population::operator[](const size_type &i)
+{
+	const individual_view retval = {row(cur_x,i),row(cur_v,i),row(cur_c,i),row(cur_f,i),row(best_x,i),row(best_c,i),row(best_f,i)};
+	return retval;
+}
+
+/// Constant individual access.
+/**
+ * @param[in] i index of the individual.
+ *
+ * @return constant views of the rows of the i-th individual.
+ *
+ * @throws index_error if i is out of range.
+ */
+soa_population::const_individual_view soa_population::operator[](const size_type &i) const
+{
+	const const_individual_view retval = {row(cur_x,i),row(cur_v,i),row(cur_c,i),row(cur_f,i),row(best_x,i),row(best_c,i),row(best_f,i)};
+	return retval;
+}
+
+/// Row access.
+/**
+ * @param[in] m matrix.
+ * @param[in] i index of the row.
+ *
+ * @return a view of the i-th row of m, which can be used as an Eigen row vector.
+ *
+ * @throws index_error if i is out of range.
+ */
+soa_population::row_type soa_population::row(matrix_type &m, const size_type &i)
+{
+	if (static_cast<matrix_type::Index>(i) >= m.rows()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	return row_type(m.data() + i * m.cols(),m.cols());
+}
+
+/// Constant row access.
+/**
+ * @param[in] m matrix.
+ * @param[in] i index of the row.
+ *
+ * @return a constant view of the i-th row of m.
+ *
+ * @throws index_error if i is out of range.
+ */
+soa_population::const_row_type soa_population::row(const matrix_type &m, const size_type &i)
+{
+	if (static_cast<matrix_type::Index>(i) >= m.rows()) {
+		pagmo_throw(index_error,"invalid individual position");
+	}
+	return const_row_type(m.data() + i * m.cols(),m.cols());
+}
+
+}}
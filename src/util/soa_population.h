@@ -0,0 +1,110 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_SOA_POPULATION_H
+#define PAGMO_UTIL_SOA_POPULATION_H
+
+#include "../config.h"
+#include "../Eigen/Dense"
+#include "../population.h"
+
+namespace pagmo{ namespace util {
+
+/// Structure-of-arrays storage of the individuals of a population.
+/**
+ * Stores the vectors of the individuals of a pagmo::population as rows of contiguous, row-major Eigen matrices (one matrix per kind
+ * of vector, e.g., cur_x is an N x D matrix), so that whole populations can be processed by vectorised code without per-individual
+ * allocations. Rows can be accessed as Eigen maps (lightweight views that behave like vectors) through operator[], either one by one
+ * or grouped in an individual view.
+ *
+ * The store is filled from a population with load() (or the constructor) and written back with store(). The matrices can be
+ * manipulated freely in between, but the store is not tied to the population: the population does not see the changes until store() is called.
+ */
+class __PAGMO_VISIBLE soa_population
+{
+	public:
+		/// Matrix type.
+		typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> matrix_type;
+		/// Mutable view of a row.
+		typedef Eigen::Map<Eigen::Matrix<double,1,Eigen::Dynamic> > row_type;
+		/// Constant view of a row.
+		typedef Eigen::Map<const Eigen::Matrix<double,1,Eigen::Dynamic> > const_row_type;
+		/// Size type.
+		typedef population::size_type size_type;
+		/// View of the vectors of an individual.
+		template <class Row>
+		struct basic_individual_view
+		{
+			/// Current decision vector.
+			Row	cur_x;
+			/// Current velocity vector.
+			Row	cur_v;
+			/// Current constraint vector.
+			Row	cur_c;
+			/// Current fitness vector.
+			Row	cur_f;
+			/// Best decision vector so far.
+			Row	best_x;
+			/// Best constraint vector so far.
+			Row	best_c;
+			/// Best fitness vector so far.
+			Row	best_f;
+		};
+		/// Mutable view of an individual.
+		typedef basic_individual_view<row_type> individual_view;
+		/// Constant view of an individual.
+		typedef basic_individual_view<const_row_type> const_individual_view;
+
+		soa_population();
+		explicit soa_population(const population &);
+		void load(const population &);
+		void store(population &) const;
+		size_type size() const;
+		individual_view operator[](const size_type &);
+		const_individual_view operator[](const size_type &) const;
+		static row_type row(matrix_type &, const size_type &);
+		static const_row_type row(const matrix_type &, const size_type &);
+
+		/// Current decision vectors.
+		matrix_type			cur_x;
+		/// Current velocity vectors.
+		matrix_type			cur_v;
+		/// Current constraint vectors.
+		matrix_type			cur_c;
+		/// Current fitness vectors.
+		matrix_type			cur_f;
+		/// Best decision vectors.
+		matrix_type			best_x;
+		/// Best constraint vectors.
+		matrix_type			best_c;
+		/// Best fitness vectors.
+		matrix_type			best_f;
+		/// Champion.
+		population::champion_type	champion;
+};
+
+}}
+
+#endif
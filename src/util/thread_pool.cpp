@@ -0,0 +1,218 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <stdexcept>
+
+#include "../exceptions.h"
+#include "thread_pool.h"
+
+namespace pagmo{ namespace util {
+
+// Bookkeeping for a single call to parallel_for().
+struct thread_pool::batch
+{
+	batch(const body_type &f):m_body(f),m_pending(0) {}
+	const body_type		&m_body;
+	// Number of tasks not completed yet.
+	std::size_t		m_pending;
+	// First exception thrown by the body, if any.
+	std::exception_ptr	m_error;
+};
+
+/// Constructor from number of threads.
+/**
+ * @param[in] n number of threads in the pool, including the calling thread. If zero, default_size() will be used.
+ *
+ * @throws std::runtime_error if the worker threads cannot be launched.
+ */
+thread_pool::thread_pool(unsigned int n):m_size(n ? n : default_size()),m_stop(false)
+{
+	try {
+		for (unsigned int i = 1; i < m_size; ++i) {
+			m_workers.create_thread(boost::bind(&thread_pool::worker_loop,this));
+		}
+	} catch (...) {
+		{
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_cond.notify_all();
+		m_workers.join_all();
+		pagmo_throw(std::runtime_error,"failed to launch the worker threads");
+	}
+}
+
+/// Destructor.
+/**
+ * Will wait for the worker threads to finish their current work and join them.
+ */
+thread_pool::~thread_pool()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cond.notify_all();
+	m_workers.join_all();
+}
+
+/// Number of threads.
+/**
+ * @return the number of threads in the pool, calling thread included.
+ */
+unsigned int thread_pool::get_size() const
+{
+	return m_size;
+}
+
+/// Default number of threads.
+/**
+ * @return the number of hardware threads available on the machine, or one if it cannot be determined.
+ */
+unsigned int thread_pool::default_size()
+{
+	const unsigned int n = boost::thread::hardware_concurrency();
+	return n ? n : 1u;
+}
+
+/// Shared pool.
+/**
+ * Returns a process-wide pool of the requested size, created on the first request and kept until the end of the program, so that
+ * code running short parallel loops without owning a pool (e.g., the hypervolume algorithms, which are constructed for each
+ * computation) does not launch new threads every time. All the callers asking for the same size share the same pool, which is
+ * safe as parallel_for() can be called concurrently.
+ *
+ * @param[in] n number of threads in the pool. If zero, default_size() will be used.
+ *
+ * @return reference to the shared pool of size n.
+ *
+ * @throws std::runtime_error if the worker threads cannot be launched.
+ */
+thread_pool &thread_pool::shared(unsigned int n)
+{
+	static boost::mutex mutex;
+	static std::map<unsigned int,boost::shared_ptr<thread_pool> > pools;
+	if (!n) {
+		n = default_size();
+	}
+	boost::lock_guard<boost::mutex> lock(mutex);
+	boost::shared_ptr<thread_pool> &pool = pools[n];
+	if (!pool) {
+		pool.reset(new thread_pool(n));
+	}
+	return *pool;
+}
+
+/// Run a functor over a range of indices.
+/**
+ * Call f(i) for each i in [0,n[, distributing the calls among the threads of the pool, and return when all calls have completed.
+ * The order in which the indices are processed is unspecified, so f must only write to locations that depend on its argument.
+ * If any of the calls throws, the remaining ones are still performed and the first exception is re-thrown in the calling thread.
+ *
+ * @param[in] n number of indices.
+ * @param[in] f functor to be called on each index.
+ */
+void thread_pool::parallel_for(std::size_t n, const body_type &f)
+{
+	if (n == 0) {
+		return;
+	}
+	if (m_size == 1 || n == 1) {
+		for (std::size_t i = 0; i < n; ++i) {
+			f(i);
+		}
+		return;
+	}
+	// Split the range in a few chunks per thread, so that uneven costs get balanced without paying the locking cost for each index.
+	const std::size_t n_chunks = std::min<std::size_t>(n,static_cast<std::size_t>(m_size) * 4u);
+	batch b(f);
+	boost::unique_lock<boost::mutex> lock(m_mutex);
+	for (std::size_t i = 0; i < n_chunks; ++i) {
+		const task t = {&b,(n * i) / n_chunks,(n * (i + 1)) / n_chunks};
+		m_tasks.push_back(t);
+	}
+	b.m_pending = n_chunks;
+	m_cond.notify_all();
+	// Help with the queued work until our own batch has completed.
+	while (b.m_pending) {
+		if (m_tasks.empty()) {
+			m_cond.wait(lock);
+		} else {
+			const task t = m_tasks.front();
+			m_tasks.pop_front();
+			run_task(t,lock);
+		}
+	}
+	lock.unlock();
+	if (b.m_error) {
+		std::rethrow_exception(b.m_error);
+	}
+}
+
+// Run a task with the mutex unlocked, and record its completion.
+void thread_pool::run_task(const task &t, boost::unique_lock<boost::mutex> &lock)
+{
+	std::exception_ptr error;
+	lock.unlock();
+	try {
+		for (std::size_t i = t.m_begin; i < t.m_end; ++i) {
+			t.m_batch->m_body(i);
+		}
+	} catch (...) {
+		error = std::current_exception();
+	}
+	lock.lock();
+	if (error && !t.m_batch->m_error) {
+		t.m_batch->m_error = error;
+	}
+	if (--t.m_batch->m_pending == 0) {
+		m_cond.notify_all();
+	}
+}
+
+void thread_pool::worker_loop()
+{
+	boost::unique_lock<boost::mutex> lock(m_mutex);
+	while (true) {
+		while (!m_stop && m_tasks.empty()) {
+			m_cond.wait(lock);
+		}
+		if (m_tasks.empty()) {
+			// Stop has been requested and there is no work left.
+			return;
+		}
+		const task t = m_tasks.front();
+		m_tasks.pop_front();
+		run_task(t,lock);
+	}
+}
+
+}}
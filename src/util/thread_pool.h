@@ -0,0 +1,84 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_THREAD_POOL_H
+#define PAGMO_UTIL_THREAD_POOL_H
+
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <deque>
+#include <exception>
+
+#include "../config.h"
+
+namespace pagmo{ namespace util {
+
+/// Fixed-size pool of threads.
+/**
+ * The pool is constructed with a number of threads n: n - 1 worker threads are spawned at construction and live
+ * until the pool is destroyed, while the thread calling parallel_for() acts as the n-th one. A pool of size one
+ * thus runs everything in the calling thread.
+ *
+ * parallel_for() can be called concurrently from several threads on the same pool (e.g., from the evolution threads
+ * of different islands sharing a problem). A thread waiting for its own work to complete keeps executing queued work,
+ * so that nested or concurrent calls cannot deadlock.
+ */
+class __PAGMO_VISIBLE thread_pool: private boost::noncopyable
+{
+	public:
+		/// Type of the functor executed by parallel_for().
+		typedef boost::function<void (std::size_t)> body_type;
+		explicit thread_pool(unsigned int = 0);
+		~thread_pool();
+		unsigned int get_size() const;
+		void parallel_for(std::size_t, const body_type &);
+		static unsigned int default_size();
+		static thread_pool &shared(unsigned int = 0);
+	private:
+		struct batch;
+		// A contiguous range of indices of a batch.
+		struct task
+		{
+			batch		*m_batch;
+			std::size_t	m_begin;
+			std::size_t	m_end;
+		};
+		void worker_loop();
+		void run_task(const task &, boost::unique_lock<boost::mutex> &);
+
+		const unsigned int		m_size;
+		boost::mutex			m_mutex;
+		boost::condition_variable	m_cond;
+		std::deque<task>		m_tasks;
+		bool				m_stop;
+		boost::thread_group		m_workers;
+};
+
+}}
+
+#endif
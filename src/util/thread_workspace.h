@@ -0,0 +1,96 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_THREAD_WORKSPACE_H
+#define PAGMO_UTIL_THREAD_WORKSPACE_H
+
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+namespace pagmo{ namespace util {
+
+/// Per-thread scratch workspace.
+/**
+ * Gives access to an object of type W kept by the calling thread across calls, so that kernels called very often can reuse its
+ * buffers instead of allocating them on every call. The object is lent for the lifetime of the thread_workspace: if the
+ * thread's object is already lent (e.g., when the kernel is reentered), a new object is built for the occasion instead.
+ * W must be default-constructible, and should be left in a reusable state by its users (buffers are not cleared here).
+ */
+template <class W>
+class thread_workspace: private boost::noncopyable
+{
+	public:
+		/// Constructor.
+		/**
+		 * Borrows the thread's workspace, or builds a private one if it is already in use.
+		 */
+		thread_workspace():m_own(),m_ptr(0)
+		{
+			if (busy()) {
+				m_own.reset(new W());
+				m_ptr = m_own.get();
+			} else {
+				busy() = true;
+				m_ptr = &local();
+			}
+		}
+		/// Destructor.
+		/**
+		 * Gives the thread's workspace back.
+		 */
+		~thread_workspace()
+		{
+			if (!m_own) {
+				busy() = false;
+			}
+		}
+		/// Dereference.
+		W &operator*() const
+		{
+			return *m_ptr;
+		}
+		/// Member access.
+		W *operator->() const
+		{
+			return m_ptr;
+		}
+	private:
+		static W &local()
+		{
+			static thread_local W w;
+			return w;
+		}
+		static bool &busy()
+		{
+			static thread_local bool b = false;
+			return b;
+		}
+		boost::scoped_ptr<W>	m_own;
+		W			*m_ptr;
+};
+
+}}
+
+#endif
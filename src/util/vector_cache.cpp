@@ -0,0 +1,370 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../exceptions.h"
+#include "vector_cache.h"
+
+namespace pagmo{ namespace util {
+
+/// Constructor.
+/**
+ * @param[in] capacity maximum number of entries stored in the cache (0 disables the cache).
+ * @param[in] eviction eviction policy.
+ */
+vector_cache::vector_cache(std::size_t capacity, eviction_type eviction):
+	m_capacity(capacity),m_eviction(eviction),m_hits(0),m_misses(0)
+{
+	init_table();
+}
+
+/// Copy constructor.
+vector_cache::vector_cache(const vector_cache &other)
+{
+	boost::mutex::scoped_lock lock(other.m_mutex);
+	m_capacity = other.m_capacity;
+	m_eviction = other.m_eviction;
+	m_entries = other.m_entries;
+	m_table = other.m_table;
+	m_head = other.m_head;
+	m_tail = other.m_tail;
+	m_hand = other.m_hand;
+	m_hits = other.m_hits;
+	m_misses = other.m_misses;
+}
+
+/// Assignment operator.
+vector_cache &vector_cache::operator=(const vector_cache &other)
+{
+	if (this != &other) {
+		vector_cache tmp(other);
+		boost::mutex::scoped_lock lock(m_mutex);
+		swap(tmp);
+	}
+	return *this;
+}
+
+/// Look up a key.
+/**
+ * If key is in the cache, its value is copied into value, the entry is marked as recently used and true is returned.
+ * Otherwise value is left untouched and false is returned.
+ *
+ * @param[out] value vector into which the cached value will be copied.
+ * @param[in] key key to look for.
+ *
+ * @return true if key was found in the cache.
+ */
+bool vector_cache::find(std::vector<double> &value, const std::vector<double> &key)
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	if (!m_capacity) {
+		++m_misses;
+		return false;
+	}
+	const std::size_t pos = probe(key,boost::hash_range(key.begin(),key.end()));
+	if (!m_table[pos]) {
+		++m_misses;
+		return false;
+	}
+	const std::size_t idx = m_table[pos] - 1;
+	value = m_entries[idx].m_value;
+	if (m_eviction == lru) {
+		unlink(idx);
+		push_front(idx);
+	} else {
+		m_entries[idx].m_referenced = true;
+	}
+	++m_hits;
+	return true;
+}
+
+/// Insert a key-value pair.
+/**
+ * If the key is already present its value is replaced. If the cache is full, an entry is evicted first.
+ *
+ * @param[in] key key to be inserted.
+ * @param[in] value value associated to key.
+ */
+void vector_cache::insert(const std::vector<double> &key, const std::vector<double> &value)
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	if (!m_capacity) {
+		return;
+	}
+	const std::size_t hash = boost::hash_range(key.begin(),key.end());
+	std::size_t pos = probe(key,hash), idx;
+	if (m_table[pos]) {
+		idx = m_table[pos] - 1;
+		m_entries[idx].m_value = value;
+		if (m_eviction == lru) {
+			unlink(idx);
+			push_front(idx);
+		}
+		return;
+	}
+	if (m_entries.size() < m_capacity) {
+		m_entries.push_back(entry());
+		idx = m_entries.size() - 1;
+	} else {
+		// Evicting shifts the content of the table, the slot needs to be looked up again.
+		idx = evict();
+		pos = probe(key,hash);
+	}
+	entry &e = m_entries[idx];
+	e.m_key = key;
+	e.m_value = value;
+	e.m_hash = hash;
+	e.m_referenced = false;
+	m_table[pos] = idx + 1;
+	if (m_eviction == lru) {
+		push_front(idx);
+	}
+}
+
+/// Remove all the entries.
+/**
+ * Capacity, eviction policy and hit/miss counters are preserved.
+ */
+void vector_cache::clear()
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	init_table();
+}
+
+/// Set capacity and eviction policy.
+/**
+ * The content of the cache is discarded.
+ *
+ * @param[in] capacity maximum number of entries stored in the cache (0 disables the cache).
+ * @param[in] eviction eviction policy.
+ */
+void vector_cache::set_capacity(std::size_t capacity, eviction_type eviction)
+{
+	if (eviction != lru && eviction != clock) {
+		pagmo_throw(value_error,"invalid eviction policy");
+	}
+	boost::mutex::scoped_lock lock(m_mutex);
+	m_capacity = capacity;
+	m_eviction = eviction;
+	init_table();
+}
+
+/// Get capacity.
+/**
+ * @return maximum number of entries stored in the cache.
+ */
+std::size_t vector_cache::get_capacity() const
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	return m_capacity;
+}
+
+/// Get eviction policy.
+/**
+ * @return the eviction policy of the cache.
+ */
+vector_cache::eviction_type vector_cache::get_eviction() const
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	return m_eviction;
+}
+
+/// Get size.
+/**
+ * @return number of entries currently stored in the cache.
+ */
+std::size_t vector_cache::get_size() const
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	return m_entries.size();
+}
+
+/// Get number of hits.
+/**
+ * @return number of successful calls to find().
+ */
+std::size_t vector_cache::get_hits() const
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	return m_hits;
+}
+
+/// Get number of misses.
+/**
+ * @return number of unsuccessful calls to find().
+ */
+std::size_t vector_cache::get_misses() const
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	return m_misses;
+}
+
+/// Reset the hit/miss counters.
+void vector_cache::reset_counters()
+{
+	boost::mutex::scoped_lock lock(m_mutex);
+	m_hits = 0;
+	m_misses = 0;
+}
+
+// Empty the cache and size the table for the current capacity.
+void vector_cache::init_table()
+{
+	std::size_t table_size = 0;
+	if (m_capacity) {
+		table_size = 1;
+		while (table_size < 2 * m_capacity) {
+			table_size <<= 1;
+		}
+	}
+	std::vector<entry>().swap(m_entries);
+	m_table.assign(table_size,0);
+	m_head = npos;
+	m_tail = npos;
+	m_hand = 0;
+}
+
+// Position in the table of the slot holding key, or of the empty slot where key would be inserted.
+std::size_t vector_cache::probe(const std::vector<double> &key, std::size_t hash) const
+{
+	const std::size_t mask = m_table.size() - 1;
+	std::size_t pos = hash & mask;
+	while (m_table[pos]) {
+		const entry &e = m_entries[m_table[pos] - 1];
+		if (e.m_hash == hash && e.m_key == key) {
+			break;
+		}
+		pos = (pos + 1) & mask;
+	}
+	return pos;
+}
+
+// Empty the slot at position pos, shifting back the following slots of the cluster so that
+// no tombstones are needed.
+void vector_cache::erase_slot(std::size_t pos)
+{
+	const std::size_t mask = m_table.size() - 1;
+	std::size_t next = pos;
+	while (true) {
+		m_table[pos] = 0;
+		while (true) {
+			next = (next + 1) & mask;
+			if (!m_table[next]) {
+				return;
+			}
+			const std::size_t home = m_entries[m_table[next] - 1].m_hash & mask;
+			// The entry in next can be moved to pos only if its home slot does not lie cyclically in (pos,next].
+			const bool stays = (pos <= next) ? (pos < home && home <= next) : (pos < home || home <= next);
+			if (!stays) {
+				break;
+			}
+		}
+		m_table[pos] = m_table[next];
+		pos = next;
+	}
+}
+
+// Remove an entry according to the eviction policy and return its index.
+std::size_t vector_cache::evict()
+{
+	pagmo_assert(m_entries.size() == m_capacity && m_capacity);
+	std::size_t idx;
+	if (m_eviction == lru) {
+		idx = m_tail;
+		unlink(idx);
+	} else {
+		while (m_entries[m_hand].m_referenced) {
+			m_entries[m_hand].m_referenced = false;
+			m_hand = (m_hand + 1) % m_entries.size();
+		}
+		idx = m_hand;
+		m_hand = (m_hand + 1) % m_entries.size();
+	}
+	erase_slot(probe(m_entries[idx].m_key,m_entries[idx].m_hash));
+	return idx;
+}
+
+void vector_cache::unlink(std::size_t idx)
+{
+	entry &e = m_entries[idx];
+	if (e.m_prev == npos) {
+		m_head = e.m_next;
+	} else {
+		m_entries[e.m_prev].m_next = e.m_next;
+	}
+	if (e.m_next == npos) {
+		m_tail = e.m_prev;
+	} else {
+		m_entries[e.m_next].m_prev = e.m_prev;
+	}
+}
+
+void vector_cache::push_front(std::size_t idx)
+{
+	entry &e = m_entries[idx];
+	e.m_prev = npos;
+	e.m_next = m_head;
+	if (m_head == npos) {
+		m_tail = idx;
+	} else {
+		m_entries[m_head].m_prev = idx;
+	}
+	m_head = idx;
+}
+
+void vector_cache::swap(vector_cache &other)
+{
+	std::swap(m_capacity,other.m_capacity);
+	std::swap(m_eviction,other.m_eviction);
+	m_entries.swap(other.m_entries);
+	m_table.swap(other.m_table);
+	std::swap(m_head,other.m_head);
+	std::swap(m_tail,other.m_tail);
+	std::swap(m_hand,other.m_hand);
+	std::swap(m_hits,other.m_hits);
+	std::swap(m_misses,other.m_misses);
+}
+
+std::vector<std::size_t> vector_cache::eviction_order() const
+{
+	std::vector<std::size_t> retval;
+	retval.reserve(m_entries.size());
+	if (m_eviction == lru) {
+		for (std::size_t idx = m_tail; idx != npos; idx = m_entries[idx].m_prev) {
+			retval.push_back(idx);
+		}
+	} else {
+		for (std::size_t i = 0; i < m_entries.size(); ++i) {
+			retval.push_back((m_hand + i) % m_entries.size());
+		}
+	}
+	return retval;
+}
+
+}}
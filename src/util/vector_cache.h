@@ -0,0 +1,152 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+#ifndef PAGMO_UTIL_VECTOR_CACHE_H
+#define PAGMO_UTIL_VECTOR_CACHE_H
+
+#include <boost/thread/mutex.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "../config.h"
+#include "../serialization.h"
+
+namespace pagmo{ namespace util {
+
+/// Bounded cache mapping vectors of doubles to vectors of doubles.
+/**
+ * This is the cache used by pagmo::problem::base to remember recently computed fitness and constraint vectors.
+ * Keys are hashed into an open-addressing table (linear probing, load factor at most 1/2), so that lookups cost
+ * O(D) regardless of the capacity. When the cache is full, an entry is evicted according to the chosen policy:
+ * - lru: the least recently used entry is discarded,
+ * - clock: the CLOCK approximation of LRU is used (a hit only sets a reference bit, no list manipulation is needed).
+ *
+ * A capacity of zero disables the cache. The number of hits and misses is recorded. All the methods can be called
+ * concurrently from different threads.
+ */
+class __PAGMO_VISIBLE vector_cache
+{
+	public:
+		/// Eviction policy.
+		enum eviction_type {
+			/// Least recently used.
+			lru,
+			/// CLOCK (second chance).
+			clock
+		};
+		explicit vector_cache(std::size_t = 0, eviction_type = lru);
+		vector_cache(const vector_cache &);
+		vector_cache &operator=(const vector_cache &);
+		bool find(std::vector<double> &, const std::vector<double> &);
+		void insert(const std::vector<double> &, const std::vector<double> &);
+		void clear();
+		void set_capacity(std::size_t, eviction_type = lru);
+		std::size_t get_capacity() const;
+		eviction_type get_eviction() const;
+		std::size_t get_size() const;
+		std::size_t get_hits() const;
+		std::size_t get_misses() const;
+		void reset_counters();
+	private:
+		struct entry
+		{
+			std::vector<double>	m_key;
+			std::vector<double>	m_value;
+			std::size_t		m_hash;
+			// Links in the LRU list.
+			std::size_t		m_prev;
+			std::size_t		m_next;
+			// Reference bit for the CLOCK policy.
+			bool			m_referenced;
+		};
+		static const std::size_t npos = static_cast<std::size_t>(-1);
+		void init_table();
+		std::size_t probe(const std::vector<double> &, std::size_t) const;
+		void erase_slot(std::size_t);
+		std::size_t evict();
+		void unlink(std::size_t);
+		void push_front(std::size_t);
+		void swap(vector_cache &);
+		// Entries in the order in which they must be re-inserted to rebuild the cache.
+		std::vector<std::size_t> eviction_order() const;
+
+		friend class boost::serialization::access;
+		template <class Archive>
+		void save(Archive &ar, const unsigned int version) const
+		{
+			boost::mutex::scoped_lock lock(m_mutex);
+			ar << m_capacity;
+			const int eviction = static_cast<int>(m_eviction);
+			ar << eviction;
+			ar << m_hits;
+			ar << m_misses;
+			const std::vector<std::size_t> order = eviction_order();
+			const std::size_t size = order.size();
+			ar << size;
+			for (std::size_t i = 0; i < size; ++i) {
+				custom_vector_double_save(ar,m_entries[order[i]].m_key,version);
+				custom_vector_double_save(ar,m_entries[order[i]].m_value,version);
+			}
+		}
+		template <class Archive>
+		void load(Archive &ar, const unsigned int version)
+		{
+			std::size_t capacity, hits, misses, size;
+			int eviction;
+			ar >> capacity;
+			ar >> eviction;
+			ar >> hits;
+			ar >> misses;
+			set_capacity(capacity,static_cast<eviction_type>(eviction));
+			ar >> size;
+			std::vector<double> key, value;
+			for (std::size_t i = 0; i < size; ++i) {
+				custom_vector_double_load(ar,key,version);
+				custom_vector_double_load(ar,value,version);
+				insert(key,value);
+			}
+			boost::mutex::scoped_lock lock(m_mutex);
+			m_hits = hits;
+			m_misses = misses;
+		}
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+		std::size_t			m_capacity;
+		eviction_type			m_eviction;
+		std::vector<entry>		m_entries;
+		// Open-addressing table: 0 marks an empty slot, otherwise the slot holds the index of an entry plus one.
+		std::vector<std::size_t>	m_table;
+		// Most and least recently used entries (LRU).
+		std::size_t			m_head;
+		std::size_t			m_tail;
+		// Position of the hand (CLOCK).
+		std::size_t			m_hand;
+		std::size_t			m_hits;
+		std::size_t			m_misses;
+		mutable boost::mutex		m_mutex;
+};
+
+}}
+
+#endif
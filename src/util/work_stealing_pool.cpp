@@ -0,0 +1,162 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#include <boost/bind.hpp>
+#include <boost/thread/locks.hpp>
+#include <stdexcept>
+
+#include "../exceptions.h"
+#include "thread_pool.h"
+#include "work_stealing_pool.h"
+
+namespace pagmo{ namespace util {
+
+namespace {
+
+// Pool and queue index of the worker running in the current thread, if any.
+thread_local const work_stealing_pool *current_pool = 0;
+thread_local unsigned int current_queue = 0;
+
+}
+
+/// Constructor from number of threads.
+/**
+ * @param[in] n number of worker threads. If zero, thread_pool::default_size() will be used.
+ *
+ * @throws std::runtime_error if the worker threads cannot be launched.
+ */
+work_stealing_pool::work_stealing_pool(unsigned int n):m_size(n ? n : thread_pool::default_size()),m_queues(new worker_queue[m_size]),
+	m_queued(0),m_next_queue(0),m_stop(false)
+{
+	try {
+		for (unsigned int i = 0; i < m_size; ++i) {
+			m_workers.create_thread(boost::bind(&work_stealing_pool::worker_loop,this,i));
+		}
+	} catch (...) {
+		stop();
+		pagmo_throw(std::runtime_error,"failed to launch the worker threads");
+	}
+}
+
+/// Destructor.
+/**
+ * Will wait for all the submitted tasks to be executed and join the worker threads.
+ */
+work_stealing_pool::~work_stealing_pool()
+{
+	stop();
+}
+
+/// Number of threads.
+/**
+ * @return the number of worker threads.
+ */
+unsigned int work_stealing_pool::get_size() const
+{
+	return m_size;
+}
+
+/// Submit a task.
+/**
+ * The task will be executed by one of the worker threads. Can be called from any thread, including the workers.
+ *
+ * @param[in] t task to be executed.
+ */
+void work_stealing_pool::submit(const task_type &t)
+{
+	const unsigned int q = (current_pool == this) ? current_queue : m_next_queue++ % m_size;
+	// Count the task before queueing it, so that the counter never underflows.
+	++m_queued;
+	{
+		boost::lock_guard<boost::mutex> lock(m_queues[q].m_mutex);
+		m_queues[q].m_tasks.push_back(t);
+	}
+	// Take the idle lock so that the notification cannot get lost between the check and the wait of a worker.
+	{
+		boost::lock_guard<boost::mutex> lock(m_idle_mutex);
+	}
+	m_idle_cond.notify_one();
+}
+
+// Take a task from the back of the worker's own queue, or steal one from the front of another queue.
+bool work_stealing_pool::pop_task(unsigned int idx, task_type &t)
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_queues[idx].m_mutex);
+		if (!m_queues[idx].m_tasks.empty()) {
+			t.swap(m_queues[idx].m_tasks.back());
+			m_queues[idx].m_tasks.pop_back();
+			--m_queued;
+			return true;
+		}
+	}
+	for (unsigned int i = 1; i < m_size; ++i) {
+		worker_queue &victim = m_queues[(idx + i) % m_size];
+		boost::lock_guard<boost::mutex> lock(victim.m_mutex);
+		if (!victim.m_tasks.empty()) {
+			t.swap(victim.m_tasks.front());
+			victim.m_tasks.pop_front();
+			--m_queued;
+			return true;
+		}
+	}
+	return false;
+}
+
+void work_stealing_pool::worker_loop(unsigned int idx)
+{
+	current_pool = this;
+	current_queue = idx;
+	task_type t;
+	while (true) {
+		if (pop_task(idx,t)) {
+			try {
+				t();
+			} catch (...) {}
+			t.clear();
+			continue;
+		}
+		boost::unique_lock<boost::mutex> lock(m_idle_mutex);
+		while (!m_stop && !m_queued) {
+			m_idle_cond.wait(lock);
+		}
+		if (m_stop && !m_queued) {
+			return;
+		}
+	}
+}
+
+// Let the workers run out of tasks and join them.
+void work_stealing_pool::stop()
+{
+	{
+		boost::lock_guard<boost::mutex> lock(m_idle_mutex);
+		m_stop = true;
+	}
+	m_idle_cond.notify_all();
+	m_workers.join_all();
+}
+
+}}
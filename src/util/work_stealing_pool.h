@@ -0,0 +1,89 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+#ifndef PAGMO_UTIL_WORK_STEALING_POOL_H
+#define PAGMO_UTIL_WORK_STEALING_POOL_H
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstddef>
+#include <deque>
+
+#include "../config.h"
+
+namespace pagmo{ namespace util {
+
+/// Fixed-size pool of threads executing independent tasks.
+/**
+ * Each of the n worker threads owns a queue of tasks. Tasks submitted from a worker (e.g., a task spawning its
+ * continuation) go to the back of the worker's own queue, while tasks submitted from other threads are distributed
+ * among the queues in round-robin fashion. A worker takes its tasks from the back of its own queue, and when the
+ * queue is empty it steals from the front of the queues of the other workers. Each queue has its own lock, so that
+ * workers contend only when stealing.
+ *
+ * Unlike thread_pool, submit() does not wait for the task to be executed: tasks must signal their completion by
+ * themselves. Tasks should not throw: exceptions escaping from a task are discarded. The destructor waits for all
+ * the submitted tasks to be executed.
+ */
+class __PAGMO_VISIBLE work_stealing_pool: private boost::noncopyable
+{
+	public:
+		/// Type of the tasks.
+		typedef boost::function<void ()> task_type;
+		explicit work_stealing_pool(unsigned int = 0);
+		~work_stealing_pool();
+		unsigned int get_size() const;
+		void submit(const task_type &);
+	private:
+		struct worker_queue
+		{
+			boost::mutex		m_mutex;
+			std::deque<task_type>	m_tasks;
+		};
+		void worker_loop(unsigned int);
+		bool pop_task(unsigned int, task_type &);
+		void stop();
+
+		const unsigned int			m_size;
+		boost::scoped_array<worker_queue>	m_queues;
+		// Number of submitted tasks not taken by a worker yet.
+		boost::atomic<std::size_t>		m_queued;
+		// Queue receiving the next task submitted from outside the pool.
+		boost::atomic<unsigned int>		m_next_queue;
+		// Idle workers wait on the condition variable.
+		boost::mutex				m_idle_mutex;
+		boost::condition_variable		m_idle_cond;
+		bool					m_stop;
+		boost::thread_group			m_workers;
+};
+
+}}
+
+#endif
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <string>
 #include <locale>
+#include <cmath>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include "../src/pagmo.h"
 #include "../src/util/hypervolume.h"
@@ -189,6 +190,89 @@ private:
 	double m_eps;
 };
 
+// The multithreaded WFG must give the same bits as the serial one.
+int test_threads()
+{
+	rng_double drng(7);
+	std::vector<fitness_vector> points(60, fitness_vector(6));
+	for (unsigned int i = 0 ; i < points.size() ; ++i) {
+		double norm = 0.0;
+		for (unsigned int d = 0 ; d < points[i].size() ; ++d) {
+			points[i][d] = 0.05 + drng();
+			norm += points[i][d] * points[i][d];
+		}
+		for (unsigned int d = 0 ; d < points[i].size() ; ++d) {
+			points[i][d] /= std::sqrt(norm);
+		}
+	}
+	const fitness_vector r(6, 1.1);
+	util::hypervolume hv(points);
+	const double serial = hv.compute(r, util::hv_algorithm::wfg(2, 1).clone());
+	const std::vector<double> serial_c = hv.contributions(r, util::hv_algorithm::wfg(2, 1).clone());
+	hv.set_threads(4);
+	if (hv.compute(r) != serial || hv.contributions(r) != serial_c) {
+		std::cout << "Multithreaded WFG differs from the serial run" << std::endl;
+		return 1;
+	}
+	// Same for the FPRAS approximation, which must also be within its error bound.
+	const double approx = hv.compute(r, util::hv_algorithm::bf_fpras(0.05, 0.05, 1).clone());
+	if (hv.compute(r, util::hv_algorithm::bf_fpras(0.05, 0.05, 4).clone()) != approx) {
+		std::cout << "Multithreaded FPRAS differs from the serial run" << std::endl;
+		return 1;
+	}
+	if (std::fabs(approx - serial) > 0.05 * serial) {
+		std::cout << "FPRAS approximation " << approx << " too far from " << serial << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// The low-dimensional kernels must agree with wfg on sets with dominated points and duplicates, and their flat versions
+// must give the same results as the common ones.
+int test_low_dim()
+{
+	rng_double drng(11);
+	for (unsigned int dim = 2 ; dim <= 3 ; ++dim) {
+		for (unsigned int n = 1 ; n <= 40 ; ++n) {
+			std::vector<fitness_vector> points(n, fitness_vector(dim));
+			std::vector<double> flat;
+			for (unsigned int i = 0 ; i < n ; ++i) {
+				for (unsigned int d = 0 ; d < dim ; ++d) {
+					// Coarse grid, so that some coordinates are shared.
+					points[i][d] = std::floor(drng() * 20.) / 20.;
+				}
+				if (i % 7 == 6) {
+					points[i] = points[i / 2];
+				}
+				flat.insert(flat.end(), points[i].begin(), points[i].end());
+			}
+			const fitness_vector r(dim, 1.1);
+			std::vector<fitness_vector> p1(points), p2(points);
+			const double hv = (dim == 2) ? util::hv_algorithm::hv2d().compute(p1, r) : util::hv_algorithm::hv3d().compute(p1, r);
+			const double hv_flat = (dim == 2) ? util::hv_algorithm::hv2d().compute(&flat[0], n, &r[0]) : util::hv_algorithm::hv3d().compute(&flat[0], n, &r[0]);
+			if (std::fabs(hv - util::hv_algorithm::wfg().compute(p2, r)) > 1e-12 || hv_flat != hv) {
+				std::cout << "Wrong hypervolume in " << dim << " dimensions" << std::endl;
+				return 1;
+			}
+			if (dim == 2) {
+				p1 = points;
+				p2 = points;
+				const std::vector<double> c = util::hv_algorithm::hv2d().contributions(p1, r);
+				const std::vector<double> c_wfg = util::hv_algorithm::wfg().contributions(p2, r);
+				std::vector<double> c_flat(n);
+				util::hv_algorithm::hv2d().contributions(&flat[0], n, &r[0], &c_flat[0]);
+				for (unsigned int i = 0 ; i < n ; ++i) {
+					if (std::fabs(c[i] - c_wfg[i]) > 1e-12 || c_flat[i] != c[i]) {
+						std::cout << "Wrong hv2d contribution: " << c[i] << " instead of " << c_wfg[i] << std::endl;
+						return 1;
+					}
+				}
+			}
+		}
+	}
+	return 0;
+}
+
 int main(int argc, char *argv[])
 {
 	std::string line;
@@ -249,5 +333,7 @@ int main(int argc, char *argv[])
 		ifs.close();
 	}
 
+	test_result |= test_threads();
+	test_result |= test_low_dim();
 	return test_result;
 }
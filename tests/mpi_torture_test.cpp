@@ -22,10 +22,32 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
  *****************************************************************************/
 
+#include <iostream>
+#include <vector>
 #include "../src/pagmo.h"
 
 using namespace pagmo;
 
+// The champions of the islands can only improve, whether the populations travel as a whole or as deltas, and the
+// function evaluations performed by the workers must be accounted for in the problems of the islands.
+bool check_islands(const archipelago &a, std::vector<double> &best, std::vector<unsigned int> &fevals)
+{
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		const population pop = a.get_island(i)->get_population();
+		if (pop.size() != 5 || pop.champion().f[0] > best[i]) {
+			std::cout << "island " << i << " lost its champion" << std::endl;
+			return false;
+		}
+		if (pop.problem().get_fevals() <= fevals[i]) {
+			std::cout << "island " << i << " lost its function evaluations" << std::endl;
+			return false;
+		}
+		best[i] = pop.champion().f[0];
+		fevals[i] = pop.problem().get_fevals();
+	}
+	return true;
+}
+
 int main()
 {
 	mpi_environment env;
@@ -34,13 +56,18 @@ int main()
 	archipelago a;
 	a.set_topology(topology::ring());
 	for (int i = 0; i < 9; ++i) {
-		a.push_back(mpi_island(algo,prob,1));
+		a.push_back(mpi_island(algo,prob,5));
 	}
+	std::vector<double> best(a.get_size(),1E300);
+	std::vector<unsigned int> fevals(a.get_size(),0);
 	for (int i = 0; i < 100; ++i) {
 		a.evolve(1);
 		a.join();
+		if (!check_islands(a,best,fevals)) {
+			return 1;
+		}
 	}
 	a.evolve(100);
 	a.join();
-	return 0;
+	return !check_islands(a,best,fevals);
 }
@@ -38,7 +38,7 @@ int main()
 	unsigned int gen = 7;
 
 	//increment this if you add a multiobjective algo
-	unsigned int n_mo = 6;
+	unsigned int n_mo = 8;
 
 	//increment this if you add a constrained algo
 	unsigned int n_con = 3;
@@ -65,6 +65,10 @@ int main()
 	algos_new.push_back(algorithm::vega().clone());
 	algos.push_back(algorithm::nsga2(gen,0.5,11,0.3,11).clone());
 	algos_new.push_back(algorithm::nsga2().clone());
+	algos.push_back(algorithm::nsga2(gen,0.5,11,0.3,11,algorithm::nsga2::STEADY_STATE).clone());
+	algos_new.push_back(algorithm::nsga2().clone());
+	algos.push_back(algorithm::moead(gen,algorithm::moead::RANDOM,10,0.8,3,0.9,0.4,15,true,true).clone());
+	algos_new.push_back(algorithm::moead().clone());
 
 
 
@@ -97,16 +101,26 @@ int main()
 	algos_new.push_back(algorithm::bee_colony().clone());
 	algos.push_back(algorithm::cmaes(gen,0.5, 0.5, 0.5, 0.5, 0.7, 1e-5, 1e-5, false).clone());
 	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes(gen,-1, -1, -1, -1, 0.7, 1e-5, 1e-5, true, algorithm::cmaes::FULL, true).clone());
+	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes(gen,-1, -1, -1, -1, 0.7, 1e-5, 1e-5, true, algorithm::cmaes::SEPARABLE).clone());
+	algos_new.push_back(algorithm::cmaes().clone());
+	algos.push_back(algorithm::cmaes(gen,-1, -1, -1, -1, 0.7, 1e-5, 1e-5, true, algorithm::cmaes::LIMITED_MEMORY).clone());
+	algos_new.push_back(algorithm::cmaes().clone());
 	algos.push_back(algorithm::cs(gen*10,0.02,0.3,0.3).clone());
 	algos_new.push_back(algorithm::cs().clone());
 	algos.push_back(algorithm::de(gen,0.9,0.9,3).clone());
 	algos_new.push_back(algorithm::de().clone());
 	algos.push_back(algorithm::de_1220(1,2,std::vector<int>(1,9),false,1e-5,1e-5).clone());
 	algos_new.push_back(algorithm::de_1220().clone());
+	algos.push_back(algorithm::de_1220(1,2,std::vector<int>(1,9),false,1e-5,1e-5,true).clone());
+	algos_new.push_back(algorithm::de_1220().clone());
 	algos.push_back(algorithm::ihs(gen,0.2,0.2,0.2,0.2,0.2).clone());
 	algos_new.push_back(algorithm::ihs().clone());
 	algos.push_back(algorithm::jde(gen,7,2).clone());
 	algos_new.push_back(algorithm::jde().clone());
+	algos.push_back(algorithm::jde(gen,7,2,1e-6,1e-6,false,true).clone());
+	algos_new.push_back(algorithm::jde().clone());
 	algos.push_back(algorithm::mbh(algorithm::de(gen),2,0.03).clone());
 	algos_new.push_back(algorithm::mbh().clone());
 	algos.push_back(algorithm::mde_pbx(gen,0.5,0.5,1e-10,1e-10).clone());
@@ -27,8 +27,12 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <sstream>
+#include <string>
 #include <vector>
 #include <cassert>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
 #include "../src/pagmo.h"
 
 using namespace pagmo;
@@ -50,6 +54,100 @@ int test_distribution_type() {
 	return 0;
 }
 
+// Migration must happen with all the combinations of distribution type and migration direction, and survive copies
+// and serialization.
+int test_migration() {
+	const archipelago::distribution_type types[] = {archipelago::point_to_point, archipelago::broadcast};
+	const archipelago::migration_direction directions[] = {archipelago::source, archipelago::destination};
+	for (int i = 0; i < 2; ++i) {
+		for (int j = 0; j < 2; ++j) {
+			archipelago a(algorithm::de(5),problem::ackley(5),8,20,topology::fully_connected(),types[i],directions[j]);
+			a.evolve(5);
+			a.join();
+			const std::string hist = a.dump_migr_history();
+			if (hist.empty() || a.get_dropped_migrations()) {
+				std::cout << "no migration for distribution type " << i << " and direction " << j << std::endl;
+				return 1;
+			}
+			archipelago a_copy(a);
+			if (a_copy.dump_migr_history() != hist) {
+				std::cout << "migration history not copied" << std::endl;
+				return 1;
+			}
+			std::stringstream ss;
+			boost::archive::text_oarchive oa(ss);
+			oa << a;
+			archipelago a_loaded;
+			boost::archive::text_iarchive ia(ss);
+			ia >> a_loaded;
+			// Pending emigrants are restored, so the loaded archipelago can keep migrating.
+			a_loaded.evolve(2);
+			a_loaded.join();
+			if (a_loaded.dump_migr_history().empty()) {
+				std::cout << "no migration after deserialization" << std::endl;
+				return 1;
+			}
+			a.clear_migr_history();
+			if (!a.dump_migr_history().empty()) {
+				std::cout << "migration history not cleared" << std::endl;
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+static std::string save_archipelago(archipelago &a) {
+	std::ostringstream oss;
+	{
+		boost::archive::text_oarchive oa(oss);
+		oa << a;
+	}
+	return oss.str();
+}
+
+// Saving a loaded archipelago must give back the same archive, rngs included. A single island is used, as the
+// construct data of several islands are temporaries which may share addresses, and thus be archived as references.
+int test_round_trip() {
+	archipelago a(algorithm::de(5),problem::ackley(5),1,20);
+	a.evolve(2);
+	const std::string saved = save_archipelago(a);
+	archipelago a_loaded;
+	std::istringstream iss(saved);
+	boost::archive::text_iarchive ia(iss);
+	ia >> a_loaded;
+	if (save_archipelago(a_loaded) != saved) {
+		std::cout << "serialization does not round-trip" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Many islands must evolve on a small thread pool, without deadlocks and with migration.
+int test_pool() {
+	archipelago a(algorithm::de(1),problem::ackley(5),64,10,topology::ring());
+	a.set_pool_size(2);
+	if (a.get_pool_size() != 2) {
+		std::cout << "wrong pool size" << std::endl;
+		return 1;
+	}
+	a.evolve(10);
+	a.join();
+	a.evolve_t(20);
+	a.join();
+	if (a.busy() || a.dump_migr_history().empty()) {
+		std::cout << "evolution on the pool failed" << std::endl;
+		return 1;
+	}
+	a.evolve(1000000);
+	a.interrupt();
+	if (a.busy()) {
+		std::cout << "interruption failed" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
 int main() {
-	return test_distribution_type();
+	return test_distribution_type() || test_migration() || test_round_trip() || test_pool();
 }
@@ -0,0 +1,133 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the index sampling of the DE kernels: uniform_index must stay in range and be uniform, index_sampler must
+// return distinct indices, never the excluded ones, uniformly over the others.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/de_kernels.h"
+
+using namespace pagmo;
+using util::de_kernels::index_sampler;
+using util::de_kernels::uniform_index;
+
+// Whether each count is within 5% of the expected one (with 10^5 or more expected hits, a fluctuation of this size is
+// more than 15 standard deviations away).
+bool roughly_uniform(const std::vector<double> &counts, double expected)
+{
+	for (std::size_t i = 0; i < counts.size(); ++i) {
+		if (std::fabs(counts[i] - expected) > 0.05 * expected) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int test_uniform_index()
+{
+	rng_uint32 urng(42);
+	const std::size_t sizes[] = {1, 2, 3, 7, 10, 100};
+	for (int s = 0; s < 6; ++s) {
+		const std::size_t n = sizes[s];
+		const std::size_t draws = 100000 * n;
+		std::vector<double> counts(n, 0.);
+		for (std::size_t t = 0; t < draws; ++t) {
+			const std::size_t idx = uniform_index(urng, n);
+			if (idx >= n) {
+				std::cout << "uniform_index: " << idx << " out of [0," << n << ")" << std::endl;
+				return 1;
+			}
+			++counts[idx];
+		}
+		if (!roughly_uniform(counts, double(draws) / n)) {
+			std::cout << "uniform_index: not uniform on [0," << n << ")" << std::endl;
+			return 1;
+		}
+	}
+	// The upper bits of a large range must be reachable too.
+	const std::size_t n = std::size_t(3) << 30;
+	bool high = false;
+	for (int t = 0; t < 1000 && !high; ++t) {
+		const std::size_t idx = uniform_index(urng, n);
+		if (idx >= n) {
+			std::cout << "uniform_index: " << idx << " out of [0," << n << ")" << std::endl;
+			return 1;
+		}
+		high = idx >= (std::size_t(2) << 30);
+	}
+	if (!high) {
+		std::cout << "uniform_index: upper part of a large range never drawn" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Samples k indices out of n excluding ex1 and ex2 (the exclusions vary between calls, as in the algorithms, so that
+// the sampler starts from the permutation left by the previous call).
+int test_index_sampler(std::size_t n, std::size_t k, bool two_excluded)
+{
+	rng_uint32 urng(static_cast<rng_uint32::result_type>(n * 10 + k));
+	index_sampler sampler(n);
+	const std::size_t n_calls = 100000 * n / k;
+	std::vector<double> counts(n, 0.);
+	std::vector<std::size_t> out(k);
+	std::vector<char> seen(n);
+	for (std::size_t t = 0; t < n_calls; ++t) {
+		const std::size_t ex1 = t % n;
+		const std::size_t ex2 = two_excluded ? (t / n + ex1 + 1) % n : index_sampler::npos;
+		sampler.sample(&out[0], k, urng, ex1, ex2);
+		std::fill(seen.begin(), seen.end(), 0);
+		for (std::size_t j = 0; j < k; ++j) {
+			if (out[j] >= n || out[j] == ex1 || out[j] == ex2 || seen[out[j]]) {
+				std::cout << "index_sampler: invalid or repeated index " << out[j] << " with n = " << n << ", k = " << k << std::endl;
+				return 1;
+			}
+			seen[out[j]] = 1;
+			++counts[out[j]];
+		}
+	}
+	// Each index is excluded in the same number of calls, so all of them are drawn equally often.
+	if (!roughly_uniform(counts, double(n_calls) * k / n)) {
+		std::cout << "index_sampler: not uniform with n = " << n << ", k = " << k << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	return test_uniform_index() ||
+		test_index_sampler(4, 1, true) ||
+		test_index_sampler(4, 2, true) ||
+		test_index_sampler(10, 3, false) ||
+		test_index_sampler(10, 9, false) ||
+		test_index_sampler(50, 7, true) ||
+		test_index_sampler(50, 48, true);
+}
@@ -0,0 +1,177 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the dynamic hypervolume: after random insertions and erasures, the contributions must match those computed
+// from scratch. In two dimensions, strictly dominated points must be rejected.
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/hv_algorithm/dynamic_hv.h"
+
+using namespace pagmo;
+using util::hv_algorithm::dynamic_hv;
+
+// Random point in [0,1]^dim, projected on the unit sphere if on_sphere is true (so that the points are mutually
+// non-dominated).
+fitness_vector random_point(rng_double &drng, fitness_vector::size_type dim, bool on_sphere)
+{
+	fitness_vector p(dim);
+	double norm = 0.;
+	for (fitness_vector::size_type i = 0; i < dim; ++i) {
+		p[i] = 0.05 + drng();
+		norm += p[i] * p[i];
+	}
+	if (on_sphere) {
+		for (fitness_vector::size_type i = 0; i < dim; ++i) {
+			p[i] /= std::sqrt(norm);
+		}
+	}
+	return p;
+}
+
+int check(const dynamic_hv &hv, const std::vector<dynamic_hv::id_type> &ids, const fitness_vector &r)
+{
+	if (hv.size() != ids.size()) {
+		std::cout << "dynamic_hv: wrong size" << std::endl;
+		return 1;
+	}
+	if (ids.empty()) {
+		return 0;
+	}
+	std::vector<fitness_vector> points;
+	for (std::vector<dynamic_hv::id_type>::size_type i = 0; i < ids.size(); ++i) {
+		points.push_back(hv.get_point(ids[i]));
+	}
+	std::vector<double> expected(1, 1.);
+	if (points.size() == 1) {
+		for (fitness_vector::size_type k = 0; k < r.size(); ++k) {
+			expected[0] *= r[k] - points[0][k];
+		}
+	} else {
+		expected = util::hypervolume(points, false).contributions(r);
+	}
+	double least = expected[0];
+	for (std::vector<dynamic_hv::id_type>::size_type i = 0; i < ids.size(); ++i) {
+		if (std::fabs(hv.contribution(ids[i]) - expected[i]) > 1e-12) {
+			std::cout << "dynamic_hv: contribution " << hv.contribution(ids[i]) << " instead of " << expected[i] << " in dimension " << r.size() << std::endl;
+			return 1;
+		}
+		least = std::min(least, expected[i]);
+	}
+	if (std::fabs(hv.contribution(hv.least_contributor()) - least) > 1e-12) {
+		std::cout << "dynamic_hv: wrong least contributor in dimension " << r.size() << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int test_random_updates(fitness_vector::size_type dim, bool on_sphere)
+{
+	rng_double drng(static_cast<rng_double::result_type>(dim));
+	rng_uint32 urng(static_cast<rng_uint32::result_type>(dim));
+	const fitness_vector r(dim, 1.2);
+	std::vector<fitness_vector> initial;
+	for (int i = 0; i < 20; ++i) {
+		initial.push_back(random_point(drng, dim, on_sphere));
+	}
+	dynamic_hv hv(initial, r);
+	std::vector<dynamic_hv::id_type> ids;
+	for (dynamic_hv::id_type i = 0; i < initial.size(); ++i) {
+		ids.push_back(i);
+	}
+	if (check(hv, ids, r)) {
+		return 1;
+	}
+	for (int t = 0; t < 300; ++t) {
+		if (ids.empty() || (ids.size() < 40 && urng() % 2)) {
+			ids.push_back(hv.insert(random_point(drng, dim, on_sphere)));
+		} else {
+			// Remove the least contributor most of the time, as a steady-state algorithm would.
+			const std::vector<dynamic_hv::id_type>::size_type i = urng() % ids.size();
+			const dynamic_hv::id_type id = (urng() % 4) ? hv.least_contributor() : ids[i];
+			hv.erase(id);
+			ids.erase(std::find(ids.begin(), ids.end(), id));
+		}
+		if (check(hv, ids, r)) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+fitness_vector point_2d(double x, double y)
+{
+	fitness_vector p(2, x);
+	p[1] = y;
+	return p;
+}
+
+int test_dominated_2d()
+{
+	const fitness_vector r(2, 3.);
+	std::vector<fitness_vector> dominated;
+	dominated.push_back(point_2d(1., 1.));
+	dominated.push_back(point_2d(2., 2.));
+	try {
+		dynamic_hv hv(dominated, r);
+		std::cout << "dynamic_hv: dominated initial set accepted" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	std::vector<fitness_vector> front;
+	front.push_back(point_2d(1., 2.));
+	front.push_back(point_2d(2., 1.));
+	dynamic_hv hv(front, r);
+	std::vector<dynamic_hv::id_type> ids;
+	ids.push_back(0);
+	ids.push_back(1);
+	const fitness_vector rejected[] = {point_2d(0.5, 0.5), point_2d(1.5, 2.5), point_2d(2.5, 2.5)};
+	for (int i = 0; i < 3; ++i) {
+		try {
+			hv.insert(rejected[i]);
+			std::cout << "dynamic_hv: dominated point accepted" << std::endl;
+			return 1;
+		} catch (const value_error &) {}
+		if (check(hv, ids, r)) {
+			return 1;
+		}
+	}
+	// Points sharing a coordinate with another one are weakly dominated and must be accepted.
+	ids.push_back(hv.insert(point_2d(1., 2.5)));
+	ids.push_back(hv.insert(point_2d(2.5, 1.)));
+	ids.push_back(hv.insert(point_2d(1.5, 1.5)));
+	return check(hv, ids, r);
+}
+
+int main()
+{
+	return test_dominated_2d() ||
+		test_random_updates(2, true) ||
+		test_random_updates(3, true) ||
+		test_random_updates(3, false) ||
+		test_random_updates(4, true) ||
+		test_random_updates(5, false);
+}
@@ -0,0 +1,193 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the hypervolume cache of the population: repeated queries and migration selections on an unchanged
+// population must not compute any hypervolume and must give the same results, while any modification must.
+
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/racing.h"
+
+using namespace pagmo;
+
+bool same_individuals(const std::vector<population::individual_type> &a, const std::vector<population::individual_type> &b)
+{
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (std::vector<population::individual_type>::size_type i = 0; i < a.size(); ++i) {
+		if (a[i].cur_x != b[i].cur_x) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int test_contributions(const problem::base &prob)
+{
+	population pop(prob, 40, 123);
+	std::vector<population::size_type> idx(pop.size());
+	std::iota(idx.begin(), idx.end(), population::size_type(0));
+	fitness_vector r = pop.compute_nadir();
+	for (fitness_vector::size_type i = 0; i < r.size(); ++i) {
+		r[i] = 10. + 2. * r[i];
+	}
+
+	pop.reset_hv_cache_counters();
+	const std::vector<double> c = pop.get_hv_contributions(idx, r);
+	const std::vector<double> c_again = pop.get_hv_contributions(idx, r);
+	if (c != c_again || pop.get_hv_cache_hits() != 1 || pop.get_hv_cache_misses() != 1) {
+		std::cout << prob.get_name() << ": repeated query not served from the cache" << std::endl;
+		return 1;
+	}
+
+	// The cache must agree with the computation from scratch.
+	std::vector<fitness_vector> points;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		points.push_back(pop.get_individual(i).cur_f);
+	}
+	const std::vector<double> c_ref = util::hypervolume(points, false).contributions(r);
+	for (std::vector<double>::size_type i = 0; i < c.size(); ++i) {
+		if (std::fabs(c[i] - c_ref[i]) > 1e-12 * std::max(1., std::fabs(c_ref[i]))) {
+			std::cout << prob.get_name() << ": wrong contribution " << c[i] << " vs " << c_ref[i] << std::endl;
+			return 1;
+		}
+	}
+
+	// A copy shares the cached values, a modified population does not.
+	population copy(pop);
+	copy.get_hv_contributions(idx, r);
+	if (copy.get_hv_cache_hits() != 2 || copy.get_hv_cache_misses() != 1) {
+		std::cout << prob.get_name() << ": copy did not use the cached values" << std::endl;
+		return 1;
+	}
+	const boost::uint64_t epoch = pop.get_epoch();
+	pop.set_x(0, pop.get_individual(1).cur_x);
+	if (pop.get_epoch() == epoch) {
+		std::cout << prob.get_name() << ": epoch not increased by set_x" << std::endl;
+		return 1;
+	}
+	pop.get_hv_contributions(idx, r);
+	if (pop.get_hv_cache_hits() != 1 || pop.get_hv_cache_misses() != 2) {
+		std::cout << prob.get_name() << ": wrong cache counters after modification" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int test_policies(const problem::base &prob)
+{
+	population pop(prob, 30, 42);
+	migration::hv_best_s_policy best(10);
+	migration::hv_greedy_s_policy greedy(10);
+
+	pop.reset_hv_cache_counters();
+	const std::vector<population::individual_type> best_1 = best.select(pop), greedy_1 = greedy.select(pop);
+	const boost::uint64_t misses = pop.get_hv_cache_misses();
+	const std::vector<population::individual_type> best_2 = best.select(pop), greedy_2 = greedy.select(pop);
+	if (pop.get_hv_cache_misses() != misses || !pop.get_hv_cache_hits()) {
+		std::cout << prob.get_name() << ": selection from an unchanged population recomputed the hypervolume" << std::endl;
+		return 1;
+	}
+	if (!same_individuals(best_1, best_2) || !same_individuals(greedy_1, greedy_2)) {
+		std::cout << prob.get_name() << ": cached selection differs" << std::endl;
+		return 1;
+	}
+
+	// The replacement policies must give valid pairs of (islander, immigrant) indices.
+	population other(prob, 30, 7);
+	const std::vector<population::individual_type> immigrants = best.select(other);
+	std::vector<std::pair<population::size_type, std::vector<population::individual_type>::size_type> > fair, greedy_r;
+	fair = migration::hv_fair_r_policy(10).select(immigrants, pop);
+	greedy_r = migration::hv_greedy_r_policy(10).select(immigrants, pop);
+	fair.insert(fair.end(), greedy_r.begin(), greedy_r.end());
+	for (std::vector<std::pair<population::size_type, std::vector<population::individual_type>::size_type> >::size_type i = 0; i < fair.size(); ++i) {
+		if (fair[i].first >= pop.size() || fair[i].second >= immigrants.size()) {
+			std::cout << prob.get_name() << ": invalid replacement" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// A racing population bypasses set_x(): its fitness updates must still invalidate the cached contributions and keep the
+// domination counts up to date.
+int test_racing(const problem::base &prob)
+{
+	util::racing::racing_population pop(population(prob, 20, 5));
+	std::vector<population::size_type> idx(pop.size());
+	std::iota(idx.begin(), idx.end(), population::size_type(0));
+	const fitness_vector r(prob.get_f_dimension(), 20.);
+	const std::vector<double> c = pop.get_hv_contributions(idx, r);
+
+	const boost::uint64_t epoch = pop.get_epoch();
+	fitness_vector f = pop.get_individual(0).cur_f;
+	for (fitness_vector::size_type i = 0; i < f.size(); ++i) {
+		f[i] *= .5;
+	}
+	pop.set_fc(0, f, pop.get_individual(0).cur_c);
+	decision_vector x(prob.get_dimension(), .5);
+	pop.push_back_noeval(x);
+	pop.set_fc(pop.size() - 1, fitness_vector(prob.get_f_dimension(), 30.), constraint_vector(prob.get_c_dimension()));
+	if (pop.get_epoch() == epoch) {
+		std::cout << prob.get_name() << ": epoch not increased by set_fc" << std::endl;
+		return 1;
+	}
+	const std::vector<double> c_new = pop.get_hv_contributions(idx, r);
+	std::vector<fitness_vector> points;
+	for (population::size_type i = 0; i < idx.size(); ++i) {
+		points.push_back(pop.get_individual(i).cur_f);
+	}
+	const std::vector<double> c_ref = util::hypervolume(points, false).contributions(r);
+	if (c_new == c || c_new != c_ref) {
+		std::cout << prob.get_name() << ": stale contributions after set_fc" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		population::size_type count = 0;
+		for (population::size_type j = 0; j < pop.size(); ++j) {
+			count += (j != i && prob.compare_fc(pop.get_individual(j).best_f, pop.get_individual(j).best_c,
+				pop.get_individual(i).best_f, pop.get_individual(i).best_c));
+		}
+		if (pop.get_domination_count(i) != count) {
+			std::cout << prob.get_name() << ": wrong domination count after set_fc" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main()
+{
+	return test_contributions(problem::zdt(1, 10)) ||
+		test_contributions(problem::dtlz(2, 5, 3)) ||
+		test_contributions(problem::dtlz(2, 5, 5)) ||
+		test_policies(problem::zdt(1, 10)) ||
+		test_policies(problem::dtlz(2, 5, 4)) ||
+		test_racing(problem::zdt(1, 10));
+}
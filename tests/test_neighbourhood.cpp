@@ -0,0 +1,124 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the nearest neighbour utilities: the kd-tree queries and the SPEA2 archive truncation must give the same
+// results as the full sort of all the pairwise distances.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/neighbourhood.h"
+
+using namespace pagmo;
+using namespace pagmo::util::neighbourhood;
+
+// Random vectors, with coordinates on a coarse grid if ties are wanted.
+std::vector<std::vector<double> > random_points(rng_uint32 &urng, rng_double &drng, population::size_type n, std::vector<double>::size_type dim, bool ties)
+{
+	std::vector<std::vector<double> > retval(n,std::vector<double>(dim));
+	for (population::size_type i = 0; i < n; ++i) {
+		for (std::vector<double>::size_type j = 0; j < dim; ++j) {
+			retval[i][j] = ties ? double(urng() % 4) : drng();
+		}
+	}
+	return retval;
+}
+
+int test_neighbours() {
+	rng_uint32 urng(42);
+	rng_double drng(42);
+	for (int t = 0; t < 100; ++t) {
+		const population::size_type n = 1 + urng() % 300, k = urng() % 20;
+		const std::vector<double>::size_type dim = 1 + urng() % 12;
+		const std::vector<std::vector<double> > points = random_points(urng,drng,n,dim,t % 2 == 0);
+		std::vector<std::vector<population::size_type> > full, partial;
+		euclidian::compute_neighbours(full,points);
+		euclidian::compute_neighbours(partial,points,k);
+		for (population::size_type i = 0; i < n; ++i) {
+			if (full[i][0] != i || !std::equal(partial[i].begin(),partial[i].end(),full[i].begin()) || partial[i].size() != std::min(k,n)) {
+				std::cout << "compute_neighbours: mismatch for n = " << n << ", k = " << k << ", dimension " << dim << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "compute_neighbours passes" << std::endl;
+	return 0;
+}
+
+// Lexicographic comparison of the sorted distances to the remaining vectors, as in the original SPEA2 truncation.
+struct distance_less
+{
+	distance_less(const std::vector<std::vector<double> > &d):m_d(d) {}
+	bool operator()(population::size_type a, population::size_type b) const
+	{
+		return m_d[a] < m_d[b];
+	}
+	const std::vector<std::vector<double> > &m_d;
+};
+
+int test_truncation() {
+	rng_uint32 urng(123);
+	rng_double drng(123);
+	for (int t = 0; t < 60; ++t) {
+		const population::size_type n = 1 + urng() % 120;
+		const std::vector<double>::size_type dim = 1 + urng() % 4;
+		const std::vector<std::vector<double> > points = random_points(urng,drng,n,dim,t % 2 == 0);
+		archive_truncation truncation(points);
+		std::vector<population::size_type> remaining;
+		for (population::size_type i = 0; i < n; ++i) {
+			remaining.push_back(i);
+		}
+		while (!remaining.empty()) {
+			std::vector<std::vector<double> > d(n);
+			for (population::size_type i = 0; i < remaining.size(); ++i) {
+				for (population::size_type j = 0; j < remaining.size(); ++j) {
+					if (i != j) {
+						d[remaining[i]].push_back(euclidian::distance(points[remaining[i]],points[remaining[j]]));
+					}
+				}
+				std::sort(d[remaining[i]].begin(),d[remaining[i]].end());
+			}
+			// The first of the smallest lists is removed.
+			const std::vector<population::size_type>::iterator expected = std::min_element(remaining.begin(),remaining.end(),distance_less(d));
+			if (truncation.remove_one() != *expected) {
+				std::cout << "archive_truncation: wrong vector removed, n = " << n << ", dimension " << dim << std::endl;
+				return 1;
+			}
+			remaining.erase(expected);
+			if (truncation.size() != remaining.size()) {
+				std::cout << "archive_truncation: wrong size" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "archive_truncation passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_neighbours() || test_truncation();
+}
@@ -0,0 +1,175 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test for the non-dominated sorting. Run with "bench" as argument to time it against the domination lists.
+
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/thread/thread.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/non_dominated_sorting.h"
+
+using namespace pagmo;
+
+// dtlz ranked through the domination lists.
+class dtlz_dom_lists: public problem::dtlz
+{
+	public:
+		dtlz_dom_lists(size_type id, size_type k, fitness_vector::size_type fdim):problem::dtlz(id,k,fdim) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new dtlz_dom_lists(*this));
+		}
+		bool has_pareto_dominance() const
+		{
+			return false;
+		}
+};
+
+// Ranks on random integer points (lots of ties) must match the definition.
+int test_random_points() {
+	rng_uint32 urng(42);
+	for (int t = 0; t < 500; ++t) {
+		const std::size_t n = 1 + urng() % 50, m = 1 + urng() % 5, range = 1 + urng() % 8;
+		std::vector<fitness_vector> f(n,fitness_vector(m));
+		for (std::size_t i = 0; i < n; ++i) {
+			for (std::size_t j = 0; j < m; ++j) {
+				f[i][j] = urng() % range;
+			}
+		}
+		std::vector<std::size_t> rank;
+		util::non_dominated_sorting::compute_ranks(rank,f);
+		// The rank of a point is one more than the highest rank among the points dominating it.
+		for (std::size_t i = 0; i < n; ++i) {
+			std::size_t expected = 0;
+			for (std::size_t j = 0; j < n; ++j) {
+				bool weak = true, strict = false;
+				for (std::size_t k = 0; k < m; ++k) {
+					weak = weak && f[j][k] <= f[i][k];
+					strict = strict || f[j][k] < f[i][k];
+				}
+				if (weak && strict) {
+					expected = std::max(expected,rank[j] + 1);
+				}
+			}
+			if (rank[i] != expected) {
+				std::cout << "non_dominated_sorting: wrong rank for " << f[i] << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "non_dominated_sorting passes" << std::endl;
+	return 0;
+}
+
+// The population must give the same Pareto information whether it uses the domination lists or not.
+int test_population(population::size_type n) {
+	population pop_fast(problem::dtlz(1,5,3),n,123);
+	population pop_lists(dtlz_dom_lists(1,5,3),n,123);
+	pop_fast.update_pareto_information();
+	pop_lists.update_pareto_information();
+	for (population::size_type i = 0; i < n; ++i) {
+		if (pop_fast.get_pareto_rank(i) != pop_lists.get_pareto_rank(i) || pop_fast.get_crowding_d(i) != pop_lists.get_crowding_d(i)
+			|| (pop_fast.get_pareto_rank(i) == 0) != (pop_fast.get_domination_count(i) == 0))
+		{
+			std::cout << "population: Pareto information mismatch at individual " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "population passes" << std::endl;
+	return 0;
+}
+
+// Replace every individual with the next one, leaving the domination information of the whole population stale.
+void shift_individuals(population &pop) {
+	std::vector<decision_vector> x;
+	std::vector<population::size_type> idx;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual((i + 1) % pop.size()).cur_x);
+		idx.push_back(i);
+	}
+	pop.set_x(idx,x);
+}
+
+void sum_domination_counts(const population *pop, population::size_type *sum) {
+	*sum = 0;
+	for (population::size_type i = 0; i < pop->size(); ++i) {
+		*sum += pop->get_domination_count(i) + pop->get_domination_list(i).size();
+	}
+}
+
+// The domination getters must give the right answer when called concurrently on a stale population.
+int test_concurrent_reads() {
+	population pop(dtlz_dom_lists(1,5,3),200,123), ref(pop);
+	population::size_type ref_sum, sums[4];
+	for (int t = 0; t < 10; ++t) {
+		shift_individuals(pop);
+		shift_individuals(ref);
+		sum_domination_counts(&ref,&ref_sum);
+		boost::thread_group threads;
+		for (int i = 0; i < 4; ++i) {
+			threads.create_thread(boost::bind(&sum_domination_counts,&pop,&sums[i]));
+		}
+		threads.join_all();
+		for (int i = 0; i < 4; ++i) {
+			if (sums[i] != ref_sum) {
+				std::cout << "population: wrong domination information under concurrent reads" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "concurrent reads pass" << std::endl;
+	return 0;
+}
+
+// Time a generation: every individual is replaced, then the Pareto information is requested.
+double time_generation(population &pop) {
+	boost::posix_time::ptime time_start(boost::posix_time::microsec_clock::local_time());
+	shift_individuals(pop);
+	pop.update_pareto_information();
+	boost::posix_time::ptime time_end(boost::posix_time::microsec_clock::local_time());
+	return (time_end - time_start).total_microseconds() / 1E6;
+}
+
+void bench() {
+	const population::size_type sizes[] = {500, 1000, 2000, 5000};
+	for (int i = 0; i < 4; ++i) {
+		population pop_fast(problem::dtlz(2,10,3),sizes[i]);
+		population pop_lists(dtlz_dom_lists(2,10,3),sizes[i]);
+		std::cout << "N = " << sizes[i] << ", M = 3:\tdomination lists " << time_generation(pop_lists) << " s,\tnon-dominated sorting "
+			<< time_generation(pop_fast) << " s" << std::endl;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1 && std::string(argv[1]) == "bench") {
+		bench();
+		return 0;
+	}
+	return test_random_points() || test_population(300) || test_concurrent_reads();
+}
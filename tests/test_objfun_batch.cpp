@@ -0,0 +1,363 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test for the batch objective function evaluation
+
+#include <algorithm>
+#include <boost/math/constants/constants.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/benchmark_kernels.h"
+#include "../src/util/thread_pool.h"
+
+using namespace pagmo;
+
+// Batch evaluation must give the same fitnesses as the per-vector path and count each distinct decision vector once.
+int test_objfun_batch() {
+	problem::zdt prob(1,30);
+	population pop(prob,50);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	// Add a duplicate.
+	x.push_back(x[3]);
+	problem::zdt prob_batch(1,30);
+	std::vector<fitness_vector> f;
+	prob_batch.objfun_batch(f,x);
+	if (f.size() != x.size() || prob_batch.get_fevals() != x.size() - 1) {
+		std::cout << "objfun_batch: wrong number of fitness vectors or evaluations" << std::endl;
+		return 1;
+	}
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (f[i] != prob.objfun(x[i])) {
+			std::cout << "objfun_batch: fitness mismatch at position " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "objfun_batch passes" << std::endl;
+	return 0;
+}
+
+// Problem whose batch evaluation drops the last fitness vector.
+class broken_batch: public problem::ackley
+{
+	public:
+		broken_batch():problem::ackley(5) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new broken_batch(*this));
+		}
+	protected:
+		void batch_objfun_impl(std::vector<fitness_vector> &f, const std::vector<decision_vector> &x) const
+		{
+			problem::ackley::batch_objfun_impl(f,x);
+			f.pop_back();
+		}
+};
+
+// An invalid batch evaluation must be reported, without counting the evaluations.
+int test_invalid_batch() {
+	broken_batch prob;
+	std::vector<decision_vector> x(3,decision_vector(5,1.));
+	x[1][0] = 2.;
+	x[2][0] = 3.;
+	std::vector<fitness_vector> f;
+	const unsigned int fevals = prob.get_fevals();
+	try {
+		prob.objfun_batch(f,x);
+	} catch (const value_error &) {
+		if (prob.get_fevals() == fevals) {
+			std::cout << "invalid batch passes" << std::endl;
+			return 0;
+		}
+	}
+	std::cout << "objfun_batch: invalid batch not reported, or its evaluations counted" << std::endl;
+	return 1;
+}
+
+// Batch push_back must give the same population as repeated push_back.
+int test_push_back_batch() {
+	problem::zdt prob(1,30);
+	population pop(prob,20,42), pop_seq(prob,0,42), pop_batch(prob,0,42);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+		pop_seq.push_back(x.back());
+	}
+	pop_batch.push_back(x);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (pop_seq.get_individual(i).cur_f != pop_batch.get_individual(i).cur_f ||
+			pop_seq.get_individual(i).cur_v != pop_batch.get_individual(i).cur_v ||
+			pop_seq.get_domination_count(i) != pop_batch.get_domination_count(i))
+		{
+			std::cout << "push_back: batch and sequential individuals differ at position " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "push_back batch passes" << std::endl;
+	return 0;
+}
+
+// Parallel evaluation must not change the outcome of an evolution.
+int test_parallel_evaluation() {
+	problem::ackley prob(10), prob_par(10);
+	prob_par.set_eval_threads(4);
+	population pop(prob,40,42), pop_par(prob_par,40,42);
+	algorithm::sga algo(50);
+	algo.reset_rngs(123);
+	algo.evolve(pop);
+	algo.reset_rngs(123);
+	algo.evolve(pop_par);
+	if (pop.champion().f != pop_par.champion().f || pop.problem().get_fevals() != pop_par.problem().get_fevals()) {
+		std::cout << "parallel evaluation: serial and parallel evolutions differ" << std::endl;
+		return 1;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (pop.get_individual(i).cur_x != pop_par.get_individual(i).cur_x) {
+			std::cout << "parallel evaluation: individuals differ at position " << i << std::endl;
+			return 1;
+		}
+	}
+	// Zero evaluation threads stand for one per hardware thread.
+	problem::ackley prob_auto(10);
+	prob_auto.set_eval_threads(0);
+	if (prob_auto.get_eval_threads() != util::thread_pool::default_size() || prob_auto.clone()->get_eval_threads() != util::thread_pool::default_size()) {
+		std::cout << "parallel evaluation: wrong number of threads for the automatic setting" << std::endl;
+		return 1;
+	}
+	// Same for MOEA/D in batch mode, where the offspring of a generation are evaluated concurrently.
+	problem::dtlz mo_prob(2,12,3), mo_prob_par(2,12,3);
+	mo_prob_par.set_eval_threads(4);
+	population mo_pop(mo_prob,91,42), mo_pop_par(mo_prob_par,91,42);
+	algorithm::moead moead(20,algorithm::moead::GRID,10,0.9,2,1.0,0.5,20,true,true);
+	const unsigned int mo_fevals = mo_pop.problem().get_fevals();
+	moead.reset_rngs(123);
+	moead.evolve(mo_pop);
+	// Each offspring is evaluated once, by the batch, and never again when it replaces an individual. The population is
+	// re-inserted (and re-evaluated) once at the end of the evolution.
+	if (mo_pop.problem().get_fevals() - mo_fevals > (20 + 1) * mo_pop.size()) {
+		std::cout << "parallel evaluation: MOEA/D re-evaluated its offspring" << std::endl;
+		return 1;
+	}
+	moead.reset_rngs(123);
+	moead.evolve(mo_pop_par);
+	for (population::size_type i = 0; i < mo_pop.size(); ++i) {
+		if (mo_pop.get_individual(i).cur_x != mo_pop_par.get_individual(i).cur_x) {
+			std::cout << "parallel evaluation: MOEA/D individuals differ at position " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "parallel evaluation passes" << std::endl;
+	return 0;
+}
+
+// Evolves two copies of the same population with the same seed and checks that they end up identical, and that no
+// more than NP evaluations per generation were spent.
+static bool same_evolution(const algorithm::base &algo, const algorithm::base &algo2, const problem::base &prob, const problem::base &prob2, int gen) {
+	population pop(prob,40,42), pop2(prob2,40,42);
+	algorithm::base_ptr a(algo.clone()), a2(algo2.clone());
+	const unsigned int fevals = pop.problem().get_fevals(), fevals2 = pop2.problem().get_fevals();
+	a->reset_rngs(123);
+	a->evolve(pop);
+	a2->reset_rngs(123);
+	a2->evolve(pop2);
+	if (pop.problem().get_fevals() - fevals > gen * pop.size() || pop2.problem().get_fevals() - fevals2 > gen * pop2.size()) {
+		std::cout << "parallel DE: more than one evaluation per individual and generation" << std::endl;
+		return false;
+	}
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		if (pop.get_individual(i).cur_x != pop2.get_individual(i).cur_x || pop.get_individual(i).cur_v != pop2.get_individual(i).cur_v) {
+			return false;
+		}
+	}
+	return pop.champion().f == pop2.champion().f;
+}
+
+// The generation-synchronous DE and PSO variants must not depend on the number of evaluation threads.
+int test_parallel_de() {
+	problem::ackley prob(10), prob_par(10);
+	prob_par.set_eval_threads(4);
+	std::vector<algorithm::base_ptr> algos;
+	algos.push_back(algorithm::de(50,0.8,0.9,2,0.,0.).clone());
+	algos.push_back(algorithm::jde(50,2,1,0.,0.,false,true).clone());
+	algos.push_back(algorithm::jde(50,15,2,0.,0.,false,true).clone());
+	algos.push_back(algorithm::de_1220(50,2,std::vector<int>(1,2),true,0.,0.,true).clone());
+	algos.push_back(algorithm::pso_generational(50).clone());
+	for (std::vector<algorithm::base_ptr>::size_type k = 0; k < algos.size(); ++k) {
+		if (!same_evolution(*algos[k],*algos[k],prob,prob_par,50)) {
+			std::cout << "parallel DE: serial and parallel evolutions differ for " << algos[k]->get_name() << std::endl;
+			return 1;
+		}
+	}
+	// With the first self-adaptation scheme the batch mode gives the same result as the default one.
+	if (!same_evolution(algorithm::jde(50,2,1,0.,0.),algorithm::jde(50,2,1,0.,0.,false,true),prob,prob_par,50)) {
+		std::cout << "parallel DE: jDE batch and default modes differ" << std::endl;
+		return 1;
+	}
+	std::cout << "parallel DE passes" << std::endl;
+	return 0;
+}
+
+// Textbook formulas of the vectorised problems, computed with the standard library.
+static double ackley_ref(const decision_vector &x) {
+	const double omega = 2. * boost::math::constants::pi<double>();
+	double s1 = 0, s2 = 0;
+	for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+		s1 += x[j] * x[j];
+		s2 += std::cos(omega * x[j]);
+	}
+	return -20 * std::exp(-.2 * std::sqrt(s1 / x.size())) - std::exp(s2 / x.size()) + 20 + std::exp(1.);
+}
+
+static double rastrigin_ref(const decision_vector &x) {
+	const double omega = 2. * boost::math::constants::pi<double>();
+	double f = 10. * x.size();
+	for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+		f += x[j] * x[j] - 10. * std::cos(omega * x[j]);
+	}
+	return f;
+}
+
+static double rosenbrock_ref(const decision_vector &x) {
+	double f = 0;
+	for (decision_vector::size_type j = 0; j + 1 < x.size(); ++j) {
+		f += 100 * (x[j] * x[j] - x[j + 1]) * (x[j] * x[j] - x[j + 1]) + (x[j] - 1) * (x[j] - 1);
+	}
+	return f;
+}
+
+static double griewank_ref(const decision_vector &x) {
+	double s = 0, p = 1;
+	for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+		s += x[j] * x[j];
+		p *= std::cos(x[j] / std::sqrt(j + 1.));
+	}
+	return s / 4000. - p + 1;
+}
+
+static double schwefel_ref(const decision_vector &x) {
+	double f = 0;
+	for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+		f += x[j] * std::sin(std::sqrt(std::fabs(x[j])));
+	}
+	return 418.9828872724338 * x.size() - f;
+}
+
+static double dejong_ref(const decision_vector &x) {
+	double f = 0;
+	for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+		f += x[j] * x[j];
+	}
+	return f;
+}
+
+static double michalewicz_ref(const decision_vector &x) {
+	double f = 0;
+	for (decision_vector::size_type j = 0; j < x.size(); ++j) {
+		f -= std::sin(x[j]) * std::pow(std::sin((j + 1) * x[j] * x[j] / boost::math::constants::pi<double>()),20);
+	}
+	return f;
+}
+
+static double levy5_ref(const decision_vector &x) {
+	double isum = 0, jsum = 0, f = 0;
+	for (decision_vector::size_type j = 0; j < x.size(); j += 2) {
+		for (int i = 1; i <= 5; ++i) {
+			isum += i * std::cos((i - 1) * x[j] + i);
+			jsum += i * std::cos((i + 1) * x[j + 1] + i);
+		}
+		f += (x[j] + 1.42513) * (x[j] + 1.42513) + (x[j + 1] + 0.80032) * (x[j + 1] + 0.80032);
+	}
+	return f + isum * jsum;
+}
+
+// Batch and per-vector fitnesses of 300 random candidates (more than a kernel block, to exercise the tails) must be the same,
+// and agree with the reference formula.
+static bool check_kernel(const problem::base &prob, double (*ref)(const decision_vector &)) {
+	population pop(prob,300,42);
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	std::vector<fitness_vector> f;
+	prob.clone()->objfun_batch(f,x);
+	for (std::vector<decision_vector>::size_type i = 0; i < x.size(); ++i) {
+		if (f[i] != prob.objfun(x[i])) {
+			std::cout << "kernels: batch and per-vector fitnesses differ for " << prob.get_name() << std::endl;
+			return false;
+		}
+		const double r = ref(x[i]);
+		if (std::fabs(f[i][0] - r) > 1E-12 * std::max(1.,std::fabs(r))) {
+			std::cout << "kernels: " << prob.get_name() << " fitness " << f[i][0] << " differs from the reference value " << r << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// The vectorised kernels must give the same fitnesses in batch and per-vector evaluation, and agree with the textbook formulas.
+int test_kernels() {
+	std::vector<problem::base_ptr> probs;
+	std::vector<double (*)(const decision_vector &)> refs;
+	probs.push_back(problem::ackley(13).clone());
+	refs.push_back(ackley_ref);
+	probs.push_back(problem::rastrigin(13).clone());
+	refs.push_back(rastrigin_ref);
+	probs.push_back(problem::rosenbrock(13).clone());
+	refs.push_back(rosenbrock_ref);
+	probs.push_back(problem::griewank(13).clone());
+	refs.push_back(griewank_ref);
+	probs.push_back(problem::schwefel(13).clone());
+	refs.push_back(schwefel_ref);
+	probs.push_back(problem::dejong(13).clone());
+	refs.push_back(dejong_ref);
+	probs.push_back(problem::michalewicz(13).clone());
+	refs.push_back(michalewicz_ref);
+	probs.push_back(problem::levy5(14).clone());
+	refs.push_back(levy5_ref);
+	for (std::vector<problem::base_ptr>::size_type k = 0; k < probs.size(); ++k) {
+		if (!check_kernel(*probs[k],refs[k])) {
+			return 1;
+		}
+	}
+	// Bounds so wide that the arguments of the trigonometric functions go beyond the range of the inline approximations. In the
+	// other problems the trigonometric terms are either negligible with such bounds, or their arguments are too ill-conditioned
+	// to be compared with a reference computed with a different rounding.
+	problem::ackley ackley(13);
+	problem::schwefel schwefel(13);
+	ackley.set_bounds(-1E13,1E13);
+	schwefel.set_bounds(-1E13,1E13);
+	if (!check_kernel(ackley,ackley_ref) || !check_kernel(schwefel,schwefel_ref)) {
+		return 1;
+	}
+	std::cout << "kernels pass (" << util::kernels::isa() << ")" << std::endl;
+	return 0;
+}
+
+int main() {
+	return test_objfun_batch() || test_invalid_batch() || test_push_back_batch() || test_parallel_evaluation() || test_parallel_de() || test_kernels();
+}
@@ -0,0 +1,82 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the Pareto dominance kernels: they must agree with the default fitness comparison of problem::base, for
+// any number of objectives and in presence of ties.
+
+#include <iostream>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/pareto_dominance.h"
+
+using namespace pagmo;
+using util::pareto_dominance;
+
+// Random fitness vectors with coordinates on a coarse grid, so that ties are frequent.
+std::vector<fitness_vector> random_fitnesses(rng_uint32 &urng, std::vector<fitness_vector>::size_type n, fitness_vector::size_type m)
+{
+	std::vector<fitness_vector> retval(n,fitness_vector(m));
+	for (std::vector<fitness_vector>::size_type i = 0; i < n; ++i) {
+		for (fitness_vector::size_type k = 0; k < m; ++k) {
+			retval[i][k] = double(urng() % 3);
+		}
+	}
+	return retval;
+}
+
+int main()
+{
+	rng_uint32 urng(42);
+	for (fitness_vector::size_type m = 2; m < 10; ++m) {
+		// Default implementation of the fitness comparison.
+		problem::dtlz prob(2,5,m);
+		const std::vector<fitness_vector> f = random_fitnesses(urng,200,m);
+		const pareto_dominance dominance(f);
+		std::vector<std::vector<pareto_dominance::size_type> > dom_list;
+		std::vector<pareto_dominance::size_type> dom_count;
+		dominance.compute_dominance(dom_list,dom_count);
+		for (pareto_dominance::size_type i = 0; i < f.size(); ++i) {
+			std::vector<pareto_dominance::size_type> list;
+			pareto_dominance::size_type count = 0;
+			for (pareto_dominance::size_type j = 0; j < f.size(); ++j) {
+				const bool ij = prob.compare_fitness(f[i],f[j]), ji = prob.compare_fitness(f[j],f[i]);
+				if (pareto_dominance::compare(f[i],f[j]) != (ij ? 1 : (ji ? -1 : 0)) || dominance.compare(i,j) != pareto_dominance::compare(f[i],f[j])) {
+					std::cout << "compare: mismatch with " << m << " objectives between " << f[i] << " and " << f[j] << std::endl;
+					return 1;
+				}
+				if (ij) {
+					list.push_back(j);
+				}
+				count += ji;
+			}
+			if (list != dom_list[i] || count != dom_count[i]) {
+				std::cout << "compute_dominance: wrong domination list or count with " << m << " objectives" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "pareto_dominance passes" << std::endl;
+	return 0;
+}
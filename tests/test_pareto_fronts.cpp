@@ -0,0 +1,173 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the incrementally maintained Pareto fronts, and for the two NSGA-II variants built on the index-based ranking.
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/non_dominated_sorting.h"
+#include "../src/util/pareto_fronts.h"
+
+using namespace pagmo;
+
+// dtlz compared through problem::base::compare_fitness().
+class dtlz_generic: public problem::dtlz
+{
+	public:
+		dtlz_generic(size_type id, size_type k, fitness_vector::size_type fdim):problem::dtlz(id,k,fdim) {}
+		problem::base_ptr clone() const
+		{
+			return problem::base_ptr(new dtlz_generic(*this));
+		}
+		bool has_pareto_dominance() const
+		{
+			return false;
+		}
+};
+
+// Crowding distances computed from scratch, ties along an objective broken by identifier.
+struct objective_less
+{
+	objective_less(const std::vector<fitness_vector> &f, const std::vector<std::size_t> &id, std::size_t k):m_f(f),m_id(id),m_k(k) {}
+	bool operator()(std::size_t a, std::size_t b) const
+	{
+		return m_f[a][m_k] < m_f[b][m_k] || (m_f[a][m_k] == m_f[b][m_k] && m_id[a] < m_id[b]);
+	}
+	const std::vector<fitness_vector> &m_f;
+	const std::vector<std::size_t> &m_id;
+	std::size_t m_k;
+};
+
+std::vector<double> reference_crowding(const std::vector<fitness_vector> &f, const std::vector<std::size_t> &id, const std::vector<std::size_t> &rank)
+{
+	std::vector<double> retval(f.size(),0.);
+	std::vector<std::vector<std::size_t> > fronts;
+	for (std::size_t i = 0; i < f.size(); ++i) {
+		if (rank[i] >= fronts.size()) {
+			fronts.resize(rank[i] + 1);
+		}
+		fronts[rank[i]].push_back(i);
+	}
+	for (std::size_t r = 0; r < fronts.size(); ++r) {
+		std::vector<std::size_t> &I = fronts[r];
+		for (std::size_t k = 0; k < f[0].size(); ++k) {
+			std::sort(I.begin(),I.end(),objective_less(f,id,k));
+			retval[I.front()] = retval[I.back()] = std::numeric_limits<double>::max();
+			const double df = f[I.back()][k] - f[I.front()][k];
+			for (std::size_t j = 1; j + 1 < I.size(); ++j) {
+				if (df != 0.) {
+					retval[I[j]] += (f[I[j + 1]][k] - f[I[j - 1]][k]) / df;
+				}
+			}
+		}
+	}
+	return retval;
+}
+
+// Random insertions and removals, with and without ties: ranks and crowding distances must match those computed from scratch.
+int test_random_operations() {
+	rng_uint32 urng(42);
+	rng_double drng(42);
+	for (int t = 0; t < 200; ++t) {
+		const std::size_t m = 2 + urng() % 3, max_id = 60, range = (t % 2) ? 0 : 2 + urng() % 6;
+		util::pareto_fronts fronts(m);
+		std::vector<fitness_vector> stored(max_id);
+		for (int op = 0; op < 300; ++op) {
+			const std::size_t id = urng() % max_id;
+			if (fronts.contains(id)) {
+				fronts.erase(id);
+			} else {
+				stored[id].resize(m);
+				for (std::size_t k = 0; k < m; ++k) {
+					stored[id][k] = range ? double(urng() % range) : drng();
+				}
+				fronts.insert(id,stored[id]);
+			}
+			std::vector<fitness_vector> f;
+			std::vector<std::size_t> ids, rank;
+			for (std::size_t i = 0; i < max_id; ++i) {
+				if (fronts.contains(i)) {
+					f.push_back(stored[i]);
+					ids.push_back(i);
+				}
+			}
+			if (f.size() != fronts.size()) {
+				std::cout << "pareto_fronts: wrong size" << std::endl;
+				return 1;
+			}
+			if (f.empty()) {
+				continue;
+			}
+			util::non_dominated_sorting::compute_ranks(rank,f);
+			const std::vector<double> crowd = reference_crowding(f,ids,rank);
+			for (std::size_t i = 0; i < f.size(); ++i) {
+				if (fronts.get_pareto_rank(ids[i]) != rank[i] || fronts.get_crowding_d(ids[i]) != crowd[i]) {
+					std::cout << "pareto_fronts: mismatch for " << f[i] << ": rank " << fronts.get_pareto_rank(ids[i]) << " vs " << rank[i]
+						<< ", crowding distance " << fronts.get_crowding_d(ids[i]) << " vs " << crowd[i] << std::endl;
+					return 1;
+				}
+			}
+			const std::size_t worst = fronts.get_worst();
+			if (fronts.get_pareto_rank(worst) + 1 != fronts.n_fronts()) {
+				std::cout << "pareto_fronts: the worst point is not in the last front" << std::endl;
+				return 1;
+			}
+		}
+	}
+	std::cout << "pareto_fronts passes" << std::endl;
+	return 0;
+}
+
+// Both NSGA-II variants must evolve the same populations whether the dominance is plain or goes through the problem.
+int test_nsga2(algorithm::nsga2::selection_type selection) {
+	population pop_plain(problem::dtlz(1,5,3),40,123);
+	population pop_generic(dtlz_generic(1,5,3),40,123);
+	algorithm::nsga2 algo(20,0.95,10,0.01,50,selection);
+	algo.reset_rngs(5);
+	algo.evolve(pop_plain);
+	algo.reset_rngs(5);
+	algo.evolve(pop_generic);
+	for (population::size_type i = 0; i < pop_plain.size(); ++i) {
+		const population::individual_type &ind = pop_plain.get_individual(i);
+		if (ind.cur_x != pop_generic.get_individual(i).cur_x || ind.cur_f != pop_generic.get_individual(i).cur_f) {
+			std::cout << "nsga2: populations differ at individual " << i << std::endl;
+			return 1;
+		}
+		if (pop_plain.problem().objfun(ind.cur_x) != ind.cur_f || ind.best_x != ind.cur_x || ind.best_f != ind.cur_f) {
+			std::cout << "nsga2: inconsistent individual " << i << std::endl;
+			return 1;
+		}
+	}
+	std::cout << "nsga2 (" << (selection == algorithm::nsga2::STEADY_STATE ? "steady-state" : "generational") << ") passes" << std::endl;
+	return 0;
+}
+
+int main()
+{
+	return test_random_operations() || test_nsga2(algorithm::nsga2::GENERATIONAL) || test_nsga2(algorithm::nsga2::STEADY_STATE);
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the binary population snapshots and the incremental checkpoints.
+
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../src/pagmo.h"
+#include "../src/util/snapshot.h"
+
+using namespace pagmo;
+
+static bool same_population(const population &a, const population &b)
+{
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (population::size_type i = 0; i < a.size(); ++i) {
+		if (util::snapshot::differs(a.get_individual(i),b.get_individual(i))) {
+			return false;
+		}
+	}
+	return a.champion().x == b.champion().x && a.champion().f == b.champion().f && a.champion().c == b.champion().c;
+}
+
+// A full record followed by a delta must rebuild the evolved population, with and without compression.
+int test_records(unsigned int flags) {
+	problem::zdt prob(1,30);
+	population ref(prob,40,7);
+	population cur(ref);
+	algorithm::nsga2 algo(3);
+	algo.evolve(cur);
+	std::ostringstream oss(std::ios::binary);
+	util::snapshot::save(oss,ref,flags);
+	util::snapshot::save_delta(oss,ref,cur,flags);
+	const std::string buffer = oss.str();
+	population loaded(prob);
+	if (util::snapshot::load(buffer.data(),buffer.size(),loaded) != 2 || !same_population(loaded,cur)) {
+		std::cout << "snapshot: wrong population rebuilt with flags " << flags << std::endl;
+		return 1;
+	}
+	// A truncated buffer must be rejected.
+	try {
+		util::snapshot::load(buffer.data(),buffer.size() - 8,loaded);
+		std::cout << "snapshot: truncated record was accepted" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	// A header claiming more rows than the payload holds must be rejected before allocating them.
+	std::string corrupted(buffer);
+	const boost::uint64_t huge = boost::uint64_t(1) << 40;
+	std::memcpy(&corrupted[16],&huge,sizeof(huge));
+	std::memcpy(&corrupted[24],&huge,sizeof(huge));
+	try {
+		util::snapshot::load(corrupted.data(),corrupted.size(),loaded);
+		std::cout << "snapshot: corrupted row count was accepted" << std::endl;
+		return 1;
+	} catch (const value_error &) {}
+	return 0;
+}
+
+// An archipelago checkpointed after each evolution must be restored to its last state.
+int test_checkpoint() {
+	const std::string filename("test_snapshot.pgs");
+	archipelago a(algorithm::de(5),problem::rosenbrock(20),4,15,topology::ring());
+	{
+		util::checkpoint cp(filename,util::snapshot::compress);
+		for (int i = 0; i < 3; ++i) {
+			a.evolve(1);
+			a.join();
+			cp.write(a);
+		}
+	}
+	archipelago b(algorithm::de(5),problem::rosenbrock(20),4,15,topology::ring());
+	util::checkpoint::restore(filename,b);
+	std::remove(filename.c_str());
+	for (archipelago::size_type i = 0; i < a.get_size(); ++i) {
+		if (!same_population(a.get_island(i)->get_population(),b.get_island(i)->get_population())) {
+			std::cout << "checkpoint: island " << i << " was not restored" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main()
+{
+	return test_records(util::snapshot::none) || test_records(util::snapshot::compress) || test_checkpoint();
+}
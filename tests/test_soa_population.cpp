@@ -0,0 +1,68 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+
+// Test for the structure-of-arrays population storage.
+
+#include <iostream>
+#include "../src/pagmo.h"
+#include "../src/util/soa_population.h"
+
+using namespace pagmo;
+
+int main()
+{
+	problem::zdt prob(1,10);
+	population pop(prob,20);
+	util::soa_population store(pop);
+	if (store.size() != pop.size() || store.cur_x.cols() != 10 || store.cur_f.cols() != 2 || store.cur_c.cols() != 0) {
+		std::cout << "soa_population: wrong dimensions" << std::endl;
+		return 1;
+	}
+	// The views must alias the matrices.
+	store[3].cur_x[4] = 0.25;
+	util::soa_population::row(store.best_f,5).setZero();
+	if (store.cur_x(3,4) != 0.25 || store[5].best_f.sum() != 0) {
+		std::cout << "soa_population: views do not alias the storage" << std::endl;
+		return 1;
+	}
+	// Store into a population of different size and check the round trip.
+	population other(prob,1);
+	store.store(other);
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		population::individual_type ind = pop.get_individual(i);
+		if (i == 3) {
+			ind.cur_x[4] = 0.25;
+		}
+		if (i == 5) {
+			ind.best_f.assign(2,0.);
+		}
+		const population::individual_type &o = other.get_individual(i);
+		if (other.size() != pop.size() || o.cur_x != ind.cur_x || o.cur_v != ind.cur_v || o.cur_f != ind.cur_f || o.best_x != ind.best_x || o.best_f != ind.best_f) {
+			std::cout << "soa_population: individual " << i << " was not stored" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ *   Copyright (C) 2004-2015 The PaGMO development team,                     *
+ *   Advanced Concepts Team (ACT), European Space Agency (ESA)               *
+ *                                                                           *
+ *   https://github.com/esa/pagmo                                            *
+ *                                                                           *
+ *   act@esa.int                                                             *
+ *                                                                           *
+ *   This program is free software; you can redistribute it and/or modify    *
+ *   it under the terms of the GNU General Public License as published by    *
+ *   the Free Software Foundation; either version 2 of the License, or       *
+ *   (at your option) any later version.                                     *
+ *                                                                           *
+ *   This program is distributed in the hope that it will be useful,         *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of          *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the           *
+ *   GNU General Public License for more details.                            *
+ *                                                                           *
+ *   You should have received a copy of the GNU General Public License       *
+ *   along with this program; if not, write to the                           *
+ *   Free Software Foundation, Inc.,                                         *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.               *
+ *****************************************************************************/
+
+// Test for the fitness/constraint cache
+
+#include <iostream>
+#include <list>
+#include <vector>
+#include "../src/pagmo.h"
+#include "../src/util/vector_cache.h"
+
+using namespace pagmo;
+
+static std::vector<double> key(double a)
+{
+	return std::vector<double>(3,a);
+}
+
+// With capacity 3, after touching a the insertion of d must evict b with both policies.
+int test_eviction(util::vector_cache::eviction_type eviction) {
+	util::vector_cache cache(3,eviction);
+	std::vector<double> v;
+	cache.insert(key(0),key(10));
+	cache.insert(key(1),key(11));
+	cache.insert(key(2),key(12));
+	cache.find(v,key(0));
+	cache.insert(key(3),key(13));
+	if (cache.find(v,key(1)) || !cache.find(v,key(0)) || v != key(10) || !cache.find(v,key(2)) || !cache.find(v,key(3))
+		|| v != key(13) || cache.get_size() != 3 || cache.get_hits() != 4 || cache.get_misses() != 1)
+	{
+		std::cout << "vector_cache: wrong eviction with policy " << eviction << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+// Compare the LRU cache against a naive model on a random access pattern, exercising collisions and deletions.
+int test_lru_model() {
+	const std::size_t capacity = 16;
+	util::vector_cache cache(capacity);
+	std::list<double> model;
+	rng_uint32 urng(42);
+	std::vector<double> v;
+	for (int i = 0; i < 20000; ++i) {
+		const double k = urng() % 40;
+		std::list<double>::iterator it = model.begin();
+		while (it != model.end() && *it != k) {
+			++it;
+		}
+		const bool expected = (it != model.end());
+		if (cache.find(v,key(k)) != expected || (expected && v != key(k + 1))) {
+			std::cout << "vector_cache: mismatch with the LRU model at iteration " << i << std::endl;
+			return 1;
+		}
+		if (expected) {
+			model.erase(it);
+		} else {
+			cache.insert(key(k),key(k + 1));
+			if (model.size() == capacity) {
+				model.pop_back();
+			}
+		}
+		model.push_front(k);
+	}
+	return 0;
+}
+
+// Re-evaluating a population must not call the objective function again when the cache is large enough.
+int test_problem_cache() {
+	problem::ackley prob(5);
+	prob.set_cache_capacity(100);
+	population pop(prob,50);
+	std::vector<fitness_vector> f;
+	std::vector<decision_vector> x;
+	for (population::size_type i = 0; i < pop.size(); ++i) {
+		x.push_back(pop.get_individual(i).cur_x);
+	}
+	// The problem may already have been evaluated (e.g., to set its known optima).
+	const unsigned int fevals = prob.get_fevals();
+	const std::size_t hits = prob.get_fitness_cache().get_hits();
+	prob.objfun_batch(f,x);
+	prob.objfun_batch(f,x);
+	if (prob.get_fevals() - fevals != x.size() || prob.get_fitness_cache().get_hits() - hits != x.size()) {
+		std::cout << "vector_cache: problem cache was not hit" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main()
+{
+	return test_eviction(util::vector_cache::lru) || test_eviction(util::vector_cache::clock) || test_lru_model() || test_problem_cache();
+}